@@ -0,0 +1,102 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE BSymKShf.cc.
+   Example program that illustrates how to solve a real symmetric
+   band standard eigenvalue problem in shift and invert mode using
+   the ARluSymStdEig class and the Krylov-Schur engine.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in shift and
+      invert mode, where A is derived from the standard central
+      difference discretization of the 2-dimensional Laplacian on
+      the unit square with zero Dirichlet boundary conditions.
+
+      The engine asks for OP*X by blocks of four vectors, and
+      ARluSymStdEig computes each block with one call to the MultInvV
+      function of ARbdSymMatrix. Before the problem is solved,
+      MultInvV is compared with four calls to MultInvv. The program
+      returns 1 if they differ or if some eigenvalue has not
+      converged.
+
+   2) Data structure used to represent matrix A:
+
+      Only the nonzero diagonals of the lower triangular part of
+      A are stored, by columns, in the vector A.
+
+   3) Library called by this example:
+
+      The LAPACK package is called by ARluSymStdEig to solve
+      some linear systems involving (A-sigma*I). This is needed to
+      implement the shift and invert strategy.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      bsmatrxa.h       BandMatrixA, a function that generates
+                       matrix A.
+      arbsmat.h        The ARbdSymMatrix class definition.
+      arbssym.h        The ARluSymStdEig class definition.
+      lsymsol.h        The Solution function.
+      lsymmulv.h       The CheckMultInvV function.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "bsmatrxa.h"
+#include "arbsmat.h"
+#include "arbssym.h"
+#include "lsymsol.h"
+#include "lsymmulv.h"
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     nx;
+  int     n;       // Dimension of the problem.
+  int     nsdiag;  // Lower (and upper) bandwidth of A.
+  double* A;       // Pointer to an array that stores the elements of A.
+  bool    ok;
+
+  // Creating a 100x100 matrix.
+
+  nx  = 10;
+  BandMatrixA(nx, n, nsdiag, A);
+  ARbdSymMatrix<double> matrix(n, nsdiag, A);
+
+  // Defining what we need: the four eigenvectors of A nearest to 0.0.
+  // The constructor factors A-sigma*I.
+
+  ARluSymStdEig<double> dprob(4L, matrix, 0.0);
+
+  // Comparing MultInvV with MultInvv.
+
+  ok = CheckMultInvV(matrix, 4, 0.0);
+
+  // Finding eigenvalues and eigenvectors with blocks of four vectors.
+
+  dprob.SetKrylovSchur(4);
+  dprob.FindEigenvectors();
+  ok = ok && (dprob.ConvergedEigenvalues() == 4);
+
+  // Printing solution.
+
+  Solution(matrix, dprob);
+
+  return ok ? 0 : 1;
+
+} // main
@@ -0,0 +1,143 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE BSymMix.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem in shift and invert mode in single
+   precision, and to refine the solution in double precision using
+   the ARSymRefine and ARMixedMatrix classes.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in shift and
+      invert mode, where A is derived from the standard central
+      difference discretization of the 2-dimensional Laplacian on
+      the unit square with zero Dirichlet boundary conditions.
+
+      A-sigma*I is factored and the Arnoldi method is run in single
+      precision by ARluSymStdEig<float>, so the Arnoldi basis, the
+      work vectors and the factors take half the memory (and memory
+      bandwidth) required in double precision. The eigenvectors are
+      then refined in double precision by ARSymRefine, that uses
+      the products A*x in double precision and solves the systems
+      with A-sigma*I by iterative refinement, reusing the single
+      precision factors (ARMixedMatrix).
+
+   2) Data structure used to represent matrix A:
+
+      {nsdiag, A}: matrix A data in symmetric band format. The elements
+      of the main diagonal and the first nsdiag subdiagonals of A are
+      stored sequentially, by columns, in vector A. A copy of A is
+      stored in single precision.
+
+   3) Library called by this example:
+
+      The LAPACK package is called by ARluSymStdEig to factor
+      A-sigma*I and by ARSymRefine.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      bsmatrxa.h       BandMatrixA, a function that generates
+                       matrix A in band format.
+      arbsmat.h        The ARbdSymMatrix class definition.
+      arbssym.h        The ARluSymStdEig class definition.
+      armixed.h        The ARSymRefine and ARMixedMatrix classes.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include "bsmatrxa.h"
+#include "arbsmat.h"
+#include "arbssym.h"
+#include "armixed.h"
+
+
+typedef ARMixedMatrix<double, ARbdSymMatrix<double>,
+                      float, ARbdSymMatrix<float> > MixedMatrix;
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     i, nx, nconv;
+  int     n;       // Dimension of the problem.
+  int     nsdiag;  // Lower (and upper) bandwidth of A.
+  double* A;       // Pointer to an array that stores the elements of A.
+  float*  Af;      // The same elements in single precision.
+
+  // Creating a 900x900 matrix (in double and in single precision).
+
+  nx  = 30;
+  BandMatrixA(nx, n, nsdiag, A);
+  BandMatrixA(nx, n, nsdiag, Af);
+  ARbdSymMatrix<double> matrix(n, nsdiag, A);
+  ARbdSymMatrix<float>  fmatrix(n, nsdiag, Af);
+
+  // Defining what we need: the four eigenvectors of A nearest to 0.0,
+  // computed in single precision.
+
+  ARluSymStdEig<float> fprob(4L, fmatrix, 0.0);
+
+  // Finding eigenvalues and eigenvectors.
+
+  fprob.FindEigenvectors();
+
+  // Refining the eigenvectors in double precision. The single precision
+  // factors of A computed by fprob are reused by MultInvv.
+
+  MixedMatrix mixed(&matrix, &fmatrix);
+  mixed.DefineShift(0.0);
+
+  ARSymRefine<double, ARbdSymMatrix<double>, MixedMatrix>
+    refine(n, &matrix, &ARbdSymMatrix<double>::MultMv);
+  refine.SetOperator(&mixed, &MixedMatrix::MultInvv);
+
+  nconv = refine.Refine(fprob);
+
+  // Printing solution.
+
+  std::cout << std::endl << "Testing ARPACK++ classes ARSymRefine and ";
+  std::cout << "ARMixedMatrix" << std::endl;
+  std::cout << "Real symmetric eigenvalue problem: A*x - lambda*x";
+  std::cout << std::endl << std::endl;
+  std::cout << "Dimension of the system:            " << n << std::endl;
+  std::cout << "Converged eigenvalues (float):      ";
+  std::cout << fprob.ConvergedEigenvalues() << std::endl;
+  std::cout << "Refined eigenvalues (double):       " << nconv << std::endl;
+  std::cout << "Rayleigh-Ritz steps:                ";
+  std::cout << refine.GetIter() << std::endl;
+  std::cout << "Refinement steps taken by MultInvv: ";
+  std::cout << mixed.GetTotalRefinements() << std::endl << std::endl;
+
+  std::cout.precision(15);
+  for (i=0; i<refine.GetNev(); i++) {
+    std::cout << "lambda[" << (i+1) << "]: " << refine.Eigenvalue(i);
+    std::cout << "  (float: " << fprob.Eigenvalue(i) << ")" << std::endl;
+  }
+  std::cout.precision(6);
+  std::cout << std::endl;
+  for (i=0; i<refine.GetNev(); i++) {
+    std::cout << "||A*x(" << (i+1) << ") - lambda(" << (i+1);
+    std::cout << ")*x(" << (i+1) << ")||: " << refine.ResidualNorm(i);
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+
+  delete[] A;
+  delete[] Af;
+
+} // main
@@ -0,0 +1,660 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE BenchMk.h
+   Templates and classes used by the matrix benchmark programs.
+   They generate banded test matrices, read Harwell-Boeing files,
+   convert matrices from CSC to band and packed dense formats,
+   time MultMv, MultInvv, FactorA, FactorAsI and FindEigenvectors
+   for a given matrix class and print the results in JSON format.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef BENCHMK_H
+#define BENCHMK_H
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include "arstats.h"
+#include "arhbmat.h"
+#include "arssym.h"
+
+
+// BenchParams class definition.
+
+class BenchParams {
+
+ public:
+
+  int    n;        // Dimension of the generated matrix.
+  int    nsdiag;   // Number of subdiagonals of the generated matrix.
+  double density;  // Fraction of nonzero elements inside the band.
+  int    nev;      // Number of eigenvalues computed by FindEigenvectors.
+  double sigma;    // Shift used by FactorAsI and FindEigenvectors.
+  double mintime;  // Minimum time spent timing each function.
+  int    maxcalls; // Maximum number of calls to each function.
+  bool   eig;      // Indicates if FindEigenvectors is to be timed.
+  std::string output;             // Output file (empty for std::cout).
+  std::vector<std::string> files; // Harwell-Boeing files.
+
+  bool Read(int argc, char* argv[]);
+  // Reads parameters from the command line.
+
+  void PrintHelp(const char* name);
+  // Prints information about the program usage.
+
+  BenchParams(int np = 10000);
+  // Constructor (defines default values).
+
+}; // class BenchParams.
+
+
+inline BenchParams::BenchParams(int np)
+{
+
+  n        = np;
+  nsdiag   = 10;
+  density  = 0.5;
+  nev      = 4;
+  sigma    = 0.0;
+  mintime  = 0.2;
+  maxcalls = 1000;
+  eig      = true;
+
+} // Constructor.
+
+
+inline void BenchParams::PrintHelp(const char* name)
+{
+
+  std::cout << name << ": ARPACK++ matrix benchmark" << std::endl;
+  std::cout << "usage:   " << name << " [parameters] [file1 file2 ...]";
+  std::cout << std::endl << "parameters:" << std::endl;
+  std::cout << "      -n <dimension of the generated matrix>" << std::endl;
+  std::cout << "      -b <number of subdiagonals>" << std::endl;
+  std::cout << "      -d <fraction of nonzero elements inside the band>";
+  std::cout << std::endl;
+  std::cout << "      -e <number of eigenvalues (0 skips FindEigenvectors)>";
+  std::cout << std::endl;
+  std::cout << "      -s <shift>" << std::endl;
+  std::cout << "      -t <minimum time spent timing each function>";
+  std::cout << std::endl;
+  std::cout << "      -r <maximum number of calls to each function>";
+  std::cout << std::endl;
+  std::cout << "      -o <output file>" << std::endl;
+  std::cout << "files must be in Harwell-Boeing format. Unsymmetric matrices";
+  std::cout << std::endl << "are replaced by their symmetric part." << std::endl;
+
+} // PrintHelp.
+
+
+inline bool BenchParams::Read(int argc, char* argv[])
+{
+
+  int i;
+
+  i = 1;
+  while (i<argc) {
+    if (argv[i][0] != '-') {
+      files.push_back(argv[i++]);
+    }
+    else if ((strlen(argv[i]) != 2) || (i+1 == argc)) {
+      return false;
+    }
+    else {
+      switch (argv[i++][1]) {
+      case 'n':
+        n = atoi(argv[i++]);
+        break;
+      case 'b':
+        nsdiag = atoi(argv[i++]);
+        break;
+      case 'd':
+        density = atof(argv[i++]);
+        break;
+      case 'e':
+        nev = atoi(argv[i++]);
+        eig = (nev > 0);
+        break;
+      case 's':
+        sigma = atof(argv[i++]);
+        break;
+      case 't':
+        mintime = atof(argv[i++]);
+        break;
+      case 'r':
+        maxcalls = atoi(argv[i++]);
+        break;
+      case 'o':
+        output = argv[i++];
+        break;
+      default :
+        return false;
+      }
+    }
+  }
+  if (nsdiag >= n) nsdiag = n-1;
+  return ((n > 0) && (nsdiag >= 0) && (density > 0.0) && (maxcalls > 0));
+
+} // Read.
+
+
+// BenchTiming class definition.
+
+class BenchTiming {
+
+ private:
+
+  double t0;       // Time at which the last call has begun.
+
+ public:
+
+  int    calls;    // Number of calls.
+  double first;    // Time spent by the first call.
+  double best;     // Time spent by the fastest call.
+  double total;    // Time spent by all calls.
+
+  void Reset() { calls = 0; first = best = total = 0.0; }
+  // Sets all counters to zero.
+
+  void Start() { t0 = ARTime(); }
+  // Must be called before each call.
+
+  void Stop();
+  // Must be called after each call.
+
+  bool Done(const BenchParams& par)
+  {
+    return (calls > 0) && ((total >= par.mintime) || (calls >= par.maxcalls));
+  }
+  // Indicates if the function was called enough times.
+
+  void Print(std::ostream& out, const char* name);
+  // Prints the results as a JSON object member.
+
+  BenchTiming() { Reset(); }
+  // Constructor.
+
+}; // class BenchTiming.
+
+
+inline void BenchTiming::Stop()
+{
+
+  double dt;
+
+  dt = ARTime()-t0;
+  if ((calls == 0) || (dt < best)) best = dt;
+  if (calls == 0) first = dt;
+  total += dt;
+  calls++;
+
+} // Stop.
+
+
+inline void BenchTiming::Print(std::ostream& out, const char* name)
+{
+
+  out << "      \"" << name << "\": {\"calls\": " << calls;
+  out << ", \"first\": " << first << ", \"best\": " << best;
+  out << ", \"mean\": " << ((calls > 0) ? total/calls : 0.0) << "}";
+
+} // Print.
+
+
+inline std::string BenchEscape(const std::string& s)
+{
+
+  // Returns s with the characters that are not allowed in a JSON string
+  // replaced.
+
+  std::string r;
+
+  for (std::string::size_type i=0; i<s.size(); i++) {
+    if ((s[i] == '"') || (s[i] == '\\')) r += '\\';
+    r += ((unsigned char)s[i] < ' ') ? ' ' : s[i];
+  }
+  return r;
+
+} // BenchEscape.
+
+
+inline double BenchRandom(unsigned long& seed)
+{
+
+  // Returns a pseudo-random number in [-1,1). A local generator is
+  // used so that the same matrix is generated on all platforms.
+
+  seed = (seed*1103515245UL+12345UL)&0x7fffffffUL;
+  return double(seed)/double(0x40000000UL)-1.0;
+
+} // BenchRandom.
+
+
+// BenchProblem class definition.
+
+template<class ARFLOAT>
+class BenchProblem {
+
+ public:
+
+  std::string name;      // Problem name.
+  int         n;         // Dimension.
+  int         nnz;       // Number of nonzero elements in the lower triangle.
+  int         nsdiag;    // Number of subdiagonals.
+  bool        symmetric; // Indicates if the original matrix was symmetric.
+  ARFLOAT*    a;         // Lower triangle of the matrix in CSC format.
+  int*        irow;
+  int*        pcol;
+
+  void Banded(const BenchParams& par);
+  // Generates a diagonally dominant matrix with par.nsdiag subdiagonals.
+
+  bool Read(const std::string& file);
+  // Reads the lower triangle of a matrix (or of its symmetric part)
+  // from a Harwell-Boeing file.
+
+  void Band(ARFLOAT* &Ab);
+  // Stores the matrix in band format (as required by ARbdSymMatrix).
+
+  void Packed(ARFLOAT* &Ad);
+  // Stores the matrix in packed format (as required by ARdsSymMatrix).
+
+  void Print(std::ostream& out);
+  // Prints the problem description as JSON object members.
+
+  BenchProblem() { a = NULL; irow = pcol = NULL; n = nnz = nsdiag = 0; }
+  // Constructor.
+
+  ~BenchProblem() { delete[] a; delete[] irow; delete[] pcol; }
+  // Destructor.
+
+}; // class BenchProblem.
+
+
+template<class ARFLOAT>
+void BenchProblem<ARFLOAT>::Banded(const BenchParams& par)
+{
+
+  int           i, j, k;
+  ARFLOAT       val;
+  ARFLOAT*      sum;
+  unsigned long seed;
+
+  // Counting nonzero elements. Subdiagonal k is stored if it is the
+  // first one or if it is selected at random with probability density.
+
+  std::vector<bool> used(par.nsdiag+1, false);
+
+  seed    = 1;
+  used[0] = true;
+  if (par.nsdiag > 0) used[1] = true;
+  for (k=2; k<=par.nsdiag; k++) {
+    used[k] = ((BenchRandom(seed)+1.0)/2.0 < par.density);
+  }
+
+  name      = "banded";
+  n         = par.n;
+  nsdiag    = par.nsdiag;
+  symmetric = true;
+  nnz       = 0;
+  for (k=0; k<=nsdiag; k++) if (used[k]) nnz += n-k;
+
+  a    = new ARFLOAT[nnz];
+  irow = new int[nnz];
+  pcol = new int[n+1];
+  sum  = new ARFLOAT[n];
+
+  for (i=0; i<n; i++) sum[i] = 0.0;
+
+  // Defining the off-diagonal elements and the diagonal, that is
+  // chosen to make the matrix positive definite.
+
+  pcol[0] = 0;
+  for (j=0; j<n; j++) {
+    pcol[j+1] = pcol[j];
+    k = pcol[j+1]++;
+    irow[k] = j;
+    for (i=j+1; (i<n) && (i-j<=nsdiag); i++) {
+      if (used[i-j]) {
+        val = ARFLOAT(BenchRandom(seed));
+        k   = pcol[j+1]++;
+        irow[k] = i;
+        a[k]    = val;
+        sum[i] += fabs(val);
+        sum[j] += fabs(val);
+      }
+    }
+  }
+  for (j=0; j<n; j++) a[pcol[j]] = sum[j]+ARFLOAT(1.0+double(j)/double(n));
+
+  delete[] sum;
+
+} // Banded.
+
+
+template<class ARFLOAT>
+bool BenchProblem<ARFLOAT>::Read(const std::string& file)
+{
+
+  int      i, j, k;
+  int      *ir, *pc;
+  ARFLOAT  *av, half;
+
+  ARhbMatrix<int, ARFLOAT> hb(file);
+
+  if ((!hb.IsDefined()) || (!hb.IsReal()) || (hb.NRows() != hb.NCols())) {
+    return false;
+  }
+
+  name      = file;
+  n         = hb.NCols();
+  symmetric = hb.IsSymmetric();
+  ir        = hb.RowInd();
+  pc        = hb.ColPtr();
+  av        = hb.Entries();
+
+  // Counting elements in the lower triangle of A (or A+A'). Elements
+  // stored in the upper triangle are moved to the lower one.
+
+  std::vector<int> cnt(n, 0);
+  for (j=0; j<n; j++) {
+    for (k=pc[j]; k<pc[j+1]; k++) cnt[(ir[k] >= j) ? j : ir[k]]++;
+  }
+
+  pcol    = new int[n+1];
+  pcol[0] = 0;
+  for (j=0; j<n; j++) pcol[j+1] = pcol[j]+cnt[j];
+  nnz     = pcol[n];
+  irow    = new int[nnz];
+  a       = new ARFLOAT[nnz];
+
+  // Copying the lower triangle. Unsymmetric matrices are replaced by
+  // (A+A')/2, so each entry is halved and duplicates are summed below.
+
+  half = symmetric ? ARFLOAT(1) : ARFLOAT(0.5);
+  for (j=0; j<n; j++) cnt[j] = pcol[j];
+  for (j=0; j<n; j++) {
+    for (k=pc[j]; k<pc[j+1]; k++) {
+      i = ir[k];
+      if (i >= j) { irow[cnt[j]] = i; a[cnt[j]++] = half*av[k]; }
+      else        { irow[cnt[i]] = j; a[cnt[i]++] = half*av[k]; }
+    }
+  }
+
+  // Sorting row indices and merging duplicated entries.
+
+  std::vector<ARFLOAT> col(n, ARFLOAT(0));
+  std::vector<int>     rows;
+  k      = 0;
+  nsdiag = 0;
+  for (j=0; j<n; j++) {
+    rows.clear();
+    for (i=pcol[j]; i<pcol[j+1]; i++) {
+      if (col[irow[i]] == ARFLOAT(0)) rows.push_back(irow[i]);
+      col[irow[i]] += a[i];
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    pcol[j] = k;
+    for (i=0; i<int(rows.size()); i++) {
+      irow[k] = rows[i];
+      a[k++]  = col[rows[i]];
+      if (rows[i]-j > nsdiag) nsdiag = rows[i]-j;
+      col[rows[i]] = ARFLOAT(0);
+    }
+  }
+  pcol[n] = nnz = k;
+  return true;
+
+} // Read.
+
+
+template<class ARFLOAT>
+void BenchProblem<ARFLOAT>::Band(ARFLOAT* &Ab)
+{
+
+  int i, j, lda;
+
+  lda = nsdiag+1;
+  Ab  = new ARFLOAT[lda*n];
+  for (i=0; i<lda*n; i++) Ab[i] = ARFLOAT(0);
+  for (j=0; j<n; j++) {
+    for (i=pcol[j]; i<pcol[j+1]; i++) Ab[irow[i]-j+j*lda] = a[i];
+  }
+
+} // Band.
+
+
+template<class ARFLOAT>
+void BenchProblem<ARFLOAT>::Packed(ARFLOAT* &Ad)
+{
+
+  int i, j, start;
+
+  Ad = new ARFLOAT[(n*n+n)/2];
+  for (i=0; i<(n*n+n)/2; i++) Ad[i] = ARFLOAT(0);
+  for (j=0, start=0; j<n; start+=(n-(j++))) {
+    for (i=pcol[j]; i<pcol[j+1]; i++) Ad[start+irow[i]-j] = a[i];
+  }
+
+} // Packed.
+
+
+template<class ARFLOAT>
+void BenchProblem<ARFLOAT>::Print(std::ostream& out)
+{
+
+  out << "      \"name\": \"" << BenchEscape(name) << "\"," << std::endl;
+  out << "      \"n\": " << n << ", \"nnz\": " << nnz;
+  out << ", \"bandwidth\": " << nsdiag;
+  out << ", \"symmetric\": " << (symmetric ? "true" : "false");
+
+} // Print.
+
+
+template<class ARMATRIX>
+bool BenchMemory(ARMATRIX&, long&, long&)
+{
+
+  // Stores in the last two arguments the number of blocks and bytes
+  // allocated by the matrix class (and by the library it calls).
+  // Returns false if the class does not count its allocations.
+  // Overloaded by the programs that can provide these numbers.
+
+  return false;
+
+} // BenchMemory.
+
+
+template<class ARFLOAT, class ARMATRIX>
+void BenchMatrix(std::ostream& out, ARMATRIX& A, BenchProblem<ARFLOAT>& prob,
+                 const BenchParams& par)
+{
+
+  // Times the main functions of matrix A and prints the results in JSON
+  // format. A must contain the matrix stored in prob.
+
+  int         i, nconv;
+  bool        mem;
+  long        nblk0, nblk1, nblk2, nbyte0, nbyte1, nbyte2;
+  BenchTiming t;
+
+  nblk0 = nblk1 = nblk2 = nbyte0 = nbyte1 = nbyte2 = 0;
+  std::vector<ARFLOAT> v(prob.n), w(prob.n);
+  unsigned long seed = 2;
+  for (i=0; i<prob.n; i++) v[i] = ARFLOAT(BenchRandom(seed));
+
+  out << "    {" << std::endl;
+  prob.Print(out);
+
+  // MultMv.
+
+  for (t.Reset(); !t.Done(par); ) {
+    t.Start();
+    A.MultMv(&v[0], &w[0]);
+    t.Stop();
+  }
+  out << "," << std::endl;
+  t.Print(out, "MultMv");
+
+  // FactorA. The first call may include the symbolic analysis.
+
+  try {
+    for (t.Reset(); !t.Done(par); ) {
+      t.Start();
+      A.FactorA();
+      t.Stop();
+    }
+    out << "," << std::endl;
+    t.Print(out, "FactorA");
+  }
+  catch (const ArpackError&) {
+    ArpackError();
+  }
+
+  // FactorAsI and MultInvv.
+
+  try {
+    for (t.Reset(); !t.Done(par); ) {
+      t.Start();
+      A.FactorAsI(ARFLOAT(par.sigma));
+      t.Stop();
+    }
+    out << "," << std::endl;
+    t.Print(out, "FactorAsI");
+    mem = BenchMemory(A, nblk0, nbyte0);
+    for (t.Reset(); !t.Done(par); ) {
+      t.Start();
+      A.MultInvv(&v[0], &w[0]);
+      t.Stop();
+      if (mem && (t.calls == 1)) BenchMemory(A, nblk1, nbyte1);
+    }
+    out << "," << std::endl;
+    t.Print(out, "MultInvv");
+
+    // Blocks allocated (and not freed) by the first call to MultInvv
+    // and by all the following ones (zero in the steady state).
+
+    if (mem) {
+      BenchMemory(A, nblk2, nbyte2);
+      out << "," << std::endl;
+      out << "      \"MultInvvMemory\": {\"first_blocks\": " << nblk1-nblk0;
+      out << ", \"first_bytes\": " << nbyte1-nbyte0;
+      out << ", \"steady_blocks\": " << nblk2-nblk1;
+      out << ", \"steady_bytes\": " << nbyte2-nbyte1 << "}";
+    }
+  }
+  catch (const ArpackError&) {
+    out << "," << std::endl << "      \"error\": \"cannot factor A-sigma*I\"";
+    out << std::endl << "    }";
+    ArpackError();
+    return;
+  }
+
+  // FindEigenvectors in shift and invert mode (A-sigma*I is factored).
+
+  if ((!par.eig) || (par.nev >= prob.n-1)) {
+    out << std::endl << "    }";
+    return;
+  }
+
+  ARStats stats;
+  nconv = 0;
+  for (t.Reset(); !t.Done(par); ) {
+    ARSymStdEig<ARFLOAT, ARMATRIX>
+      eig(prob.n, par.nev, &A, &ARMATRIX::MultInvv, ARFLOAT(par.sigma));
+    t.Start();
+    eig.FindEigenvectors();
+    t.Stop();
+    nconv = eig.ConvergedEigenvalues();
+    stats = eig.GetStats();
+  }
+  out << "," << std::endl;
+  t.Print(out, "FindEigenvectors");
+  out << "," << std::endl;
+  out << "      \"eigen\": {\"nev\": " << par.nev << ", \"nconv\": " << nconv;
+  out << ", \"nopx\": " << stats.nopx << ", \"restarts\": " << stats.nrestart;
+  out << ", \"tuser\": " << stats.tuser << ", \"taupp\": " << stats.taupp;
+  out << ", \"teupp\": " << stats.teupp << "}" << std::endl << "    }";
+
+} // BenchMatrix.
+
+
+template<class ARFLOAT, class ARBUILDER>
+int BenchMain(int argc, char* argv[], const char* backend, ARBUILDER build,
+              int np = 10000)
+{
+
+  // Reads the command line, defines all problems, calls "build" to
+  // time each one of them and prints the JSON document. np is the
+  // default dimension of the generated matrix.
+
+  BenchParams   par(np);
+  std::ofstream file;
+  std::ostream* out;
+  unsigned      p;
+
+  if (!par.Read(argc, argv)) {
+    par.PrintHelp(argv[0]);
+    return 1;
+  }
+  out = &std::cout;
+  if (!par.output.empty()) {
+    file.open(par.output.c_str());
+    if (!file) {
+      std::cerr << argv[0] << ": cannot open " << par.output << std::endl;
+      return 1;
+    }
+    out = &file;
+  }
+  out->precision(6);
+
+  *out << "{" << std::endl;
+  *out << "  \"backend\": \"" << backend << "\"," << std::endl;
+  *out << "  \"sigma\": " << par.sigma << "," << std::endl;
+  *out << "  \"problems\": [" << std::endl;
+
+  // Generated matrix.
+
+  {
+    BenchProblem<ARFLOAT> prob;
+    prob.Banded(par);
+    build(*out, prob, par);
+  }
+
+  // Harwell-Boeing files.
+
+  for (p=0; p<par.files.size(); p++) {
+    BenchProblem<ARFLOAT> prob;
+    if (prob.Read(par.files[p])) {
+      *out << "," << std::endl;
+      build(*out, prob, par);
+    }
+    else {
+      std::cerr << argv[0] << ": cannot read " << par.files[p] << std::endl;
+    }
+  }
+
+  *out << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return 0;
+
+} // BenchMain.
+
+
+#endif // BENCHMK_H
+
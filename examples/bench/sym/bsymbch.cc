@@ -0,0 +1,77 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE BSymBch.cc.
+   Benchmark program that measures the time spent by the main
+   functions of the ARbdSymMatrix class.
+
+   1) Problem description:
+
+      MultMv, FactorA, FactorAsI and MultInvv are timed for a
+      positive definite banded matrix A, generated with the dimension
+      (10000 by default), number of subdiagonals and band density
+      given in the command line, and for each symmetric or unsymmetric
+      matrix read from a Harwell-Boeing file (the symmetric part of
+      unsymmetric matrices is used). Also timed is a full run of
+      FindEigenvectors of an ARSymStdEig object in shift and invert
+      mode. Results are printed in JSON format.
+
+   2) Data structure used to represent matrix A:
+
+      {nsdiag, Ab}: lower triangular part of matrix A stored in
+                    band format (nsdiag+1 rows, one column of Ab
+                    for each column of A).
+
+   3) Library called by this example:
+
+      The LAPACK band routines are called by ARbdSymMatrix to
+      factor A and A-sigma*I.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      arbsmat.h        The ARbdSymMatrix class definition.
+      benchmk.h        The BenchMatrix and BenchMain functions.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arbsmat.h"
+#include "benchmk.h"
+
+
+void Build(std::ostream& out, BenchProblem<double>& prob,
+           const BenchParams& par)
+/*
+  Stores prob in an ARbdSymMatrix object and times it.
+*/
+{
+
+  double* Ab;
+
+  prob.Band(Ab);
+  ARbdSymMatrix<double> A(prob.n, prob.nsdiag, Ab);
+
+  BenchMatrix(out, A, prob, par);
+  delete[] Ab;
+
+} // Build.
+
+
+int main(int argc, char* argv[])
+{
+
+  return BenchMain<double>(argc, argv, "ARbdSymMatrix", Build);
+
+} // main.
+
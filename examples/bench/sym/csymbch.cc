@@ -0,0 +1,90 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE CSymBch.cc.
+   Benchmark program that measures the time spent by the main
+   functions of the ARchSymMatrix class.
+
+   1) Problem description:
+
+      MultMv, FactorA, FactorAsI and MultInvv are timed for a
+      positive definite banded matrix A, generated with the dimension
+      (10000 by default), number of subdiagonals and band density
+      given in the command line, and for each symmetric or unsymmetric
+      matrix read from a Harwell-Boeing file (the symmetric part of
+      unsymmetric matrices is used). Also timed is a full run of
+      FindEigenvectors of an ARSymStdEig object in shift and invert
+      mode. Results are printed in JSON format. The number of blocks
+      (and bytes) allocated by CHOLMOD is also reported for the first
+      call to MultInvv, that creates the workspaces kept by
+      cholmod_solve2, and for all the following calls, that should
+      not allocate any memory ("steady_blocks" and "steady_bytes"
+      must be zero).
+
+   2) Data structure used to represent matrix A:
+
+      {nnz, irow, pcol, a}: lower triangular part of matrix A
+                            stored in CSC format.
+
+   3) Library called by this example:
+
+      The CHOLMOD package is called by ARchSymMatrix to factor
+      A and A-sigma*I.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      arcsmat.h        The ARchSymMatrix class definition.
+      benchmk.h        The BenchMatrix and BenchMain functions.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arcsmat.h"
+#include "benchmk.h"
+
+
+bool BenchMemory(ARchSymMatrix<double>& A, long& nblocks, long& nbytes)
+/*
+  Provides the number of blocks and bytes allocated by CHOLMOD for A.
+*/
+{
+
+  nblocks = A.MallocCount();
+  nbytes  = A.MemoryInUse();
+  return true;
+
+} // BenchMemory.
+
+
+void Build(std::ostream& out, BenchProblem<double>& prob,
+           const BenchParams& par)
+/*
+  Stores prob in an ARchSymMatrix object and times it.
+*/
+{
+
+  ARchSymMatrix<double> A(prob.n, prob.nnz, prob.a, prob.irow, prob.pcol);
+
+  BenchMatrix(out, A, prob, par);
+
+} // Build.
+
+
+int main(int argc, char* argv[])
+{
+
+  return BenchMain<double>(argc, argv, "ARchSymMatrix", Build);
+
+} // main.
+
@@ -0,0 +1,182 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE MSymBch.cc.
+   Benchmark program that measures the throughput (problems solved
+   per second) of the ARBatchSymStdEig class.
+
+   1) Problem description:
+
+      A set of independent positive definite banded matrices, with
+      dimensions chosen at random in an interval given in the command
+      line, is generated. The nev eigenvalues of largest magnitude
+      (and the corresponding eigenvectors) of all matrices are found
+      by an ARBatchSymStdEig object, first with one thread and then
+      with the number of threads given in the command line. Results
+      are printed in JSON format.
+
+   2) Data structure used to represent each matrix:
+
+      {nsdiag, Ab}: lower triangular part of the matrix stored in
+                    band format (see ARbdSymMatrix).
+
+   3) Library called by this example:
+
+      BLAS (sbmv) and LAPACK are called by ARbdSymMatrix and by
+      the block Krylov-Schur engine. ARPACK is not called.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      arbsmat.h        The ARbdSymMatrix class definition.
+      arbatch.h        The ARBatchSymStdEig class definition.
+      benchmk.h        The BenchProblem class definition.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arbsmat.h"
+#include "arbatch.h"
+#include "benchmk.h"
+
+
+void PrintHelp(const char* name)
+{
+
+  std::cout << name << ": ARPACK++ batched solver benchmark" << std::endl;
+  std::cout << "usage:   " << name << " [parameters]" << std::endl;
+  std::cout << "parameters:" << std::endl;
+  std::cout << "      -p <number of problems>" << std::endl;
+  std::cout << "      -m <minimum dimension>" << std::endl;
+  std::cout << "      -n <maximum dimension>" << std::endl;
+  std::cout << "      -b <number of subdiagonals>" << std::endl;
+  std::cout << "      -d <fraction of nonzero elements inside the band>";
+  std::cout << std::endl;
+  std::cout << "      -e <number of eigenvalues>" << std::endl;
+  std::cout << "      -j <number of threads (0 = all)>" << std::endl;
+  std::cout << "      -o <output file>" << std::endl;
+
+} // PrintHelp.
+
+
+void Run(std::ostream& out, ARBatchSymStdEig<double, ARbdSymMatrix<double> >&
+         batch, int nthreads, bool comma)
+/*
+  Solves all problems with nthreads threads and prints the results.
+*/
+{
+
+  int k, nok, niter;
+
+  batch.SetThreads(nthreads);
+  nok   = batch.Solve();
+  niter = 0;
+  for (k=0; k<batch.Problems(); k++) niter += batch.GetIter(k);
+
+  out << "    {\"threads\": " << nthreads << ", \"solved\": " << nok;
+  out << ", \"iterations\": " << niter << ", \"time\": " << batch.GetTime();
+  out << ", \"problems_per_second\": " << batch.Throughput() << "}";
+  out << (comma ? "," : "") << std::endl;
+
+} // Run.
+
+
+int main(int argc, char* argv[])
+{
+
+  BenchParams   par(2000);
+  std::ofstream file;
+  std::ostream* out;
+  unsigned long seed;
+  int           i, k, np, nmin, nthreads;
+  double*       Ab;
+
+  // Reading the command line.
+
+  np       = 1000;
+  nmin     = 500;
+  nthreads = 0;
+  for (i=1; i<argc; i+=2) {
+    if ((strlen(argv[i]) != 2) || (argv[i][0] != '-') || (i+1 == argc)) {
+      PrintHelp(argv[0]);
+      return 1;
+    }
+    switch (argv[i][1]) {
+    case 'p': np         = atoi(argv[i+1]); break;
+    case 'm': nmin       = atoi(argv[i+1]); break;
+    case 'n': par.n      = atoi(argv[i+1]); break;
+    case 'b': par.nsdiag = atoi(argv[i+1]); break;
+    case 'd': par.density = atof(argv[i+1]); break;
+    case 'e': par.nev    = atoi(argv[i+1]); break;
+    case 'j': nthreads   = atoi(argv[i+1]); break;
+    case 'o': par.output = argv[i+1]; break;
+    default:
+      PrintHelp(argv[0]);
+      return 1;
+    }
+  }
+  if ((np < 1) || (nmin < par.nev+2) || (par.n < nmin) || (par.nev < 1)) {
+    PrintHelp(argv[0]);
+    return 1;
+  }
+  out = &std::cout;
+  if (!par.output.empty()) {
+    file.open(par.output.c_str());
+    if (!file) {
+      std::cerr << argv[0] << ": cannot open " << par.output << std::endl;
+      return 1;
+    }
+    out = &file;
+  }
+  out->precision(6);
+
+  // Generating the matrices.
+
+  std::vector<ARbdSymMatrix<double>*> A(np);
+  std::vector<double*>                band(np);
+  ARBatchSymStdEig<double, ARbdSymMatrix<double> >
+    batch(par.nev, &ARbdSymMatrix<double>::MultMv);
+
+  BenchParams gen(par);
+  seed = 7;
+  for (k=0; k<np; k++) {
+    BenchProblem<double> prob;
+    gen.n      = nmin+int(0.5*(BenchRandom(seed)+1.0)*(par.n-nmin+1));
+    if (gen.n > par.n) gen.n = par.n;
+    gen.nsdiag = (par.nsdiag < gen.n) ? par.nsdiag : gen.n-1;
+    prob.Banded(gen);
+    prob.Band(Ab);
+    band[k] = Ab;
+    A[k]    = new ARbdSymMatrix<double>(prob.n, prob.nsdiag, Ab);
+    batch.AddProblem(prob.n, A[k]);
+  }
+
+  // Solving the problems.
+
+  *out << "{" << std::endl;
+  *out << "  \"backend\": \"ARBatchSymStdEig\"," << std::endl;
+  *out << "  \"problems\": " << np << ", \"nmin\": " << nmin;
+  *out << ", \"nmax\": " << par.n << ", \"nev\": " << par.nev;
+  *out << "," << std::endl << "  \"runs\": [" << std::endl;
+  Run(*out, batch, 1, true);
+  Run(*out, batch, nthreads, false);
+  *out << "  ]" << std::endl << "}" << std::endl;
+
+  for (k=0; k<np; k++) {
+    delete A[k];
+    delete[] band[k];
+  }
+  return 0;
+
+} // main.
+
@@ -0,0 +1,72 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE USymBch.cc.
+   Benchmark program that measures the time spent by the main
+   functions of the ARumSymMatrix class.
+
+   1) Problem description:
+
+      MultMv, FactorA, FactorAsI and MultInvv are timed for a
+      positive definite banded matrix A, generated with the dimension
+      (10000 by default), number of subdiagonals and band density
+      given in the command line, and for each symmetric or unsymmetric
+      matrix read from a Harwell-Boeing file (the symmetric part of
+      unsymmetric matrices is used). Also timed is a full run of
+      FindEigenvectors of an ARSymStdEig object in shift and invert
+      mode. Results are printed in JSON format.
+
+   2) Data structure used to represent matrix A:
+
+      {nnz, irow, pcol, a}: lower triangular part of matrix A
+                            stored in CSC format.
+
+   3) Library called by this example:
+
+      The UMFPACK package is called by ARumSymMatrix to factor
+      A and A-sigma*I.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      arusmat.h        The ARumSymMatrix class definition.
+      benchmk.h        The BenchMatrix and BenchMain functions.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arusmat.h"
+#include "benchmk.h"
+
+
+void Build(std::ostream& out, BenchProblem<double>& prob,
+           const BenchParams& par)
+/*
+  Stores prob in an ARumSymMatrix object and times it.
+*/
+{
+
+  ARumSymMatrix<double> A(prob.n, prob.nnz, prob.a, prob.irow, prob.pcol);
+
+  BenchMatrix(out, A, prob, par);
+
+} // Build.
+
+
+int main(int argc, char* argv[])
+{
+
+  return BenchMain<double>(argc, argv, "ARumSymMatrix", Build);
+
+} // main.
+
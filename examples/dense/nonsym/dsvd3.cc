@@ -0,0 +1,139 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE DSVD3.cc.
+   Example program that illustrates how to determine the largest
+   and the smallest singular values of a matrix, as well as the
+   corresponding singular vectors, using the ARSVD class.
+
+   1) Problem description:
+
+      In this example, Arpack++ is called to find some singular
+      triplets (sigma, u, v) of a real m by n matrix A, i.e.
+
+                    A*v = sigma*u  and  A'*u = sigma*v.
+
+      A Golub-Kahan-Lanczos bidiagonalization of A is used, so
+      neither A'*A nor [0 A; A' 0] is formed, and both u and v are
+      obtained directly (this also works when m < n).
+
+   2) Data structure used to represent the matrix:
+
+      A is stored columnwise in a vector called A.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      dnmatrxw.h       MatrixW, a function that generates matrix A.
+      ardnsmat.h       The ARdsNonSymMatrix class definition.
+      arsvd.h          The ARSVD class definition.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arsvd.h"
+#include "dnmatrxw.h"
+#include "ardnsmat.h"
+#include <iostream>
+#include <cmath>
+
+
+template<class MATRIX>
+void Solution(MATRIX& A, ARSVD<double, MATRIX>& svd)
+{
+
+  int     i, j, m, n, nconv;
+  double  sigma, r1, r2;
+  double  *u, *v, *Av, *Atu;
+
+  m     = svd.GetM();
+  n     = svd.GetN();
+  nconv = svd.ConvergedSingularValues();
+
+  std::cout << std::endl << "Testing ARPACK++ class ARSVD" << std::endl;
+  std::cout << "Singular triplets: A*v = sigma*u, A'*u = sigma*v";
+  std::cout << std::endl << std::endl;
+  std::cout << "Dimension of the matrix            : " << m << " x " << n;
+  std::cout << std::endl;
+  std::cout << "Number of 'requested' values       : " << svd.GetNsv();
+  std::cout << std::endl;
+  std::cout << "Number of 'converged' values       : " << nconv;
+  std::cout << std::endl;
+  std::cout << "Number of products with A and A'   : ";
+  std::cout << svd.GetStats().nopx << std::endl;
+  std::cout << std::endl;
+
+  Av  = new double[m];
+  Atu = new double[n];
+
+  for (i=0; i<nconv; i++) {
+    sigma = svd.SingularValue(i);
+    u     = svd.RawLeftSingularVector(i);
+    v     = svd.RawRightSingularVector(i);
+    A.MultMv(v, Av);
+    A.MultMtv(u, Atu);
+    r1 = r2 = 0.0;
+    for (j=0; j<m; j++) r1 += (Av[j]-sigma*u[j])*(Av[j]-sigma*u[j]);
+    for (j=0; j<n; j++) r2 += (Atu[j]-sigma*v[j])*(Atu[j]-sigma*v[j]);
+    std::cout << "  sigma[" << i+1 << "]: " << sigma;
+    std::cout << "   ||A*v-sigma*u||: " << std::sqrt(r1);
+    std::cout << "   ||A'*u-sigma*v||: " << std::sqrt(r2) << std::endl;
+  }
+  std::cout << std::endl;
+
+  delete[] Av;
+  delete[] Atu;
+
+} // Solution.
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     m;          // Number of rows in A.
+  int     n;          // Number of columns in A.
+  double* valA;       // Pointer to an array that stores the elements of A.
+
+  // Creating a matrix.
+
+  m  = 500;
+  n  = 100;
+  MatrixW(m, n, valA);
+
+  // Using ARdsNonSymMatrix to store matrix information and to
+  // perform the products A*v and A'*u.
+
+  ARdsNonSymMatrix<double, double> A(m, n, valA);
+
+  // Defining what we need: the four largest singular values.
+
+  ARSVD<double, ARdsNonSymMatrix<double, double> > dsvd(4, A);
+
+  // Finding singular values and vectors.
+
+  dsvd.FindSingularVectors();
+  Solution(A, dsvd);
+
+  // Now the four smallest singular values.
+
+  dsvd.ChangeWhich("SM");
+  dsvd.ChangeNcv(30);
+  dsvd.ResetStats();
+  dsvd.FindSingularVectors();
+  Solution(A, dsvd);
+
+  delete[] valA;
+
+} // main.
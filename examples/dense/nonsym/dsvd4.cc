@@ -0,0 +1,110 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE DSVD4.cc.
+   Example program that illustrates how to obtain approximate
+   singular values of an out-of-core dense matrix with a few passes
+   over the matrix, using the ARRandSVD class, and how to use them
+   to start the Lanczos method.
+
+   1) Problem description:
+
+      In this example, ARRandSVD is used to find approximations to the
+      four largest singular triplets of a 1000 by 50 matrix A. Each
+      product with A (or A') involves 4+10 vectors (10 is the
+      oversampling), so the file that contains A is read only four
+      times (one power iteration is performed).
+      The approximate right singular vectors are then passed to
+      ARSymStdEig, that solves
+
+                             (A'*A)*v = sigma*v
+
+      to full accuracy.
+
+   2) Data structure used to represent the matrix:
+
+      A is stored row-wise in a file (matrix.dat, that must be
+      uncompressed before running the program) and is loaded by
+      blocks of 250 rows (see dsvd2.cc).
+
+   3) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      ardnsmat.h       The ARdsNonSymMatrix class definition.
+      arrand.h         The ARRandSVD class definition.
+      arssym.h         The ARSymStdEig class definition.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arrand.h"
+#include "arssym.h"
+#include "ardnsmat.h"
+#include <iostream>
+#include <cmath>
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     i;
+  double  svalue[4];
+
+  // Using ARdsNonSymMatrix to store matrix data and to
+  // perform the products A*X, A'*X and A'*A*x.
+
+  ARdsNonSymMatrix<double, double> A("matrix.dat", 250);
+
+  // Defining what we need: the four largest singular values
+  // (10 extra vectors and one power iteration).
+
+  ARRandSVD<double, ARdsNonSymMatrix<double, double> > rsvd(4, A, 10, 1);
+
+  // Finding the approximate singular triplets.
+
+  rsvd.FindSingularVectors();
+
+  std::cout << std::endl << "Testing ARPACK++ class ARRandSVD" << std::endl;
+  std::cout << "Number of passes over A: " << rsvd.GetStats().nsteps;
+  std::cout << std::endl << "approximate singular values: " << std::endl;
+  for (i=0; i<4; i++) {
+    std::cout << "  sigma [" << i+1 << "]: " << rsvd.SingularValue(3-i);
+    std::cout << std::endl;
+  }
+
+  // Using the right singular vectors to start ARSymStdEig.
+
+  ARSymStdEig<double, ARdsNonSymMatrix<double, double> >
+    dprob(A.ncols(), 4L, &A, &ARdsNonSymMatrix<double, double>::MultMtMv);
+
+  dprob.SetSubspace(4, rsvd.RawRightSingularVectors());
+
+  // Finding eigenvalues and calculating singular values.
+
+  dprob.FindEigenvalues();
+  for (i=0; i<4; i++) {
+    svalue[i] = std::sqrt(dprob.Eigenvalue(3-i));
+  }
+
+  std::cout << std::endl << "Testing ARPACK++ class ARSymStdEig" << std::endl;
+  std::cout << "Obtaining singular values by solving (A'*A)*v = sigma*v";
+  std::cout << std::endl << "Number of products A'*A*x: ";
+  std::cout << dprob.GetStats().nopx << std::endl;
+  std::cout << "greatest singular values: " << std::endl;
+  for (i=0; i<4; i++) {
+    std::cout << "  sigma [" << i+1 << "]: " << svalue[i] << std::endl;
+  }
+
+} // main.
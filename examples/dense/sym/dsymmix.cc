@@ -0,0 +1,211 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE DSymMix.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem in single precision and to refine the
+   solution in double precision using the ARSymRefine and
+   ARMixedMatrix classes. The residuals of the refined eigenpairs are
+   checked against the tolerance required by ARSymRefine.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda, where A is
+      derived from the standard central difference discretization of
+      the 2-dimensional Laplacian on the unit square with zero
+      Dirichlet boundary conditions.
+
+      Two problems are solved by ARluSymStdEig<float> (with the
+      Krylov-Schur engine, so the FORTRAN ARPACK routines are not
+      called):
+
+      - the four largest eigenvalues, in regular mode. The
+        eigenvectors are refined by ARSymRefine without an operator
+        (the residuals are added to the subspace as they are);
+
+      - the four eigenvalues nearest to 1000.0, in shift and invert
+        mode. The eigenvectors are refined by ARSymRefine using
+        inv(A-sigma*I) as operator. The systems are solved by
+        ARMixedMatrix by iterative refinement, reusing the single
+        precision factors of A-sigma*I.
+
+      In both cases, ||A*x - lambda*x|| is computed again in double
+      precision and compared with tol*||A||, where tol is the default
+      tolerance of ARSymRefine (100 units of roundoff) and ||A|| is
+      the largest eigenvalue of A.
+
+   2) Data structure used to represent matrix A:
+
+      Only the lower triangular part of A is stored (by columns) in
+      vector A. A copy of A is stored in single precision.
+
+   3) Library called by this example:
+
+      The LAPACK package is called by ARluSymStdEig to factor
+      A-sigma*I and by ARSymRefine.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      dsmatrxa.h       DenseMatrixA, a function that generates matrix
+                       A in dense format.
+      ardsmat.h        The ARdsSymMatrix class definition.
+      ardssym.h        The ARluSymStdEig class definition.
+      armixed.h        The ARSymRefine and ARMixedMatrix classes.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include "dsmatrxa.h"
+#include "ardsmat.h"
+#include "ardssym.h"
+#include "armixed.h"
+
+
+typedef ARMixedMatrix<double, ARdsSymMatrix<double>,
+                      float, ARdsSymMatrix<float> > MixedMatrix;
+
+typedef ARSymRefine<double, ARdsSymMatrix<double>, MixedMatrix> Refinement;
+
+
+double MaxResidual(ARdsSymMatrix<double>& A, Refinement& refine)
+{
+
+  // Computing max ||A*x - lambda*x|| over the refined eigenpairs.
+
+  int     i, j, n;
+  double  r, rmax;
+  double* x;
+  double* w;
+
+  n    = A.nrows();
+  w    = new double[n];
+  rmax = 0.0;
+  for (i=0; i<refine.GetNev(); i++) {
+    x = refine.RawEigenvector(i);
+    A.MultMv(x, w);
+    r = 0.0;
+    for (j=0; j<n; j++) {
+      r += (w[j]-refine.Eigenvalue(i)*x[j])*(w[j]-refine.Eigenvalue(i)*x[j]);
+    }
+    if (std::sqrt(r) > rmax) rmax = std::sqrt(r);
+  }
+  delete[] w;
+  return rmax;
+
+} // MaxResidual.
+
+
+bool Report(const char* title, ARluSymStdEig<float>& fprob,
+            Refinement& refine, double rmax, double bound)
+{
+
+  // Printing the refined eigenvalues and the result of the check.
+
+  int i;
+
+  std::cout << std::endl << title << std::endl;
+  std::cout << "Converged eigenvalues (float):      ";
+  std::cout << fprob.ConvergedEigenvalues() << std::endl;
+  std::cout << "Refined eigenvalues (double):       ";
+  std::cout << refine.ConvergedEigenvalues() << std::endl;
+  std::cout << "Rayleigh-Ritz steps:                ";
+  std::cout << refine.GetIter() << std::endl;
+  std::cout.precision(15);
+  for (i=0; i<refine.GetNev(); i++) {
+    std::cout << "lambda[" << (i+1) << "]: " << refine.Eigenvalue(i);
+    std::cout << "  (float: " << fprob.Eigenvalue(i) << ")" << std::endl;
+  }
+  std::cout.precision(6);
+  std::cout << "max ||A*x - lambda*x||: " << rmax;
+  std::cout << "  (tol*||A||: " << bound << ")  ";
+  std::cout << ((rmax <= bound) ? "passed" : "FAILED") << std::endl;
+  return (rmax <= bound);
+
+} // Report.
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     i, nx;
+  int     n;       // Dimension of the problem.
+  double  anorm;   // ||A||.
+  double  bound;   // Required residual norm.
+  double* A;       // Pointer to an array that stores the elements of A.
+  float*  Af;      // The same elements in single precision.
+  bool    ok;
+
+  // Creating a 400x400 matrix (in double and in single precision).
+
+  nx  = 20;
+  DenseMatrixA(nx, n, A);
+  DenseMatrixA(nx, n, Af);
+  ARdsSymMatrix<double> matrix(n, A);
+  ARdsSymMatrix<float>  fmatrix(n, Af);
+
+  std::cout << std::endl << "Testing ARPACK++ classes ARSymRefine and ";
+  std::cout << "ARMixedMatrix" << std::endl;
+  std::cout << "Real symmetric eigenvalue problem: A*x - lambda*x";
+  std::cout << std::endl;
+
+  // The four largest eigenvalues, computed in single precision (with
+  // 20 Lanczos vectors, since the largest eigenvalues of A are close)
+  // and refined without an operator.
+
+  ARluSymStdEig<float> fprob1(4L, fmatrix, "LA", 20);
+  fprob1.SetKrylovSchur();
+  fprob1.FindEigenvectors();
+
+  Refinement refine1(n, &matrix, &ARdsSymMatrix<double>::MultMv);
+  refine1.Refine(fprob1, 50);
+
+  anorm = refine1.Eigenvalue(0);
+  for (i=1; i<refine1.GetNev(); i++) {
+    if (refine1.Eigenvalue(i) > anorm) anorm = refine1.Eigenvalue(i);
+  }
+  bound = 100.0*std::numeric_limits<double>::epsilon()*anorm;
+  ok    = Report("Largest eigenvalues (regular mode, no operator):",
+                 fprob1, refine1, MaxResidual(matrix, refine1), bound);
+
+  // The four eigenvalues nearest to 1000.0, computed in shift and
+  // invert mode in single precision and refined with inv(A-sigma*I).
+  // The single precision factors of A-sigma*I computed by fprob2 are
+  // reused by MultInvv.
+
+  ARluSymStdEig<float> fprob2(4L, fmatrix, 1000.0f);
+  fprob2.SetKrylovSchur();
+  fprob2.FindEigenvectors();
+
+  MixedMatrix mixed(&matrix, &fmatrix);
+  mixed.DefineShift(1000.0);
+
+  Refinement refine2(n, &matrix, &ARdsSymMatrix<double>::MultMv);
+  refine2.SetOperator(&mixed, &MixedMatrix::MultInvv);
+  refine2.Refine(fprob2, 50);
+
+  ok = Report("Eigenvalues nearest to 1000.0 (shift and invert mode):",
+              fprob2, refine2, MaxResidual(matrix, refine2), bound) && ok;
+  std::cout << std::endl;
+
+  delete[] A;
+  delete[] Af;
+
+  return ok ? 0 : 1;
+
+} // main
@@ -36,6 +36,12 @@ class MatrixWithProduct {
   virtual void MultMv(ART* v, ART* w) = 0;
   // Matrix-vector product: w = M*v.
 
+  virtual void MultMV(ART* X, ART* Y, int nvec)
+  // Matrix-block product: Y = M*X (X and Y stored by columns).
+  {
+    for (int j=0; j<nvec; j++) MultMv(&X[j*n], &Y[j*m]);
+  } // MultMV.
+
   MatrixWithProduct(int nrows, int ncols = 0)
   // Constructor.
   {
@@ -0,0 +1,84 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE LSymMulV.h
+   Template function that checks the block solve MultInvV of the
+   symmetric matrix classes against nrhs calls to MultInvv.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef LSYMMULV_H
+#define LSYMMULV_H
+
+#include <cmath>
+#include <limits>
+#include <iostream>
+
+
+template<class ARMATRIX, class ARFLOAT>
+bool CheckMultInvV(ARMATRIX &A, int nrhs, ARFLOAT type)
+/*
+  Solves (A-sigma*I)*Y = X for nrhs columns of X with one call to
+  MultInvV and with one call to MultInvv per column, and prints the
+  largest difference between both solutions (relative to the largest
+  element of Y). A must have been factored by FactorA or FactorAsI.
+  Returns true if the difference is below 100 units of roundoff.
+*/
+
+{
+
+  int     i, j, n;
+  ARFLOAT diff, ymax, tol;
+  ARFLOAT *X, *Y, *Z;
+
+  n = A.ncols();
+  X = new ARFLOAT[n*nrhs];
+  Y = new ARFLOAT[n*nrhs];
+  Z = new ARFLOAT[n*nrhs];
+
+  // Defining X (column j of X is column j of the Hilbert matrix).
+
+  for (j=0; j<nrhs; j++) {
+    for (i=0; i<n; i++) X[i+j*n] = ARFLOAT(1)/ARFLOAT(i+j+1);
+  }
+
+  // Solving all columns at once and one column at a time.
+
+  A.MultInvV(X, Y, nrhs);
+  for (j=0; j<nrhs; j++) A.MultInvv(&X[j*n], &Z[j*n]);
+
+  // Comparing the solutions.
+
+  diff = ARFLOAT(0);
+  ymax = ARFLOAT(0);
+  for (i=0; i<n*nrhs; i++) {
+    if (std::fabs(Y[i]-Z[i]) > diff) diff = std::fabs(Y[i]-Z[i]);
+    if (std::fabs(Z[i]) > ymax) ymax = std::fabs(Z[i]);
+  }
+  if (ymax > ARFLOAT(0)) diff /= ymax;
+  tol = ARFLOAT(100)*std::numeric_limits<ARFLOAT>::epsilon();
+
+  std::cout << std::endl << "Checking MultInvV with " << nrhs;
+  std::cout << " right-hand sides against MultInvv" << std::endl;
+  std::cout << "max |Y(MultInvV)-Y(MultInvv)|/max |Y|: " << diff;
+  std::cout << ((diff <= tol) ? "  passed" : "  FAILED") << std::endl;
+
+  delete[] X;
+  delete[] Y;
+  delete[] Z;
+
+  return (diff <= tol);
+
+} // CheckMultInvV.
+
+
+#endif // LSYMMULV_H
+
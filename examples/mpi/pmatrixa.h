@@ -0,0 +1,96 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE PMatrixA.h
+   Function template that generates the rows of the matrix
+
+                          | T -I          |
+                          |-I  T -I       |
+                      A = |   -I  T       |
+                          |        ...  -I|
+                          |           -I T|
+
+   derived from the standard central difference discretization of the
+   2-dimensional convection-diffusion operator (Laplacian u) + rho*(du/dx)
+   on a unit square with zero Dirichlet boundary conditions, that are
+   stored by one process of an MPI communicator. The n = nx*nx rows of
+   A are divided into blocks of consecutive rows (one per process) of
+   almost the same size. A is symmetric when rho = 0.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef PMATRIXA_H
+#define PMATRIXA_H
+
+#include <mpi.h>
+
+template<class ARFLOAT>
+void ConvDiffMatrix(MPI_Comm comm, int nx, ARFLOAT rho, int& nloc,
+                    int& nnz, ARFLOAT* &A, int* &jcol, int* &prow)
+
+{
+
+  // Defining internal variables.
+
+  int      i, j, n, first, rank, nprocs;
+  ARFLOAT  h, h2, df;
+  ARFLOAT  dd, dl, du;
+
+  // Defining constants.
+
+  h   = 1.0/ARFLOAT(nx+1);
+  h2  = h*h;
+  dd  = 4.0/h2;
+  df  = -1.0/h2;
+  dl  = df - 5.0e-1*rho/h;
+  du  = df + 5.0e-1*rho/h;
+
+  // Finding the rows stored by this process.
+
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nprocs);
+  n     = nx*nx;
+  nloc  = n/nprocs + ((rank < n%nprocs) ? 1 : 0);
+  first = rank*(n/nprocs) + ((rank < n%nprocs) ? rank : n%nprocs);
+
+  // Creating output vectors.
+
+  A    = new ARFLOAT[5*nloc];
+  jcol = new int[5*nloc];
+  prow = new int[nloc+1];
+
+  // Creating the local rows (with global column indices).
+
+  prow[0] = 0;
+  i       = 0;
+
+  for (j = first; j < first+nloc; j++) {
+    if (j >= nx) {
+      A[i] = df;   jcol[i++] = j-nx;
+    }
+    if ((j%nx) != 0) {
+      A[i] = dl;   jcol[i++] = j-1;
+    }
+    A[i] = dd;     jcol[i++] = j;
+    if (((j+1)%nx) != 0) {
+      A[i] = du;   jcol[i++] = j+1;
+    }
+    if (j < n-nx) {
+      A[i] = df;   jcol[i++] = j+nx;
+    }
+    prow[j-first+1] = i;
+  }
+  nnz = i;
+
+} // ConvDiffMatrix.
+
+#endif // PMATRIXA_H
@@ -0,0 +1,183 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE PSol.h
+   Template functions that exemplify how to print information
+   about distributed eigenvalue problems (only process 0 prints).
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef PSOL_H
+#define PSOL_H
+
+#include <cmath>
+#include <iostream>
+#include <mpi.h>
+#include "blas1c.h"
+#include "arrpssym.h"
+#include "arrpsnsym.h"
+
+
+template<class ARMATRIX, class ARFLOAT>
+ARFLOAT ParResidual(ARMATRIX &A, MPI_Comm comm, int n, ARFLOAT lambda,
+                    ARFLOAT* x)
+/*
+  Returns ||A*x - lambda*x|| / |lambda|. Must be called by all
+  processes, since x is distributed.
+*/
+
+{
+
+  double  local, global;
+  ARFLOAT *Ax;
+
+  Ax = new ARFLOAT[n];
+  A.MultMv(x, Ax);
+  axpy(n, -lambda, x, 1, Ax, 1);
+  local = 0.0;
+  for (int i=0; i<n; i++) local += double(Ax[i])*double(Ax[i]);
+  MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_SUM, comm);
+  delete[] Ax;
+  return ARFLOAT(std::sqrt(global)/std::fabs(double(lambda)));
+
+} // ParResidual.
+
+
+template<class ARMATRIX, class ARFLOAT>
+void Solution(ARMATRIX &A, ARrcParSymStdEig<ARFLOAT> &Prob)
+/*
+  Prints eigenvalues and residual norms of distributed symmetric
+  eigen-problems on standard "std::cout" stream.
+*/
+
+{
+
+  int     i, nconv, rank;
+  ARFLOAT ResNorm;
+
+  MPI_Comm_rank(Prob.GetCommunicator(), &rank);
+  nconv = Prob.ConvergedEigenvalues();
+
+  if (rank == 0) {
+    std::cout << std::endl << std::endl << "Testing ARPACK++ class ";
+    std::cout << "ARParSymStdEig" << std::endl;
+    std::cout << "Real symmetric eigenvalue problem: A*x - lambda*x";
+    std::cout << std::endl << std::endl;
+    std::cout << "Dimension of the system            : ";
+    std::cout << Prob.GetGlobalN() << std::endl;
+    std::cout << "Number of 'requested' eigenvalues  : ";
+    std::cout << Prob.GetNev() << std::endl;
+    std::cout << "Number of 'converged' eigenvalues  : " << nconv << std::endl;
+    std::cout << "Number of Arnoldi vectors generated: ";
+    std::cout << Prob.GetNcv() << std::endl;
+    std::cout << "Number of iterations taken         : ";
+    std::cout << Prob.GetIter() << std::endl << std::endl;
+  }
+
+  if (Prob.EigenvaluesFound() && (rank == 0)) {
+    std::cout << "Eigenvalues:" << std::endl;
+    for (i=0; i<nconv; i++) {
+      std::cout << "  lambda[" << (i+1) << "]: " << Prob.Eigenvalue(i);
+      std::cout << std::endl;
+    }
+    std::cout << std::endl;
+  }
+
+  if (Prob.EigenvectorsFound()) {
+
+    // Printing the residual norm || A*x - lambda*x ||
+    // for the nconv accurately computed eigenvectors.
+
+    for (i=0; i<nconv; i++) {
+      ResNorm = ParResidual(A, Prob.GetCommunicator(), Prob.GetN(),
+                            Prob.Eigenvalue(i), Prob.RawEigenvector(i));
+      if (rank == 0) {
+        std::cout << "||A*x(" << (i+1) << ") - lambda(" << (i+1);
+        std::cout << ")*x(" << (i+1) << ")||: " << ResNorm << std::endl;
+      }
+    }
+    if (rank == 0) std::cout << std::endl;
+
+  }
+
+} // Solution (symmetric).
+
+
+template<class ARMATRIX, class ARFLOAT>
+void Solution(ARMATRIX &A, ARrcParNonSymStdEig<ARFLOAT> &Prob)
+/*
+  Prints eigenvalues and residual norms of distributed nonsymmetric
+  eigen-problems on standard "std::cout" stream. Residual norms are
+  only computed for real eigenvalues.
+*/
+
+{
+
+  int     i, nconv, rank;
+  ARFLOAT ResNorm;
+
+  MPI_Comm_rank(Prob.GetCommunicator(), &rank);
+  nconv = Prob.ConvergedEigenvalues();
+
+  if (rank == 0) {
+    std::cout << std::endl << std::endl << "Testing ARPACK++ class ";
+    std::cout << "ARParNonSymStdEig" << std::endl;
+    std::cout << "Real nonsymmetric eigenvalue problem: A*x - lambda*x";
+    std::cout << std::endl << std::endl;
+    std::cout << "Dimension of the system            : ";
+    std::cout << Prob.GetGlobalN() << std::endl;
+    std::cout << "Number of 'requested' eigenvalues  : ";
+    std::cout << Prob.GetNev() << std::endl;
+    std::cout << "Number of 'converged' eigenvalues  : " << nconv << std::endl;
+    std::cout << "Number of Arnoldi vectors generated: ";
+    std::cout << Prob.GetNcv() << std::endl;
+    std::cout << "Number of iterations taken         : ";
+    std::cout << Prob.GetIter() << std::endl << std::endl;
+  }
+
+  if (Prob.EigenvaluesFound() && (rank == 0)) {
+    std::cout << "Eigenvalues:" << std::endl;
+    for (i=0; i<nconv; i++) {
+      std::cout << "  lambda[" << (i+1) << "]: " << Prob.EigenvalueReal(i);
+      if (Prob.EigenvalueImag(i)>=0.0) {
+        std::cout << " + " << Prob.EigenvalueImag(i) << " I" << std::endl;
+      }
+      else {
+        std::cout << " - " << std::fabs(Prob.EigenvalueImag(i));
+        std::cout << " I" << std::endl;
+      }
+    }
+    std::cout << std::endl;
+  }
+
+  if (Prob.EigenvectorsFound()) {
+
+    // Printing the residual norm || A*x - lambda*x ||
+    // for the real eigenvalues.
+
+    for (i=0; i<nconv; i++) {
+      if (Prob.EigenvalueImag(i) != 0.0) continue;
+      ResNorm = ParResidual(A, Prob.GetCommunicator(), Prob.GetN(),
+                            Prob.EigenvalueReal(i), Prob.RawEigenvector(i));
+      if (rank == 0) {
+        std::cout << "||A*x(" << (i+1) << ") - lambda(" << (i+1);
+        std::cout << ")*x(" << (i+1) << ")||: " << ResNorm << std::endl;
+      }
+    }
+    if (rank == 0) std::cout << std::endl;
+
+  }
+
+} // Solution (nonsymmetric).
+
+
+#endif // PSOL_H
@@ -0,0 +1,119 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE PSymRC.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem in regular mode on a distributed
+   memory computer using the ARrcParSymStdEig class (the reverse
+   communication interface to PARPACK).
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode,
+      where A is derived from the central difference discretization
+      of the 2-dimensional Laplacian on the unit square [0,1]x[0,1]
+      with zero Dirichlet boundary conditions.
+
+   2) Data structure used to represent matrix A:
+
+      ARrcParSymStdEig is a class that requires the user to provide
+      a way to perform the matrix-vector products required by the
+      Arnoldi method. GetVector and PutVector point to the rows of v
+      and w stored by this process, so the products w <- A*v are
+      performed here by all processes at the same time, using the
+      MultMv function of ARmpMatrix.
+
+   3) Library called by this example:
+
+      PARPACK (the MPI version of ARPACK). The program must be run
+      with mpirun, e.g. "mpirun -np 4 psymrc".
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      pmatrixa.h       ConvDiffMatrix, a function that generates the
+                       local rows of matrix A in CSR format.
+      armpmat.h        The ARmpMatrix class definition.
+      arrpssym.h       The ARrcParSymStdEig class definition.
+      psol.h           The Solution function.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <mpi.h>
+#include "pmatrixa.h"
+#include "armpmat.h"
+#include "arrpssym.h"
+#include "psol.h"
+
+
+int main(int argc, char* argv[])
+{
+
+  // Defining variables.
+
+  int     nloc;   // Number of rows stored by this process.
+  int     nnz;    // Number of nonzero elements in these rows.
+  int*    jcol;   // Column indices of the nonzero elements.
+  int*    prow;   // Pointers to the beginning of each row.
+  double* A;      // Nonzero elements.
+
+  MPI_Init(&argc, &argv);
+
+  // Creating the rows of a 900x900 matrix stored by this process.
+
+  ConvDiffMatrix(MPI_COMM_WORLD, 30, 0.0, nloc, nnz, A, jcol, prow);
+  ARmpMatrix<double> matrix(MPI_COMM_WORLD, nloc, nnz, A, jcol, prow);
+
+  {
+
+    // Creating a symmetric eigenvalue problem and defining what we
+    // need: the four eigenvectors of A with smallest magnitude.
+
+    ARrcParSymStdEig<double> prob(MPI_COMM_WORLD, nloc, 4, "SM");
+
+    // Finding an Arnoldi basis.
+
+    while (!prob.ArnoldiBasisFound()) {
+
+      // Calling PARPACK FORTRAN code.
+
+      prob.TakeStep();
+
+      if ((prob.GetIdo() == 1)||(prob.GetIdo() == -1)) {
+
+        // Performing the product w <- A*v on the local rows.
+
+        matrix.MultMv(prob.GetVector(), prob.PutVector());
+
+      }
+
+    }
+
+    // Finding eigenvalues and eigenvectors.
+
+    prob.FindEigenvectors();
+
+    // Printing solution.
+
+    Solution(matrix, prob);
+
+  }
+
+  delete[] A;
+  delete[] jcol;
+  delete[] prow;
+
+  MPI_Finalize();
+
+} // main.
@@ -0,0 +1,114 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE PSymReg.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem in regular mode on a distributed
+   memory computer, using the ARParSymStdEig and ARmpMatrix classes.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode,
+      where A is derived from the central difference discretization
+      of the 2-dimensional Laplacian on the unit square [0,1]x[0,1]
+      with zero Dirichlet boundary conditions.
+
+   2) Data structure used to represent matrix A:
+
+      {nnz, A, jcol, prow}: rows of A stored by each process, in CSR
+                            format with global column indices.
+
+      Each process stores a block of consecutive rows of A, and the
+      same rows of all vectors (the Arnoldi basis and the
+      eigenvectors). ARmpMatrix::MultMv exchanges the elements of v
+      needed by the neighbouring processes.
+
+   3) Library called by this example:
+
+      PARPACK (the MPI version of ARPACK). The program must be run
+      with mpirun, e.g. "mpirun -np 4 psymreg".
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      pmatrixa.h       ConvDiffMatrix, a function that generates the
+                       local rows of matrix A in CSR format.
+      armpmat.h        The ARmpMatrix class definition.
+      arpssym.h        The ARParSymStdEig class definition.
+      psol.h           The Solution function.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <mpi.h>
+#include "pmatrixa.h"
+#include "armpmat.h"
+#include "arpssym.h"
+#include "psol.h"
+
+
+template<class T>
+void Test(T type)
+{
+
+  // Defining variables.
+
+  int  nloc;   // Number of rows stored by this process.
+  int  nnz;    // Number of nonzero elements in these rows.
+  int* jcol;   // Column indices of the nonzero elements.
+  int* prow;   // Pointers to the beginning of each row.
+  T*   A;      // Nonzero elements.
+
+  // Creating the rows of a 900x900 matrix stored by this process.
+
+  ConvDiffMatrix(MPI_COMM_WORLD, 30, (T)0.0, nloc, nnz, A, jcol, prow);
+  ARmpMatrix<T> matrix(MPI_COMM_WORLD, nloc, nnz, A, jcol, prow);
+
+  // Defining what we need: the four eigenvectors of A with smallest
+  // magnitude. matrix.MultMv performs the product w <- A.v on the
+  // rows stored by this process.
+
+  ARParSymStdEig<T, ARmpMatrix<T> >
+    dprob(MPI_COMM_WORLD, nloc, 4, &matrix, &ARmpMatrix<T>::MultMv, "SM");
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  Solution(matrix, dprob);
+
+  delete[] A;
+  delete[] jcol;
+  delete[] prow;
+
+} // Test.
+
+
+int main(int argc, char* argv[])
+{
+
+  MPI_Init(&argc, &argv);
+
+  // Solving a double precision problem with n = 900.
+
+  Test((double)0.0);
+
+  // Solving a single precision problem with n = 900.
+
+  Test((float)0.0);
+
+  MPI_Finalize();
+
+} // main.
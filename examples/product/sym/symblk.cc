@@ -0,0 +1,86 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymBlk.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem in regular mode using the
+   ARbkSymStdEig class (block Krylov-Schur method).
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode,
+      where A is derived from the central difference discretization
+      of the 2-dimensional Laplacian on the unit square [0,1]x[0,1]
+      with zero Dirichlet boundary conditions.
+
+   2) Data structure used to represent matrix A:
+
+      When using ARbkSymStdEig, the user is required to provide a
+      class that contains a member function which computes the
+      the matrix-block product Y = AX, where X and Y have nvec
+      columns. In this example, this class is called SymMatrixA,
+      and MultMV is the function.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      smatrixa.h       The SymMatrixA class definition.
+      arkssym.h        The ARbkSymStdEig class definition.
+      symsol.h         The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arkssym.h"
+#include "smatrixa.h"
+#include "symsol.h"
+
+template<class T>
+void Test(T type)
+{
+
+  // Creating a symmetric matrix.
+
+  SymMatrixA<T> A(10L); // n = 10*10.
+
+  // Defining what we need: the four eigenvectors of A with largest magnitude.
+  // A.MultMV is the function that performs the product Y <- A.X. Blocks
+  // with two vectors are used.
+
+  ARbkSymStdEig<T, SymMatrixA<T> >
+    dprob(A.ncols(), 4L, &A, &SymMatrixA<T>::MultMV, "LM", 0, 0.0, 0,
+          (T*)NULL, 2);
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  Solution(A, dprob);
+
+} // Test.
+
+
+int main()
+{
+
+  // Solving a double precision problem with n = 100.
+
+  Test((double)0.0);
+
+  // Solving a single precision problem with n = 100.
+
+  Test((float)0.0);
+
+} // main.
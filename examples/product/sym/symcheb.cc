@@ -0,0 +1,134 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymCheb.cc.
+   Example program that illustrates how to find the eigenvalues of
+   a real symmetric matrix that lie in an interval of its spectrum
+   using the ARSymStdEig class in regular mode and a Chebyshev
+   polynomial filter (ARChebyshevOp), without factoring any matrix.
+
+   1) Problem description:
+
+      In this example we try to find the eigenvalues of A that lie in
+      the interval [140, 200], where A is derived from the central
+      difference discretization of the 2-dimensional Laplacian on the
+      unit square [0,1]x[0,1] with zero Dirichlet boundary conditions.
+      There are five such eigenvalues (two of them are double).
+
+      The bounds of the spectrum of A are estimated by a few Lanczos
+      steps. ARSymStdEig then finds the eigenvalues of largest
+      algebraic value of p(A), where p is a polynomial that is close
+      to one in [140, 200] and close to zero in the rest of the
+      spectrum. The eigenvalues of A are the Rayleigh quotients of
+      the eigenvectors of p(A).
+
+   2) Data structure used to represent matrix A:
+
+      When using ARChebyshevOp, the user is only required to provide
+      a class that contains a member function which computes the
+      the matrix-vector product w = Av. In this example, this class is
+      called SymMatrixA, and MultMv is the function. ARChebyshevOp
+      itself has a MultMv function that computes w = p(A)v, which is
+      passed to ARSymStdEig.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      smatrixa.h       The SymMatrixA class definition.
+      archeb.h         The ARChebyshevOp class definition.
+      arssym.h         The ARSymStdEig class definition.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include "arssym.h"
+#include "archeb.h"
+#include "smatrixa.h"
+
+template<class T>
+void Test(T type)
+{
+
+  int i, nconv;
+  T   *x, *r, lambda;
+
+  // Creating a symmetric matrix.
+
+  SymMatrixA<T> A(10L); // n = 10*10.
+
+  // Defining a polynomial filter of degree 60 that keeps the eigenvalues
+  // of A in [140, 200]. The bounds of the spectrum of A are estimated
+  // by 20 Lanczos steps.
+
+  ARChebyshevOp<T, SymMatrixA<T> > F(A.ncols(), &A);
+
+  F.EstimateBounds(20);
+  F.DefineInterval(T(140.0), T(200.0), 60);
+
+  // Defining what we need: the five eigenvectors of p(A) with largest
+  // algebraic value. F.MultMv is the function that performs the
+  // product w <- p(A).v.
+
+  ARSymStdEig<T, ARChebyshevOp<T, SymMatrixA<T> > >
+    dprob(A.ncols(), 5L, &F, &ARChebyshevOp<T, SymMatrixA<T> >::MultMv,
+          "LA");
+
+  // Finding eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing the eigenvalues of A (Rayleigh quotients) and the
+  // corresponding residual norms ||A*x - lambda*x||.
+
+  nconv = dprob.ConvergedEigenvalues();
+  r     = new T[A.ncols()];
+
+  std::cout << std::endl << "Testing ARPACK++ class ARChebyshevOp" << std::endl;
+  std::cout << "Real symmetric eigenvalue problem: A*x - lambda*x" << std::endl;
+  std::cout << "Spectrum of A estimated in [" << F.GetLowerBound() << ", ";
+  std::cout << F.GetUpperBound() << "]" << std::endl;
+  std::cout << "Degree of the filter:          " << F.GetDegree() << std::endl;
+  std::cout << "Number of converged values:    " << nconv << std::endl;
+  std::cout << "Products A*v performed:        " << F.GetProducts();
+  std::cout << std::endl << std::endl;
+
+  for (i=0; i<nconv; i++) {
+    x      = dprob.RawEigenvector(i);
+    lambda = F.RayleighQuotient(x);
+    A.MultMv(x, r);
+    axpy(A.ncols(), -lambda, x, 1, r, 1);
+    std::cout << "lambda[" << (i+1) << "]: " << lambda;
+    std::cout << "   p(lambda): " << F.FilterValue(lambda);
+    std::cout << "   ||A*x - lambda*x||: " << nrm2(A.ncols(), r, 1);
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+
+  delete[] r;
+
+} // Test.
+
+
+int main()
+{
+
+  // Solving a double precision problem with n = 100.
+
+  Test((double)0.0);
+
+  // Solving a single precision problem with n = 100.
+
+  Test((float)0.0);
+
+} // main.
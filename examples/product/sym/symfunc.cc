@@ -0,0 +1,137 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymFunc.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem when the matrix-vector product is
+   given by a function object (or by a lambda) instead of a pair
+   (object, member function), using the ARFuncSymStdEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode
+      and in shift and invert mode, where A is the one dimensional
+      discrete Laplacian on the interval [0,1] with zero Dirichlet
+      boundary conditions.
+
+   2) Data structure used to represent matrix A:
+
+      ARFuncSymStdEig stores a copy of any object that can be called
+      as op(v, w) to compute w <- OP*v. The type of this object is a
+      template parameter, so the product is inlined into the ARPACK
+      loop when possible. Three operators are used here:
+
+      - LaplacianOp, a function object that calls SymMatrixB::MultMv
+        by its qualified name (so the call is not virtual);
+      - ARMemberOp, that turns SymMatrixB::MultOPv into a function
+        object;
+      - a lambda, if the compiler supports C++11.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      smatrixb.h       The SymMatrixB class definition.
+      arfunc.h         The ARFuncSymStdEig class definition.
+      symsol.h         The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arfunc.h"
+#include "smatrixb.h"
+#include "symsol.h"
+
+
+template<class T>
+class LaplacianOp {
+
+ private:
+
+  SymMatrixB<T>* A;
+
+ public:
+
+  void operator()(T* v, T* w) { A->SymMatrixB<T>::MultMv(v, w); }
+
+  LaplacianOp(SymMatrixB<T>* Ap) { A = Ap; }
+
+}; // LaplacianOp.
+
+
+template<class T>
+void Test(T type)
+{
+
+  // Creating a symmetric matrix.
+
+  SymMatrixB<T> A(100, 0.0); // n = 100, shift = 0.0.
+
+  // Defining what we need: the four eigenvectors of A with largest
+  // magnitude. The product w <- A.v is performed by a LaplacianOp.
+
+  ARFuncSymStdEig<T, LaplacianOp<T> >
+    dprob(A.ncols(), 4, LaplacianOp<T>(&A), "LM");
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  Solution(A, dprob);
+
+  // Defining what we need: the four eigenvectors of A nearest to 0.0.
+  // The product w <- OP.v is performed by A.MultOPv, wrapped in an
+  // ARMemberOp.
+
+  typedef ARMemberOp<SymMatrixB<T>, T, &SymMatrixB<T>::MultOPv> ShiftOp;
+
+  ARFuncSymStdEig<T, ShiftOp> sprob(A.ncols(), 4, ShiftOp(&A), 0.0);
+
+  // Finding eigenvalues and eigenvectors.
+
+  sprob.FindEigenvectors();
+
+  // Printing solution.
+
+  Solution(A, sprob);
+
+#if __cplusplus >= 201103L
+
+  // Repeating the first problem with a lambda that captures A.
+
+  auto op = [&A](T* v, T* w) { A.SymMatrixB<T>::MultMv(v, w); };
+
+  ARFuncSymStdEig<T, decltype(op)> lprob(A.ncols(), 4, op, "LM");
+
+  lprob.FindEigenvectors();
+
+  Solution(A, lprob);
+
+#endif
+
+} // Test.
+
+
+int main()
+{
+
+  // Solving a double precision problem with n = 100.
+
+  Test((double)0.0);
+
+  // Solving a single precision problem with n = 100.
+
+  Test((float)0.0);
+
+} // main.
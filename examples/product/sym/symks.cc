@@ -0,0 +1,78 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymKS.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem in regular mode with the ARSymStdEig
+   class, using the block Krylov-Schur engine instead of the FORTRAN
+   ARPACK routines.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode,
+      where A is derived from the central difference discretization
+      of the 2-dimensional Laplacian on the unit square [0,1]x[0,1]
+      with zero Dirichlet boundary conditions. The problem is solved
+      twice: by ARPACK's DSAUPD and by the thick restart block Lanczos
+      method of ARbkSymStdEig, that orthogonalizes blocks of vectors
+      with level 3 BLAS.
+
+   2) Data structure used to represent matrix A:
+
+      When using ARSymStdEig, the user is required to provide a
+      class that contains a member function which computes the
+      the matrix-vector product w = Av. In this example, this class
+      is called SymMatrixA, and MultMv is the function. The same
+      function is used by both methods.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      smatrixa.h       The SymMatrixA class definition.
+      arssym.h         The ARSymStdEig class definition.
+      symsol.h         The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "arssym.h"
+#include "smatrixa.h"
+#include "symsol.h"
+
+
+int main()
+{
+
+  // Creating a symmetric matrix (n = 30*30).
+
+  SymMatrixA<double> A(30L);
+
+  // Defining what we need: the six eigenvectors of A with largest
+  // magnitude. A.MultMv is the function that performs w <- A.v.
+
+  ARSymStdEig<double, SymMatrixA<double> >
+    dprob(A.ncols(), 6L, &A, &SymMatrixA<double>::MultMv, "LM", 40);
+
+  // Finding eigenvalues and eigenvectors with DSAUPD and DSEUPD.
+
+  dprob.FindEigenvectors();
+  Solution(A, dprob);
+
+  // Finding them again with the Krylov-Schur engine (blocks of 4
+  // vectors).
+
+  dprob.SetKrylovSchur(4);
+  dprob.FindEigenvectors();
+  Solution(A, dprob);
+
+} // main.
@@ -21,10 +21,10 @@
 #include <cmath>
 #include "blas1c.h"
 #include "matprod.h"
-#include "arssym.h"
+#include "arrssym.h"
 
 template<class ARMATRIX, class ARFLOAT>
-void Solution(ARMATRIX &A, ARSymStdEig<ARFLOAT, ARMATRIX> &Prob)
+void Solution(ARMATRIX &A, ARrcSymStdEig<ARFLOAT> &Prob)
 /*
   Prints eigenvalues and eigenvectors of symmetric eigen-problems
   on standard "std::cout" stream.
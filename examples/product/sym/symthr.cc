@@ -0,0 +1,218 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymThr.cc.
+   Example program that illustrates how to run several real
+   symmetric eigenvalue problems at the same time (one in each
+   thread) using the ARbkSymStdEig and ARSymStdEig classes.
+
+   1) Problem description:
+
+      In this example we solve 48 independent problems A*x = x*lambda
+      in regular mode, where A is derived from the central difference
+      discretization of the 2-dimensional Laplacian on the unit square
+      with a mesh size that changes from problem to problem. Problems
+      are distributed among threads by OpenMP (they are solved one
+      after the other if OpenMP is not available).
+
+      The 48 problems are solved twice: first by ARbkSymStdEig, then
+      by ARSymStdEig. ARSymStdEig uses the block Krylov-Schur engine
+      (see SetKrylovSchur), since the FORTRAN ARPACK routines keep
+      their state in static variables and cannot be called by several
+      threads at the same time.
+
+      Every fourth problem is deliberately ill-defined (nev = n), so
+      the error state must be set in the thread that solves it and
+      must not affect the problems solved by the other threads.
+
+   2) Data structure used to represent matrix A:
+
+      When using ARbkSymStdEig, the user is required to provide a
+      class that contains a member function which computes the
+      the matrix-block product Y = AX, where X and Y have nvec
+      columns. In this example, this class is called SymMatrixA,
+      and MultMV is the function. ARSymStdEig uses MultMv, the
+      function that computes the matrix-vector product y = Ax.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      smatrixa.h       The SymMatrixA class definition.
+      arkssym.h        The ARbkSymStdEig class definition.
+      arssym.h         The ARSymStdEig class definition.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#define ARPACK_SILENT_MODE
+
+#include <iostream>
+#include <cmath>
+#include "arkssym.h"
+#include "arssym.h"
+#include "smatrixa.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+
+template<class EIGPROB>
+double Residual(SymMatrixA<double>& A, EIGPROB& prob)
+{
+
+  // Returns max ||A*x(i) - lambda(i)*x(i)||/|lambda(i)|.
+
+  int     i, n;
+  double  res, resmax;
+  double* Ax;
+
+  n      = A.ncols();
+  Ax     = new double[n];
+  resmax = 0.0;
+  for (i=0; i<prob.ConvergedEigenvalues(); i++) {
+    A.MultMv(prob.RawEigenvector(i), Ax);
+    axpy(n, -prob.Eigenvalue(i), prob.RawEigenvector(i), 1, Ax, 1);
+    res = nrm2(n, Ax, 1)/fabs(prob.Eigenvalue(i));
+    if (res > resmax) resmax = res;
+  }
+  delete[] Ax;
+  return resmax;
+
+} // Residual.
+
+
+int Check(int nprob, int status[], int nconv[], double resid[],
+          double& resmax)
+{
+
+  // Returns the number of problems with unexpected results.
+
+  int p, failed;
+
+  failed = 0;
+  resmax = 0.0;
+  for (p=0; p<nprob; p++) {
+    if (p%4 == 3) {
+      if (status[p] != ArpackError::PARAMETER_ERROR) failed++;
+    }
+    else {
+      if ((status[p] != ArpackError::NO_ERRORS) || (nconv[p] != 4)) failed++;
+      if (resid[p] > resmax) resmax = resid[p];
+    }
+  }
+  return failed;
+
+} // Check.
+
+
+int main()
+{
+
+  const int nprob = 48;
+
+  int    p, nx, nev, nthreads;
+  int    status[nprob], nconv[nprob];
+  double resid[nprob];
+  int    bkfailed, ksfailed;
+  double bkresmax, ksresmax;
+
+  nthreads = 1;
+#ifdef _OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+
+  // Solving all problems at once with ARbkSymStdEig.
+
+#ifdef _OPENMP
+#pragma omp parallel for private(nx, nev) schedule(dynamic, 1)
+#endif
+  for (p=0; p<nprob; p++) {
+
+    // Problem p has dimension n = nx*nx. Ill-defined problems ask for
+    // all eigenvalues of A.
+
+    nx  = 8+(p%8);
+    nev = (p%4 == 3) ? nx*nx : 4;
+
+    SymMatrixA<double> A(nx);
+    ARbkSymStdEig<double, SymMatrixA<double> >
+      prob(A.ncols(), nev, &A, &SymMatrixA<double>::MultMV, "LM", 0, 0.0,
+           0, (double*)NULL, 2);
+
+    // Status is checked right after the definition of the problem, since
+    // it is stored separately by each thread.
+
+    status[p] = ArpackError::Status();
+    nconv[p]  = 0;
+    resid[p]  = 0.0;
+    if (status[p] == ArpackError::NO_ERRORS) {
+      prob.FindEigenvectors();
+      nconv[p] = prob.ConvergedEigenvalues();
+      resid[p] = Residual(A, prob);
+    }
+    ArpackError();
+
+  }
+
+  bkfailed = Check(nprob, status, nconv, resid, bkresmax);
+
+  // Solving the same problems with ARSymStdEig. Only the Krylov-Schur
+  // engine may be used by several threads at the same time. 20 Lanczos
+  // vectors are used, since the largest eigenvalues of A are close.
+
+#ifdef _OPENMP
+#pragma omp parallel for private(nx, nev) schedule(dynamic, 1)
+#endif
+  for (p=0; p<nprob; p++) {
+
+    nx  = 8+(p%8);
+    nev = (p%4 == 3) ? nx*nx : 4;
+
+    SymMatrixA<double> A(nx);
+    ARSymStdEig<double, SymMatrixA<double> >
+      prob(A.ncols(), nev, &A, &SymMatrixA<double>::MultMv, "LM", 20);
+
+    status[p] = ArpackError::Status();
+    nconv[p]  = 0;
+    resid[p]  = 0.0;
+    if (status[p] == ArpackError::NO_ERRORS) {
+      prob.SetKrylovSchur();
+      prob.FindEigenvectors();
+      nconv[p] = prob.ConvergedEigenvalues();
+      resid[p] = Residual(A, prob);
+    }
+    ArpackError();
+
+  }
+
+  ksfailed = Check(nprob, status, nconv, resid, ksresmax);
+
+  // Printing results.
+
+  cout << endl << "Testing concurrent ARbkSymStdEig and ARSymStdEig problems";
+  cout << endl << endl;
+  cout << "Number of threads                  : " << nthreads << endl;
+  cout << "Number of problems (each class)    : " << nprob << endl;
+  cout << endl << "ARbkSymStdEig:" << endl;
+  cout << "Problems with unexpected results   : " << bkfailed << endl;
+  cout << "Max ||A*x(i) - lambda(i)*x(i)||/|lambda(i)| : " << bkresmax << endl;
+  cout << endl << "ARSymStdEig (Krylov-Schur engine):" << endl;
+  cout << "Problems with unexpected results   : " << ksfailed << endl;
+  cout << "Max ||A*x(i) - lambda(i)*x(i)||/|lambda(i)| : " << ksresmax << endl;
+  cout << endl;
+
+  return ((bkfailed == 0) && (ksfailed == 0)) ? 0 : 1;
+
+} // main.
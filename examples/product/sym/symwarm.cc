@@ -0,0 +1,277 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymWarm.cc.
+   Example program that illustrates how to solve a sequence of slowly
+   varying real symmetric standard eigenvalue problems with the
+   ARbkSymStdEig class, reusing the eigenvectors of each problem to
+   start the next one.
+
+   1) Problem description:
+
+      In this example we solve A(s)*x = x*lambda for the eight values
+      s = 1.0, 1.1, ..., 1.7 of a parameter s, where A(s) is a
+      tridiagonal matrix of order 2000 with -1 on the off-diagonals
+      and 2+s*sin(pi*i/n) on the diagonal (i = 1, ..., n). The six
+      largest eigenvalues of each matrix are required.
+
+      The sweep is performed four times, with blocks of one and of
+      four vectors:
+
+      - cold start: a new problem is defined for each value of s;
+      - WarmStart(true): the same problem is used for all values of s.
+        The operator is changed by ChangeMultOPX, so the eigenvectors
+        of the previous problem are kept and used as the starting
+        subspace of the next one;
+      - Recycle: the matrix is changed in place, so Recycle must be
+        called to keep the eigenvectors and restart the solver;
+      - SetSubspace: a new problem is defined for each value of s and
+        the eigenvectors found in the previous step (kept in a copy of
+        the previous problem) are supplied by SetSubspace.
+
+      The total number of products y <- A*x (GetStats().nopx) of each
+      sweep is printed.
+
+   2) Data structure used to represent matrix A:
+
+      When using ARbkSymStdEig, the user is required to provide a
+      class that contains a member function which computes the
+      the matrix-block product Y = AX, where X and Y have nvec
+      columns. In this example, this class is called TriMatrix,
+      and MultMV is the function.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      arkssym.h        The ARbkSymStdEig class definition.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include <cmath>
+#include "arkssym.h"
+
+using namespace std;
+
+
+template<class ART>
+class TriMatrix {
+
+ private:
+
+  int n;
+  ART s;
+
+ public:
+
+  int ncols() { return n; }
+
+  void ChangeParameter(ART sp) { s = sp; }
+
+  void MultMV(ART* X, ART* Y, int nvec);
+
+  TriMatrix(int np = 2000, ART sp = 0.0) { n = np; s = sp; }
+
+}; // TriMatrix.
+
+
+template<class ART>
+void TriMatrix<ART>::MultMV(ART* X, ART* Y, int nvec)
+{
+
+  // Computing Y <- A(s)*X, one column at a time.
+
+  int  i, j;
+  ART  d, pi;
+  ART* x;
+  ART* y;
+
+  pi = 4.0*atan(1.0);
+  for (j=0; j<nvec; j++) {
+    x = &X[j*n];
+    y = &Y[j*n];
+    for (i=0; i<n; i++) {
+      d    = 2.0+s*sin(pi*ART(i+1)/ART(n));
+      y[i] = d*x[i];
+      if (i > 0)   y[i] -= x[i-1];
+      if (i < n-1) y[i] -= x[i+1];
+    }
+  }
+
+} // MultMV.
+
+
+typedef TriMatrix<double> Matrix;
+
+typedef ARbkSymStdEig<double, Matrix> Problem;
+
+
+const int    nsteps = 8;
+const int    nev    = 6;
+const double s0     = 1.0;
+const double ds     = 0.1;
+
+
+long Cold(int nb, double* EigVal)
+{
+
+  // Defining a new problem for each value of s.
+
+  int  k;
+  long nopx;
+
+  nopx = 0;
+  for (k=0; k<nsteps; k++) {
+    Matrix  A(2000, s0+k*ds);
+    Problem prob(A.ncols(), nev, &A, &Matrix::MultMV, "LA", 0, 0.0, 0,
+                 (double*)NULL, nb);
+    prob.FindEigenvectors();
+    nopx += prob.GetStats().nopx;
+    EigVal[k] = prob.Eigenvalue(nev-1);
+  }
+  return nopx;
+
+} // Cold.
+
+
+long Warm(int nb, double* EigVal)
+{
+
+  // Using the same problem for all values of s. Each matrix is a
+  // different object, so the operator is changed by ChangeMultOPX.
+
+  int     k;
+  Matrix  A[nsteps];
+  Problem prob;
+
+  for (k=0; k<nsteps; k++) A[k].ChangeParameter(s0+k*ds);
+
+  prob.DefineParameters(A[0].ncols(), nev, &A[0], &Matrix::MultMV, "LA",
+                        0, 0.0, 0, (double*)NULL, nb);
+  prob.WarmStart(true);
+  for (k=0; k<nsteps; k++) {
+    if (k > 0) prob.ChangeMultOPX(&A[k], &Matrix::MultMV);
+    prob.FindEigenvectors();
+    EigVal[k] = prob.Eigenvalue(nev-1);
+  }
+  return prob.GetStats().nopx;
+
+} // Warm.
+
+
+long Recycled(int nb, double* EigVal)
+{
+
+  // Changing the matrix in place. Recycle keeps the eigenvectors of
+  // the last problem and restarts the solver.
+
+  int     k;
+  Matrix  A(2000, s0);
+  Problem prob(A.ncols(), nev, &A, &Matrix::MultMV, "LA", 0, 0.0, 0,
+               (double*)NULL, nb);
+
+  for (k=0; k<nsteps; k++) {
+    if (k > 0) {
+      A.ChangeParameter(s0+k*ds);
+      prob.Recycle();
+    }
+    prob.FindEigenvectors();
+    EigVal[k] = prob.Eigenvalue(nev-1);
+  }
+  return prob.GetStats().nopx;
+
+} // Recycled.
+
+
+long Seeded(int nb, double* EigVal)
+{
+
+  // Defining a new problem for each value of s, starting from the
+  // eigenvectors of the previous one. The previous problem is kept
+  // by the assignment operator (along with the vectors it received
+  // from SetSubspace).
+
+  int     k;
+  long    nopx;
+  Problem last;
+
+  nopx = 0;
+  for (k=0; k<nsteps; k++) {
+    Matrix  A(2000, s0+k*ds);
+    Problem prob(A.ncols(), nev, &A, &Matrix::MultMV, "LA", 0, 0.0, 0,
+                 (double*)NULL, nb);
+    if (k > 0) prob.SetSubspace(nev, last.RawEigenvectors());
+    prob.FindEigenvectors();
+    nopx += prob.GetStats().nopx;
+    EigVal[k] = prob.Eigenvalue(nev-1);
+    last = prob;
+  }
+  return nopx;
+
+} // Seeded.
+
+
+double MaxDiff(double* x, double* y)
+{
+
+  // Returns max |x[k]-y[k]|.
+
+  int    k;
+  double d;
+
+  d = 0.0;
+  for (k=0; k<nsteps; k++) if (fabs(x[k]-y[k]) > d) d = fabs(x[k]-y[k]);
+  return d;
+
+} // MaxDiff.
+
+
+int main()
+{
+
+  int    nb;
+  long   cold, warm, recycled, seeded;
+  double vcold[nsteps], vwarm[nsteps], vrecycled[nsteps], vseeded[nsteps];
+  double diff;
+
+  cout << endl << "Testing warm starts of ARbkSymStdEig" << endl;
+  cout << "Sweep of " << nsteps << " tridiagonal problems (n = 2000, ";
+  cout << "nev = " << nev << ")" << endl;
+
+  for (nb=1; nb<=4; nb*=4) {
+
+    cold     = Cold(nb, vcold);
+    warm     = Warm(nb, vwarm);
+    recycled = Recycled(nb, vrecycled);
+    seeded   = Seeded(nb, vseeded);
+
+    diff = MaxDiff(vcold, vwarm);
+    if (MaxDiff(vcold, vrecycled) > diff) diff = MaxDiff(vcold, vrecycled);
+    if (MaxDiff(vcold, vseeded) > diff)   diff = MaxDiff(vcold, vseeded);
+
+    cout << endl << "Block size: " << nb << endl;
+    cout << "OP*x products (cold start)       : " << cold << endl;
+    cout << "OP*x products (WarmStart(true))  : " << warm;
+    cout << "  (" << double(cold)/double(warm) << "x fewer)" << endl;
+    cout << "OP*x products (Recycle)          : " << recycled;
+    cout << "  (" << double(cold)/double(recycled) << "x fewer)" << endl;
+    cout << "OP*x products (SetSubspace)      : " << seeded;
+    cout << "  (" << double(cold)/double(seeded) << "x fewer)" << endl;
+    cout << "Max difference in lambda(" << nev << ")      : " << diff << endl;
+
+  }
+  cout << endl;
+
+} // main.
+
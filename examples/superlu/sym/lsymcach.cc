@@ -0,0 +1,108 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE LSymCach.cc.
+   Example program that illustrates how to reuse the factorizations
+   of A-sigma*I when the shift of a real symmetric standard eigenvalue
+   problem is changed back and forth, using the ARluSymStdEig class
+   and the factorization cache of ARluSymMatrix.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in shift and
+      invert mode, where A is derived from the central difference
+      discretization of the one-dimensional Laplacian on [0, 1]
+      with zero Dirichlet boundary conditions. The eigenvalues
+      nearest to 1.0, to 2.0 and then again to 1.0 are computed.
+
+   2) Data structure used to represent matrix A:
+
+      {nnz, irow, pcol, A}: lower triangular part of matrix A
+                            stored in CSC format.
+
+      ARluSymMatrix keeps the factors of A-sigma*I computed for the
+      last two shifts, so the third call to ChangeShift does not
+      factor A-1.0*I again.
+
+   3) Library called by this example:
+
+      The SuperLU package is called by ARluSymStdEig to solve
+      some linear systems involving (A-sigma*I). This is needed to
+      implement the shift and invert strategy.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      lsmatrxb.h       SymmetricMatrixB, a function that generates
+                       matrix A in CSC format.
+      arlsmat.h        The ARluSymMatrix class definition.
+      arlssym.h        The ARluSymStdEig class definition.
+      lsymsol.h        The Solution function.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "lsmatrxb.h"
+#include "arlsmat.h"
+#include "arlssym.h"
+#include "lsymsol.h"
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     n;          // Dimension of the problem.
+  int     nnz;        // Number of nonzero elements in A.
+  int*    irow;       // pointer to an array that stores the row
+                      // indices of the nonzeros in A.
+  int*    pcol;       // pointer to an array of pointers to the
+                      // beginning of each column of A in vector A.
+  double* A;          // pointer to an array that stores the
+                      // nonzero elements of A.
+
+  // Creating a 100x100 matrix. The factors of A-sigma*I are kept
+  // for up to two shifts.
+
+  n = 100;
+  SymmetricMatrixB(n, nnz, A, irow, pcol);
+  ARluSymMatrix<double> matrix(n, nnz, A, irow, pcol);
+  matrix.SetFactorCache(2);
+
+  // Defining what we need: the four eigenvectors of A nearest to 1.0.
+
+  ARluSymStdEig<double> dprob(4L, matrix, 1.0);
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+  Solution(matrix, dprob);
+
+  // Finding the eigenvalues nearest to 2.0 (A-2.0*I is factored).
+
+  dprob.ChangeShift(2.0);
+  dprob.FindEigenvectors();
+  Solution(matrix, dprob);
+
+  // Finding the eigenvalues nearest to 1.0 again. The factors of
+  // A-1.0*I are taken from the cache.
+
+  dprob.ChangeShift(1.0);
+  dprob.FindEigenvectors();
+  Solution(matrix, dprob);
+
+  std::cout << "Factorizations reused: " << matrix.GetCacheHits();
+  std::cout << std::endl << std::endl;
+
+} // main
@@ -0,0 +1,139 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE LSymGSlc.cc.
+   Example program that illustrates how to find all eigenvalues
+   of a real symmetric generalized problem that lie inside an
+   interval using the ARSymSlice class (spectrum slicing).
+
+   1) Problem description:
+
+      In this example we try to find all solutions of A*x = B*x*lambda
+      with lambda in [100, 40000), where A and B are obtained from the
+      finite element discretization of the 1-dimensional discrete
+      Laplacian
+                                  d^2u / dx^2
+      on the interval [0,1] with zero Dirichlet boundary conditions
+      using piecewise linear elements.
+
+      The interval is split into slices that contain at most 20
+      eigenvalues. The number of eigenvalues in each slice is obtained
+      from the inertia of A-sigma*B, and the slices are solved in
+      parallel (in shift and invert mode) when OpenMP is available.
+
+   2) Data structure used to represent matrices A and B:
+
+      {nnzA, irowA, pcolA, valA}: lower triangular part of matrix A
+                                  stored in CSC format.
+      {nnzB, irowB, pcolB, valB}: lower triangular part of matrix B
+                                  stored in CSC format.
+
+   3) Library called by this example:
+
+      The SuperLU package is called by ARluSymPencil to factor
+      A-sigma*B and to solve some linear systems involving this matrix.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      lsmatrxc.h       SymmetricMatrixC, a function that generates
+                       matrix A in CSC format.
+      lsmatrxd.h       SymmetricMatrixD, a function that generates
+                       matrix B in CSC format.
+      arlsmat.h        The ARluSymMatrix class definition.
+      arlspen.h        The ARluSymPencil class definition.
+      arslice.h        The ARSymSlice class definition.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "lsmatrxc.h"
+#include "lsmatrxd.h"
+#include "arlsmat.h"
+#include "arlspen.h"
+#include "arslice.h"
+
+#include <iostream>
+#include <cmath>
+using namespace std;
+
+int main()
+{
+
+  int    i, j, n;        // Dimension of the problem.
+  int    nnzA,   nnzB;   // Number of nonzero elements in A and B.
+  int    *irowA, *irowB; // pointer to an array that stores the row
+                         // indices of the nonzeros in A and B.
+  int    *pcolA, *pcolB; // pointer to an array of pointers to the
+                         // beginning of each column of A (B) in valA (valB).
+  double *valA,  *valB;  // pointer to an array that stores the nonzero
+                         // elements of A and B.
+  double *Ax, *Bx;       // Residual computation.
+  double res, resmax;
+
+  // Creating matrices A and B.
+
+  n = 1000;
+  SymmetricMatrixC(n, nnzA, valA, irowA, pcolA);
+  ARluSymMatrix<double> A(n, nnzA, valA, irowA, pcolA);
+
+  SymmetricMatrixD(n, nnzB, valB, irowB, pcolB);
+  ARluSymMatrix<double> B(n, nnzB, valB, irowB, pcolB);
+
+  // Defining what we need: all eigenvalues in [100, 40000), using
+  // slices with at most 20 eigenvalues.
+
+  ARSymSlice<double, ARluSymMatrix<double>, ARluSymPencil<double> >
+    dprob(A, B, 100.0, 40000.0, 20);
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  cout << endl << endl << "Testing ARPACK++ class ARSymSlice" << endl;
+  cout << "Real symmetric generalized eigenvalue problem: A*x - B*x*lambda";
+  cout << endl << endl;
+
+  cout << "Dimension of the system            : " << n << endl;
+  cout << "Number of slices                   : " << dprob.GetSlices();
+  cout << endl;
+  cout << "Eigenvalues in the interval        : " << dprob.TotalEigenvalues();
+  cout << endl;
+  cout << "Number of converged eigenvalues    : ";
+  cout << dprob.ConvergedEigenvalues() << endl << endl;
+
+  Ax     = new double[n];
+  Bx     = new double[n];
+  resmax = 0.0;
+  for (i=0; i<dprob.ConvergedEigenvalues(); i++) {
+    A.MultMv(dprob.RawEigenvector(i), Ax);
+    B.MultMv(dprob.RawEigenvector(i), Bx);
+    axpy(n, -dprob.Eigenvalue(i), Bx, 1, Ax, 1);
+    res = nrm2(n, Ax, 1)/fabs(dprob.Eigenvalue(i));
+    if (res > resmax) resmax = res;
+  }
+
+  cout << "Smallest and largest eigenvalues   : ";
+  j = dprob.ConvergedEigenvalues();
+  if (j > 0) cout << dprob.Eigenvalue(0) << ", " << dprob.Eigenvalue(j-1);
+  cout << endl;
+  cout << "Max ||A*x(i) - B*x(i)*lambda(i)||/|lambda(i)| : " << resmax;
+  cout << endl << endl;
+
+  delete[] Ax;
+  delete[] Bx;
+
+} // main.
+
@@ -0,0 +1,106 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE LSymKShf.cc.
+   Example program that illustrates how to solve a real symmetric
+   sparse standard eigenvalue problem in shift and invert mode using
+   the ARluSymStdEig class and the Krylov-Schur engine.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in shift and
+      invert mode, where A is derived from the central difference
+      discretization of the one-dimensional Laplacian on [0, 1]
+      with zero Dirichlet boundary conditions.
+
+      The engine asks for OP*X by blocks of four vectors, and
+      ARluSymStdEig computes each block with one call to the MultInvV
+      function of ARluSymMatrix. Before the problem is solved,
+      MultInvV is compared with four calls to MultInvv. The program
+      returns 1 if they differ or if some eigenvalue has not
+      converged.
+
+   2) Data structure used to represent matrix A:
+
+      {nnz, irow, pcol, A}: lower triangular part of matrix A
+                            stored in CSC format.
+
+   3) Library called by this example:
+
+      The SuperLU package is called by ARluSymStdEig to solve
+      some linear systems involving (A-sigma*I). This is needed to
+      implement the shift and invert strategy.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      lsmatrxb.h       SymmetricMatrixB, a function that generates
+                       matrix A in CSC format.
+      arlsmat.h        The ARluSymMatrix class definition.
+      arlssym.h        The ARluSymStdEig class definition.
+      lsymsol.h        The Solution function.
+      lsymmulv.h       The CheckMultInvV function.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include "lsmatrxb.h"
+#include "arlsmat.h"
+#include "arlssym.h"
+#include "lsymsol.h"
+#include "lsymmulv.h"
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     n;          // Dimension of the problem.
+  int     nnz;        // Number of nonzero elements in A.
+  int*    irow;       // pointer to an array that stores the row
+                      // indices of the nonzeros in A.
+  int*    pcol;       // pointer to an array of pointers to the
+                      // beginning of each column of A in vector A.
+  double* A;          // pointer to an array that stores the
+                      // nonzero elements of A.
+  bool    ok;
+
+  // Creating a 100x100 matrix.
+
+  n = 100;
+  SymmetricMatrixB(n, nnz, A, irow, pcol);
+  ARluSymMatrix<double> matrix(n, nnz, A, irow, pcol);
+
+  // Defining what we need: the four eigenvectors of A nearest to 1.0.
+  // The constructor factors A-sigma*I.
+
+  ARluSymStdEig<double> dprob(4L, matrix, 1.0);
+
+  // Comparing MultInvV with MultInvv.
+
+  ok = CheckMultInvV(matrix, 4, 0.0);
+
+  // Finding eigenvalues and eigenvectors with blocks of four vectors.
+
+  dprob.SetKrylovSchur(4);
+  dprob.FindEigenvectors();
+  ok = ok && (dprob.ConvergedEigenvalues() == 4);
+
+  // Printing solution.
+
+  Solution(matrix, dprob);
+
+  return ok ? 0 : 1;
+
+} // main
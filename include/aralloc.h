@@ -0,0 +1,222 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARAlloc.h.
+   Allocators for the working arrays of the eigenvalue solvers.
+   ARAllocator is the interface used by ARrcStdEig to obtain the
+   Arnoldi basis, the ARPACK workspace and the output vectors.
+   ARAlignedAllocator returns aligned (and optionally first-touched
+   or huge page backed) memory, and ARArenaAllocator hands out
+   memory from a buffer that is reused from one problem to the next.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARALLOC_H
+#define ARALLOC_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include "arch.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+
+// ARAllocator class definition.
+
+class ARAllocator {
+
+ public:
+
+  enum Use {     // Kind of array being allocated.
+    BASIS,       // Arnoldi basis V (n*ncv elements).
+    WORKSPACE,   // ARPACK workspace (workd, workl, workv and rwork).
+    VECTOR       // Starting vector, eigenvalues and eigenvectors.
+  };
+
+  virtual void* Allocate(size_t bytes, Use /* use */)
+  {
+    return ::operator new(bytes);
+  }
+  // Returns a block of at least "bytes" bytes, or throws std::bad_alloc.
+
+  virtual void Deallocate(void* p) { ::operator delete(p); }
+  // Releases a block returned by Allocate.
+
+  virtual ~ARAllocator() { }
+  // Destructor.
+
+}; // class ARAllocator.
+
+
+// ARAlignedAllocator class definition.
+
+class ARAlignedAllocator: public ARAllocator {
+
+ protected:
+
+  size_t alignment;  // Alignment of all blocks (a power of two).
+  bool   hugebasis;  // Use transparent huge pages for the Arnoldi basis.
+  bool   touch;      // Touch all pages in the allocating thread.
+
+ public:
+
+  virtual void* Allocate(size_t bytes, Use use)
+  {
+
+    // Returns a block aligned to "alignment" bytes (to 2 MB if the block
+    // holds a large Arnoldi basis and hugebasis is true). The address of
+    // the memory obtained from operator new is stored just before the
+    // block.
+
+    const size_t hugepage = size_t(2)*1024*1024;
+
+    size_t align;
+    char   *raw, *p;
+
+    align = alignment;
+    if (hugebasis && (use == BASIS) && (bytes >= hugepage)) align = hugepage;
+    if (align < sizeof(void*)) align = sizeof(void*);
+
+    raw = (char*)::operator new(bytes+align+sizeof(void*));
+    p   = raw+sizeof(void*);
+    p  += (align-size_t(p)%align)%align;
+    ((char**)p)[-1] = raw;
+
+#if defined(MADV_HUGEPAGE)
+    if (align == hugepage) madvise(p, bytes-bytes%hugepage, MADV_HUGEPAGE);
+#endif
+
+    // With a first-touch NUMA policy, pages are placed on the node of the
+    // thread that writes them first.
+
+    if (touch) memset(p, 0, bytes);
+    return p;
+
+  } // Allocate.
+
+  virtual void Deallocate(void* p)
+  {
+    if (p != NULL) ::operator delete(((char**)p)[-1]);
+  }
+
+  ARAlignedAllocator(size_t alignmentp = 64, bool hugebasisp = false,
+                     bool touchp = false)
+  {
+    alignment = alignmentp;
+    hugebasis = hugebasisp;
+    touch     = touchp;
+  }
+  // Constructor.
+
+}; // class ARAlignedAllocator.
+
+
+// ARArenaAllocator class definition.
+
+class ARArenaAllocator: public ARAlignedAllocator {
+
+ protected:
+
+  char*  arena;    // Memory handed out by Allocate.
+  size_t size;     // Size of arena.
+  size_t top;      // First free byte of arena.
+  size_t last;     // Offset of the last block allocated from arena.
+  int    live;     // Number of blocks of arena in use.
+  bool   owner;    // Indicates if arena was allocated by this object.
+
+ public:
+
+  virtual void* Allocate(size_t bytes, Use use)
+  {
+
+    // Blocks are taken from the arena one after the other. Blocks that
+    // do not fit are obtained from ARAlignedAllocator.
+
+    size_t start;
+
+    if (arena == NULL) return ARAlignedAllocator::Allocate(bytes, use);
+    start = top+(alignment-size_t(arena+top)%alignment)%alignment;
+    if (start+bytes > size) return ARAlignedAllocator::Allocate(bytes, use);
+    if (touch) memset(arena+start, 0, bytes);
+    last = start;
+    top  = start+bytes;
+    live++;
+    return arena+start;
+
+  } // Allocate.
+
+  virtual void Deallocate(void* p)
+  {
+
+    // The arena is reused as soon as all of its blocks are released
+    // (as it happens each time the solver is prepared again).
+
+    if ((p == NULL) || ((char*)p < arena) || ((char*)p >= arena+size)) {
+      ARAlignedAllocator::Deallocate(p);
+      return;
+    }
+    if ((char*)p == arena+last) top = last;
+    if (--live == 0) top = last = 0;
+
+  } // Deallocate.
+
+  size_t Used() const { return top; }
+  // Returns the number of bytes of the arena in use.
+
+  size_t Size() const { return size; }
+  // Returns the size of the arena.
+
+  ARArenaAllocator(void* arenap, size_t sizep, size_t alignmentp = 64,
+                   bool touchp = false):
+    ARAlignedAllocator(alignmentp, false, touchp)
+  {
+    arena = (char*)arenap;
+    size  = sizep;
+    top   = last = 0;
+    live  = 0;
+    owner = false;
+  }
+  // Constructor that uses a buffer supplied by the caller (that must
+  // not be released before this object).
+
+  ARArenaAllocator(size_t sizep, size_t alignmentp = 64,
+                   bool hugepagesp = false, bool touchp = false):
+    ARAlignedAllocator(alignmentp, hugepagesp, touchp)
+  {
+    arena = (char*)ARAlignedAllocator::Allocate(sizep, BASIS);
+    size  = sizep;
+    top   = last = 0;
+    live  = 0;
+    owner = true;
+  }
+  // Constructor that allocates an arena of sizep bytes (backed by
+  // transparent huge pages if hugepagesp is true).
+
+  virtual ~ARArenaAllocator()
+  {
+    if (owner) ARAlignedAllocator::Deallocate(arena);
+  }
+  // Destructor.
+
+ private:
+
+  ARArenaAllocator(const ARArenaAllocator&);
+
+  ARArenaAllocator& operator=(const ARArenaAllocator&);
+
+}; // class ARArenaAllocator.
+
+
+#endif // ARALLOC_H
+
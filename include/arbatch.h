@@ -0,0 +1,576 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARBatch.h.
+   Arpack++ classes ARBatchSymStdEig and ARBatchNonSymStdEig.
+   These classes solve a large number of independent (and usually
+   small) real standard eigenproblems. Each problem is defined by
+   an object that has a member function MultOPx(x, y), as in
+   ARSymStdEig and ARNonSymStdEig. Problems are solved by the
+   block Krylov-Schur engine (ARbkSymStdEig and ARbkNonSymStdEig,
+   that do not call the FORTRAN code and so may run concurrently)
+   on a pool of OpenMP threads. Each thread owns a queue of
+   problems and steals problems from the other queues when its
+   own queue is empty. The solver object and its working arrays
+   (taken from an arena, see aralloc.h) are reused by each thread
+   for all the problems it solves, and results are stored in
+   contiguous arrays.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARBATCH_H
+#define ARBATCH_H
+
+#include <new>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "arch.h"
+#include "arerror.h"
+#include "arstats.h"
+#include "aralloc.h"
+#include "arkssym.h"
+#include "arksnsym.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+// ARBatchOp class definition.
+
+template<class ARFLOAT, class ARFOP>
+class ARBatchOp {
+
+ public:
+
+  typedef void (ARFOP::* TypeOPx)(ARFLOAT[], ARFLOAT[]);
+
+  int     n;        // Dimension of the current problem.
+  ARFOP   *objOP;   // Object that defines the current problem.
+  TypeOPx MultOPx;  // Function that evaluates the product OP*x.
+
+  void MultOPX(ARFLOAT X[], ARFLOAT Y[], int nvec)
+  {
+    for (int j=0; j<nvec; j++) {
+      (objOP->*MultOPx)(&X[size_t(j)*size_t(n)], &Y[size_t(j)*size_t(n)]);
+    }
+  }
+  // Applies OP to the nvec columns of X (as required by ARbkStdEig).
+
+  ARBatchOp() { n = 0; objOP = NULL; MultOPx = NULL; }
+  // Constructor.
+
+}; // class ARBatchOp.
+
+
+// ARBatchStdEig class definition.
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+class ARBatchStdEig {
+
+ public:
+
+ // a) Notation.
+
+  typedef void (ARFOP::* TypeOPx)(ARFLOAT[], ARFLOAT[]);
+
+
+ protected:
+
+ // b) User defined parameters.
+
+  int         nev;      // Number of eigenvalues of each problem.
+  int         ncv;      // Number of Arnoldi vectors (0 = default).
+  int         maxit;    // Maximum number of iterations (0 = default).
+  int         nb;       // Block size (0 = default).
+  ARFLOAT     tol;      // Stopping criterion.
+  std::string which;    // Part of the spectrum that is required.
+  TypeOPx     MultOPx;  // Function that evaluates the product OP*x.
+  int         nthreads; // Number of threads (0 = omp_get_max_threads()).
+
+  std::vector<ARFOP*> objOP; // Objects that define the problems.
+  std::vector<int>    dim;   // Dimensions of the problems.
+
+
+ // c) Results.
+
+  int                 nval;    // Eigenvalues stored for each problem.
+  bool                vecOK;   // Indicates if eigenvectors were computed.
+  std::vector<size_t> offset;  // Position of each problem in EigVec.
+  std::vector<int>    nconv;   // Number of converged eigenvalues.
+  std::vector<int>    niter;   // Number of iterations taken.
+  std::vector<ARFLOAT> EigValR; // Eigenvalues (real part), nval each.
+  std::vector<ARFLOAT> EigValI; // Imaginary part (nonsymmetric problems).
+  std::vector<ARFLOAT> EigVec;  // Eigenvectors, n x nval for each problem.
+  double              tsolve;  // Time spent by the last call to Solve.
+
+
+ // d) Work queues.
+
+  std::vector<int>    task;    // Problems, grouped by thread.
+  std::vector<int>    first;   // First problem in the queue of each thread.
+  std::vector<int>    last;    // End of the queue of each thread.
+#ifdef _OPENMP
+  omp_lock_t*         lock;    // One lock per queue.
+#endif
+
+
+ // e) Protected functions:
+
+  void StoreImag(ARrcStdEig<ARFLOAT, ARFLOAT>&, int) { }
+
+  void StoreImag(ARrcNonSymStdEig<ARFLOAT>& solver, int k);
+  // Copies the imaginary part of the eigenvalues of problem k.
+
+  size_t ArenaSize();
+  // Estimates the memory required by the largest problem.
+
+  void Schedule(int nt);
+  // Sorts the problems by decreasing dimension and deals them to
+  // the queues of nt threads.
+
+  int NextTask(int t, int nt);
+  // Takes a problem from the front of the queue of thread t or,
+  // if it is empty, from the back of the queue of another thread.
+  // Returns -1 if all queues are empty.
+
+  void SolveProblem(ARSOLVER& solver, ARBatchOp<ARFLOAT, ARFOP>& op,
+                    int k);
+  // Solves problem k using solver and stores the results.
+
+  void Worker(int t, int nt);
+  // Solves the problems assigned to thread t.
+
+
+ public:
+
+ // f) Public functions:
+
+ // f.1) Functions that define the problems.
+
+  int AddProblem(int np, ARFOP* objOPp);
+  // Adds a problem of dimension np defined by objOPp->MultOPx.
+  // Returns the index of the problem. Objects that define different
+  // problems are used concurrently by different threads.
+
+  void Clear();
+  // Removes all problems and results.
+
+  void SetThreads(int nthreadsp) { nthreads = nthreadsp; }
+  // Defines the number of threads (0 means omp_get_max_threads()).
+
+  void SetBlockSize(int nbp) { nb = nbp; }
+  // Defines the block size used by the Krylov-Schur engine.
+
+
+ // f.2) Functions that solve all problems.
+
+  int Solve(bool ivec = true);
+  // Finds nev eigenvalues (and eigenvectors, if ivec is true) of all
+  // problems. Returns the number of problems for which all nev
+  // eigenvalues have converged.
+
+
+ // f.3) Functions that return the results.
+
+  int Problems() { return int(dim.size()); }
+  // Returns the number of problems.
+
+  int GetN(int k) { return dim[k]; }
+  // Returns the dimension of problem k.
+
+  int GetNev() { return nev; }
+  // Returns the number of eigenvalues required for each problem.
+
+  int ConvergedEigenvalues(int k) { return nconv[k]; }
+  // Returns the number of converged eigenvalues of problem k.
+
+  int GetIter(int k) { return niter[k]; }
+  // Returns the number of iterations taken by problem k.
+
+  ARFLOAT* RawEigenvalues() { return EigValR.empty() ? NULL : &EigValR[0]; }
+  // Provides raw access to the eigenvalues of all problems (those of
+  // problem k begin at position k*GetNev()).
+
+  ARFLOAT* RawEigenvalues(int k) { return &EigValR[size_t(k)*nval]; }
+  // Provides raw access to the eigenvalues of problem k.
+
+  ARFLOAT* RawEigenvectors(int k);
+  // Provides raw access to the eigenvectors of problem k (stored
+  // sequentially, as GetN(k) x ConvergedEigenvalues(k) matrix).
+
+  ARFLOAT Eigenvalue(int k, int i) { return EigValR[size_t(k)*nval+i]; }
+  // Furnishes the i-th eigenvalue of problem k.
+
+  double GetTime() { return tsolve; }
+  // Returns the time spent by the last call to Solve.
+
+  double Throughput() { return (tsolve > 0.0) ? Problems()/tsolve : 0.0; }
+  // Returns the number of problems solved per second by Solve.
+
+
+ // f.4) Constructors and destructor.
+
+  ARBatchStdEig(int nevp, int nvalp, TypeOPx MultOPxp,
+                const std::string& whichp, int ncvp, ARFLOAT tolp,
+                int maxitp);
+  // Constructor. nvalp is the number of eigenvalues stored for each
+  // problem (nev, or nev+1 for nonsymmetric problems).
+
+  virtual ~ARBatchStdEig() { }
+  // Destructor.
+
+}; // class ARBatchStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARBatchStdEig member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+inline void ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::
+StoreImag(ARrcNonSymStdEig<ARFLOAT>& solver, int k)
+{
+
+  ARFLOAT* val = solver.RawEigenvaluesImag();
+
+  for (int i=0; i<nconv[k]; i++) EigValI[size_t(k)*nval+i] = val[i];
+
+} // StoreImag.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+size_t ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::ArenaSize()
+{
+
+  // V, resid, workd, workl, the eigenvalues and some room for alignment.
+  // Arrays that do not fit are simply allocated elsewhere.
+
+  size_t nmax, ncvmax;
+  int    k;
+
+  nmax = 0;
+  for (k=0; k<Problems(); k++) if (size_t(dim[k]) > nmax) nmax = dim[k];
+  ncvmax = (ncv > 0) ? size_t(ncv) : size_t(nev+4*(nev+1));
+  if (ncvmax > nmax) ncvmax = nmax;
+  return sizeof(ARFLOAT)*(nmax*(ncvmax+6)+ncvmax*(ncvmax+8)+2*nval)+1024;
+
+} // ArenaSize.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+void ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::Schedule(int nt)
+{
+
+  // Larger problems are dealt first, so each queue receives a similar
+  // amount of work and the smallest problems are left to be stolen.
+
+  std::vector<std::pair<int, int> > order(Problems());
+  int                               k, t, p;
+
+  for (k=0; k<Problems(); k++) order[k] = std::make_pair(-dim[k], k);
+  std::sort(order.begin(), order.end());
+
+  task.resize(Problems());
+  first.resize(nt);
+  last.resize(nt);
+  p = 0;
+  for (t=0; t<nt; t++) {
+    first[t] = p;
+    for (k=t; k<Problems(); k+=nt) task[p++] = order[k].second;
+    last[t] = p;
+  }
+
+} // Schedule.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+int ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::NextTask(int t, int nt)
+{
+
+  int k;
+
+  k = -1;
+
+#ifdef _OPENMP
+
+  int i, v;
+
+  omp_set_lock(&lock[t]);
+  if (first[t] < last[t]) k = task[first[t]++];
+  omp_unset_lock(&lock[t]);
+
+  for (i=1; (k < 0) && (i < nt); i++) {  // Stealing from thread v.
+    v = (t+i)%nt;
+    omp_set_lock(&lock[v]);
+    if (first[v] < last[v]) k = task[--last[v]];
+    omp_unset_lock(&lock[v]);
+  }
+
+#else
+
+  if (first[t] < last[t]) k = task[first[t]++];
+
+#endif
+
+  return k;
+
+} // NextTask.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+void ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::
+SolveProblem(ARSOLVER& solver, ARBatchOp<ARFLOAT, ARFOP>& op, int k)
+{
+
+  ARFLOAT* val;
+  int      i;
+
+  op.n       = dim[k];
+  op.objOP   = objOP[k];
+  op.MultOPx = MultOPx;
+
+  try {
+    solver.DefineParameters(dim[k], nev, &op,
+                            &ARBatchOp<ARFLOAT, ARFOP>::MultOPX,
+                            which, ncv, tol, maxit, NULL, nb);
+    nconv[k] = vecOK ? solver.FindEigenvectors() : solver.FindEigenvalues();
+    niter[k] = solver.GetIter();
+    if (nconv[k] > 0) {
+      val = solver.RawEigenvalues();
+      for (i=0; i<nconv[k]; i++) EigValR[size_t(k)*nval+i] = val[i];
+      StoreImag(solver, k);
+      if (vecOK) solver.CopyEigenvectors(&EigVec[offset[k]], dim[k]);
+    }
+  }
+  catch (const ArpackError&) {   // Problem k could not be solved.
+    nconv[k] = 0;
+  }
+  catch (const std::bad_alloc&) {
+    nconv[k] = 0;
+  }
+
+} // SolveProblem.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+void ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::Worker(int t, int nt)
+{
+
+  // The arena is created (and touched) by the thread that uses it, so
+  // its pages are placed on the memory of that thread (first touch).
+
+  ARArenaAllocator          arena(ArenaSize(), 64, false, true);
+  ARBatchOp<ARFLOAT, ARFOP> op;
+  ARSOLVER*                 solver;
+  int                       k;
+
+  // Solver constructors change the (global) ARPACK trace variables.
+
+#ifdef _OPENMP
+#pragma omp critical (ARBatchStdEig)
+#endif
+  solver = new ARSOLVER;
+
+  solver->SetAllocator(&arena);
+  while ((k = NextTask(t, nt)) >= 0) SolveProblem(*solver, op, k);
+  delete solver;
+
+} // Worker.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+int ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::AddProblem(int np, ARFOP* objOPp)
+{
+
+  offset.push_back(offset.empty() ? 0 :
+                   offset.back()+size_t(dim.back())*size_t(nval));
+  dim.push_back(np);
+  objOP.push_back(objOPp);
+  return Problems()-1;
+
+} // AddProblem.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+void ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::Clear()
+{
+
+  objOP.clear();
+  dim.clear();
+  offset.clear();
+  nconv.clear();
+  niter.clear();
+  EigValR.clear();
+  EigValI.clear();
+  EigVec.clear();
+  vecOK  = false;
+  tsolve = 0.0;
+
+} // Clear.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+int ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::Solve(bool ivec)
+{
+
+  int    nt, k, nok;
+  double t0;
+
+  // Creating the output arrays.
+
+  vecOK = ivec;
+  nconv.assign(Problems(), 0);
+  niter.assign(Problems(), 0);
+  EigValR.assign(size_t(Problems())*nval, ARFLOAT(0.0));
+  EigValI.assign(size_t(Problems())*nval, ARFLOAT(0.0));
+  EigVec.clear();
+  if (ivec && (Problems() > 0)) {
+    EigVec.resize(offset.back()+size_t(dim.back())*size_t(nval));
+  }
+
+  // Choosing the number of threads and filling the queues.
+
+#ifdef _OPENMP
+  nt = (nthreads > 0) ? nthreads : omp_get_max_threads();
+#else
+  nt = 1;
+#endif
+  if (nt > Problems()) nt = Problems();
+  if (nt < 1) nt = 1;
+  Schedule(nt);
+
+  // Solving all problems.
+
+  t0 = ARTime();
+
+#ifdef _OPENMP
+
+  int t;
+
+  lock = new omp_lock_t[nt];
+  for (t=0; t<nt; t++) omp_init_lock(&lock[t]);
+
+#pragma omp parallel num_threads(nt)
+  Worker(omp_get_thread_num(), omp_get_num_threads());
+
+  for (t=0; t<nt; t++) omp_destroy_lock(&lock[t]);
+  delete[] lock;
+
+#else
+
+  Worker(0, 1);
+
+#endif
+
+  tsolve = ARTime()-t0;
+
+  // Counting the problems that were solved.
+
+  nok = 0;
+  for (k=0; k<Problems(); k++) if (nconv[k] >= nev) nok++;
+  return nok;
+
+} // Solve.
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+inline ARFLOAT* ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::RawEigenvectors(int k)
+{
+
+  if (!vecOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawEigenvectors(k)");
+  }
+  return &EigVec[offset[k]];
+
+} // RawEigenvectors(k).
+
+
+template<class ARFLOAT, class ARFOP, class ARSOLVER>
+inline ARBatchStdEig<ARFLOAT, ARFOP, ARSOLVER>::
+ARBatchStdEig(int nevp, int nvalp, TypeOPx MultOPxp,
+              const std::string& whichp, int ncvp, ARFLOAT tolp, int maxitp)
+{
+
+  nev      = nevp;
+  nval     = nvalp;
+  MultOPx  = MultOPxp;
+  which    = whichp;
+  ncv      = ncvp;
+  tol      = tolp;
+  maxit    = maxitp;
+  nb       = 0;
+  nthreads = 0;
+  Clear();
+
+} // Constructor.
+
+
+// ARBatchSymStdEig class definition.
+
+template<class ARFLOAT, class ARFOP>
+class ARBatchSymStdEig:
+  public ARBatchStdEig<ARFLOAT, ARFOP,
+           ARbkSymStdEig<ARFLOAT, ARBatchOp<ARFLOAT, ARFOP> > > {
+
+ public:
+
+  typedef void (ARFOP::* TypeOPx)(ARFLOAT[], ARFLOAT[]);
+
+  ARBatchSymStdEig(int nevp, TypeOPx MultOPxp,
+                   const std::string& whichp = "LM", int ncvp = 0,
+                   ARFLOAT tolp = 0.0, int maxitp = 0):
+    ARBatchStdEig<ARFLOAT, ARFOP,
+      ARbkSymStdEig<ARFLOAT, ARBatchOp<ARFLOAT, ARFOP> > >
+      (nevp, nevp, MultOPxp, whichp, ncvp, tolp, maxitp) { }
+  // Constructor. MultOPxp is the member function of ARFOP that
+  // evaluates y <- OP*x for each problem.
+
+}; // class ARBatchSymStdEig.
+
+
+// ARBatchNonSymStdEig class definition.
+
+template<class ARFLOAT, class ARFOP>
+class ARBatchNonSymStdEig:
+  public ARBatchStdEig<ARFLOAT, ARFOP,
+           ARbkNonSymStdEig<ARFLOAT, ARBatchOp<ARFLOAT, ARFOP> > > {
+
+ public:
+
+  typedef void (ARFOP::* TypeOPx)(ARFLOAT[], ARFLOAT[]);
+
+  ARFLOAT* RawEigenvaluesImag(int k)
+  {
+    return &this->EigValI[size_t(k)*this->nval];
+  }
+  // Provides raw access to the imaginary part of the eigenvalues of
+  // problem k. As in ARrcNonSymStdEig, the eigenvectors associated
+  // with a complex conjugate pair are stored as two real vectors
+  // (the real and the imaginary part of the first one).
+
+  ARBatchNonSymStdEig(int nevp, TypeOPx MultOPxp,
+                      const std::string& whichp = "LM", int ncvp = 0,
+                      ARFLOAT tolp = 0.0, int maxitp = 0):
+    ARBatchStdEig<ARFLOAT, ARFOP,
+      ARbkNonSymStdEig<ARFLOAT, ARBatchOp<ARFLOAT, ARFOP> > >
+      (nevp, nevp+1, MultOPxp, whichp, ncvp, tolp, maxitp) { }
+  // Constructor.
+
+}; // class ARBatchNonSymStdEig.
+
+
+#endif // ARBATCH_H
+
@@ -0,0 +1,354 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARBFile.h
+   Binary matrix file format used by ARhbMatrix and ARdfMatrix.
+   A binary file contains a 64 byte heading (ARbfHeader) followed
+   by the matrix data, stored exactly as it is used by ARPACK++:
+
+   - sparse matrices: column pointers, row indices and values in
+     CSC format (zero based);
+   - dense matrices: values in column-major order or, if blksize
+     is not zero, in blocks of blksize rows (each block stored in
+     column-major order).
+
+   Each array begins at a 64 byte boundary, so the file may be
+   mapped into memory and used without copying. A checksum of all
+   data that follows the heading is stored in the heading.
+
+   ARPACK authors:
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+
+#ifndef ARBFILE_H
+#define ARBFILE_H
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "arch.h"
+#include "arcomp.h"
+#include "arerror.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+// Kind of matrix stored in a binary file.
+
+enum ARbfKind { ARbfSparse = 1, ARbfDense = 2 };
+
+
+// Type of the values stored in a binary file.
+
+enum ARbfValue { ARbfFloat = 1, ARbfDouble = 2,
+                 ARbfCompFloat = 3, ARbfCompDouble = 4 };
+
+
+// ARbfHeader struct definition.
+
+struct ARbfHeader {
+
+  char     magic[8];  // "ARPACK++".
+  unsigned version;   // Format version (1).
+  unsigned order;     // 0x01020304 written in the byte order of the writer.
+  unsigned kind;      // ARbfSparse or ARbfDense.
+  unsigned vtype;     // Type of the values (ARbfValue).
+  unsigned isize;     // Size of row indices and column pointers (bytes).
+  char     type[4];   // Harwell-Boeing matrix type ("RSA", "CUA", ...).
+  int      m;         // Number of rows.
+  int      n;         // Number of columns.
+  int      nnz;       // Number of nonzero elements (sparse matrices).
+  int      blksize;   // Rows per block (dense matrices, 0 = column-major).
+  unsigned sum1;      // Checksum of the data (sum of all 32 bit words).
+  unsigned sum2;      // Checksum of the data (sum of the partial sums).
+  unsigned reserved[2];
+
+}; // struct ARbfHeader.
+
+
+inline size_t ARbfAlign(size_t bytes) { return (bytes+63)&~size_t(63); }
+// Rounds bytes up to a multiple of 64.
+
+
+inline size_t ARbfValueSize(unsigned vtype)
+{
+
+  switch (vtype) {
+  case ARbfFloat:      return sizeof(float);
+  case ARbfDouble:     return sizeof(double);
+  case ARbfCompFloat:  return 2*sizeof(float);
+  case ARbfCompDouble: return 2*sizeof(double);
+  default:             return 0;
+  }
+
+} // ARbfValueSize.
+
+
+inline unsigned ARbfValueType(float*) { return ARbfFloat; }
+
+inline unsigned ARbfValueType(double*) { return ARbfDouble; }
+
+inline unsigned ARbfValueType(arcomplex<float>*) { return ARbfCompFloat; }
+
+inline unsigned ARbfValueType(arcomplex<double>*) { return ARbfCompDouble; }
+
+
+template<class ARFLOAT>
+bool ARbfCopyReal(const char* src, unsigned vtype, ARFLOAT* dst, size_t k)
+{
+
+  // Copies k real values of type vtype to dst.
+
+  size_t i;
+
+  if (vtype == ARbfFloat) {
+    const float* s = (const float*)src;
+    for (i=0; i<k; i++) dst[i] = (ARFLOAT)s[i];
+  }
+  else if (vtype == ARbfDouble) {
+    const double* s = (const double*)src;
+    for (i=0; i<k; i++) dst[i] = (ARFLOAT)s[i];
+  }
+  else {
+    return false;
+  }
+  return true;
+
+} // ARbfCopyReal.
+
+
+inline bool ARbfCopy(const char* src, unsigned vtype, float* dst, size_t k)
+{
+  return ARbfCopyReal(src, vtype, dst, k);
+}
+
+inline bool ARbfCopy(const char* src, unsigned vtype, double* dst, size_t k)
+{
+  return ARbfCopyReal(src, vtype, dst, k);
+}
+
+inline bool ARbfCopy(const char* src, unsigned vtype,
+                     arcomplex<float>* dst, size_t k)
+{
+  return (vtype > ARbfDouble) &&
+         ARbfCopyReal(src, vtype-2, (float*)dst, 2*k);
+}
+
+inline bool ARbfCopy(const char* src, unsigned vtype,
+                     arcomplex<double>* dst, size_t k)
+{
+  return (vtype > ARbfDouble) &&
+         ARbfCopyReal(src, vtype-2, (double*)dst, 2*k);
+}
+// Copies k values of type vtype stored in src to dst, converting
+// them to the type of dst. Returns false if a complex value would
+// be stored in a real array or vice-versa.
+
+
+inline void ARbfChecksum(const void* data, size_t bytes,
+                         unsigned& sum1, unsigned& sum2)
+{
+
+  // Updates the checksum with 32 bit words stored in data. Bytes
+  // must be a multiple of 4.
+
+  const unsigned* w = (const unsigned*)data;
+  size_t          i, k;
+
+  k = bytes/sizeof(unsigned);
+  for (i=0; i<k; i++) {
+    sum1 += w[i];
+    sum2 += sum1;
+  }
+
+} // ARbfChecksum.
+
+
+inline void ARbfInitHeader(ARbfHeader& head, unsigned kind, unsigned vtype,
+                           unsigned isize, const std::string& type,
+                           int m, int n, int nnz, int blksize)
+{
+
+  memset(&head, 0, sizeof(head));
+  memcpy(head.magic, "ARPACK++", 8);
+  head.version = 1;
+  head.order   = 0x01020304;
+  head.kind    = kind;
+  head.vtype   = vtype;
+  head.isize   = isize;
+  strncpy(head.type, type.c_str(), 3);
+  head.m       = m;
+  head.n       = n;
+  head.nnz     = nnz;
+  head.blksize = blksize;
+
+} // ARbfInitHeader.
+
+
+inline bool ARbfCheckHeader(const char* data, size_t size)
+{
+
+  // Returns true if data (the contents of a file of the given size)
+  // begins with a valid binary heading.
+
+  const ARbfHeader* head = (const ARbfHeader*)data;
+
+  return (size >= sizeof(ARbfHeader)) &&
+         (memcmp(head->magic, "ARPACK++", 8) == 0) &&
+         (head->version == 1) && (head->order == 0x01020304) &&
+         (ARbfValueSize(head->vtype) != 0) &&
+         (head->m > 0) && (head->n > 0) && (head->nnz >= 0) &&
+         (head->blksize >= 0);
+
+} // ARbfCheckHeader.
+
+
+inline bool ARbfIsBinary(const std::string& filename)
+{
+
+  // Returns true if filename is an ARPACK++ binary file.
+
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  char          magic[8];
+
+  return file.read(magic, 8) && (memcmp(magic, "ARPACK++", 8) == 0);
+
+} // ARbfIsBinary.
+
+
+inline void ARbfWrite(std::ofstream& file, const void* data, size_t bytes,
+                      unsigned& sum1, unsigned& sum2)
+{
+
+  // Writes an array to file, updating the checksum.
+
+  file.write((const char*)data, bytes);
+  ARbfChecksum(data, bytes, sum1, sum2);
+
+} // ARbfWrite.
+
+
+inline void ARbfPad(std::ofstream& file, size_t bytes,
+                    unsigned& sum1, unsigned& sum2)
+{
+
+  // Writes the zeros required to align an array of the given size
+  // to a 64 byte boundary.
+
+  char zero[64];
+
+  memset(zero, 0, 64);
+  ARbfWrite(file, zero, ARbfAlign(bytes)-bytes, sum1, sum2);
+
+} // ARbfPad.
+
+
+inline const char* ARbfMapFile(const std::string& filename, size_t& size,
+                               bool& mapped, bool writable = false)
+{
+
+  // Maps filename into memory (or reads the whole file if mmap is not
+  // available). When writable is true, the mapping is private, so the
+  // data may be changed in memory without changing the file. Returns
+  // NULL if the file cannot be read.
+
+  char* data;
+
+#if defined(__unix__) || defined(__APPLE__)
+
+  struct stat st;
+  void*       map;
+  int         fd;
+
+  fd = open(filename.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    map = MAP_FAILED;
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+      map = mmap(NULL, size_t(st.st_size),
+                 writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                 MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map != MAP_FAILED) {
+      size   = size_t(st.st_size);
+      mapped = true;
+      return (const char*)map;
+    }
+  }
+
+#endif
+
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+
+  mapped = false;
+  if (!file) return NULL;
+  file.seekg(0, std::ios::end);
+  size = size_t(file.tellg());
+  file.seekg(0, std::ios::beg);
+  data = new char[size+64];
+  if (!file.read(data, size)) size = size_t(file.gcount());
+  return data;
+
+} // ARbfMapFile.
+
+
+inline void ARbfUnmapFile(const char* data, size_t size, bool mapped)
+{
+
+  if (data == NULL) return;
+#if defined(__unix__) || defined(__APPLE__)
+  if (mapped) {
+    munmap((void*)data, size);
+    return;
+  }
+#endif
+  delete[] data;
+
+} // ARbfUnmapFile.
+
+
+inline void ARbfPrefetch(const char* data, size_t bytes)
+{
+
+  // Asks the system to read a region of a mapped file and waits until
+  // its pages are in memory.
+
+  const volatile char* p = data;
+  size_t               i;
+
+#if defined(__unix__) || defined(__APPLE__)
+  size_t page = size_t(sysconf(_SC_PAGESIZE));
+  size_t skip = size_t(data)%page;
+  madvise((void*)(data-skip), bytes+skip, MADV_WILLNEED);
+#else
+  size_t page = 4096;
+#endif
+  for (i=0; i<bytes; i+=page) p[i];
+
+} // ARbfPrefetch.
+
+
+inline bool ARbfInside(const void* p, const char* data, size_t size)
+{
+  return (data != NULL) && ((const char*)p >= data) &&
+         ((const char*)p < data+size);
+}
+// Returns true if p points to the memory region [data, data+size).
+
+
+#endif // ARBFILE_H
+
@@ -21,6 +21,7 @@
 #define ARBNSMAT_H
 
 #include <cstddef>
+#include <new>
 #include "arch.h"
 #include "armat.h"
 #include "arerror.h"
@@ -70,6 +71,9 @@ class ARbdNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
+  void MultMtV(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Computes Y = M'*X one column at a time.
+
   void MultMtMv(ARTYPE* v, ARTYPE* w);
 
   void MultMMtv(ARTYPE* v, ARTYPE* w);
@@ -78,6 +82,8 @@ class ARbdNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+
   void DefineMatrix(int np, int ndiagLp, int ndiagUp, ARTYPE* Ap);
 
   ARbdNonSymMatrix(): ARMatrix<ARTYPE>() { factored = false; }
@@ -184,8 +190,19 @@ inline void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::CreateStructure()
 {
 
   ClearMem();
-  Ainv = new ARTYPE[lda* this->n];
-  ipiv = new int[ this->n];
+  Ainv = NULL;
+  ipiv = NULL;
+  try {
+    Ainv = new ARTYPE[lda*this->n];
+    ipiv = new int[this->n];
+  }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    delete[] Ainv;
+    Ainv     = NULL;
+    factored = false;
+    throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                      "ARbdNonSymMatrix::FactorA");
+  }
 
 } // CreateStructure.
 
@@ -317,14 +334,58 @@ void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 } // MultMtv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMtV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  for (int k=0; k<nvec; k++) MultMtv(&X[k*this->m], &Y[k*this->n]);
+
+} // MultMtV.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[ this->m];
+  int     i, j, k, i0, i1, ld, lag;
+  ARTYPE  s;
+  ARTYPE* t;
+
+  // Quitting the function if A was not defined.
+
+  if (! this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARbdNonSymMatrix::MultMtMv");
+  }
 
-  MultMv(v,t);
-  MultMtv(t,w);
+  // Determining w = M'.M.v in a single pass over the columns of M.
+  // t = M.v is accumulated column by column. Row i of t is complete
+  // when column i+ndiagU is reached, so w[j] = M(:,j)'.t can be
+  // computed lag = ndiagL+ndiagU columns after column j was used,
+  // while it is still in cache.
+
+  ld  = ndiagL+ndiagU+1;
+  lag = ndiagL+ndiagU;
+  t   = new ARTYPE[this->m];
+  for (i=0; i!=this->m; i++) t[i] = (ARTYPE)0;
+
+  for (k=0; k!=this->n+lag; k++) {
+    if (k < this->n) {
+      i0 = (k > ndiagU) ? k-ndiagU : 0;
+      i1 = (k+ndiagL < this->m) ? k+ndiagL : this->m-1;
+      s  = v[k];
+      for (i=i0; i<=i1; i++) t[i] += s*A[ndiagU+i-k+k*ld];
+    }
+    j = k-lag;
+    if (j >= 0) {
+      i0 = (j > ndiagU) ? j-ndiagU : 0;
+      i1 = (j+ndiagL < this->m) ? j+ndiagL : this->m-1;
+      s  = (ARTYPE)0;
+      for (i=i0; i<=i1; i++) s += A[ndiagU+i-j+j*ld]*t[i];
+      w[j] = s;
+    }
+  }
 
   delete[] t;
 
@@ -335,12 +396,31 @@ template<class ARTYPE, class ARFLOAT>
 void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[ this->n];
+  int     i, j, i0, i1, ld;
+  ARTYPE  s;
+  ARTYPE* Aj;
 
-  MultMtv(v,t);
-  MultMv(t,w);
+  // Quitting the function if A was not defined.
 
-  delete[] t;
+  if (! this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARbdNonSymMatrix::MultMMtv");
+  }
+
+  // Determining w = M.M'.v. Each column of M is used twice while it is
+  // still in cache: s = M(:,j)'.v is computed and s*M(:,j) is added to w.
+
+  ld = ndiagL+ndiagU+1;
+  for (i=0; i!=this->m; i++) w[i] = (ARTYPE)0;
+
+  for (j=0; j!=this->n; j++) {
+    i0 = (j > ndiagU) ? j-ndiagU : 0;
+    i1 = (j+ndiagL < this->m) ? j+ndiagL : this->m-1;
+    Aj = &A[ndiagU-j+j*ld];
+    s  = (ARTYPE)0;
+    for (i=i0; i<=i1; i++) s += Aj[i]*v[i];
+    for (i=i0; i<=i1; i++) w[i] += s*Aj[i];
+  }
 
 } // MultMMtv.
 
@@ -381,6 +461,33 @@ void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::
+MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARbdNonSymMatrix::MultInvV");
+  }
+
+  // Overwritting Y with X.
+
+  if (X != Y) copy(this->n*nrhs, X, 1, Y, 1);
+
+  // Solving A.Y = X (or AsI.Y = X).
+
+  gbtrs("N", this->n, ndiagL, ndiagU, nrhs, Ainv, lda, ipiv, Y, this->m, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvV.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int np, int ndiagLp, int ndiagUp, ARTYPE* Ap)
@@ -85,7 +85,9 @@ inline void ARluCompStdEig<ARFLOAT>::
 ChangeShift(arcomplex<ARFLOAT> sigmaRp)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsI(sigmaRp);
+  this->StopFactor();
   ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> >::ChangeShift(sigmaRp);
 
 } // ChangeShift.
@@ -111,6 +113,7 @@ SetShiftInvertMode(arcomplex<ARFLOAT> sigmap)
            ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP,
                        &ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -144,6 +147,7 @@ ARluCompStdEig(int nevp, ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
                    &ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
@@ -21,6 +21,7 @@
 #define ARBSMAT_H
 
 #include <cstddef>
+#include <new>
 #include "arch.h"
 #include "armat.h"
 #include "arerror.h"
@@ -69,6 +70,8 @@ class ARbdSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+
   void DefineMatrix(int np, int nsdiagp, ARTYPE* Ap, char uplop = 'L');
 
   ARbdSymMatrix(): ARMatrix<ARTYPE>() { factored = false; }
@@ -198,8 +201,19 @@ inline void ARbdSymMatrix<ARTYPE>::CreateStructure()
 {
 
   ClearMem();
-  Ainv = new ARTYPE[lda*this->n];
-  ipiv = new int[this->n];
+  Ainv = NULL;
+  ipiv = NULL;
+  try {
+    Ainv = new ARTYPE[lda*this->n];
+    ipiv = new int[this->n];
+  }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    delete[] Ainv;
+    Ainv     = NULL;
+    factored = false;
+    throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                      "ARbdSymMatrix::FactorA");
+  }
 
 } // CreateStructure.
 
@@ -328,6 +342,32 @@ void ARbdSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARbdSymMatrix<ARTYPE>::MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARbdSymMatrix::MultInvV");
+  }
+
+  // Overwritting Y with X.
+
+  if (X != Y) copy(this->n*nrhs, X, 1, Y, 1);
+
+  // Solving A.Y = X (or AsI.Y = X).
+
+  gbtrs("N", this->n, nsdiag, nsdiag, nrhs, Ainv, lda, ipiv, Y, this->m, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvV.
+
+
 template<class ARTYPE>
 inline void ARbdSymMatrix<ARTYPE>::
 DefineMatrix(int np, int nsdiagp, ARTYPE* Ap, char uplop)
@@ -87,7 +87,9 @@ ChangeShift(ARFLOAT sigmaRp)
    this->mode      = 3;
    this->iparam[7] =  this->mode;
 
+   this->StartFactor();
    this->objOP->FactorAsI( this->sigmaR);
+   this->StopFactor();
    this->Restart();
 
 } // ChangeShift.
@@ -110,6 +112,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARbdNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap,  this->objOP, 
                        &ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -142,6 +145,7 @@ ARluNonSymStdEig(int nevp, ARbdNonSymMatrix<ARFLOAT, ARFLOAT>& A,
                    &ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
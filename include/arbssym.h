@@ -87,7 +87,9 @@ ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -109,6 +111,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARbdSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARbdSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARbdSymMatrix<ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -138,6 +141,7 @@ ARluSymStdEig(int nevp, ARbdSymMatrix<ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, &ARbdSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARbdSymMatrix<ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
@@ -54,6 +54,36 @@
                   // to be considered "dense". Dense columns have more
                   // than max{0,UMFABDEN,UMFREDEN*sqrt(n)} elements.
 
+// Storage class of variables that must be private to each thread
+// (such as the error code stored by ArpackError).
+
+#if (__cplusplus >= 201103L)
+  #define ARTHREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+  #define ARTHREAD_LOCAL __declspec(thread)
+#else
+  #define ARTHREAD_LOCAL __thread
+#endif
+
+// Block size of the Krylov-Schur engine used by default by the standard
+// problem classes (see ARStdEig::SetKrylovSchur). ARKSBLOCK = 0 selects
+// the default block size. If ARKSBLOCK is negative (or not defined in
+// the compiler command line, e.g. -DARKSBLOCK=4), the FORTRAN ARPACK
+// routines are used by default.
+
+#ifndef ARKSBLOCK
+#define ARKSBLOCK -1
+#endif
+
+// Number of matrix entries that are expected to fit in cache. Dense
+// matrices stored in memory are split into panels of (at most)
+// ARCACHEBLK entries when M*M'*v is computed, so each panel is used
+// twice while it is still in cache.
+
+#ifndef ARCACHEBLK
+#define ARCACHEBLK 262144
+#endif
+
 // Line length used when reading a dense matrix from a file.
 
 #define LINELEN 256
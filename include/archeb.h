@@ -0,0 +1,453 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARCheb.h.
+   Arpack++ class ARChebyshevOp definition.
+   ARChebyshevOp is a matrix whose product with a vector is
+   p(A)*v, where p is a Chebyshev polynomial approximation of
+   degree d (with Jackson damping) to the indicator function of
+   an interval [a, b] of the spectrum of a real symmetric matrix
+   A. Only the products A*v are used, so A may be any class that
+   has a MultMv member function (an ARMatrix, for example).
+
+   Used as the operator of ARSymStdEig (or ARbkSymStdEig) in
+   regular mode with which = "LA", this class makes the Lanczos
+   method converge to the eigenvectors of A associated with the
+   eigenvalues that lie in [a, b] (or to the smallest eigenvalues
+   of A) without factoring any matrix. The eigenvalues of A are
+   recovered from the eigenvectors by Rayleigh quotients.
+
+   The bounds of the spectrum of A, required to map it onto
+   [-1, 1], are estimated by a few steps of the Lanczos method.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARCHEB_H
+#define ARCHEB_H
+
+#include <cmath>
+#include <cstddef>
+#include "arch.h"
+#include "arerror.h"
+#include "armat.h"
+#include "blas1c.h"
+#include "lapackc.h"
+
+
+template<class ARFLOAT, class ARMATRIX = ARMatrix<ARFLOAT> >
+class ARChebyshevOp: public ARMatrix<ARFLOAT> {
+
+ protected:
+
+  ARMATRIX* A;      // Matrix whose spectrum is filtered.
+  int       degree; // Degree of the polynomial.
+  ARFLOAT   lmin;   // Lower bound of the spectrum of A.
+  ARFLOAT   lmax;   // Upper bound of the spectrum of A.
+  ARFLOAT   lower;  // Lower end of the interval that is kept.
+  ARFLOAT   upper;  // Upper end of the interval that is kept.
+  ARFLOAT*  coef;   // Damped Chebyshev coefficients (degree+1).
+  ARFLOAT*  y0;     // Work vectors used by the three-term recurrence.
+  ARFLOAT*  y1;
+  ARFLOAT*  y2;
+  long      nprod;  // Number of products A*v performed.
+
+  void ClearMem();
+  // Deletes the coefficients and the work vectors.
+
+  void Scale(ARFLOAT* x, ARFLOAT* y, ARFLOAT* z, ARFLOAT alpha);
+  // Stores alpha*((A-cI)/e)*y - z in x, where c and e are the center
+  // and the half width of [lmin, lmax]. z may be NULL.
+
+ public:
+
+  bool BoundsDefined() { return lmax > lmin; }
+  // Indicates if the bounds of the spectrum of A were defined.
+
+  bool FilterDefined() { return coef != NULL; }
+  // Indicates if the polynomial was defined.
+
+  ARFLOAT GetLowerBound() { return lmin; }
+  // Returns the lower bound of the spectrum of A.
+
+  ARFLOAT GetUpperBound() { return lmax; }
+  // Returns the upper bound of the spectrum of A.
+
+  ARFLOAT GetLower() { return lower; }
+  // Returns the lower end of the interval kept by the filter.
+
+  ARFLOAT GetUpper() { return upper; }
+  // Returns the upper end of the interval kept by the filter.
+
+  int GetDegree() { return degree; }
+  // Returns the degree of the polynomial.
+
+  long GetProducts() { return nprod; }
+  // Returns the number of products A*v performed so far.
+
+  void ResetProducts() { nprod = 0; }
+  // Sets the number of products A*v to zero.
+
+  void SetBounds(ARFLOAT lminp, ARFLOAT lmaxp);
+  // Defines the bounds of the spectrum of A. Eigenvalues that lie
+  // outside [lminp, lmaxp] are amplified by the filter, so these
+  // bounds must contain the whole spectrum.
+
+  void EstimateBounds(int steps = 20);
+  // Estimates the bounds of the spectrum of A by "steps" steps of the
+  // Lanczos method. The extreme Ritz values are widened by the norm of
+  // the corresponding residual and by one percent of the width of the
+  // spectrum.
+
+  void DefineInterval(ARFLOAT a, ARFLOAT b, int degreep);
+  // Defines a filter of degree degreep that keeps the eigenvalues of A
+  // that lie in [a, b]. The bounds of the spectrum are estimated if
+  // they were not defined by SetBounds.
+
+  void DefineSmallest(ARFLOAT cut, int degreep);
+  // Defines a filter of degree degreep that keeps the eigenvalues of A
+  // that are smaller than cut.
+
+  ARFLOAT FilterValue(ARFLOAT lambda);
+  // Returns p(lambda).
+
+  void MultMv(ARFLOAT* v, ARFLOAT* w);
+  // Filtered matrix-vector product: w <- p(A)*v.
+
+  ARFLOAT RayleighQuotient(ARFLOAT* x);
+  // Returns x'*A*x/x'*x.
+
+  void Eigenvalues(int nvec, ARFLOAT* X, ARFLOAT* val);
+  // Stores in val the Rayleigh quotients of the nvec vectors stored
+  // sequentially in X (the eigenvalues of A associated with the
+  // eigenvectors of p(A) found by ARPACK).
+
+  ARChebyshevOp(int np, ARMATRIX* Ap);
+  // Constructor.
+
+  virtual ~ARChebyshevOp() { ClearMem(); }
+  // Destructor.
+
+ private:
+
+  ARChebyshevOp(const ARChebyshevOp& other);
+
+  ARChebyshevOp& operator=(const ARChebyshevOp& other);
+
+}; // class ARChebyshevOp.
+
+
+// ------------------------------------------------------------------------ //
+// ARChebyshevOp member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARMATRIX>
+inline void ARChebyshevOp<ARFLOAT, ARMATRIX>::ClearMem()
+{
+
+  if (coef != NULL) delete[] coef;
+  if (y0 != NULL) delete[] y0;
+  if (y1 != NULL) delete[] y1;
+  if (y2 != NULL) delete[] y2;
+  coef = y0 = y1 = y2 = NULL;
+
+} // ClearMem.
+
+
+template<class ARFLOAT, class ARMATRIX>
+void ARChebyshevOp<ARFLOAT, ARMATRIX>::
+Scale(ARFLOAT* x, ARFLOAT* y, ARFLOAT* z, ARFLOAT alpha)
+{
+
+  int     i, n;
+  ARFLOAT c, s;
+
+  n = this->n;
+  c = (lmax+lmin)/ARFLOAT(2);
+  s = alpha*ARFLOAT(2)/(lmax-lmin);
+
+  A->MultMv(y, x);
+  nprod++;
+  if (z == NULL) {
+    for (i=0; i<n; i++) x[i] = s*(x[i]-c*y[i]);
+  }
+  else {
+    for (i=0; i<n; i++) x[i] = s*(x[i]-c*y[i])-z[i];
+  }
+
+} // Scale.
+
+
+template<class ARFLOAT, class ARMATRIX>
+inline void ARChebyshevOp<ARFLOAT, ARMATRIX>::
+SetBounds(ARFLOAT lminp, ARFLOAT lmaxp)
+{
+
+  if (lmaxp <= lminp) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "ARChebyshevOp::SetBounds");
+  }
+  lmin = lminp;
+  lmax = lmaxp;
+
+} // SetBounds.
+
+
+template<class ARFLOAT, class ARMATRIX>
+void ARChebyshevOp<ARFLOAT, ARMATRIX>::EstimateBounds(int steps)
+{
+
+  // Lanczos method without reorthogonalization, started from a random
+  // vector. The extreme Ritz values converge fast and, for a Ritz pair
+  // (theta, s) of T, |beta_k*s_k| bounds the distance from theta to the
+  // nearest eigenvalue of A.
+
+  int           i, j, k, n, lwork, info;
+  unsigned long seed;
+  ARFLOAT       alpha, beta, norm, rlow, rupp, width;
+  ARFLOAT       *v, *vold, *w, *tmp, *T, *theta, *work, *diag, *offd;
+
+  n = this->n;
+  if (steps > n) steps = n;
+  if (steps < 1) steps = 1;
+
+  diag  = new ARFLOAT[steps];
+  offd  = new ARFLOAT[steps];
+  vold  = y0;
+  v     = y1;
+  w     = y2;
+
+  seed = 1;
+  for (i=0; i<n; i++) {
+    seed = (seed*1103515245UL+12345UL)&0x7fffffffUL;
+    v[i] = ARFLOAT(2.0)*ARFLOAT(seed)/ARFLOAT(0x7fffffffUL)-ARFLOAT(1.0);
+    vold[i] = ARFLOAT(0.0);
+  }
+  norm = ARFLOAT(1.0)/nrm2(n, v, 1);
+  scal(n, norm, v, 1);
+
+  beta = ARFLOAT(0.0);
+  for (k=0; k<steps; ) {
+    A->MultMv(v, w);
+    nprod++;
+    axpy(n, -beta, vold, 1, w, 1);
+    alpha = dot(n, v, 1, w, 1);
+    axpy(n, -alpha, v, 1, w, 1);
+    beta  = nrm2(n, w, 1);
+    diag[k] = alpha;
+    offd[k++] = beta;
+    if (beta <= ARFLOAT(1e-10)*(std::fabs(alpha)+ARFLOAT(1.0))) break;
+    norm = ARFLOAT(1.0)/beta;
+    scal(n, norm, w, 1);
+    tmp = vold; vold = v; v = w; w = tmp;
+  }
+
+  // Eigenvalues and eigenvectors of the tridiagonal matrix T.
+
+  lwork = 3*k;
+  T     = new ARFLOAT[k*k];
+  theta = new ARFLOAT[k];
+  work  = new ARFLOAT[lwork];
+  for (i=0; i<k*k; i++) T[i] = ARFLOAT(0.0);
+  for (j=0; j<k; j++) {
+    T[j*k+j] = diag[j];
+    if (j+1 < k) T[j*k+j+1] = T[(j+1)*k+j] = offd[j];
+  }
+  syev("V", "L", k, T, k, theta, work, lwork, info);
+  if (info != 0) {
+    delete[] diag; delete[] offd;
+    delete[] T; delete[] theta; delete[] work;
+    throw ArpackError(ArpackError::LAPACK_ERROR,
+                      "ARChebyshevOp::EstimateBounds");
+  }
+
+  rlow  = std::fabs(offd[k-1]*T[k-1]);
+  rupp  = std::fabs(offd[k-1]*T[(k-1)*k+k-1]);
+  width = theta[k-1]-theta[0]+rlow+rupp;
+  if (width <= ARFLOAT(0.0)) width = std::fabs(theta[0])+ARFLOAT(1.0);
+  lmin  = theta[0]-rlow-ARFLOAT(0.01)*width;
+  lmax  = theta[k-1]+rupp+ARFLOAT(0.01)*width;
+
+  delete[] diag;
+  delete[] offd;
+  delete[] T;
+  delete[] theta;
+  delete[] work;
+
+} // EstimateBounds.
+
+
+template<class ARFLOAT, class ARMATRIX>
+void ARChebyshevOp<ARFLOAT, ARMATRIX>::
+DefineInterval(ARFLOAT a, ARFLOAT b, int degreep)
+{
+
+  // The coefficients of the expansion of the indicator function of
+  // [a', b'] (a and b mapped onto [-1, 1]) in Chebyshev polynomials are
+  // multiplied by the Jackson damping factors, which remove the Gibbs
+  // oscillations near the ends of the interval.
+
+  const ARFLOAT pi = ARFLOAT(3.14159265358979323846);
+
+  int     k;
+  ARFLOAT c, e, ta, tb, alpha, g;
+
+  if ((degreep < 1) || (a >= b)) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR,
+                      "ARChebyshevOp::DefineInterval");
+  }
+  if (!BoundsDefined()) EstimateBounds();
+
+  degree = degreep;
+  lower  = a;
+  upper  = b;
+  if (coef != NULL) delete[] coef;
+  coef   = new ARFLOAT[degree+1];
+
+  c  = (lmax+lmin)/ARFLOAT(2);
+  e  = (lmax-lmin)/ARFLOAT(2);
+  ta = (a-c)/e;
+  tb = (b-c)/e;
+  if (ta < ARFLOAT(-1.0)) ta = ARFLOAT(-1.0);
+  if (tb > ARFLOAT(1.0)) tb = ARFLOAT(1.0);
+  if (ta > ARFLOAT(1.0)) ta = ARFLOAT(1.0);
+  if (tb < ARFLOAT(-1.0)) tb = ARFLOAT(-1.0);
+  ta = std::acos(ta);
+  tb = std::acos(tb);
+
+  alpha   = pi/ARFLOAT(degree+2);
+  coef[0] = (ta-tb)/pi;
+  for (k=1; k<=degree; k++) {
+    g = ((ARFLOAT(1.0)-ARFLOAT(k)/ARFLOAT(degree+2))*std::sin(alpha)*
+         std::cos(ARFLOAT(k)*alpha)+std::cos(alpha)*
+         std::sin(ARFLOAT(k)*alpha)/ARFLOAT(degree+2))/std::sin(alpha);
+    coef[k] = g*ARFLOAT(2.0)*(std::sin(ARFLOAT(k)*ta)-
+                              std::sin(ARFLOAT(k)*tb))/(ARFLOAT(k)*pi);
+  }
+
+} // DefineInterval.
+
+
+template<class ARFLOAT, class ARMATRIX>
+inline void ARChebyshevOp<ARFLOAT, ARMATRIX>::
+DefineSmallest(ARFLOAT cut, int degreep)
+{
+
+  if (!BoundsDefined()) EstimateBounds();
+  DefineInterval(lmin, cut, degreep);
+
+} // DefineSmallest.
+
+
+template<class ARFLOAT, class ARMATRIX>
+ARFLOAT ARChebyshevOp<ARFLOAT, ARMATRIX>::FilterValue(ARFLOAT lambda)
+{
+
+  int     k;
+  ARFLOAT t, t0, t1, t2, p;
+
+  if (!FilterDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARChebyshevOp::FilterValue");
+  }
+  t  = (lambda-(lmax+lmin)/ARFLOAT(2))*ARFLOAT(2)/(lmax-lmin);
+  t0 = ARFLOAT(1.0);
+  t1 = t;
+  p  = coef[0]+coef[1]*t1;
+  for (k=2; k<=degree; k++) {
+    t2 = ARFLOAT(2.0)*t*t1-t0;
+    p += coef[k]*t2;
+    t0 = t1;
+    t1 = t2;
+  }
+  return p;
+
+} // FilterValue.
+
+
+template<class ARFLOAT, class ARMATRIX>
+void ARChebyshevOp<ARFLOAT, ARMATRIX>::MultMv(ARFLOAT* v, ARFLOAT* w)
+{
+
+  // Three-term recurrence T_{k+1}(B)v = 2*B*T_k(B)v - T_{k-1}(B)v, with
+  // B = (A-cI)/e. Each term costs one product A*v.
+
+  int     i, k, n;
+  ARFLOAT *t0, *t1, *t2, *tmp;
+
+  if (!FilterDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARChebyshevOp::MultMv");
+  }
+
+  n  = this->n;
+  t0 = y0;
+  t1 = y1;
+  t2 = y2;
+
+  Scale(t1, v, NULL, ARFLOAT(1.0));
+  for (i=0; i<n; i++) w[i] = coef[0]*v[i]+coef[1]*t1[i];
+  if (degree < 2) return;
+
+  Scale(t2, t1, v, ARFLOAT(2.0));
+  axpy(n, coef[2], t2, 1, w, 1);
+  for (k=3; k<=degree; k++) {
+    tmp = t0; t0 = t1; t1 = t2; t2 = tmp;
+    Scale(t2, t1, t0, ARFLOAT(2.0));
+    axpy(n, coef[k], t2, 1, w, 1);
+  }
+
+} // MultMv.
+
+
+template<class ARFLOAT, class ARMATRIX>
+ARFLOAT ARChebyshevOp<ARFLOAT, ARMATRIX>::RayleighQuotient(ARFLOAT* x)
+{
+
+  int n = this->n;
+
+  A->MultMv(x, y0);
+  nprod++;
+  return dot(n, x, 1, y0, 1)/dot(n, x, 1, x, 1);
+
+} // RayleighQuotient.
+
+
+template<class ARFLOAT, class ARMATRIX>
+inline void ARChebyshevOp<ARFLOAT, ARMATRIX>::
+Eigenvalues(int nvec, ARFLOAT* X, ARFLOAT* val)
+{
+
+  for (int j=0; j<nvec; j++) {
+    val[j] = RayleighQuotient(&X[size_t(j)*size_t(this->n)]);
+  }
+
+} // Eigenvalues.
+
+
+template<class ARFLOAT, class ARMATRIX>
+ARChebyshevOp<ARFLOAT, ARMATRIX>::ARChebyshevOp(int np, ARMATRIX* Ap):
+  ARMatrix<ARFLOAT>(np)
+{
+
+  A      = Ap;
+  degree = 0;
+  lmin   = lmax = ARFLOAT(0.0);
+  lower  = upper = ARFLOAT(0.0);
+  nprod  = 0;
+  coef   = NULL;
+  y0     = new ARFLOAT[np];
+  y1     = new ARFLOAT[np];
+  y2     = new ARFLOAT[np];
+  this->defined = true;
+
+} // Constructor.
+
+
+#endif // ARCHEB_H
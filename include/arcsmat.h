@@ -29,10 +29,12 @@
 #define ARCSMAT_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "armat.h"
 #include "arhbmat.h"
+#include "arspmv.h"
 #include "arerror.h"
 #include "cholmodc.h"
 //#include "blas1c.h"
@@ -40,6 +42,27 @@
 //#include "arlspdef.h"
 //#include "arlutil.h"
 #include <fstream>  
+#include "arfcache.h"
+
+
+inline std::size_t ARchFactorSize(cholmod_factor* f)
+{
+
+  // Returns the (approximate) memory taken by the factorization f of
+  // A-sigma*I (or A-sigma*B), in bytes.
+
+  std::size_t bytes;
+
+  if (f->is_super) {
+    bytes = f->xsize*sizeof(double)+f->ssize*sizeof(int);
+  }
+  else {
+    bytes = f->nzmax*(sizeof(double)+sizeof(int));
+  }
+  return bytes+4*f->n*sizeof(int);
+
+} // ARchFactorSize.
+
 
 template<class ARTYPE> class ARchSymPencil;
 
@@ -51,6 +74,7 @@ class ARchSymMatrix: public ARMatrix<ARTYPE> {
  protected:
 
   bool    factored;
+  bool    analyzed;
   char    uplo;
   int     nnz;
   int*    irow;
@@ -58,9 +82,18 @@ class ARchSymMatrix: public ARMatrix<ARTYPE> {
   double  threshold;
   ARTYPE* a;
   ARhbMatrix<int, ARTYPE> mat;
+  ARspSymMV<ARTYPE>       prod;
   cholmod_common c ;
   cholmod_sparse *A ; 
   cholmod_factor *L ; 
+  cholmod_dense  bsol;  // Header that points to the right-hand side.
+  cholmod_dense* xsol;  // Solution computed by cholmod_solve2.
+  cholmod_dense* ysol;  // Workspaces used by cholmod_solve2.
+  cholmod_dense* esol;
+  bool    shifted;
+  ARTYPE  sigmaf;
+  unsigned long version;
+  ARFactorCache<ARTYPE, cholmod_factor*, ARchSymMatrix<ARTYPE> > cache;
    
   bool DataOK();
 
@@ -68,25 +101,88 @@ class ARchSymMatrix: public ARMatrix<ARTYPE> {
 
   void ClearMem();
 
+  void FreeWorkspace();
+  // Releases xsol, ysol and esol.
+
+  void Solve(ARTYPE* X, ARTYPE* Y, int nrhs);
+  // Solves A.Y = X (or AsI.Y = X). xsol, ysol and esol are kept
+  // between calls, so no memory is allocated after the first one
+  // (unless nrhs is changed).
+
+  void FreeFactor(cholmod_factor*& f) { cholmod_free_factor(&f, &c); }
+
+  void ReleaseFactor();
+  // Stores a copy of L in the cache if L contains the factors of
+  // A-sigmaf*I. L itself is kept, since it also contains the symbolic
+  // analysis of A.
+
+  bool ReuseFactor(ARTYPE sigma);
+  // Returns true if L contains (or was taken from the cache and now
+  // contains) the factors of A-sigma*I.
+
  public:
 
   int nzeros() { return nnz; }
 
+  long MallocCount() { return long(c.malloc_count); }
+  // Returns the number of blocks currently allocated by CHOLMOD.
+
+  long MemoryInUse() { return long(c.memory_inuse); }
+  // Returns the number of bytes currently allocated by CHOLMOD.
+
   bool IsFactored() { return factored; }
 
   void FactorA();
 
   void FactorAsI(ARTYPE sigma);
 
+  void ClearSymbolic();
+  // Discards the symbolic analysis of A that was computed by the first
+  // call to FactorA or FactorAsI and is reused by the following ones
+  // (the current factorization is also discarded). Must be called if
+  // the sparsity pattern of A (irow, pcol) was changed after
+  // DefineMatrix. Changes in the values of A only require a call to
+  // ChangeValues.
+
+  void ChangeValues();
+  // Must be called when the values of A (but not its pattern) were
+  // changed after DefineMatrix. The factors of A-sigma*I computed
+  // before (including those stored in the cache) are discarded.
+
+  void SetFactorCache(int maxentries, std::size_t budget = 0);
+  // Keeps the factors of A-sigma*I computed for up to maxentries
+  // previous shifts, taking at most budget bytes (0 = no limit), so
+  // FactorAsI does not factor A-sigma*I again when one of these shifts
+  // is used. The least recently used factors are discarded first.
+  // maxentries = 0 (the default) disables the cache. The factors of
+  // the last shift are always reused if sigma is not changed.
+
+  int GetCacheEntries() { return cache.GetEntries(); }
+
+  std::size_t GetCacheMemory() { return cache.GetMemory(); }
+
+  int GetCacheHits() { return cache.GetHits(); }
+
+  int GetThreads() { return prod.GetThreads(); }
+
+  void ChangeThreads(int nthreadsp) { prod.ChangeThreads(nthreadsp); }
+  // Changes the number of threads used by MultMv (0 = OpenMP default).
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMV(ARTYPE* X, ARTYPE* Y, int nvec);
+
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+
   void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
                     int* pcolp, char uplop = 'L', double thresholdp = 0.1, 
                     bool check = true);
 
-  ARchSymMatrix(): ARMatrix<ARTYPE>() { factored = false; cholmod_start (&c) ;}
+  ARchSymMatrix(): ARMatrix<ARTYPE>()
+  { factored = false; analyzed = false; shifted = false; version = 0;
+    L = NULL; xsol = ysol = esol = NULL; cholmod_start (&c) ;}
   // Short constructor that does nothing.
 
   ARchSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
@@ -98,7 +194,10 @@ class ARchSymMatrix: public ARMatrix<ARTYPE> {
                 bool check = true);
   // Long constructor (Harwell-Boeing file).
 
-  ARchSymMatrix(const ARchSymMatrix& other) { cholmod_start (&c) ; Copy(other); }
+  ARchSymMatrix(const ARchSymMatrix& other)
+  { factored = false; analyzed = false; shifted = false; version = 0;
+    L = NULL; xsol = ysol = esol = NULL; cholmod_start (&c) ;
+    Copy(other); }
   // Copy constructor.
 
   virtual ~ARchSymMatrix() { ClearMem(); cholmod_finish (&c) ;}
@@ -152,9 +251,8 @@ template<class ARTYPE>
 void ARchSymMatrix<ARTYPE>::ClearMem()
 {
 
-  if (factored) {
-    cholmod_free_factor (&L, &c) ;
-  }
+  ClearSymbolic();
+  FreeWorkspace();
   if (this->defined) {
     //cholmod_free_sparse (&A, &c);
     //delete[] permc;
@@ -169,6 +267,110 @@ void ARchSymMatrix<ARTYPE>::ClearMem()
 } // ClearMem.
 
 
+template<class ARTYPE>
+inline void ARchSymMatrix<ARTYPE>::FreeWorkspace()
+{
+
+  if (xsol != NULL) cholmod_free_dense(&xsol, &c);
+  if (ysol != NULL) cholmod_free_dense(&ysol, &c);
+  if (esol != NULL) cholmod_free_dense(&esol, &c);
+  xsol = ysol = esol = NULL;
+
+} // FreeWorkspace.
+
+
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::ClearSymbolic()
+{
+
+  if (analyzed) {
+    cholmod_free_factor (&L, &c) ;
+    L = NULL;
+    analyzed = false;
+    factored = false;
+  }
+
+  // The factors stored in the cache are discarded as well.
+
+  cache.Clear();
+  shifted = false;
+
+} // ClearSymbolic.
+
+
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::ReleaseFactor()
+{
+
+  cholmod_factor* f;
+
+  if (factored && shifted && cache.Enabled()) {
+    f = L;
+    L = cholmod_copy_factor(f, &c);
+    cache.Store(sigmaf, version, f, ARchFactorSize(f));
+  }
+  factored = false;
+  shifted  = false;
+
+} // ReleaseFactor.
+
+
+template<class ARTYPE>
+bool ARchSymMatrix<ARTYPE>::ReuseFactor(ARTYPE sigma)
+{
+
+  cholmod_factor* f;
+
+  // Checking if L already contains the factors of A-sigma*I.
+
+  if (factored && shifted && (sigmaf == sigma)) return true;
+
+  // Looking for the factors of A-sigma*I in the cache.
+
+  if (!cache.Retrieve(sigma, version, f)) return false;
+
+  // Replacing L by the factors found in the cache (that also contain
+  // the symbolic analysis of A).
+
+  if (factored && shifted) {
+    cache.Store(sigmaf, version, L, ARchFactorSize(L));
+  }
+  else if (L != NULL) {
+    cholmod_free_factor(&L, &c);
+  }
+  L        = f;
+  analyzed = true;
+  factored = true;
+  shifted  = true;
+  sigmaf   = sigma;
+  return true;
+
+} // ReuseFactor.
+
+
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::ChangeValues()
+{
+
+  // L can no longer be reused by FactorAsI.
+
+  cache.Clear();
+  shifted = false;
+  version++;
+
+} // ChangeValues.
+
+
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::
+SetFactorCache(int maxentries, std::size_t budget)
+{
+
+  cache.Define(this, &ARchSymMatrix<ARTYPE>::FreeFactor, maxentries, budget);
+
+} // SetFactorCache.
+
+
 
 template<class ARTYPE>
 inline void ARchSymMatrix<ARTYPE>::Copy(const ARchSymMatrix<ARTYPE>& other)
@@ -189,13 +391,19 @@ inline void ARchSymMatrix<ARTYPE>::Copy(const ARchSymMatrix<ARTYPE>& other)
   pcol = other.pcol;
   threshold = other.threshold;
   a = other.a;
+  prod = other.prod;
   //c = other.c;
    
   A = cholmod_copy_sparse(other.A,&c);
 
-  if (L) cholmod_free_factor(&L,&c);
-  if (factored)
-    L = cholmod_copy_factor(other.L,&c);
+  analyzed = other.analyzed;
+  L = (analyzed) ? cholmod_copy_factor(other.L,&c) : NULL;
+
+  shifted = other.shifted;
+  sigmaf  = other.sigmaf;
+  version = 0;
+  cache.Define(this, &ARchSymMatrix<ARTYPE>::FreeFactor,
+               other.cache.GetMaxEntries(), other.cache.GetBudget());
 
 } // Copy.
 
@@ -213,12 +421,14 @@ void ARchSymMatrix<ARTYPE>::FactorA()
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARchSymMatrix::FactorA");
   }
 
-  // Deleting previous versions of L.
-  if (factored) {
-    cholmod_free_factor (&L, &c) ;
+  // Storing the previous factors in the cache.
+  ReleaseFactor();
+
+  // Analyzing A (only once, L is reused by the following calls).
+  if (!analyzed) {
+    L = cholmod_analyze (A, &c) ;
+    analyzed = true;
   }
-  
-  L = cholmod_analyze (A, &c) ;
   info = cholmod_factorize (A, L, &c) ;  
   
 
@@ -262,11 +472,19 @@ void ARchSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARchSymMatrix::FactorAsI");
   }
 
+  // Reusing the factors of A-sigma*I computed before, if possible.
+  if (ReuseFactor(sigma)) return;
 
-  // Deleting previous versions of L.
-  if (factored) {
-    cholmod_free_factor (&L, &c) ;
-  }  
+  // Storing the previous factors in the cache.
+  ReleaseFactor();
+
+  // Analyzing A (only once, L is reused by the following calls).
+  // The pattern of A-sigma*I is the pattern of A, since the diagonal
+  // of L is always stored.
+  if (!analyzed) {
+    L = cholmod_analyze (A, &c) ;
+    analyzed = true;
+  }
    
 //  FILE *fp ;
 //  fp = fopen ("A.mat", "w" ) ; 
@@ -276,10 +494,11 @@ void ARchSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
   double sigma2[2];
   sigma2[0] = -sigma;
   sigma2[1] = 0.0;
-  L = cholmod_analyze (A, &c) ;
   int info = cholmod_factorize_p (A,sigma2,NULL,0,L,&c) ;  
 
   factored = (info != 0);
+  shifted  = factored;
+  sigmaf   = sigma;
   
   if (c.status != CHOLMOD_OK)
   {
@@ -296,10 +515,6 @@ void ARchSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
 template<class ARTYPE>
 void ARchSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 {
-  //std::cout << "ARchSymMatrix::MultMv " << std::endl;
-
-  int    i, j, k;
-  ARTYPE t;
 
   // Quitting the function if A was not defined.
 
@@ -309,48 +524,54 @@ void ARchSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 
   // Determining w = M.v.
 
-  for (i=0; i!=this->m; i++) w[i]=(ARTYPE)0;
+  prod.MultMv(v, w);
 
-  if (uplo == 'U') {
+} // MultMv.
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i+1];
-      if ((k!=pcol[i])&&(irow[k-1]==i)) {
-        w[i] += t*a[k-1];
-        k--;
-      }
-      for (j=pcol[i]; j<k; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
 
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARchSymMatrix::MultMV");
   }
-  else {
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i];
-      if ((k!=pcol[i+1])&&(irow[k]==i)) {
-        w[i] += t*a[k];
-        k++;
-      }
-      for (j=k; j<pcol[i+1]; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
+  // Determining Y = M.X.
+
+  prod.MultMV(X, Y, nvec);
+
+} // MultMV.
+
+
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::Solve(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
 
+  // Making bsol point to X (data is not copied).
+
+  Set_Cholmod_Dense_Matrix(&bsol, this->n, nrhs, X);
+
+  // Solving the systems. cholmod_solve2 only allocates xsol, ysol and
+  // esol if they are not large enough (X and Y may be the same array,
+  // since the solution is written into xsol).
+
+  if (!cholmod_solve2(CHOLMOD_A, L, &bsol, NULL, &xsol, NULL,
+                      &ysol, &esol, &c)) {
+    throw ArpackError(ArpackError::INSUFICIENT_MEMORY,
+                      "ARchSymMatrix::Solve");
   }
 
-} // MultMv.
+  Get_Cholmod_Dense_Data(xsol, this->n*nrhs, Y);
+
+} // Solve.
 
 
 template<class ARTYPE>
 void ARchSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 {
-  //std::cout << "ARchSymMatrix::MultInvv " << std::endl;
 
   // Quitting the function if A (or AsI) was not factored.
 
@@ -360,29 +581,28 @@ void ARchSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
   }
 
   // Solving A.w = v (or AsI.w = v).
-  
-  //std::cout<< " b = [ " << v[0];
-  //for(int i=1;i<this->n;i++)
-  //  std::cout << " , " << v[i];
-  //std::cout<< " ]" <<std::endl;
-  
-  //create b from v (data is not copied!!)
-  cholmod_dense * b = Create_Cholmod_Dense_Matrix(this->n,1,v,&c);
 
-  cholmod_dense *x = cholmod_solve (CHOLMOD_A, L, b, &c) ;
+  Solve(v, w, 1);
+
+} // MultInvv.
 
-  Get_Cholmod_Dense_Data(x, this->n, w);
 
-  //std::cout<< " x = [ " << w[0];
-  //for(int i=1;i<this->n;i++)
-  //  std::cout << " , " << w[i];
-  //std::cout<< " ]" <<std::endl;
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
 
-  free(b);
-  cholmod_free_dense(&x,&c);
-    
+  // Quitting the function if A (or AsI) was not factored.
 
-} // MultInvv.
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARchSymMatrix::MultInvV");
+  }
+
+  // Solving A.Y = X (or AsI.Y = X) for all columns at once.
+
+  Solve(X, Y, nrhs);
+
+} // MultInvV.
 
 
 template<class ARTYPE>
@@ -391,6 +611,10 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
              char uplop, double thresholdp, bool check)
 {
 
+  // Discarding the symbolic analysis of the previous matrix.
+  ClearSymbolic();
+  version++;
+
   this->m   = np;
   this->n   = np;
   nnz       = nnzp;
@@ -410,6 +634,10 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
   // Creating SuperMatrix A.
   A = Create_Cholmod_Sparse_Matrix(this->n, this->n, nnz, a, irow, pcol, uplo, &c);
 
+  // Preparing the matrix-vector product.
+
+  prod.Define(this->n, a, irow, pcol, uplo);
+
   this->defined = true;
 
 } // DefineMatrix.
@@ -424,6 +652,11 @@ ARchSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
  cholmod_start (&c) ;
 
   factored = false;
+  analyzed = false;
+  shifted  = false;
+  version  = 0;
+  L = NULL;
+  xsol = ysol = esol = NULL;
   DefineMatrix(np, nnzp, ap, irowp, pcolp, uplop, thresholdp, check);
 
 } // Long constructor.
@@ -436,6 +669,11 @@ ARchSymMatrix(const std::string& file, double thresholdp, bool check)
  cholmod_start (&c) ;
 
   factored = false;
+  analyzed = false;
+  shifted  = false;
+  version  = 0;
+  L = NULL;
+  xsol = ysol = esol = NULL;
 
   try {
     mat.Define(file);
@@ -443,6 +681,10 @@ ARchSymMatrix(const std::string& file, double thresholdp, bool check)
   catch (ArpackError) {    // Returning from here if an error has occurred.
     throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARchSymMatrix");
   }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "ARchSymMatrix");
+    throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARchSymMatrix");
+  }
 
   if ((mat.NCols() == mat.NRows()) && (mat.IsSymmetric())) {
 
@@ -43,9 +43,31 @@ class ARchSymPencil
   cholmod_factor *LAsB ; 
   bool    factoredAsB;
   cholmod_common c ;
+  cholmod_dense  bsol;  // Header that points to the right-hand side.
+  cholmod_dense* xsol;  // Solution computed by cholmod_solve2.
+  cholmod_dense* ysol;  // Workspaces used by cholmod_solve2.
+  cholmod_dense* esol;
+  ARTYPE  sigmaf;
+  unsigned long fversion;
+  ARFactorCache<ARTYPE, cholmod_factor*, ARchSymPencil<ARTYPE> > cache;
 
   virtual void Copy(const ARchSymPencil& other);
 
+  void FreeWorkspace();
+  // Releases xsol, ysol and esol.
+
+  unsigned long Version() { return A->version+B->version; }
+
+  void FreeFactor(cholmod_factor*& f) { cholmod_free_factor(&f, &c); }
+
+  void ReleaseFactor();
+  // Moves LAsB to the cache, or deletes it if the cache is disabled.
+
+  bool ReuseFactor(ARTYPE sigma, bool ldl);
+  // Returns true if LAsB contains (or was taken from the cache and now
+  // contains) the factors of A-sigma*B. If ldl is true, only simplicial
+  // LDL' factorizations are accepted.
+
 //  void SparseSaxpy(ARTYPE a, ARTYPE x[], int xind[], int nx, ARTYPE y[],
 //                   int yind[], int ny, ARTYPE z[], int zind[], int& nz);
 
@@ -59,6 +81,13 @@ class ARchSymPencil
 
   void FactorAsB(ARTYPE sigma);
 
+  int Inertia(ARTYPE sigma);
+  // Computes the LDL' decomposition of A-sigma*B and returns the number
+  // of negative elements of D, that is, the number of eigenvalues of
+  // (A,B) that are smaller than sigma (B must be positive definite).
+  // Unlike FactorAsB, sigma may lie inside the spectrum. The
+  // factorization can be used by MultInvAsBv.
+
   void MultAv(ARTYPE* v, ARTYPE* w) { A->MultMv(v,w); }
 
   void MultBv(ARTYPE* v, ARTYPE* w) { B->MultMv(v,w); }
@@ -67,18 +96,37 @@ class ARchSymPencil
 
   void MultInvAsBv(ARTYPE* v, ARTYPE* w);
 
+  void SetFactorCache(int maxentries, std::size_t budget = 0);
+  // Keeps the factors of A-sigma*B computed for up to maxentries
+  // previous shifts, taking at most budget bytes (0 = no limit), so
+  // FactorAsB and Inertia do not factor A-sigma*B again when one of
+  // these shifts is used. maxentries = 0 disables the cache. The
+  // factors of the last shift are always reused if sigma, A and B
+  // are not changed (see ARchSymMatrix::ChangeValues).
+
+  int GetCacheEntries() { return cache.GetEntries(); }
+
+  std::size_t GetCacheMemory() { return cache.GetMemory(); }
+
+  int GetCacheHits() { return cache.GetHits(); }
+
   void DefineMatrices(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp);
 
-  ARchSymPencil() { factoredAsB = false; A=NULL; B=NULL; LAsB=NULL; cholmod_start (&c) ; }
+  ARchSymPencil()
+  { factoredAsB = false; A=NULL; B=NULL; LAsB=NULL;
+    xsol = ysol = esol = NULL; cholmod_start (&c) ; }
   // Short constructor that does nothing.
 
   ARchSymPencil(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp);
   // Long constructor.
 
-  ARchSymPencil(const ARchSymPencil& other) { cholmod_start (&c) ; Copy(other); }
+  ARchSymPencil(const ARchSymPencil& other)
+  { LAsB=NULL; xsol = ysol = esol = NULL; cholmod_start (&c) ; Copy(other); }
   // Copy constructor.
 
-  virtual ~ARchSymPencil() {  if (LAsB) cholmod_free_factor(&LAsB,&c);  cholmod_finish (&c) ;}
+  virtual ~ARchSymPencil()
+  { cache.Clear(); if (LAsB) cholmod_free_factor(&LAsB,&c);
+    FreeWorkspace(); cholmod_finish (&c) ;}
   // Destructor.
 
   ARchSymPencil& operator=(const ARchSymPencil& other);
@@ -100,9 +148,74 @@ inline void ARchSymPencil<ARTYPE>::Copy(const ARchSymPencil<ARTYPE>& other)
   factoredAsB = other.factoredAsB;
   if (factoredAsB)
     LAsB = cholmod_copy_factor(other.LAsB,&c);
+  sigmaf   = other.sigmaf;
+  fversion = other.fversion;
+  cache.Define(this, &ARchSymPencil<ARTYPE>::FreeFactor,
+               other.cache.GetMaxEntries(), other.cache.GetBudget());
 
 } // Copy.
 
+
+template<class ARTYPE>
+inline void ARchSymPencil<ARTYPE>::FreeWorkspace()
+{
+
+  if (xsol != NULL) cholmod_free_dense(&xsol, &c);
+  if (ysol != NULL) cholmod_free_dense(&ysol, &c);
+  if (esol != NULL) cholmod_free_dense(&esol, &c);
+  xsol = ysol = esol = NULL;
+
+} // FreeWorkspace.
+
+
+template<class ARTYPE>
+void ARchSymPencil<ARTYPE>::ReleaseFactor()
+{
+
+  if (factoredAsB && cache.Enabled()) {
+    cache.Store(sigmaf, fversion, LAsB, ARchFactorSize(LAsB));
+    LAsB = NULL;
+  }
+  else if (LAsB) {
+    cholmod_free_factor(&LAsB,&c);
+  }
+  factoredAsB = false;
+
+} // ReleaseFactor.
+
+
+template<class ARTYPE>
+bool ARchSymPencil<ARTYPE>::ReuseFactor(ARTYPE sigma, bool ldl)
+{
+
+  cholmod_factor* f;
+
+  // Checking if LAsB already contains the factors of A-sigma*B.
+
+  if (factoredAsB && (sigmaf == sigma) && (fversion == Version()) &&
+      (!ldl || !(LAsB->is_ll || LAsB->is_super))) {
+    return true;
+  }
+
+  // Looking for the factors of A-sigma*B in the cache.
+
+  if (!cache.Retrieve(sigma, Version(), f)) return false;
+  if (ldl && (f->is_ll || f->is_super)) {
+    cholmod_free_factor(&f,&c);
+    return false;
+  }
+
+  // Replacing LAsB by the factors found in the cache.
+
+  ReleaseFactor();
+  LAsB        = f;
+  factoredAsB = true;
+  sigmaf      = sigma;
+  fversion    = Version();
+  return true;
+
+} // ReuseFactor.
+
 /*
 template<class ARTYPE>
 void ARchSymPencil<ARTYPE>::
@@ -309,8 +422,11 @@ void ARchSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
                       "ARchSymPencil::FactorAsB");
   }
 
+  // Reusing the factors of A-sigma*B computed before, if possible.
+  if (ReuseFactor(sigma, false)) return;
 
-  if (LAsB) cholmod_free_factor(&LAsB,&c);
+  // Deleting the previous factors (or storing them in the cache).
+  ReleaseFactor();
 
   cholmod_sparse* AsB;
   if (sigma != 0.0)
@@ -337,6 +453,8 @@ void ARchSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   int info = cholmod_factorize (AsB, LAsB, &c) ;  
 
   factoredAsB = (info != 0);  
+  sigmaf      = sigma;
+  fversion    = Version();
   if (c.status != CHOLMOD_OK)
   {
     //std::cout << " sigma : " << sigma << std::endl;
@@ -356,6 +474,77 @@ void ARchSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
 } // FactorAsB (ARTYPE shift).
 
 
+template<class ARTYPE>
+int ARchSymPencil<ARTYPE>::Inertia(ARTYPE sigma)
+{
+
+  // Quitting the function if A and B were not defined.
+
+  if (!(A->IsDefined()&&B->IsDefined())) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARchSymPencil::Inertia");
+  }
+
+  // Reusing an LDL' factorization of A-sigma*B computed before, if
+  // possible.
+
+  if (!ReuseFactor(sigma, true)) {
+
+    // Deleting the previous factors (or storing them in the cache).
+
+    ReleaseFactor();
+
+    cholmod_sparse* AsB;
+    if (sigma != 0.0)
+    {
+      double alpha[2]; alpha[0]=1.0; alpha[1] = 1.0;
+      double beta[2]; beta[0] = -sigma; beta[1]=1.0;
+      AsB = cholmod_add(A->A,B->A,alpha,beta,1,0,&c);
+    }
+    else
+      AsB = A->A;
+
+    // A simplicial LDL' factorization is used, since supernodal
+    // factorizations are always LL'.
+
+    int supernodal = c.supernodal;
+    int final_ll   = c.final_ll;
+    c.supernodal = CHOLMOD_SIMPLICIAL;
+    c.final_ll   = 0;
+
+    LAsB = cholmod_analyze (AsB, &c) ;
+    cholmod_factorize (AsB, LAsB, &c) ;
+
+    c.supernodal = supernodal;
+    c.final_ll   = final_ll;
+
+    if (sigma != 0.0)
+      cholmod_free_sparse(&AsB,&c);
+
+    // Sigma is (numerically) an eigenvalue if a pivot is zero.
+
+    if ((c.status != CHOLMOD_OK) || LAsB->is_ll || LAsB->is_super)
+    {
+      throw ArpackError(ArpackError::MATRIX_IS_SINGULAR,
+                        "ARchSymPencil::Inertia");
+    }
+    factoredAsB = true;
+    sigmaf      = sigma;
+    fversion    = Version();
+
+  }
+
+  // Counting negative elements of D (stored in the diagonal of L).
+
+  int*    lp  = (int*)LAsB->p;
+  double* lx  = (double*)LAsB->x;
+  int     neg = 0;
+  for (int j=0; j<A->n; j++) if (lx[lp[j]] < 0.0) neg++;
+  return neg;
+
+} // Inertia.
+
+
 template<class ARTYPE>
 void ARchSymPencil<ARTYPE>::MultInvBAv(ARTYPE* v, ARTYPE* w)
 {
@@ -376,26 +565,43 @@ void ARchSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
                       "ARchSymPencil::MultInvAsBv");
   }
 
-  // Solving A.w = v (or AsI.w = v).
-  
-  //create b from v (data is not copied!!)
-  cholmod_dense * b = Create_Cholmod_Dense_Matrix(A->n,1,v,&c);
-
-  cholmod_dense *x = cholmod_solve (CHOLMOD_A, LAsB, b, &c) ;
+  // Solving AsB.w = v. bsol points to v (data is not copied) and
+  // cholmod_solve2 reuses xsol, ysol and esol, so no memory is
+  // allocated after the first call.
 
-  Get_Cholmod_Dense_Data(x, A->n, w);
+  Set_Cholmod_Dense_Matrix(&bsol, A->n, 1, v);
 
-  free(b);
-  cholmod_free_dense(&x,&c);
+  if (!cholmod_solve2(CHOLMOD_A, LAsB, &bsol, NULL, &xsol, NULL,
+                      &ysol, &esol, &c)) {
+    throw ArpackError(ArpackError::INSUFICIENT_MEMORY,
+                      "ARchSymPencil::MultInvAsBv");
+  }
 
+  Get_Cholmod_Dense_Data(xsol, A->n, w);
 
 } // MultInvAsBv
 
+
+template<class ARTYPE>
+void ARchSymPencil<ARTYPE>::
+SetFactorCache(int maxentries, std::size_t budget)
+{
+
+  cache.Define(this, &ARchSymPencil<ARTYPE>::FreeFactor, maxentries, budget);
+
+} // SetFactorCache.
+
 template<class ARTYPE>
 inline void ARchSymPencil<ARTYPE>::
 DefineMatrices(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp)
 {
 
+  // Discarding the factors of the previous pencil.
+
+  cache.Clear();
+  if (LAsB) cholmod_free_factor(&LAsB,&c);
+  factoredAsB = false;
+
   A = &Ap;
   B = &Bp;
 
@@ -413,6 +619,7 @@ ARchSymPencil(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp)
 {
   cholmod_start (&c) ;
   LAsB=NULL; 
+  xsol = ysol = esol = NULL;
   DefineMatrices(Ap, Bp);
 
 } // Long constructor.
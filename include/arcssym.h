@@ -94,7 +94,9 @@ inline void ARluSymStdEig<ARFLOAT>::ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -116,6 +118,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARchSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARchSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARchSymMatrix<ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -145,6 +148,7 @@ ARluSymStdEig(int nevp, ARchSymMatrix<ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, &ARchSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   this->ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARchSymMatrix<ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
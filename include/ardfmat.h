@@ -4,6 +4,10 @@
 
    MODULE ARDFMat.h
    Matrix template that generates a dense matrix from a file.
+   Both text files and binary files written by WriteBinary (see
+   arbfile.h) are accepted. Binary files are mapped into memory,
+   and blocks stored in the same layout used by ReadBlock are
+   not copied.
 
    ARPACK authors:
       Richard Lehoucq
@@ -27,6 +31,11 @@
 #include <string>
 #include "arch.h"
 #include "arerror.h"
+#include "arbfile.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 template<class ARTYPE>
@@ -51,6 +60,20 @@ class ARdfMatrix {
   bool     roword;    // A variable that indicates if the data will be read
                       // using a row-major or a column-major ordering.
   ARTYPE*  val;       // Numerical values of matrix entries.
+  ARTYPE*  buf;       // Buffer that stores the values read from the file.
+  const char* fdata;  // Binary file mapped into memory (or NULL).
+  size_t   fsize;     // Size of fdata.
+  bool     fmapped;   // Indicates if fdata was obtained by mmap.
+  int      fblksize;  // Rows per block in the binary file (0 = by columns).
+  unsigned fvtype;    // Type of the values stored in the binary file.
+  bool     fcopy;     // Indicates if blocks of the binary file are copied.
+  bool     pending;   // Indicates if the next block is being read.
+  bool     nok;       // Indicates if the next block was read correctly.
+  ARTYPE*  nbuf;      // Buffer that stores the next block.
+  ARTYPE*  nval;      // Numerical values of the next block.
+  int      nfirst;    // First row/column of the next block.
+  int      nrows;     // Number of rows of the next block.
+  int      ncols;     // Number of columns of the next block.
 			
   void ConvertDouble(char* num);
 
@@ -63,6 +86,18 @@ class ARdfMatrix {
   bool ReadEntry(std::ifstream& file, arcomplex<double>& val);
 
   bool ReadEntry(std::ifstream& file, arcomplex<float>& val);
+
+  const char* FileEntry(int i, int j);
+
+  void ReadColumn(int i0, int i1, int j, ARTYPE* dest);
+
+  void DefineBinary();
+
+  void SkipHeading();
+
+  bool Fetch(ARTYPE* dest, ARTYPE*& data, int& firstp, int& rows, int& cols);
+
+  void ClearMem();
   
  public:
   
@@ -96,10 +131,18 @@ class ARdfMatrix {
 
   void ReadBlock();
   // Function that reads a block of blksize rows/columns of the matrix.
+  // When called inside an OpenMP parallel region, ReadBlock also starts
+  // reading the following block in an OpenMP task, so the file is read
+  // while the current block is being used.
 
   void Define(const std::string& filename, int blksizep = 0);
   // Function that reads the matrix dimension. Define also read all
   // of the matrix elements when blocksize = 0.
+
+  void WriteBinary(const std::string& filename);
+  // Function that stores the matrix in a binary file (see arbfile.h).
+  // Blocks of rows are preserved, so ReadBlock does not copy any data
+  // when the binary file is read with the same block size.
   
   ARdfMatrix();
   // Short constructor.
@@ -227,44 +270,181 @@ ReadEntry(std::ifstream& file, arcomplex<float>& val)
 } // ReadEntry (arcomplex<float>).
 
 
+template<class ARTYPE>
+inline const char* ARdfMatrix<ARTYPE>::FileEntry(int i, int j)
+{
+
+  // Returns the address of element (i,j) in the binary file.
+
+  size_t r, b;
+
+  if (fblksize == 0) {
+    r = size_t(i)+size_t(j)*size_t(m);
+  }
+  else {
+    b = size_t(i/fblksize)*size_t(fblksize);   // First row of the block.
+    r = (size_t(m)-b < size_t(fblksize)) ? size_t(m)-b : size_t(fblksize);
+    r = b*size_t(n)+(size_t(i)-b)+size_t(j)*r;
+  }
+  return fdata+sizeof(ARbfHeader)+r*ARbfValueSize(fvtype);
+
+} // FileEntry.
+
+
+template<class ARTYPE>
+void ARdfMatrix<ARTYPE>::ReadColumn(int i0, int i1, int j, ARTYPE* dest)
+{
+
+  // Copies rows i0 to i1-1 of column j from the binary file to dest.
+
+  int i, k;
+
+  for (i=i0; i<i1; i+=k) {
+    k = (fblksize == 0) ? i1-i : (i/fblksize+1)*fblksize-i;
+    if (k > i1-i) k = i1-i;
+    ARbfCopy(FileEntry(i, j), fvtype, &dest[i-i0], size_t(k));
+  }
+
+} // ReadColumn.
+
+
+template<class ARTYPE>
+void ARdfMatrix<ARTYPE>::DefineBinary()
+{
+
+  // Declaring variables.
+
+  const ARbfHeader* head;
+  size_t            end;
+  unsigned          sum1, sum2;
+
+  // Mapping the file into memory.
+
+  fdata = ARbfMapFile(datafile, fsize, fmapped, true);
+
+  if (fdata == NULL) {
+    throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARdfMatrix");
+  }
+
+  // Reading the heading.
+
+  head = (const ARbfHeader*)fdata;
+  if ((!ARbfCheckHeader(fdata, fsize)) || (head->kind != ARbfDense)) {
+    ClearMem();
+    throw ArpackError(ArpackError::WRONG_DATA_TYPE, "ARdfMatrix");
+  }
+  if ((head->vtype > ARbfDouble) != (ARbfValueType(val) > ARbfDouble)) {
+    ClearMem();
+    throw ArpackError(ArpackError::WRONG_MATRIX_TYPE, "ARdfMatrix");
+  }
+
+  m        = head->m;
+  n        = head->n;
+  fvtype   = head->vtype;
+  fblksize = (head->blksize < m) ? head->blksize : 0;
+  end      = sizeof(ARbfHeader)+
+             ARbfAlign(size_t(m)*size_t(n)*ARbfValueSize(fvtype));
+
+  if (fsize < end) {
+    ClearMem();
+    throw ArpackError(ArpackError::UNEXPECTED_EOF, "ARdfMatrix");
+  }
+
+  // Verifying the checksum.
+
+  sum1 = sum2 = 0;
+  ARbfChecksum(fdata+sizeof(ARbfHeader), end-sizeof(ARbfHeader), sum1, sum2);
+  if ((sum1 != head->sum1) || (sum2 != head->sum2)) {
+    ClearMem();
+    throw ArpackError(ArpackError::INCONSISTENT_DATA, "ARdfMatrix");
+  }
+
+} // DefineBinary.
+
+
+template<class ARTYPE>
+void ARdfMatrix<ARTYPE>::ClearMem()
+{
+
+#ifdef _OPENMP
+  if (pending) {
+#pragma omp taskwait
+  }
+#endif
+  pending = false;
+  if (buf  != NULL) delete[] buf;
+  if (nbuf != NULL) delete[] nbuf;
+  ARbfUnmapFile(fdata, fsize, fmapped);
+  buf   = NULL;
+  nbuf  = NULL;
+  val   = NULL;
+  fdata = NULL;
+  fsize = 0;
+
+} // ClearMem.
+
+
 template<class ARTYPE>
 void ARdfMatrix<ARTYPE>::Rewind() 
 { 
 
-  char data[LINELEN];
-  char c;
+  // Discarding a block that was read in advance.
+
+#ifdef _OPENMP
+  if (pending) {
+#pragma omp taskwait
+  }
+#endif
+  pending = false;
 
-  file.seekg(0);
   block  = 0; 
   first  = 0;
   strows = 0;
   stcols = 0;
+  if (fdata == NULL) SkipHeading();
 
-  // Skipping the header. 
+} // Rewind.
+
+
+template<class ARTYPE>
+void ARdfMatrix<ARTYPE>::SkipHeading() 
+{ 
 
+  char data[LINELEN];
+  char c;
+
+  file.clear();
+  file.seekg(0);
   for (int i=0; i<headsize; i++) {
     file.get((char*)data,LINELEN,'\n');
     file.get(c);
   }
 
-} // Rewind.
+} // SkipHeading.
 
 
 template<class ARTYPE>
-void ARdfMatrix<ARTYPE>::ReadBlock()
+bool ARdfMatrix<ARTYPE>::
+Fetch(ARTYPE* dest, ARTYPE*& data, int& firstp, int& rows, int& cols)
 {
 
+  // Reads block "block" into dest (or points data to the block if it
+  // is stored in the mapped file) and sets the index of its first
+  // row/column and its dimensions. Returns false if the file is
+  // corrupted.
+
   int    i, j, last;
   ARTYPE value;
 
   // Repositioning the file pointer if block == 0.
 
-  if (block == 0) Rewind();
+  if ((block == 0) && (fdata == NULL)) SkipHeading();
 
   // Reading a block.
 
-  first = (block++)*blksize; // First row/column to be read.
-  last  = first+blksize;     // First row/column of the next block.
+  firstp = (block++)*blksize; // First row/column to be read.
+  last   = firstp+blksize;    // First row/column of the next block.
+  data   = dest;
 
   if (roword) {
 
@@ -272,26 +452,36 @@ void ARdfMatrix<ARTYPE>::ReadBlock()
 
     if (last > m) {
       last  = m;
-      block = 0;
     }
-    last  -= first;
-    strows = last;
-    stcols = n;
+    if (last == m) block = 0;
+    last -= firstp;
+    rows  = last;
+    cols  = n;
 
     // Reading matrix data.
 
+    if (fdata != NULL) {
+      if (!fcopy) {
+        data = (ARTYPE*)FileEntry(firstp, 0);
+      }
+      else {
+        for (j=0; j<n; j++) {
+          ReadColumn(firstp, firstp+last, j, &dest[j*last]);
+        }
+      }
+      return true;
+    }
+
     for (i=0; i<last; i++) {
       j = i;
       while ((j < n*last) && (ReadEntry(file, value))) {
-        val[j] = value;
+        dest[j] = value;
         j+=last;
       }  
 
       // Exiting if the file is corrupted.
 
-      if (j < (n*last)) {
-        throw ArpackError(ArpackError::UNEXPECTED_EOF, "ARdfMatrix");
-      }
+      if (j < (n*last)) return false;
     }
 
   }
@@ -301,27 +491,97 @@ void ARdfMatrix<ARTYPE>::ReadBlock()
 
     if (last > n) {
       last  = n;
-      block = 0;
     }
-    last  -= first;
-    strows = m;
-    stcols = last;
+    if (last == n) block = 0;
+    last -= firstp;
+    rows  = m;
+    cols  = last;
 
     // Reading matrix data.
 
+    if (fdata != NULL) {
+      if (!fcopy) {
+        data = (ARTYPE*)FileEntry(0, firstp);
+      }
+      else {
+        for (j=0; j<last; j++) ReadColumn(0, m, firstp+j, &dest[j*m]);
+      }
+      return true;
+    }
+
     j = 0;
     while ((j < m*last) && (ReadEntry(file, value))) {
-      val[j++] = value;  
+      dest[j++] = value;  
     }
 
     // Exiting if the file is corrupted.
 
-    if (j < m*last) {
-      throw ArpackError(ArpackError::UNEXPECTED_EOF, "ARdfMatrix");
-    }
+    if (j < m*last) return false;
  
   }
 
+  return true;
+
+} // Fetch.
+
+
+template<class ARTYPE>
+void ARdfMatrix<ARTYPE>::ReadBlock()
+{
+
+  ARTYPE* t;
+  bool    ok;
+
+  if (pending) {
+
+    // Using the block that was read in advance.
+
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+    pending = false;
+    t       = buf;
+    buf     = nbuf;
+    nbuf    = t;
+    val     = nval;
+    first   = nfirst;
+    strows  = nrows;
+    stcols  = ncols;
+    ok      = nok;
+
+  }
+  else {
+
+    ok = Fetch(buf, val, first, strows, stcols);
+
+  }
+
+  if (!ok) {
+    throw ArpackError(ArpackError::UNEXPECTED_EOF, "ARdfMatrix");
+  }
+
+  // Reading the next block in the background if ReadBlock was called
+  // inside a parallel region (see ARdsNonSymMatrix). The block is read
+  // by any other thread of the team while this one uses the current
+  // block.
+
+#ifdef _OPENMP
+  if ((block != 0) && omp_in_parallel()) {
+    if ((nbuf == NULL) && (buf != NULL)) {
+      nbuf = new ARTYPE[roword ? blksize*n : m*blksize];
+    }
+    pending = true;
+#pragma omp task
+    {
+      nok = Fetch(nbuf, nval, nfirst, nrows, ncols);
+      if (nok && !fcopy) {
+        ARbfPrefetch((const char*)nval,
+                     size_t(nrows)*size_t(ncols)*sizeof(ARTYPE));
+      }
+    }
+  }
+#endif
+
 } // ReadBlock.
 
 
@@ -334,17 +594,13 @@ void ARdfMatrix<ARTYPE>::Define(const std::string& filename, int blksizep)
   char   c;
   char   data[LINELEN];
 
-  // Opening the file.
-
-  datafile = filename;
-  file.open(datafile.c_str());
-  
-  if (!file) {
-    throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARdfMatrix");
-  }
-
   // Setting initial values.
 
+  ClearMem();
+  if (file.is_open()) file.close();
+  file.clear();
+
+  datafile = filename;
   blksize  = blksizep;
   block    = 0;
   headsize = 0;
@@ -352,64 +608,136 @@ void ARdfMatrix<ARTYPE>::Define(const std::string& filename, int blksizep)
   strows   = 0;
   stcols   = 0;
 
-  // Reading the file heading.
+  // Reading binary files.
 
-  do {
-    file.get((char*)data,LINELEN,'\n'); 
-    file.get(c);
-    headsize++;
+  if (ARbfIsBinary(datafile)) {
+    DefineBinary();
   }
-  while (data[0] == '%'); 
+  else {
 
-  // Reading m and n or returning if a problem was detected.
+    // Opening the file.
+
+    file.open(datafile.c_str());
+  
+    if (!file) {
+      throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARdfMatrix");
+    }
+
+    // Reading the file heading.
+
+    do {
+      file.get((char*)data,LINELEN,'\n'); 
+      file.get(c);
+      headsize++;
+    }
+    while (data[0] == '%'); 
+
+    // Reading m and n or returning if a problem was detected.
+
+    if (sscanf(data, "%d %d", &m, &n) != 2) {
+      throw ArpackError(ArpackError::PARAMETER_ERROR, "ARdfMatrix");
+    }
+    if ((m<1) || (n<1)) {
+      throw ArpackError(ArpackError::PARAMETER_ERROR, "ARdfMatrix");
+    }
 
-  if (sscanf(data, "%d %d", &m, &n) != 2) {
-    throw ArpackError(ArpackError::PARAMETER_ERROR, "ARdfMatrix");
-  }
-  if ((m<1) || (n<1)) {
-    throw ArpackError(ArpackError::PARAMETER_ERROR, "ARdfMatrix");
   }
 
-  // Defining roword.
+  // Defining roword and blksize.
 
   roword = ((blksize != 0) && (m > n));
 
-  // (Re)Dimensioning val.
+  if (blksize == 0) {
+    blksize = n;
+  }
+  else if (roword) {
+    if (blksize > m) blksize = m;
+  }
+  else {
+    if (blksize > n) blksize = n;
+  }
+  nblocks = roword ? (m+blksize-1)/blksize : (n+blksize-1)/blksize;
 
-  if (val != NULL) delete[] val;
+  // (Re)Dimensioning buf. A binary file does not require a buffer if
+  // its blocks coincide with those read by ReadBlock.
 
-  if (blksize == 0) {
+  fcopy = (fdata == NULL) || (fvtype != ARbfValueType(buf));
+  if (roword) {
+    fcopy = fcopy || ((fblksize != blksize) &&
+                      ((fblksize != 0) || (blksize != m)));
+  }
+  else {
+    fcopy = fcopy || (fblksize != 0);
+  }
+  if (fcopy) buf = new ARTYPE[roword ? blksize*n : m*blksize];
+  val = buf;
 
-    // Redefining blksize and reading the entire matrix.
+  // Reading the entire matrix if blksize = n (or m).
 
-    blksize = n;
-    nblocks = 1;
-    val = new ARTYPE[m*blksize]; 
-    ReadBlock();
-  
+  if (blksize == (roword ? m : n)) ReadBlock();
+
+} // Define.
+
+
+template<class ARTYPE>
+void ARdfMatrix<ARTYPE>::WriteBinary(const std::string& filename)
+{
+
+  ARbfHeader head;
+  unsigned   sum1, sum2;
+  size_t     bytes;
+  int        i;
+
+  if (!IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdfMatrix::WriteBinary");
   }
-  else if (roword) {  
 
-    // m >> n, so we will read only blksize rows (but not now).
- 
-    if (blksize > m) blksize = m;
-    nblocks = (m+blksize-1)/blksize;
-    val = new ARTYPE[blksize*n]; 
-    if (blksize == m) ReadBlock();
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary |
+                                      std::ios::trunc);
+  if (!out) {
+    throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARdfMatrix::WriteBinary");
+  }
 
-  } 
-  else {       
+  // Writing the heading (without the checksum).
 
-    // n >> m, so we will read only blksize columns (but not now).
-  
-    if (blksize > n) blksize = n;
-    nblocks = (n+blksize-1)/blksize;
-    val = new ARTYPE[m*blksize]; 
-    if (blksize == n) ReadBlock();
+  ARbfInitHeader(head, ARbfDense, ARbfValueType(val), 0,
+                 std::string(ARbfValueType(val) > ARbfDouble ? "C" : "R"),
+                 m, n, 0, (roword && (blksize < m)) ? blksize : 0);
+  out.write((const char*)&head, sizeof(head));
+
+  // Writing the matrix one block at a time. Blocks of columns are
+  // stored consecutively in column-major order, and so are blocks
+  // of rows.
+
+  sum1  = sum2 = 0;
+  bytes = 0;
+  if (!IsOutOfCore() && (strows == m) && (stcols == n)) {
+    bytes = size_t(m)*size_t(n)*sizeof(ARTYPE);
+    ARbfWrite(out, val, bytes, sum1, sum2);
+  }
+  else {
+    Rewind();
+    for (i=0; i<nblocks; i++) {
+      ReadBlock();
+      ARbfWrite(out, val, size_t(strows)*size_t(stcols)*sizeof(ARTYPE),
+                sum1, sum2);
+      bytes += size_t(strows)*size_t(stcols)*sizeof(ARTYPE);
+    }
+  }
+  ARbfPad(out, bytes, sum1, sum2);
+
+  // Writing the checksum.
 
+  head.sum1 = sum1;
+  head.sum2 = sum2;
+  out.seekp(0);
+  out.write((const char*)&head, sizeof(head));
+
+  if (!out) {
+    throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARdfMatrix::WriteBinary");
   }
 
-} // Define.
+} // WriteBinary.
 
 
 template<class ARTYPE>
@@ -426,6 +754,15 @@ ARdfMatrix<ARTYPE>::ARdfMatrix()
   stcols   = 0;
   roword   = false;
   val      = NULL;
+  buf      = NULL;
+  fdata    = NULL;
+  fsize    = 0;
+  fmapped  = false;
+  fblksize = 0;
+  fvtype   = 0;
+  fcopy    = true;
+  pending  = false;
+  nbuf     = NULL;
 
 } // Short constructor.
 
@@ -434,7 +771,13 @@ template<class ARTYPE>
 ARdfMatrix<ARTYPE>::ARdfMatrix(const std::string& filename, int blksizep) 
 { 
 
-  val = NULL;
+  val     = NULL;
+  buf     = NULL;
+  nbuf    = NULL;
+  fdata   = NULL;
+  fsize   = 0;
+  fmapped = false;
+  pending = false;
   Define(filename, blksizep); 
 
 } // Long constructor.
@@ -444,7 +787,7 @@ template<class ARTYPE>
 ARdfMatrix<ARTYPE>::~ARdfMatrix()
 {
 
-  if (val != NULL) delete[] val;
+  ClearMem();
 
 } // Destructor.
 
@@ -115,7 +115,9 @@ inline void ARluCompGenEig<ARFLOAT>::
 ChangeShift(arcomplex<ARFLOAT> sigmaRp)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsB(sigmaRp);
+  this->StopFactor();
   ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> >::ChangeShift(sigmaRp);
 
 } // ChangeShift.
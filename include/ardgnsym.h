@@ -123,12 +123,14 @@ inline void ARluNonSymGenEig<ARFLOAT>::
 ChangeShift(ARFLOAT sigmaRp, ARFLOAT sigmaIp)
 {
 
+  this->StartFactor();
   if (sigmaIp == 0.0) {
     this->objOP->FactorAsB(sigmaRp);
   }
   else {
     this->objOP->FactorAsB(sigmaRp, sigmaIp, this->part);
   }
+  this->StopFactor();
   ARrcNonSymGenEig<ARFLOAT>::ChangeShift(sigmaRp, sigmaIp);
 
 } // ChangeShift.
@@ -116,7 +116,9 @@ template<class ARFLOAT>
 inline void ARluSymGenEig<ARFLOAT>::ChangeShift(ARFLOAT sigmap)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsB(sigmap);
+  this->StopFactor();
   ARrcSymGenEig<ARFLOAT>::ChangeShift(sigmap);
 
 } // ChangeShift.
@@ -21,6 +21,7 @@
 #define ARDNSMAT_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "armat.h"
@@ -53,6 +54,10 @@ class ARdsNonSymMatrix: public ARMatrix<ARTYPE> {
   void CreateStructure();
 
   void ThrowError();
+
+  void MultBlock(char op, ARTYPE* X, ARTYPE* Y, int nvec, ARTYPE* t);
+
+  void MultBlocks(char op, ARTYPE* X, ARTYPE* Y, int nvec = 1);
   
  public:
 
@@ -64,8 +69,12 @@ class ARdsNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMV(ARTYPE* X, ARTYPE* Y, int nvec);
+
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
+  void MultMtV(ARTYPE* X, ARTYPE* Y, int nvec);
+
   void MultMtMv(ARTYPE* v, ARTYPE* w);
 
   void MultMMtv(ARTYPE* v, ARTYPE* w);
@@ -74,6 +83,8 @@ class ARdsNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+
   void DefineMatrix(int np, ARTYPE* Ap);
 
   void DefineMatrix(int mp, int np, ARTYPE* Ap);
@@ -160,8 +171,19 @@ inline void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::CreateStructure()
 {
 
   ClearMem();
-  Ainv = new ARTYPE[this->m*this->n];
-  ipiv = new int[this->n];
+  Ainv = NULL;
+  ipiv = NULL;
+  try {
+    Ainv = new ARTYPE[this->m*this->n];
+    ipiv = new int[this->n];
+  }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    delete[] Ainv;
+    Ainv     = NULL;
+    factored = false;
+    throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                      "ARdsNonSymMatrix::FactorA");
+  }
 
 } // CreateStructure.
 
@@ -182,6 +204,145 @@ inline void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::ThrowError()
 } // ThrowError.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
+MultBlock(char op, ARTYPE* X, ARTYPE* Y, int nvec, ARTYPE* t)
+{
+
+  // Performs the part of the product given by op (see MultBlocks) that
+  // involves the block of the matrix that is currently in memory.
+
+  int     f, r, c;
+  ARTYPE* B;
+  ARTYPE  one;
+  ARTYPE  zero;
+
+  one  = (ARTYPE)0 + 1.0;
+  zero = (ARTYPE)0;
+  f    = mat.FirstIndex();
+  r    = mat.RowsInMemory();
+  c    = mat.ColsInMemory();
+  B    = mat.Entries();
+
+  if (mat.IsRowOrdered()) {
+
+    // B contains rows f to f+r-1 of the matrix ("tall" matrix).
+
+    switch (op) {
+    case 'N':
+      if (nvec == 1) {
+        gemv("N", r, c, one, B, r, X, 1, zero, &Y[f], 1);
+      }
+      else {
+        gemm("N", "N", r, nvec, c, one, B, r, X, c, zero, &Y[f], this->m);
+      }
+      break;
+    case 'T':
+      if (nvec == 1) {
+        gemv("T", r, c, one, B, r, &X[f], 1, one, Y, 1);
+      }
+      else {
+        gemm("T", "N", c, nvec, r, one, B, r, &X[f], this->m, one, Y, c);
+      }
+      break;
+    case 'A':
+      gemv("N", r, c, one, B, r, X, 1, zero, t, 1);
+      gemv("T", r, c, one, B, r, t, 1, one, Y, 1);
+      break;
+    }
+
+  }
+  else {
+
+    // B contains columns f to f+c-1 of the matrix ("fat" matrix).
+
+    switch (op) {
+    case 'N':
+      if (nvec == 1) {
+        gemv("N", r, c, one, B, r, &X[f], 1, one, Y, 1);
+      }
+      else {
+        gemm("N", "N", r, nvec, c, one, B, r, &X[f], this->n, one, Y, r);
+      }
+      break;
+    case 'T':
+      if (nvec == 1) {
+        gemv("T", r, c, one, B, r, X, 1, zero, &Y[f], 1);
+      }
+      else {
+        gemm("T", "N", c, nvec, r, one, B, r, X, r, zero, &Y[f], this->n);
+      }
+      break;
+    case 'M':
+      gemv("T", r, c, one, B, r, X, 1, zero, t, 1);
+      gemv("N", r, c, one, B, r, t, 1, one, Y, 1);
+      break;
+    }
+
+  }
+
+} // MultBlock.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
+MultBlocks(char op, ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  // Computes Y = M*X (op = 'N'), Y = M'*X ('T'), Y = M'*M*X ('A', "tall"
+  // matrices only) or Y = M*M'*X ('M', "fat" matrices only) when M is
+  // stored out of core. When OpenMP is available, each block is read
+  // by a second thread while the previous one is being used.
+
+  int     i, ny;
+  bool    ok;
+  ARTYPE* t;
+
+  // Setting to zero the vectors that are accumulated block by block.
+
+  ny = 0;
+  if (mat.IsRowOrdered()) {
+    if (op == 'T') ny = this->n*nvec;
+    if ((op == 'A') || (op == 'M')) ny = this->n;
+  }
+  else {
+    if (op == 'N') ny = this->m*nvec;
+    if (op == 'M') ny = this->m;
+  }
+  for (i=0; i<ny; i++) Y[i] = (ARTYPE)0;
+
+  t  = ((op == 'A') || (op == 'M')) ? new ARTYPE[mat.BlockSize()] : NULL;
+  ok = true;
+
+  // Computing the product.
+
+  mat.Rewind();
+#ifdef _OPENMP
+#pragma omp parallel num_threads(2) if (mat.NBlocks() > 1)
+#pragma omp single
+#endif
+  {
+    try {
+      for (i=0; i<mat.NBlocks(); i++) {
+        mat.ReadBlock();
+        MultBlock(op, X, Y, nvec, t);
+      }
+    }
+    catch (const ArpackError&) {
+      ok = false;
+    }
+  }
+
+  if (t != NULL) delete[] t;
+
+  if (!ok) {
+    throw ArpackError(ArpackError::CANNOT_READ_FILE,
+                      "ARdsNonSymMatrix::MultBlocks");
+  }
+
+} // MultBlocks.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
 {
@@ -270,8 +431,6 @@ template<class ARTYPE, class ARFLOAT>
 void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 {
 
-  int     i;
-  ARTYPE* t;
   ARTYPE  one;
   ARTYPE  zero;
 
@@ -288,51 +447,56 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 
   if (mat.IsOutOfCore()) {
 
-    if (this->m>this->n) { 
+    MultBlocks('N', v, w);
 
-      // Matrix is "tall".
+  }
+  else {
 
-      mat.Rewind();
-      for (i=0; i<mat.NBlocks(); i++) {
-        mat.ReadBlock();
-        gemv("N", mat.RowsInMemory(), this->n, one, mat.Entries(), 
-             mat.RowsInMemory(), v, 1, zero, &w[mat.FirstIndex()], 1);
-      }
+    gemv("N", this->m, this->n, one, A, this->m, v, 1, zero, w, 1);
 
-    }
-    else {
+  }
 
-      // Matrix is "fat".
+} // MultMv.
 
-      mat.Rewind();
-      t = new ARTYPE[mat.ColsInMemory()];
-      for (i=0; i<this->m; i++) w[i] = zero;
-      for (i=0; i<mat.NBlocks(); i++) {
-        mat.ReadBlock();
-        gemv("N", this->m, mat.ColsInMemory(), one, mat.Entries(), 
-             this->m, &v[mat.FirstIndex()], 1, zero, t, 1);
-        axpy(this->m, one, t, 1, w, 1); 
-      }
-      delete[] t;
 
-    }
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  ARTYPE  one;
+  ARTYPE  zero;
+
+  one  = (ARTYPE)0 + 1.0;
+  zero = (ARTYPE)0;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsNonSymMatrix::MultMV");
+  }
+
+  // Determining Y = M.X.
+
+  if (mat.IsOutOfCore()) {
+
+    MultBlocks('N', X, Y, nvec);
 
   }
   else {
 
-    gemv("N", this->m, this->n, one, A, this->m, v, 1, zero, w, 1);
+    gemm("N", "N", this->m, nvec, this->n, one, A, this->m, X, this->n,
+         zero, Y, this->m);
 
   }
 
-} // MultMv.
+} // MultMV.
 
 
 template<class ARTYPE, class ARFLOAT>
 void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  int     i;
-  ARTYPE* t;
   ARTYPE  one;   
   ARTYPE  zero; 
 
@@ -349,34 +513,7 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 
   if (mat.IsOutOfCore()) {
 
-    if (this->m<=this->n) { 
-
-      // Matrix is "fat".
-
-      mat.Rewind();
-      for (i=0; i<mat.NBlocks(); i++) {
-        mat.ReadBlock();
-        gemv("T", this->m, mat.ColsInMemory(), one, mat.Entries(), 
-             this->m, v, 1, zero, &w[mat.FirstIndex()], 1);
-      }
-
-    }
-    else {
-
-      // Matrix is "tall".
-
-      mat.Rewind();
-      t = new ARTYPE[mat.ColsInMemory()];
-      for (i=0; i<this->m; i++) w[i] = zero;
-      for (i=0; i<mat.NBlocks(); i++) {
-        mat.ReadBlock();
-        gemv("T", mat.RowsInMemory(), this->n, one, mat.Entries(), 
-             mat.RowsInMemory(), &v[mat.FirstIndex()], 1, zero, t, 1);
-        axpy(mat.RowsInMemory(), one, t, 1, w, 1); 
-      }
-      delete[] t;
-
-    }
+    MultBlocks('T', v, w);
 
   }
   else {
@@ -390,38 +527,50 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 
 
 template<class ARTYPE, class ARFLOAT>
-void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMtV(ARTYPE* X, ARTYPE* Y, int nvec)
 {
 
-  int    i;
-  ARTYPE *t, *s;
-  ARTYPE one;   
-  ARTYPE zero; 
+  ARTYPE  one;
+  ARTYPE  zero;
 
   one  = (ARTYPE)0 + 1.0;
   zero = (ARTYPE)0;
 
-  if (mat.IsOutOfCore() && (this->m>this->n)) {
+  // Quitting the function if A was not defined.
 
-    // Special code for "tall" matrices.
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsNonSymMatrix::MultMtV");
+  }
 
-    t = new ARTYPE[mat.BlockSize()];
-    s = new ARTYPE[this->n];
+  // Determining Y = M'.X.
 
-    mat.Rewind();
-    for (i=0; i<this->n; i++) w[i] = zero;
-    for (i=0; i<mat.NBlocks(); i++) {
-      mat.ReadBlock();
-      gemv("N", mat.RowsInMemory(), this->n, one, mat.Entries(), 
-           mat.RowsInMemory(), v, 1, zero, t, 1);
-      gemv("T", mat.RowsInMemory(), this->n, one, mat.Entries(), 
-           mat.RowsInMemory(), t, 1, zero, s, 1);
-      axpy(this->n, one, s, 1, w, 1); 
+  if (mat.IsOutOfCore()) {
 
-    }
+    MultBlocks('T', X, Y, nvec);
 
-    delete[] t;
-    delete[] s;
+  }
+  else {
+
+    gemm("T", "N", this->n, nvec, this->m, one, A, this->m, X, this->m,
+         zero, Y, this->n);
+
+  }
+
+} // MultMtV.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
+{
+
+  ARTYPE* t;
+
+  if (mat.IsOutOfCore() && (this->m>this->n)) {
+
+    // Special code for "tall" matrices.
+
+    MultBlocks('A', v, w);
 
   }
   else {
@@ -443,35 +592,44 @@ template<class ARTYPE, class ARFLOAT>
 void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  int    i;
-  ARTYPE *t, *s;
-  ARTYPE one;   
-  ARTYPE zero; 
+  int     f, c, nb;
+  ARTYPE* t;
+  ARTYPE  one;
+  ARTYPE  zero;
 
   one  = (ARTYPE)0 + 1.0;
   zero = (ARTYPE)0;
+  nb   = (this->m > 0) ? ARCACHEBLK/this->m : 0;
 
   if (mat.IsOutOfCore() && (this->m<=this->n)) {
 
     // Special code for "fat" matrices.
 
-    t = new ARTYPE[mat.BlockSize()];
-    s = new ARTYPE[this->m];
+    MultBlocks('M', v, w);
+
+  }
+  else if (!mat.IsOutOfCore() && (nb >= 8) && (nb < this->n)) {
+
+    // Quitting the function if A was not defined.
+
+    if (!this->IsDefined()) {
+      throw ArpackError(ArpackError::DATA_UNDEFINED,
+                        "ARdsNonSymMatrix::MultMMtv");
+    }
+
+    // Splitting M into panels of nb columns that fit in cache, so
+    // w = sum_b M_b*(M_b'*v) is computed reading M only once.
 
-    mat.Rewind();
-    for (i=0; i<this->m; i++) w[i] = zero;
-    for (i=0; i<mat.NBlocks(); i++) {
-      mat.ReadBlock();
-      gemv("T", this->m, mat.ColsInMemory(), one, mat.Entries(), 
-           this->m, v, 1, zero, t, 1);
-      gemv("N", this->m, mat.ColsInMemory(), one, mat.Entries(), 
-           this->m, t, 1, zero, s, 1);
-      axpy(this->m, one, s, 1, w, 1); 
+    t = new ARTYPE[nb];
 
+    for (f=0; f<this->n; f+=nb) {
+      c = (this->n-f < nb) ? this->n-f : nb;
+      gemv("T", this->m, c, one, &A[f*this->m], this->m, v, 1, zero, t, 1);
+      gemv("N", this->m, c, one, &A[f*this->m], this->m, t, 1,
+           (f == 0) ? zero : one, w, 1);
     }
 
     delete[] t;
-    delete[] s;
 
   }
   else {
@@ -524,6 +682,33 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
+MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARdsNonSymMatrix::MultInvV");
+  }
+
+  // Overwritting Y with X.
+
+  if (X != Y) copy(this->n*nrhs, X, 1, Y, 1);
+
+  // Solving A.Y = X (or AsI.Y = X).
+
+  getrs("N", this->n, nrhs, Ainv, this->m, ipiv, Y, this->m, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvV.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int np, ARTYPE* Ap)
@@ -594,6 +779,10 @@ ARdsNonSymMatrix<ARTYPE, ARFLOAT>::ARdsNonSymMatrix(const std::string& file, int
   catch (ArpackError) {    // Returning from here if an error has occurred.
     throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARdsNonSymMatrix");
   }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "ARdsNonSymMatrix");
+    throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARdsNonSymMatrix");
+  }
 
   if (mat.NCols() == mat.NRows()) {
     DefineMatrix(mat.NCols(), (ARTYPE*)mat.Entries());
@@ -85,7 +85,9 @@ inline void ARluCompStdEig<ARFLOAT>::
 ChangeShift(arcomplex<ARFLOAT> sigmaRp)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsI(sigmaRp);
+  this->StopFactor();
   ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> >::ChangeShift(sigmaRp);
 
 } // ChangeShift.
@@ -112,6 +114,7 @@ SetShiftInvertMode(arcomplex<ARFLOAT> sigmap)
            ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP,
                        &ARdsNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARdsNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -145,6 +148,7 @@ ARluCompStdEig(int nevp, ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
                    &ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARdsNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
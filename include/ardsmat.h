@@ -21,6 +21,7 @@
 #define ARDSMAT_H
 
 #include <cstddef>
+#include <new>
 
 #include "arch.h"
 #include "armat.h"
@@ -66,6 +67,8 @@ class ARdsSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+
   void DefineMatrix(int np, ARTYPE* Ap, char uplop = 'L');
 
   ARdsSymMatrix(): ARMatrix<ARTYPE>() { factored = false; }
@@ -161,8 +164,19 @@ inline void ARdsSymMatrix<ARTYPE>::CreateStructure()
 {
 
   ClearMem();
-  Ainv = new ARTYPE[(this->n*this->n+this->n)/2];
-  ipiv = new int[this->n];
+  Ainv = NULL;
+  ipiv = NULL;
+  try {
+    Ainv = new ARTYPE[(this->n*this->n+this->n)/2];
+    ipiv = new int[this->n];
+  }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    delete[] Ainv;
+    Ainv     = NULL;
+    factored = false;
+    throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                      "ARdsSymMatrix::FactorA");
+  }
 
 } // CreateStructure.
 
@@ -310,6 +324,32 @@ void ARdsSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARdsSymMatrix<ARTYPE>::MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARdsSymMatrix::MultInvV");
+  }
+
+  // Overwritting Y with X.
+
+  if (X != Y) copy(this->n*nrhs, X, 1, Y, 1);
+
+  // Solving A.Y = X (or AsI.Y = X).
+
+  sptrs(&uplo, this->n, nrhs, Ainv, ipiv, Y, this->n, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvV.
+
+
 template<class ARTYPE>
 inline void ARdsSymMatrix<ARTYPE>::
 DefineMatrix(int np, ARTYPE* Ap, char uplop)
@@ -87,7 +87,9 @@ ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -110,6 +112,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARdsNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, 
                        &ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -142,6 +145,7 @@ ARluNonSymStdEig(int nevp, ARdsNonSymMatrix<ARFLOAT, ARFLOAT>& A,
                    &ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
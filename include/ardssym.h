@@ -87,7 +87,9 @@ ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -109,6 +111,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARdsSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARdsSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARdsSymMatrix<ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -138,6 +141,7 @@ ARluSymStdEig(int nevp, ARdsSymMatrix<ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, &ARdsSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARdsSymMatrix<ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
@@ -126,7 +126,11 @@ class ArpackError {
 
  private:
 
-  static ErrorCode code;
+  ErrorCode error;  // Error code of this object.
+
+  static ErrorCode& Code();
+  // Returns the last error code set by the calling thread. Each thread
+  // has its own copy, so solvers can run concurrently.
 
   static void Print(const std::string& where, const std::string& message);
   // Writes error messages on cerr stream.
@@ -136,34 +140,49 @@ class ArpackError {
   static void Set(ErrorCode error, const std::string& where="AREigenProblem");
   // Set error code and write error messages.
 
-  static int Status() { return (int) code; }
-  // Returns current value of error code.
+  static int Status() { return (int) Code(); }
+  // Returns current value of error code (in the calling thread).
+
+  int GetCode() const { return (int) error; }
+  // Returns the error code of this object (useful in catch blocks).
 
-  ArpackError(ErrorCode error, const std::string& where="AREigenProblem") {
-    Set(error,where);
+  ArpackError(ErrorCode errorp, const std::string& where="AREigenProblem") {
+    error = errorp;
+    Set(errorp,where);
   }
   // Constructor that set error code.
 
-  ArpackError() { code = NO_ERRORS; };
+  ArpackError() { error = NO_ERRORS; Code() = NO_ERRORS; };
   // Constructor that does nothing.
 
 };
 
+inline ArpackError::ErrorCode& ArpackError::Code()
+{
+
+  static ARTHREAD_LOCAL ErrorCode code = NO_ERRORS;
+  return code;
+
+} // Code.
+
 inline void ArpackError::Print(const std::string& where, const std::string& message)
 {
 
+  // The message is written at once, so messages from different
+  // threads are not mixed.
+
 #ifndef ARPACK_SILENT_MODE
-  std::cerr << "Arpack error in " << where << "." << std::endl;
-  std::cerr << "-> " << message << "." << std::endl;
+  std::cerr << ("Arpack error in " + where + ".\n-> " + message + ".\n");
+  std::cerr.flush();
 #endif
 
 } // Print
 
-void ArpackError::Set(ErrorCode error, const std::string& where)
+inline void ArpackError::Set(ErrorCode error, const std::string& where)
 {
 
-  code = error;
-  switch (code) {
+  Code() = error;
+  switch (error) {
   case NO_ERRORS          :
     return;
   case NOT_IMPLEMENTED    :
@@ -330,7 +349,4 @@ void ArpackError::Set(ErrorCode error, const std::string& where)
 
 } // Set.
 
-ArpackError::ErrorCode ArpackError::code = NO_ERRORS;
-// "code" initialization.
-
 #endif // ARERROR_H
@@ -0,0 +1,300 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARFCache.h.
+   Arpack++ class ARFactorCache definition.
+   ARFactorCache keeps the factorizations of A-sigma*I (or A-sigma*B)
+   that were computed for previous shifts, so a sparse matrix or pencil
+   class can reuse them when the same shift is requested again. The
+   entries are identified by the shift and by a version number of the
+   matrix values, and the least recently used ones are discarded when
+   the number of entries or the memory they take exceeds a limit.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARFCACHE_H
+#define ARFCACHE_H
+
+#include <cstddef>
+#include "arch.h"
+#include "arerror.h"
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+class ARFactorCache {
+
+ private:
+
+  // a) Cache parameters.
+
+  AROWNER*       owner;       // Object that computed the factors.
+  void (AROWNER::*FreeFactor)(ARFACTOR&); // Releases an entry.
+  int            maxentries;  // Maximum number of entries (0 = disabled).
+  std::size_t    budget;      // Maximum memory taken by all entries
+                              // (0 = no limit), in bytes.
+
+  // b) Entries.
+
+  int            nentries;    // Number of entries stored.
+  int            hits;        // Number of factorizations reused.
+  std::size_t    used;        // Memory taken by all entries.
+  unsigned long  clock;       // Time of the last access.
+  ARTYPE*        sigma;       // Shift of each entry.
+  unsigned long* version;     // Version of the matrix values.
+  unsigned long* stamp;       // Time of the last access to each entry.
+  std::size_t*   bytes;       // Memory taken by each entry.
+  ARFACTOR*      factor;      // Factorizations.
+
+  void Remove(int i);
+  // Removes entry i from the cache without releasing its factors.
+
+  void Evict(int i);
+  // Releases the factors of entry i and removes it from the cache.
+
+  ARFactorCache(const ARFactorCache& other);
+  ARFactorCache& operator=(const ARFactorCache& other);
+  // Copying is not allowed, since the factors are owned by the cache.
+
+ public:
+
+  bool Enabled() const { return (maxentries > 0); }
+
+  int GetMaxEntries() const { return maxentries; }
+
+  std::size_t GetBudget() const { return budget; }
+
+  int GetEntries() const { return nentries; }
+
+  std::size_t GetMemory() const { return used; }
+
+  int GetHits() const { return hits; }
+
+  void Define(AROWNER* ownerp, void (AROWNER::*FreeFactorp)(ARFACTOR&),
+              int maxentriesp, std::size_t budgetp = 0);
+  // Releases all entries and sets the maximum number of entries and
+  // the memory budget. FreeFactorp is the member function of ownerp
+  // that releases the factors of an entry.
+
+  void Clear();
+  // Releases all entries.
+
+  bool Retrieve(ARTYPE sigmap, unsigned long versionp, ARFACTOR& f);
+  // Looks for the factorization of A-sigmap*I computed for version
+  // versionp of A. If it is found, it is copied to f and removed from
+  // the cache (the caller becomes its owner) and true is returned.
+
+  void Store(ARTYPE sigmap, unsigned long versionp, ARFACTOR& f,
+             std::size_t bytesp);
+  // Stores the factorization f of A-sigmap*I (that takes bytesp bytes),
+  // so the cache becomes its owner. Entries of other versions of A are
+  // released, as are the least recently used ones if maxentries or the
+  // budget would be exceeded. f is released at once if the cache is
+  // disabled or if f alone exceeds the budget. Define must have been
+  // called before.
+
+  ARFactorCache();
+  // Constructor. The cache is disabled.
+
+  ~ARFactorCache();
+  // Destructor. Owners must call Clear before their factors become
+  // invalid.
+
+}; // class ARFactorCache.
+
+
+// ------------------------------------------------------------------------ //
+// ARFactorCache member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+inline void ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::Remove(int i)
+{
+
+  used -= bytes[i];
+  nentries--;
+  if (i != nentries) {
+    sigma[i]   = sigma[nentries];
+    version[i] = version[nentries];
+    stamp[i]   = stamp[nentries];
+    bytes[i]   = bytes[nentries];
+    factor[i]  = factor[nentries];
+  }
+
+} // Remove.
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+inline void ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::Evict(int i)
+{
+
+  (owner->*FreeFactor)(factor[i]);
+  Remove(i);
+
+} // Evict.
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+void ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::
+Define(AROWNER* ownerp, void (AROWNER::*FreeFactorp)(ARFACTOR&),
+       int maxentriesp, std::size_t budgetp)
+{
+
+  // Releasing the previous entries.
+
+  Clear();
+  if (maxentries != maxentriesp) {
+    delete[] sigma;
+    delete[] version;
+    delete[] stamp;
+    delete[] bytes;
+    delete[] factor;
+    sigma   = NULL;
+    version = NULL;
+    stamp   = NULL;
+    bytes   = NULL;
+    factor  = NULL;
+  }
+
+  // Checking parameters.
+
+  if (maxentriesp < 0) {
+    maxentries = 0;
+    throw ArpackError(ArpackError::PARAMETER_ERROR,
+                      "ARFactorCache::Define");
+  }
+
+  // Setting parameters and reserving memory for the entries.
+
+  owner      = ownerp;
+  FreeFactor = FreeFactorp;
+  budget     = budgetp;
+  if ((maxentries != maxentriesp) && (maxentriesp > 0)) {
+    sigma   = new ARTYPE[maxentriesp];
+    version = new unsigned long[maxentriesp];
+    stamp   = new unsigned long[maxentriesp];
+    bytes   = new std::size_t[maxentriesp];
+    factor  = new ARFACTOR[maxentriesp];
+  }
+  maxentries = maxentriesp;
+
+} // Define.
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+void ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::Clear()
+{
+
+  while (nentries > 0) Evict(nentries-1);
+
+} // Clear.
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+bool ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::
+Retrieve(ARTYPE sigmap, unsigned long versionp, ARFACTOR& f)
+{
+
+  int i;
+
+  for (i=0; i<nentries; i++) {
+    if ((sigma[i] == sigmap) && (version[i] == versionp)) {
+      f = factor[i];
+      Remove(i);
+      hits++;
+      return true;
+    }
+  }
+  return false;
+
+} // Retrieve.
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+void ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::
+Store(ARTYPE sigmap, unsigned long versionp, ARFACTOR& f,
+      std::size_t bytesp)
+{
+
+  int i, lru;
+
+  // Releasing f if it cannot be stored.
+
+  if ((!Enabled()) || ((budget > 0) && (bytesp > budget))) {
+    (owner->*FreeFactor)(f);
+    return;
+  }
+
+  // Releasing the entries of other versions of A (and the one that has
+  // the same shift, that can only be there if f was computed again).
+
+  for (i=nentries-1; i>=0; i--) {
+    if ((version[i] != versionp) || (sigma[i] == sigmap)) Evict(i);
+  }
+
+  // Releasing the least recently used entries.
+
+  while ((nentries == maxentries) ||
+         ((budget > 0) && (used+bytesp > budget))) {
+    lru = 0;
+    for (i=1; i<nentries; i++) if (stamp[i] < stamp[lru]) lru = i;
+    Evict(lru);
+  }
+
+  // Storing f.
+
+  sigma[nentries]   = sigmap;
+  version[nentries] = versionp;
+  stamp[nentries]   = ++clock;
+  bytes[nentries]   = bytesp;
+  factor[nentries]  = f;
+  used += bytesp;
+  nentries++;
+
+} // Store.
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+inline ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::ARFactorCache()
+{
+
+  owner      = NULL;
+  FreeFactor = NULL;
+  maxentries = 0;
+  budget     = 0;
+  nentries   = 0;
+  hits       = 0;
+  used       = 0;
+  clock      = 0;
+  sigma      = NULL;
+  version    = NULL;
+  stamp      = NULL;
+  bytes      = NULL;
+  factor     = NULL;
+
+} // Constructor.
+
+
+template<class ARTYPE, class ARFACTOR, class AROWNER>
+inline ARFactorCache<ARTYPE, ARFACTOR, AROWNER>::~ARFactorCache()
+{
+
+  Clear();
+  delete[] sigma;
+  delete[] version;
+  delete[] stamp;
+  delete[] bytes;
+  delete[] factor;
+
+} // Destructor.
+
+
+#endif // ARFCACHE_H
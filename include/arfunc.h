@@ -0,0 +1,497 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARFunc.h.
+   Arpack++ classes ARFuncSymStdEig, ARFuncNonSymStdEig and
+   ARFuncCompStdEig definition.
+   These classes solve standard eigenvalue problems, like
+   ARSymStdEig, ARNonSymStdEig and ARCompStdEig, but the operator
+   OP is given by any callable object (a function object, or a
+   lambda when C++11 is available) that is stored by value and
+   called as func(x, y) to compute y <- OP*x. The type of the
+   callable is a template parameter, so small operators can be
+   inlined into the reverse communication loop, avoiding the
+   pointer-to-member (and often virtual) call made by ARStdEig.
+
+   ARMemberOp turns a member function such as MultMv into such
+   a callable. The member function is a template argument, so it
+   is called directly when it is not virtual.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARFUNC_H
+#define ARFUNC_H
+
+#include <cstddef>
+#include <string>
+#include "arch.h"
+#include "arerror.h"
+#include "arrseig.h"
+#include "arrssym.h"
+#include "arrsnsym.h"
+#include "arrscomp.h"
+
+
+// ARMemberOp class definition.
+
+template<class ARFOP, class ARTYPE, void (ARFOP::* MULT)(ARTYPE[], ARTYPE[])>
+class ARMemberOp {
+
+ protected:
+
+  ARFOP* objOP;  // Object that has MULT as a member function.
+
+ public:
+
+  void operator()(ARTYPE* x, ARTYPE* y) { (objOP->*MULT)(x, y); }
+  // Computes y <- OP*x.
+
+  ARMemberOp(ARFOP* objOPp = NULL) { objOP = objOPp; }
+  // Constructor.
+
+}; // class ARMemberOp.
+
+
+// ARFuncStdEig class definition.
+
+template<class ARFLOAT, class ARTYPE, class ARFUNC>
+class ARFuncStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
+
+ protected:
+
+ // a) User defined parameters.
+
+  ARFUNC func;  // Callable object that evaluates the product OP*x.
+
+
+ public:
+
+ // b) Public functions:
+
+ // b.1) Function that stores user defined parameters.
+
+  using ARrcStdEig<ARFLOAT, ARTYPE>::DefineParameters;
+
+  void DefineParameters(int np, int nevp, const ARFUNC& funcp,
+                        const std::string& whichp="LM", int ncvp=0,
+                        ARFLOAT tolp=0.0, int maxitp=0, ARTYPE* residp=NULL,
+                        bool ishiftp=true);
+  // Set values of problem parameters. The functions of this class that
+  // replace func are not virtual, so they are only compiled if they are
+  // used (a lambda may be copied, but not assigned).
+
+ // b.2) Functions that allow changes in problem parameters.
+
+  ARFUNC& GetOperator() { return func; }
+  // Returns the callable object that evaluates OP*x. Changes made to
+  // its state (through this reference) are seen by the next product.
+
+  void ChangeOperator(const ARFUNC& funcp);
+  // Changes the callable object that evaluates OP*x.
+
+  void SetRegularMode(const ARFUNC& funcp);
+  // Turns problem to regular mode.
+
+  void SetShiftInvertMode(ARTYPE sigmap, const ARFUNC& funcp);
+  // Turns problem to shift and invert mode with shift defined by sigmap.
+
+ // b.3) Function that permits step by step execution of ARPACK.
+
+  virtual void Iterate() {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "Iterate");
+  }
+  // Takes one iteration of IRA method.
+
+ // b.4) Function that performs all calculations in one step.
+
+  virtual int FindArnoldiBasis();
+  // Determines the Arnoldi basis related to the given problem.
+
+ // b.5) Constructors and destructor.
+
+  ARFuncStdEig() { }
+  // Constructor (requires ARFUNC to have a default constructor).
+
+  ARFuncStdEig(const ARFUNC& funcp): func(funcp) { }
+  // Constructor that only stores the callable object.
+
+  ARFuncStdEig(const ARFuncStdEig& other): func(other.func)
+  {
+    ARrcStdEig<ARFLOAT, ARTYPE>::Copy(other);
+  }
+  // Copy constructor.
+
+  virtual ~ARFuncStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARFuncStdEig& operator=(const ARFuncStdEig& other);
+  // Assignment operator (requires ARFUNC to be assignable).
+
+}; // class ARFuncStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARFuncStdEig member functions definition.                                //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARTYPE, class ARFUNC>
+void ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>::
+DefineParameters(int np, int nevp, const ARFUNC& funcp,
+                 const std::string& whichp, int ncvp, ARFLOAT tolp,
+                 int maxitp, ARTYPE* residp, bool ishiftp)
+{
+
+  ARrcStdEig<ARFLOAT, ARTYPE>::DefineParameters(np, nevp, whichp, ncvp, tolp,
+                                                maxitp, residp, ishiftp);
+  func = funcp;
+
+} // DefineParameters.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFUNC>
+inline void ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>::
+ChangeOperator(const ARFUNC& funcp)
+{
+
+  func = funcp;
+  this->Restart();
+
+} // ChangeOperator.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFUNC>
+inline void ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>::
+SetRegularMode(const ARFUNC& funcp)
+{
+
+  ChangeOperator(funcp);
+  this->NoShift();
+
+} // SetRegularMode.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFUNC>
+inline void ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>::
+SetShiftInvertMode(ARTYPE sigmap, const ARFUNC& funcp)
+{
+
+  ChangeOperator(funcp);
+  this->ChangeShift(sigmap);
+
+} // SetShiftInvertMode.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFUNC>
+int ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>::FindArnoldiBasis()
+{
+
+  if (!this->BasisOK) this->Restart();
+
+  // Changing to auto shift mode.
+
+  if (!this->AutoShift) {
+    ArpackError::Set(ArpackError::CHANGING_AUTOSHIFT, "FindArnoldiBasis");
+    this->AutoShift=true;
+  }
+
+  // ARPACK main loop.
+
+  while (!this->BasisOK) {
+
+    // Calling Aupp.
+
+    try { this->TakeStep(); }
+    catch (const ArpackError&) {
+      ArpackError(ArpackError::CANNOT_FIND_BASIS, "FindArnoldiBasis");
+      return 0;
+    }
+
+    if ((this->ido == -1) || (this->ido == 1)) {
+
+      // Performing Matrix vector multiplication: y <- OP*x.
+
+      func(&this->workd[this->ipntr[1]], &this->workd[this->ipntr[2]]);
+
+    }
+
+  }
+  return this->nconv;
+
+} // FindArnoldiBasis.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFUNC>
+ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>& ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>::
+operator=(const ARFuncStdEig<ARFLOAT, ARTYPE, ARFUNC>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    ARrcStdEig<ARFLOAT, ARTYPE>::Copy(other);
+    func = other.func;
+  }
+  return *this;
+
+} // operator=.
+
+
+// ARFuncSymStdEig class definition.
+
+template<class ARFLOAT, class ARFUNC>
+class ARFuncSymStdEig:
+  public virtual ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>,
+  public virtual ARrcSymStdEig<ARFLOAT> {
+
+ public:
+
+ // a) Constructors and destructor.
+
+  ARFuncSymStdEig() { }
+  // Short constructor.
+
+  ARFuncSymStdEig(int np, int nevp, const ARFUNC& funcp,
+                  const std::string& whichp = "LM", int ncvp = 0,
+                  ARFLOAT tolp = 0.0, int maxitp = 0, ARFLOAT* residp = NULL,
+                  bool ishiftp = true);
+  // Long constructor (regular mode).
+
+  ARFuncSymStdEig(int np, int nevp, const ARFUNC& funcp, ARFLOAT sigmap,
+                  const std::string& whichp = "LM", int ncvp = 0,
+                  ARFLOAT tolp = 0.0, int maxitp = 0, ARFLOAT* residp = NULL,
+                  bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARFuncSymStdEig(const ARFuncSymStdEig& other):
+    ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>(other) { }
+  // Copy constructor.
+
+  virtual ~ARFuncSymStdEig() { }
+  // Destructor.
+
+ // b) Operators.
+
+  ARFuncSymStdEig& operator=(const ARFuncSymStdEig& other)
+  {
+    ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>::operator=(other);
+    return *this;
+  }
+  // Assignment operator.
+
+}; // class ARFuncSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARFuncSymStdEig member functions definition.                             //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFUNC>
+inline ARFuncSymStdEig<ARFLOAT, ARFUNC>::
+ARFuncSymStdEig(int np, int nevp, const ARFUNC& funcp,
+                const std::string& whichp, int ncvp, ARFLOAT tolp,
+                int maxitp, ARFLOAT* residp, bool ishiftp):
+  ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>(funcp)
+
+{
+
+  this->NoShift();
+  this->DefineParameters(np, nevp, whichp, ncvp, tolp, maxitp, residp,
+                         ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFUNC>
+inline ARFuncSymStdEig<ARFLOAT, ARFUNC>::
+ARFuncSymStdEig(int np, int nevp, const ARFUNC& funcp, ARFLOAT sigmap,
+                const std::string& whichp, int ncvp, ARFLOAT tolp,
+                int maxitp, ARFLOAT* residp, bool ishiftp):
+  ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>(funcp)
+
+{
+
+  this->ChangeShift(sigmap);
+  this->DefineParameters(np, nevp, whichp, ncvp, tolp, maxitp, residp,
+                         ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+// ARFuncNonSymStdEig class definition.
+
+template<class ARFLOAT, class ARFUNC>
+class ARFuncNonSymStdEig:
+  public virtual ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>,
+  public virtual ARrcNonSymStdEig<ARFLOAT> {
+
+ public:
+
+ // a) Constructors and destructor.
+
+  ARFuncNonSymStdEig() { }
+  // Short constructor.
+
+  ARFuncNonSymStdEig(int np, int nevp, const ARFUNC& funcp,
+                     const std::string& whichp = "LM", int ncvp = 0,
+                     ARFLOAT tolp = 0.0, int maxitp = 0,
+                     ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (regular mode).
+
+  ARFuncNonSymStdEig(int np, int nevp, const ARFUNC& funcp, ARFLOAT sigmap,
+                     const std::string& whichp = "LM", int ncvp = 0,
+                     ARFLOAT tolp = 0.0, int maxitp = 0,
+                     ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARFuncNonSymStdEig(const ARFuncNonSymStdEig& other):
+    ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>(other) { }
+  // Copy constructor.
+
+  virtual ~ARFuncNonSymStdEig() { }
+  // Destructor.
+
+ // b) Operators.
+
+  ARFuncNonSymStdEig& operator=(const ARFuncNonSymStdEig& other)
+  {
+    ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>::operator=(other);
+    return *this;
+  }
+  // Assignment operator.
+
+}; // class ARFuncNonSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARFuncNonSymStdEig member functions definition.                          //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFUNC>
+inline ARFuncNonSymStdEig<ARFLOAT, ARFUNC>::
+ARFuncNonSymStdEig(int np, int nevp, const ARFUNC& funcp,
+                   const std::string& whichp, int ncvp, ARFLOAT tolp,
+                   int maxitp, ARFLOAT* residp, bool ishiftp):
+  ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>(funcp)
+
+{
+
+  this->NoShift();
+  this->DefineParameters(np, nevp, whichp, ncvp, tolp, maxitp, residp,
+                         ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFUNC>
+inline ARFuncNonSymStdEig<ARFLOAT, ARFUNC>::
+ARFuncNonSymStdEig(int np, int nevp, const ARFUNC& funcp, ARFLOAT sigmap,
+                   const std::string& whichp, int ncvp, ARFLOAT tolp,
+                   int maxitp, ARFLOAT* residp, bool ishiftp):
+  ARFuncStdEig<ARFLOAT, ARFLOAT, ARFUNC>(funcp)
+
+{
+
+  this->ChangeShift(sigmap);
+  this->DefineParameters(np, nevp, whichp, ncvp, tolp, maxitp, residp,
+                         ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+// ARFuncCompStdEig class definition.
+
+template<class ARFLOAT, class ARFUNC>
+class ARFuncCompStdEig:
+  public virtual ARFuncStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFUNC>,
+  public virtual ARrcCompStdEig<ARFLOAT> {
+
+ public:
+
+ // a) Constructors and destructor.
+
+  ARFuncCompStdEig() { }
+  // Short constructor.
+
+  ARFuncCompStdEig(int np, int nevp, const ARFUNC& funcp,
+                   const std::string& whichp = "LM", int ncvp = 0,
+                   ARFLOAT tolp = 0.0, int maxitp = 0,
+                   arcomplex<ARFLOAT>* residp = NULL, bool ishiftp = true);
+  // Long constructor (regular mode).
+
+  ARFuncCompStdEig(int np, int nevp, const ARFUNC& funcp,
+                   arcomplex<ARFLOAT> sigmap,
+                   const std::string& whichp = "LM", int ncvp = 0,
+                   ARFLOAT tolp = 0.0, int maxitp = 0,
+                   arcomplex<ARFLOAT>* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARFuncCompStdEig(const ARFuncCompStdEig& other):
+    ARFuncStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFUNC>(other) { }
+  // Copy constructor.
+
+  virtual ~ARFuncCompStdEig() { }
+  // Destructor.
+
+ // b) Operators.
+
+  ARFuncCompStdEig& operator=(const ARFuncCompStdEig& other)
+  {
+    ARFuncStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFUNC>::operator=(other);
+    return *this;
+  }
+  // Assignment operator.
+
+}; // class ARFuncCompStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARFuncCompStdEig member functions definition.                            //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFUNC>
+inline ARFuncCompStdEig<ARFLOAT, ARFUNC>::
+ARFuncCompStdEig(int np, int nevp, const ARFUNC& funcp,
+                 const std::string& whichp, int ncvp, ARFLOAT tolp,
+                 int maxitp, arcomplex<ARFLOAT>* residp, bool ishiftp):
+  ARFuncStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFUNC>(funcp)
+
+{
+
+  this->NoShift();
+  this->DefineParameters(np, nevp, whichp, ncvp, tolp, maxitp, residp,
+                         ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFUNC>
+inline ARFuncCompStdEig<ARFLOAT, ARFUNC>::
+ARFuncCompStdEig(int np, int nevp, const ARFUNC& funcp,
+                 arcomplex<ARFLOAT> sigmap, const std::string& whichp,
+                 int ncvp, ARFLOAT tolp, int maxitp,
+                 arcomplex<ARFLOAT>* residp, bool ishiftp):
+  ARFuncStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFUNC>(funcp)
+
+{
+
+  this->ChangeShift(sigmap);
+  this->DefineParameters(np, nevp, whichp, ncvp, tolp, maxitp, residp,
+                         ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+#endif // ARFUNC_H
@@ -4,7 +4,11 @@
 
    MODULE ARHBMat.h
    Matrix template that generates a matrix in CSC format
-   from a Harwell-Boing matrix file.
+   from a Harwell-Boing matrix file. The data section of the
+   file is mapped into memory and parsed in parallel (one chunk
+   of lines per thread) when OpenMP is available. Files written
+   by WriteBinary (see arbfile.h) are also accepted; in this case
+   the matrix arrays point directly to the mapped file.
 
    ARPACK authors:
       Richard Lehoucq
@@ -22,11 +26,18 @@
 
 #include <cstddef>
 #include <fstream>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <string>
+#include <vector>
 #include "arch.h"
 #include "arerror.h"
+#include "arbfile.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 template<class ARINT, class ARTYPE>
@@ -44,21 +55,39 @@ class ARhbMatrix {
   ARINT*      irow;        // Row indices.
   ARINT*      pcol;        // Column pointers.
   ARTYPE*     val;         // Numerical values of matrix entries.
+  const char* fdata;       // Binary file mapped into memory (or NULL).
+  size_t      fsize;       // Size of fdata.
+  bool        fmapped;     // Indicates if fdata was obtained by mmap.
+
+  static ARINT ParseInt(const char* p, const char* end);
+
+  static double ParseDouble(const char* p, const char* end);
 
-  void ConvertDouble(char* num);
+  static void StoreEntry(double* v, int i, double x) { v[i] = x; }
+
+  static void StoreEntry(float* v, int i, double x) { v[i] = (float)x; }
+
+  static void StoreEntry(arcomplex<double>* v, int i, double x)
+  {
+    ((double*)v)[i] = x;
+  }
 
-  bool ReadEntry(std::ifstream& file, int nval, int fval, int& j, double& val);
+  static void StoreEntry(arcomplex<float>* v, int i, double x)
+  {
+    ((float*)v)[i] = (float)x;
+  }
 
-  bool ReadEntry(std::ifstream& file, int nval, int fval, int& j, float& val);
+  static ARINT* ReadIndex(const char* data, unsigned isize, int k);
 
-  bool ReadEntry(std::ifstream& file, int nval, int fval,
-                 int& j, arcomplex<double>& val);
+  void ClearMem();
 
-  bool ReadEntry(std::ifstream& file, int nval, int fval,
-                 int& j, arcomplex<float>& val);
+  bool ReadData(const char* data, size_t size, int npcol, int fpcol,
+                int nirow, int firow, int nval, int fval);
 
   void ReadFormat(std::ifstream& file, int& n, int& fmt);
 
+  void DefineBinary(const std::string& filename);
+
  public:
 
   bool IsDefined() { return (m!=0); }
@@ -98,10 +127,14 @@ class ARhbMatrix {
   void Define(const std::string& filename);
   // Function that reads the matrix file. 
 
+  void WriteBinary(const std::string& filename);
+  // Function that stores the matrix in a binary file (see arbfile.h)
+  // that can be read by Define without any parsing.
+
   ARhbMatrix();
   // Short constructor.
 
-  ARhbMatrix(const std::string& filename) { Define(filename); }
+  ARhbMatrix(const std::string& filename);
   // Long constructor.
 
   ~ARhbMatrix();
@@ -116,115 +149,262 @@ class ARhbMatrix {
 
 
 template<class ARINT, class ARTYPE>
-inline void ARhbMatrix<ARINT, ARTYPE>::ConvertDouble(char* num) 
+ARINT ARhbMatrix<ARINT, ARTYPE>::ParseInt(const char* p, const char* end)
 {
 
-  char* pd;
+  // Reads an integer stored in [p, end) (as atoi does).
 
-  pd = strchr((char*)num,'D');
-  if (pd) *pd = 'E';
-  pd = strchr((char*)num,'d');
-  if (pd) *pd = 'E';
+  ARINT v;
+  bool  neg;
 
+  v   = 0;
+  neg = false;
+  while ((p < end) && ((*p == ' ') || (*p == '\t'))) p++;
+  if ((p < end) && ((*p == '+') || (*p == '-'))) neg = (*p++ == '-');
+  while ((p < end) && (*p >= '0') && (*p <= '9')) v = 10*v+ARINT(*p++ -'0');
+  return neg ? -v : v;
 
-} // ConvertDouble.
+} // ParseInt.
 
 
 template<class ARINT, class ARTYPE>
-inline bool ARhbMatrix<ARINT, ARTYPE>::
-ReadEntry(std::ifstream& file, int nval, int fval, int& j, double& val)
+double ARhbMatrix<ARINT, ARTYPE>::ParseDouble(const char* p, const char* end)
 {
 
-  char num[81];
-  char c;
+  // Reads a real number stored in [p, end) in any FORTRAN format
+  // (D and Q exponents and exponents without a letter are accepted).
+  // The result does not depend on the locale. When the mantissa and
+  // the power of ten are exactly representable, a single product or
+  // division gives the correctly rounded value. Otherwise, strtod is
+  // called with a string that does not contain a decimal point.
+
+  static const double pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  const double maxmant = 9007199254740992.0; // 2^53.
+
+  char   buf[128];
+  int    ndig, e10, ex, k;
+  bool   neg, eneg, exact;
+  double mant;
+
+  // Reading the sign.
+
+  while ((p < end) && ((*p == ' ') || (*p == '\t'))) p++;
+  neg = false;
+  if ((p < end) && ((*p == '+') || (*p == '-'))) neg = (*p++ == '-');
+
+  // Reading the mantissa. Leading zeros are skipped.
+
+  mant  = 0.0;
+  ndig  = 0;
+  e10   = 0;
+  exact = true;
+  while ((p < end) && (*p == '0')) p++;
+  for (k=0; k<2; k++) {
+    while ((p < end) && (*p >= '0') && (*p <= '9')) {
+      if ((ndig > 0) || (*p != '0')) {
+        if (ndig < 100) buf[ndig++] = *p;
+        else e10++;
+        if (mant*10.0+9.0 <= maxmant) mant = mant*10.0+double(*p-'0');
+        else exact = false;
+      }
+      if (k == 1) e10--;
+      p++;
+    }
+    if ((k == 0) && (p < end) && (*p == '.')) p++;
+    else break;
+  }
 
-  if (file.get((char*)num,fval,'\n')) {
-    ConvertDouble((char*)num);
-    val = atof((char*)num);
-    if (!((++j)%nval)) do file.get(c); while (c!='\n'); 
-    return true;
+  // Reading the exponent.
+
+  if ((p < end) && ((*p == 'E') || (*p == 'e') || (*p == 'D') ||
+                    (*p == 'd') || (*p == 'Q') || (*p == 'q'))) p++;
+  eneg = false;
+  if ((p < end) && ((*p == '+') || (*p == '-'))) eneg = (*p++ == '-');
+  ex = 0;
+  while ((p < end) && (*p >= '0') && (*p <= '9')) {
+    if (ex < 100000) ex = 10*ex+(*p-'0');
+    p++;
   }
-  else {
-    return false;
+  e10 += eneg ? -ex : ex;
+
+  // Computing the result.
+
+  if (ndig == 0) return neg ? -0.0 : 0.0;
+  if (exact && (e10 >= -22) && (e10 <= 22)) {
+    mant = (e10 < 0) ? mant/pow10[-e10] : mant*pow10[e10];
+    return neg ? -mant : mant;
   }
+  sprintf(&buf[ndig], "E%d", e10);
+  mant = strtod(buf, NULL);
+  return neg ? -mant : mant;
 
-} // ReadEntry (double).
+} // ParseDouble.
 
 
 template<class ARINT, class ARTYPE>
-inline bool ARhbMatrix<ARINT, ARTYPE>::
-ReadEntry(std::ifstream& file, int nval, int fval, int& j, float& val)
+ARINT* ARhbMatrix<ARINT, ARTYPE>::
+ReadIndex(const char* data, unsigned isize, int k)
 {
 
-  double dval;
-  bool   ret;
-  
-  ret = ReadEntry(file, nval, fval, j, dval);
-  val = (float)dval;
-  return ret;
+  // Returns the k indices of size isize stored in data, converted to
+  // ARINT (no copy is made when isize == sizeof(ARINT)).
+
+  ARINT* ind;
+  int    i;
 
-} // ReadEntry (float).
+  if (isize == sizeof(ARINT)) return (ARINT*)data;
+  if ((isize != sizeof(int)) && (isize != sizeof(long))) {
+    throw ArpackError(ArpackError::WRONG_DATA_TYPE, "ARhbMatrix");
+  }
+  ind = new ARINT[k];
+  for (i=0; i<k; i++) {
+    ind[i] = (isize == sizeof(int)) ? ARINT(((const int*)data)[i])
+                                    : ARINT(((const long*)data)[i]);
+  }
+  return ind;
+
+} // ReadIndex.
 
 
 template<class ARINT, class ARTYPE>
-inline bool ARhbMatrix<ARINT, ARTYPE>::
-ReadEntry(std::ifstream& file, int nval, int fval,
-          int& j, arcomplex<double>& val)
+void ARhbMatrix<ARINT, ARTYPE>::ClearMem()
 {
 
-  char num[81], img[81];
-  char c;
+  // Arrays that point to the mapped file are not deleted.
 
-  if (file.get((char*)num,fval,'\n')) {
-    ConvertDouble((char*)num);
-    if (!((++j)%nval)) do file.get(c); while (c!='\n'); 
-    if (file.get((char*)img,fval,'\n')) {
-      ConvertDouble((char*)img);
-      if (!((++j)%nval)) do file.get(c); while (c!='\n'); 
-      val = arcomplex<double>(atof((char*)num), atof((char*)img));
-      return true;
-    }
-    else {
-      return false;
-    }
-  }
-  else {
-    return false;
-  }
+  if (!ARbfInside(irow, fdata, fsize)) delete[] irow;
+  if (!ARbfInside(pcol, fdata, fsize)) delete[] pcol;
+  if (!ARbfInside(val,  fdata, fsize)) delete[] val;
+  ARbfUnmapFile(fdata, fsize, fmapped);
+  irow  = NULL;
+  pcol  = NULL;
+  val   = NULL;
+  fdata = NULL;
+  fsize = 0;
 
-} // ReadEntry (arcomplex<double>).
+} // ClearMem.
 
 
 template<class ARINT, class ARTYPE>
-inline bool ARhbMatrix<ARINT, ARTYPE>::
-ReadEntry(std::ifstream& file, int nval, int fval,
-          int& j, arcomplex<float>& val)
+bool ARhbMatrix<ARINT, ARTYPE>::
+ReadData(const char* data, size_t size, int npcol, int fpcol,
+         int nirow, int firow, int nval, int fval)
 {
 
-  // I hope one day c++ will have a standard complex
-  // class, so functions like this can be suppressed.
-
-  char num[81], img[81];
-  char c;
+  // Reads column pointers, row indices and matrix elements from
+  // [data, data+size). The data is split into chunks of whole lines
+  // that are parsed in parallel. Since the number of fields in each
+  // line is fixed by the format, the position of the first entry of
+  // a chunk in pcol, irow or val only depends on the number of lines
+  // that precede the chunk, that is counted in a first pass.
+
+  int    c, nchunk, bad;
+  long   lptr, lind, lval, ltot;
+
+  // Defining the number of lines of each section.
+
+  lptr  = (long(n)+long(npcol))/long(npcol);
+  lind  = (long(nnz)+long(nirow)-1)/long(nirow);
+  lval  = (long(nnz)*(IsComplex() ? 2 : 1)+long(nval)-1)/long(nval);
+  ltot  = lptr+lind+lval;
+
+  // Splitting the data into chunks that begin at the start of a line.
+
+  nchunk = 1;
+#ifdef _OPENMP
+  nchunk = 4*omp_get_max_threads();
+  if (size_t(nchunk) > size/65536+1) nchunk = int(size/65536+1);
+#endif
+
+  std::vector<size_t> first(nchunk+1);
+  std::vector<long>   line(nchunk+1, 0);
+
+  first[0]      = 0;
+  first[nchunk] = size;
+  for (c=1; c<nchunk; c++) {
+    const char* q;
+    first[c] = (size/size_t(nchunk))*size_t(c);
+    if (first[c] < first[c-1]) first[c] = first[c-1];
+    q = (const char*)memchr(data+first[c], '\n', size-first[c]);
+    first[c] = (q != NULL) ? size_t(q-data)+1 : size;
+  }
 
-  if (file.get((char*)num,fval,'\n')) {
-    ConvertDouble((char*)num);
-    if (!((++j)%nval)) do file.get(c); while (c!='\n'); 
-    if (file.get((char*)img,fval,'\n')) {
-      ConvertDouble((char*)img);
-      if (!((++j)%nval)) do file.get(c); while (c!='\n'); 
-      val = arcomplex<float>(atof((char*)num), atof((char*)img));
-      return true;
-    }
-    else {
-      return false;
+  // First pass: counting the lines of each chunk.
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for (c=0; c<nchunk; c++) {
+    const char* p   = data+first[c];
+    const char* end = data+first[c+1];
+    while ((p < end) &&
+           ((p = (const char*)memchr(p, '\n', size_t(end-p))) != NULL)) {
+      line[c+1]++;
+      p++;
     }
   }
-  else {
-    return false;
+  if ((size > 0) && (data[size-1] != '\n')) line[nchunk]++;
+  for (c=0; c<nchunk; c++) line[c+1] += line[c];
+
+  if (line[nchunk] < ltot) return false;
+
+  // Second pass: parsing all lines. Fields are read as in the original
+  // FORTRAN format, so a field may be shorter than fpcol, firow or fval
+  // only if it is the last one of a line.
+
+  bad = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) reduction(+:bad)
+#endif
+  for (c=0; c<nchunk; c++) {
+
+    const char* p   = data+first[c];
+    const char* end = data+first[c+1];
+    const char *eol, *lend, *f;
+    long        g, k, k0, k1;
+
+    for (g=line[c]; (g<ltot) && (p<end); g++) {
+
+      eol  = (const char*)memchr(p, '\n', size_t(end-p));
+      if (eol == NULL) eol = end;
+      lend = ((eol > p) && (eol[-1] == '\r')) ? eol-1 : eol;
+
+      if (g < lptr) {                  // Column pointers.
+        k0 = g*npcol;
+        k1 = (k0+npcol < long(n)+1) ? k0+npcol : long(n)+1;
+        for (k=k0, f=p; k<k1; k++, f+=fpcol) {
+          if (f >= lend) { bad++; break; }
+          pcol[k] = ParseInt(f, (f+fpcol < lend) ? f+fpcol : lend)-1;
+        }
+      }
+      else if (g < lptr+lind) {        // Row indices.
+        k0 = (g-lptr)*nirow;
+        k1 = (k0+nirow < long(nnz)) ? k0+nirow : long(nnz);
+        for (k=k0, f=p; k<k1; k++, f+=firow) {
+          if (f >= lend) { bad++; break; }
+          irow[k] = ParseInt(f, (f+firow < lend) ? f+firow : lend)-1;
+        }
+      }
+      else {                           // Matrix elements.
+        k0 = (g-lptr-lind)*nval;
+        k1 = long(nnz)*(IsComplex() ? 2 : 1);
+        if (k0+nval < k1) k1 = k0+nval;
+        for (k=k0, f=p; k<k1; k++, f+=fval) {
+          if (f >= lend) { bad++; break; }
+          StoreEntry(val, int(k),
+                     ParseDouble(f, (f+fval < lend) ? f+fval : lend));
+        }
+      }
+      p = eol+1;
+
+    }
   }
 
-} // ReadEntry (arcomplex<float>).
+  return (bad == 0);
+
+} // ReadData.
 
 
 template<class ARINT, class ARTYPE>
@@ -258,15 +438,23 @@ void ARhbMatrix<ARINT, ARTYPE>::Define(const std::string& filename)
 
   // Declaring variables.
 
-  int    i, j;
-  int    lintot, linptr, linind, linval, linrhs; 
-  int    npcol, fpcol, nirow, firow, nval, fval;
-  char   c;
-  char   num[81];
-  char   titlechar[73];
-  char   namechar[9];
-  char   typechar[4];
-  ARTYPE value;
+  int         lintot, linptr, linind, linval, linrhs;
+  int         npcol, fpcol, nirow, firow, nval, fval;
+  char        c;
+  char        titlechar[73];
+  char        namechar[9];
+  char        typechar[4];
+  bool        mapped, ok;
+  size_t      start, size;
+  const char* data;
+
+  // Reading binary files.
+
+  ClearMem();
+  if (ARbfIsBinary(filename)) {
+    DefineBinary(filename);
+    return;
+  }
 
   // Opening file.
 
@@ -314,7 +502,8 @@ void ARhbMatrix<ARINT, ARTYPE>::Define(const std::string& filename)
   ReadFormat(file, nirow, firow);
   ReadFormat(file, nval, fval);
   do file.get(c); while (c!='\n'); 
-  if ((fpcol<1) || (firow<1) || (fval<1)) {
+  if ((fpcol<1) || (firow<1) || (fval<1) ||
+      (npcol<1) || (nirow<1) || (nval<1)) {
     throw ArpackError(ArpackError::WRONG_DATA_TYPE, "ARhbMatrix");
   }
 
@@ -325,56 +514,148 @@ void ARhbMatrix<ARINT, ARTYPE>::Define(const std::string& filename)
     ArpackError(ArpackError::RHS_IGNORED, "ARhbMatrix");
   }
 
-  // Reading column pointers.
+  // Reading column pointers, row indices and matrix elements directly
+  // from memory.
+
+  start = size_t(file.tellg());
+  file.close();
 
   pcol = new ARINT[n+1];
-  fpcol++;
-  i = 0;
-  while ((i <= n) && (file.get((char*)num,fpcol,'\n'))) {
-    pcol[i++] = atoi((char*)num)-1;
-    if (!(i%npcol)) do file.get(c); while (c!='\n'); 
-  }
-  if (i%npcol) do file.get(c); while (c!='\n'); 
+  irow = new ARINT[nnz];
+  val  = new ARTYPE[nnz];
+
+  data = ARbfMapFile(datafile, size, mapped);
+  ok   = (data != NULL) && (start <= size) &&
+         ReadData(data+start, size-start, npcol, fpcol, nirow, firow,
+                  nval, fval);
+  ARbfUnmapFile(data, size, mapped);
 
-  if (i <= n) {
+  if (!ok) {
     throw ArpackError(ArpackError::UNEXPECTED_EOF, "ARhbMatrix");
   }
 
-  // Reading row indices.
+} // Define.
 
-  irow = new ARINT[nnz];
-  firow++;
-  i = 0;
-  while ((i < nnz) && (file.get((char*)num,firow,'\n'))) {
-    irow[i++] = atoi((char*)num)-1;
-    if (!(i%nirow)) do file.get(c); while (c!='\n'); 
+
+template<class ARINT, class ARTYPE>
+void ARhbMatrix<ARINT, ARTYPE>::DefineBinary(const std::string& filename)
+{
+
+  // Declaring variables.
+
+  const ARbfHeader* head;
+  size_t            ofptr, ofind, ofval, end;
+  unsigned          sum1, sum2;
+  char              typechar[4];
+
+  // Mapping the file into memory.
+
+  datafile = filename;
+  fdata    = ARbfMapFile(datafile, fsize, fmapped, true);
+
+  if (fdata == NULL) {
+    throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARhbMatrix");
   }
-  if (i%nirow) do file.get(c); while (c!='\n'); 
-  
-  if (i < nnz) { 
+
+  // Reading the heading.
+
+  head = (const ARbfHeader*)fdata;
+  if ((!ARbfCheckHeader(fdata, fsize)) || (head->kind != ARbfSparse)) {
+    ClearMem();
+    throw ArpackError(ArpackError::WRONG_DATA_TYPE, "ARhbMatrix");
+  }
+
+  m     = head->m;
+  n     = head->n;
+  nnz   = head->nnz;
+  memcpy(typechar, head->type, 3);
+  typechar[3] = '\0';
+  type  = std::string(typechar);
+  ofptr = sizeof(ARbfHeader);
+  ofind = ofptr+ARbfAlign(size_t(n+1)*head->isize);
+  ofval = ofind+ARbfAlign(size_t(nnz)*head->isize);
+  end   = ofval+ARbfAlign(size_t(nnz)*ARbfValueSize(head->vtype));
+
+  if (fsize < end) {
+    ClearMem();
     throw ArpackError(ArpackError::UNEXPECTED_EOF, "ARhbMatrix");
   }
 
-  // Reading matrix elements.
+  // Verifying the checksum.
 
-  fval++;
-  val = new ARTYPE[nnz];
-  i = 0;
-  j = 0;
-  while ((i < nnz) && (ReadEntry(file, nval, fval, j, value))) {
-    val[i++] = value;
-  }  
-  if (j%nval) do file.get(c); while (c!='\n'); 
+  sum1 = sum2 = 0;
+  ARbfChecksum(fdata+ofptr, end-ofptr, sum1, sum2);
+  if ((sum1 != head->sum1) || (sum2 != head->sum2)) {
+    ClearMem();
+    throw ArpackError(ArpackError::INCONSISTENT_DATA, "ARhbMatrix");
+  }
 
-  if (i < nnz) {
-    throw ArpackError(ArpackError::UNEXPECTED_EOF, "ARhbMatrix");
+  // Pointing pcol, irow and val to the file data. A copy is only
+  // made if the types used in the file and by ARhbMatrix differ.
+
+  pcol = ReadIndex(fdata+ofptr, head->isize, n+1);
+  irow = ReadIndex(fdata+ofind, head->isize, nnz);
+  if (head->vtype == ARbfValueType((ARTYPE*)NULL)) {
+    val = (ARTYPE*)(fdata+ofval);
+  }
+  else {
+    val = new ARTYPE[nnz];
+    if (!ARbfCopy(fdata+ofval, head->vtype, val, size_t(nnz))) {
+      ClearMem();
+      throw ArpackError(ArpackError::WRONG_MATRIX_TYPE, "ARhbMatrix");
+    }
   }
 
-  // Closing file and reporting success.
+} // DefineBinary.
 
-  file.close();
 
-} // Define.
+template<class ARINT, class ARTYPE>
+void ARhbMatrix<ARINT, ARTYPE>::WriteBinary(const std::string& filename)
+{
+
+  ARbfHeader head;
+  unsigned   sum1, sum2;
+  size_t     bytes;
+
+  if (!IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARhbMatrix::WriteBinary");
+  }
+
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary |
+                                       std::ios::trunc);
+  if (!file) {
+    throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARhbMatrix::WriteBinary");
+  }
+
+  // Writing the heading (without the checksum) and the matrix data.
+
+  ARbfInitHeader(head, ARbfSparse, ARbfValueType(val), sizeof(ARINT),
+                 type, m, n, nnz, 0);
+  file.write((const char*)&head, sizeof(head));
+
+  sum1 = sum2 = 0;
+  bytes = size_t(n+1)*sizeof(ARINT);
+  ARbfWrite(file, pcol, bytes, sum1, sum2);
+  ARbfPad(file, bytes, sum1, sum2);
+  bytes = size_t(nnz)*sizeof(ARINT);
+  ARbfWrite(file, irow, bytes, sum1, sum2);
+  ARbfPad(file, bytes, sum1, sum2);
+  bytes = size_t(nnz)*sizeof(ARTYPE);
+  ARbfWrite(file, val, bytes, sum1, sum2);
+  ARbfPad(file, bytes, sum1, sum2);
+
+  // Writing the checksum.
+
+  head.sum1 = sum1;
+  head.sum2 = sum2;
+  file.seekp(0);
+  file.write((const char*)&head, sizeof(head));
+
+  if (!file) {
+    throw ArpackError(ArpackError::CANNOT_OPEN_FILE, "ARhbMatrix::WriteBinary");
+  }
+
+} // WriteBinary.
 
 
 template<class ARINT, class ARTYPE>
@@ -388,17 +669,33 @@ ARhbMatrix<ARINT, ARTYPE>::ARhbMatrix()
   pcol    = NULL;
   irow    = NULL;
   val     = NULL;
+  fdata   = NULL;
+  fsize   = 0;
+  fmapped = false;
 
 } // Short constructor.
 
 
+template<class ARINT, class ARTYPE>
+ARhbMatrix<ARINT, ARTYPE>::ARhbMatrix(const std::string& filename)
+{
+
+  pcol    = NULL;
+  irow    = NULL;
+  val     = NULL;
+  fdata   = NULL;
+  fsize   = 0;
+  fmapped = false;
+  Define(filename);
+
+} // Long constructor.
+
+
 template<class ARINT, class ARTYPE>
 ARhbMatrix<ARINT, ARTYPE>::~ARhbMatrix()
 {
 
-  if (irow != NULL) delete[] irow;
-  if (pcol != NULL) delete[] pcol;
-  if (val  != NULL) delete[] val;
+  ClearMem();
 
 } // Destructor.
 
@@ -0,0 +1,300 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARKSComp.h.
+   Arpack++ class ARbkCompStdEig definition.
+   Block Krylov-Schur solver for complex
+   standard problems.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARKSCOMP_H
+#define ARKSCOMP_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "arch.h"
+#include "arkseig.h"
+#include "arrscomp.h"
+
+
+template<class ARFLOAT, class ARFOP>
+class ARbkCompStdEig:
+  virtual public ARbkStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFOP>,
+  virtual public ARrcCompStdEig<ARFLOAT> {
+
+ protected:
+
+ // a) Protected functions:
+
+  bool RitzStep(bool last);
+  // Computes the Schur form of Hm, checks convergence and restarts.
+
+  void Eupp();
+  // Computes the converged eigenvalues and eigenvectors.
+
+
+ public:
+
+ // b) Constructors and destructor.
+
+  ARbkCompStdEig() { }
+  // Short constructor.
+
+  ARbkCompStdEig(int np, int nevp, ARFOP* objOPp,
+                 void (ARFOP::* MultOPXp)(arcomplex<ARFLOAT>[],
+                                          arcomplex<ARFLOAT>[], int),
+                 const std::string& whichp = "LM", int ncvp = 0,
+                 ARFLOAT tolp = 0.0, int maxitp = 0,
+                 arcomplex<ARFLOAT>* residp = NULL, int nbp = 0);
+  // Long constructor (regular mode).
+
+  ARbkCompStdEig(int np, int nevp, ARFOP* objOPp,
+                 void (ARFOP::* MultOPXp)(arcomplex<ARFLOAT>[],
+                                          arcomplex<ARFLOAT>[], int),
+                 arcomplex<ARFLOAT> sigmap,
+                 const std::string& whichp = "LM", int ncvp = 0,
+                 ARFLOAT tolp = 0.0, int maxitp = 0,
+                 arcomplex<ARFLOAT>* residp = NULL, int nbp = 0);
+  // Long constructor (shift and invert mode).
+
+  ARbkCompStdEig(const ARbkCompStdEig& other) { this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARbkCompStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARbkCompStdEig& operator=(const ARbkCompStdEig& other);
+  // Assignment operator.
+
+}; // class ARbkCompStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARbkCompStdEig member functions definition.                              //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+bool ARbkCompStdEig<ARFLOAT, ARFOP>::RitzStep(bool last)
+{
+
+  int                i, j, k, m, nc, nb, ncv, inf;
+  ARFLOAT            theta;
+  arcomplex<ARFLOAT> one, czero;
+
+  m     = this->nbas;
+  nb    = this->nb;
+  ncv   = this->ncv;
+  one   = arcomplex<ARFLOAT>(1.0, 0.0);
+  czero = arcomplex<ARFLOAT>(0.0, 0.0);
+
+  // Computing the Schur form Hm = Sm*Tm*Sm' and the eigenvectors of Hm
+  // (stored in Ym).
+
+  lacpy("A", m, m, this->Hm, ncv, this->Tm, ncv);
+  gees("V", m, this->Tm, ncv, this->Ritz, this->Sm, ncv, this->Wk,
+       this->lwk, this->Rwk, this->Bwork, inf);
+  if (inf != 0) throw ArpackError(ArpackError::LAPACK_ERROR, "RitzStep");
+
+  lacpy("A", m, m, this->Sm, ncv, this->Ym, ncv);
+  trevc("B", this->Select, m, this->Tm, ncv, this->Ym, ncv, m, k,
+        this->Wk, this->Rwk, inf);
+  if (inf != 0) throw ArpackError(ArpackError::LAPACK_ERROR, "RitzStep");
+
+  // Sorting Ritz values according to "which".
+
+  for (i=0; i<m; i++) {
+    if (this->which == "LM")      this->Key[i] = std::abs(this->Ritz[i]);
+    else if (this->which == "SM") this->Key[i] = -std::abs(this->Ritz[i]);
+    else if (this->which == "LR") this->Key[i] = real(this->Ritz[i]);
+    else if (this->which == "SR") this->Key[i] = -real(this->Ritz[i]);
+    else if (this->which == "LI") this->Key[i] = imag(this->Ritz[i]);
+    else                          this->Key[i] = -imag(this->Ritz[i]);
+  }
+  this->SortRitz(m);
+
+  // Checking convergence of the wanted Ritz values.
+
+  this->SetTolerance(m);
+
+  nc = 0;
+  for (k=0; k<m; k++) {
+    i = this->Index[k];
+    this->Rnorm[i] = this->ResidualNorm(&this->Ym[i*ncv], m)/
+                     nrm2(m, &this->Ym[i*ncv], 1);
+    theta = std::abs(this->Ritz[i]);
+    this->Select[i] = (k < this->nev) &&
+                      this->Converged(this->Rnorm[i], theta);
+    if (this->Select[i]) nc++;
+  }
+
+  if ((nc >= this->nev) || last) {
+
+    // Moving converged Ritz values to the top of the Schur form and
+    // storing the corresponding Schur vectors in V.
+
+    if (nc > 0) {
+      trsen(this->Select, m, this->Tm, ncv, this->Sm, ncv, this->Ritz, k,
+            this->Wk, this->lwk, inf);
+      if (inf != 0) {
+        throw ArpackError(ArpackError::REORDERING_ERROR, "RitzStep");
+      }
+      this->RotateBasis(m, k, this->Sm, ncv);
+    }
+    this->nconv = nc;
+    return true;
+
+  }
+
+  // Thick restart: keeping k Schur vectors.
+
+  k = (m-this->nev)/2;
+  if ((nb == 1) && (nc < k)) k = nc;
+  k += this->nev;
+  if (k > (m-nb)) k = m-nb;
+
+  for (i=0; i<m; i++) this->Select[i] = false;
+  for (j=0; j<k; j++) this->Select[this->Index[j]] = true;
+
+  trsen(this->Select, m, this->Tm, ncv, this->Sm, ncv, this->Ritz, k,
+        this->Wk, this->lwk, inf);
+  if (inf != 0) throw ArpackError(ArpackError::REORDERING_ERROR, "RitzStep");
+
+  // Hm <- Tm(1:k,1:k); Hm(k+1:k+nb,1:k) <- Rb*Sm(m-nb+1:m,1:k).
+
+  for (j=0; j<k; j++) {
+    for (i=0; i<k; i++) {
+      this->Hm[i+j*ncv] = (i <= j) ? this->Tm[i+j*ncv] : czero;
+    }
+  }
+  gemm("N", "N", nb, k, nb, one, this->Rb, nb, &this->Sm[m-nb], ncv,
+       czero, &this->Hm[k], ncv);
+
+  this->RotateBasis(m, k, this->Sm, ncv);
+  this->nbas = k;
+  return false;
+
+} // RitzStep.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARbkCompStdEig<ARFLOAT, ARFOP>::Eupp()
+{
+
+  int                i, k, nc, ncv, inf;
+  ARFLOAT            s;
+  arcomplex<ARFLOAT> one, zero, *X;
+
+  nc   = this->nconv;
+  ncv  = this->ncv;
+  one  = arcomplex<ARFLOAT>(1.0, 0.0);
+  zero = arcomplex<ARFLOAT>(0.0, 0.0);
+
+  // Eigenvalues (lambda = sigma+1/theta in shift and invert mode).
+
+  for (i=0; i<nc; i++) {
+    if (this->mode == 3) {
+      this->EigValR[i] = this->sigmaR+one/this->Ritz[i];
+    }
+    else {
+      this->EigValR[i] = this->Ritz[i];
+    }
+  }
+
+  // Eigenvectors: X <- V(:,1:nc)*Y, where Y are the eigenvectors of the
+  // triangular matrix Tm(1:nc,1:nc). Schur vectors are kept in V unless
+  // EigVec overrides V.
+
+  this->info = 0;
+  if ((!this->rvec) || (this->HowMny != 'A') || (nc == 0)) return;
+
+  trevc("A", this->Select, nc, this->Tm, ncv, this->Ym, ncv, nc, k,
+        this->Wk, this->Rwk, inf);
+  if (inf != 0) {
+    this->info = -9;
+    return;
+  }
+
+  if (this->OverV()) {
+    this->RotateBasis(nc, nc, this->Ym, ncv);
+    X = &this->V[1];
+  }
+  else {
+    gemm("N", "N", this->n, nc, nc, one, &this->V[1], this->n, this->Ym, ncv,
+         zero, this->EigVec, this->n);
+    X = this->EigVec;
+  }
+
+  for (i=0; i<nc; i++) {
+    s = 1.0/nrm2(this->n, &X[i*this->n], 1);
+    sscal(this->n, s, &X[i*this->n], 1);
+  }
+
+} // Eupp.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARbkCompStdEig<ARFLOAT, ARFOP>::
+ARbkCompStdEig(int np, int nevp, ARFOP* objOPp,
+               void (ARFOP::* MultOPXp)(arcomplex<ARFLOAT>[],
+                                        arcomplex<ARFLOAT>[], int),
+               const std::string& whichp, int ncvp, ARFLOAT tolp,
+               int maxitp, arcomplex<ARFLOAT>* residp, int nbp)
+
+{
+
+  this->NoShift();
+  this->DefineParameters(np, nevp, objOPp, MultOPXp, whichp,
+                         ncvp, tolp, maxitp, residp, nbp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARbkCompStdEig<ARFLOAT, ARFOP>::
+ARbkCompStdEig(int np, int nevp, ARFOP* objOPp,
+               void (ARFOP::* MultOPXp)(arcomplex<ARFLOAT>[],
+                                        arcomplex<ARFLOAT>[], int),
+               arcomplex<ARFLOAT> sigmap, const std::string& whichp,
+               int ncvp, ARFLOAT tolp, int maxitp,
+               arcomplex<ARFLOAT>* residp, int nbp)
+
+{
+
+  this->ChangeShift(sigmap);
+  this->DefineParameters(np, nevp, objOPp, MultOPXp, whichp,
+                         ncvp, tolp, maxitp, residp, nbp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT, class ARFOP>
+ARbkCompStdEig<ARFLOAT, ARFOP>& ARbkCompStdEig<ARFLOAT, ARFOP>::
+operator=(const ARbkCompStdEig<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->BlockClear();
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARKSCOMP_H
+
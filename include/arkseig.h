@@ -0,0 +1,898 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARKSEig.h.
+   Arpack++ class ARbkStdEig definition.
+   This class is the base class for all block Krylov-Schur
+   standard problem templates. Unlike ARStdEig, it does not
+   call the FORTRAN ARPACK code. OP is applied to nb vectors
+   at a time through a user supplied function in the form
+   OP.MultOPX(X, Y, nb), so sparse and dense matrix-matrix
+   products can be used in place of nb matrix-vector products.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARKSEIG_H
+#define ARKSEIG_H
+
+#include <new>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "arch.h"
+#include "arerror.h"
+#include "blas1c.h"
+#include "lapackc.h"
+#include "arrseig.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template<class ARFLOAT, class ARTYPE, class ARFOP> class ARStdEig;
+
+// ARbkStdEig class definition.
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+class ARbkStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
+
+  template<class F, class T, class O> friend class ARStdEig;
+
+ public:
+
+ // a) Notation.
+
+  typedef void (ARFOP::* TypeOPX)(ARTYPE[], ARTYPE[], int);
+
+
+ protected:
+
+ // b) User defined parameters.
+
+  ARFOP   *objOP;     // Object that has MultOPX as a member function.
+  TypeOPX MultOPX;    // Function that evaluates the product OP*X, where X
+                      // is a n x nvec matrix stored by columns.
+  int     nb;         // Block size (number of vectors OP is applied to).
+  ARFOP   *objB;      // Object that has MultBX as a member function.
+  TypeOPX MultBX;     // Function that evaluates B*X. If it is defined,
+                      // the basis is B-orthonormal (generalized problems).
+
+
+ // c) Internal variables.
+
+  int       nbas;     // Number of vectors currently stored in V.
+  ARFLOAT   tolr;     // Relative tolerance used in the convergence test.
+  ARFLOAT   eps23;    // eps^(2/3).
+  ARFLOAT   rfloor;   // Residual norms below rfloor are at rounding level.
+  int       lwk;      // Dimension of array Wk.
+  unsigned long seed; // Seed used to generate random vectors.
+  ARTYPE    *Hm;      // ncv x ncv projection of OP onto V.
+  ARTYPE    *Sm;      // Eigenvectors (or Schur vectors) of Hm.
+  ARTYPE    *Tm;      // Schur form of Hm / auxiliary ncv x ncv matrix.
+  ARTYPE    *Ym;      // Eigenvectors of Tm / auxiliary ncv x ncv matrix.
+  ARTYPE    *Fb;      // n x nb block that will be appended to V.
+  ARTYPE    *Wb;      // n x nb working block.
+  ARTYPE    *Zb;      // n x nb block that stores B*X.
+  ARTYPE    *Rb;      // nb x nb matrix such that OP*V = V*Hm + Fb*Rb*E'.
+  ARTYPE    *Cb;      // ncv x nb matrix of projection coefficients.
+  ARTYPE    *Ritz;    // Ritz values (real part for nonsymmetric problems).
+  ARTYPE    *Wk;      // LAPACK workspace.
+  ARFLOAT   *RitzI;   // Imaginary part of Ritz values (nonsymmetric case).
+  ARFLOAT   *Rnorm;   // Residual norms of Ritz pairs.
+  ARFLOAT   *Key;     // Sorting key used to order Ritz values.
+  ARFLOAT   *Rwk;     // LAPACK real workspace (complex problems).
+  int       *Index;   // Ritz values sorted according to "which".
+  int       *Iwk;     // LAPACK integer workspace.
+  ARlogical *Select;  // Ritz values that must be kept after a restart.
+  ARlogical *Bwork;   // LAPACK logical workspace.
+
+
+ // d) Protected functions:
+
+ // d.1) Memory control functions.
+
+  void BlockInit();
+  // Sets all block pointers to NULL.
+
+  void BlockAllocate();
+  // Creates the arrays used by the block Krylov-Schur method.
+
+  void BlockClear();
+  // Deletes the arrays used by the block Krylov-Schur method.
+
+  virtual void Prepare();
+  // Adjusts nb and ncv and allocates working arrays.
+
+  virtual void Copy(const ARbkStdEig& other);
+  // Makes a deep copy of "other" over "this" object.
+  // Old values are not deleted (this function is to be used
+  // by the copy constructor and the assignment operator only).
+
+
+ // d.2) Functions that build the Krylov basis.
+
+  virtual void MultOPBlock(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Performs Y <- OP*X, where X and Y are n x nvec matrices.
+
+  ARTYPE* MultBBlock(ARTYPE* X, int nvec);
+  // Stores B*X in Zb and returns Zb (returns X if B is not defined).
+
+  ARFLOAT Norm(ARTYPE* x);
+  // Returns the norm of x induced by B (or the 2-norm of x).
+
+  void RandomBlock(ARTYPE* X, int nvec);
+  // Fills X with nvec pseudo-random vectors.
+
+  void Project(ARTYPE* x, ARTYPE* Q, int k, ARTYPE* c);
+  // Performs c <- Q'*B*x and x <- x - Q*c, where Q is a n x k matrix.
+
+  void Orthogonalize(ARTYPE* X, int nvec, int m, ARTYPE* h, int ldh,
+                     ARTYPE* r, int ldr);
+  // Orthogonalizes X against the first m columns of V (classical
+  // Gram-Schmidt with reorthogonalization, using level 3 BLAS) and then
+  // computes the QR factorization of X. Coefficients are added to h
+  // (m x nvec) and r (nvec x nvec). B inner products are used when
+  // MultBX is defined.
+
+  void StartBasis();
+  // Defines the first block of the Krylov basis.
+
+  void ExpandBasis();
+  // Appends blocks to V until ncv vectors are stored.
+
+  virtual void SymmetrizeBlock(int, int) { }
+  // Replaces Hm(1:c0,c0+1:c1) by known values when OP is hermitian.
+  // Redefined in ARbkSymStdEig.
+
+  void RotateBasis(int m, int k, ARTYPE* S, int lds);
+  // Performs V(:,1:k) <- V(:,1:m)*S(1:m,1:k) in place. Blocks of rows
+  // of V are updated in parallel when OpenMP is enabled.
+
+  ARFLOAT ResidualNorm(ARTYPE* s, int m);
+  // Returns ||Rb*s(m-nb+1:m)||.
+
+  void SortRitz(int m);
+  // Sorts Index(1:m) so that Key is in decreasing order.
+
+  void SetTolerance(int m);
+  // Defines tolr, eps23 and rfloor for the current projected matrix.
+
+  bool Converged(ARFLOAT rnorm, ARFLOAT theta) {
+    if (theta < eps23) theta = eps23;
+    return ((rnorm <= tolr*theta) || (rnorm <= rfloor));
+  }
+  // Convergence test (same as ARPACK's, except that residuals that
+  // cannot be reduced any further due to rounding errors are accepted).
+
+  virtual bool RitzStep(bool last) {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "RitzStep");
+    return last;
+  }
+  // Computes Ritz pairs, checks convergence and restarts the method.
+  // Returns true when no other iteration is needed.
+  // Must be defined by a derived class.
+  // Redefined in ARbk[Sym|NonSym|Comp]StdEig.
+
+
+ public:
+
+ // e) Public functions:
+
+ // e.1) Function that stores user defined parameters.
+
+  virtual void DefineParameters(int np, int nevp, ARFOP* objOPp,
+                                TypeOPX MultOPXp,
+                                const std::string& whichp="LM",
+                                int ncvp=0, ARFLOAT tolp=0.0, int maxitp=0,
+                                ARTYPE* residp=NULL, int nbp=0);
+  // Set values of problem parameters (also called by constructors).
+  // If nbp = 0, the block size is set to min(nev, 4). If ncvp = 0,
+  // ncv is set to nev+nb*(nev+1) when nb > 1.
+
+
+ // e.2) Functions that allow changes in problem parameters.
+
+  void ChangeMultOPX(ARFOP* objOPp, TypeOPX MultOPXp);
+  // Changes the matrix-matrix function that performs OP*X.
+
+  void ChangeMultBX(ARFOP* objBp, TypeOPX MultBXp);
+  // Defines the matrix-matrix function that performs B*X. It must be
+  // used when OP = inv(A-sigma*B)*B, so the symmetric solver can also
+  // handle generalized problems in shift and invert mode.
+
+  virtual void SetRegularMode(ARFOP* objOPp, TypeOPX MultOPXp);
+  // Turns problem to regular mode.
+
+  virtual void SetShiftInvertMode(ARTYPE sigmap, ARFOP* objOPp,
+                                  TypeOPX MultOPXp);
+  // Turns problem to shift and invert mode with shift defined by sigmap.
+
+  void ChangeBlockSize(int nbp);
+  // Changes the block size.
+
+  int GetBlockSize() { return nb; }
+  // Returns the block size actually used.
+
+
+ // e.3) Function that permits step by step execution of ARPACK.
+
+  virtual int TakeStep() {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "TakeStep");
+    return 0;
+  }
+  // Block solvers do not use the reverse communication interface.
+
+
+ // e.4) Function that performs all calculations in one step.
+
+  virtual int FindArnoldiBasis();
+  // Determines the Krylov basis related to the given problem.
+
+
+ // e.5) Constructor and destructor.
+
+  ARbkStdEig() { BlockInit(); }
+  // Constructor that does nothing but calling base class constructor.
+
+  ARbkStdEig(const ARbkStdEig& other) { BlockInit(); Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARbkStdEig() { BlockClear(); }
+  // Very simple destructor.
+
+ // f) Operators.
+
+  ARbkStdEig& operator=(const ARbkStdEig& other);
+  // Assignment operator.
+
+}; // class ARbkStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARbkStdEig member functions definition.                                  //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::BlockInit()
+{
+
+  nb     = 0;
+  objB   = NULL;
+  MultBX = NULL;
+  nbas   = 0;
+  tolr   = 0.0;
+  eps23  = 0.0;
+  rfloor = 0.0;
+  lwk    = 0;
+  seed   = 1;
+  Hm     = NULL;
+  Sm     = NULL;
+  Tm     = NULL;
+  Ym     = NULL;
+  Fb     = NULL;
+  Wb     = NULL;
+  Zb     = NULL;
+  Rb     = NULL;
+  Cb     = NULL;
+  Ritz   = NULL;
+  Wk     = NULL;
+  RitzI  = NULL;
+  Rnorm  = NULL;
+  Key    = NULL;
+  Rwk    = NULL;
+  Index  = NULL;
+  Iwk    = NULL;
+  Select = NULL;
+  Bwork  = NULL;
+
+} // BlockInit.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::BlockAllocate()
+{
+
+  int ncv = this->ncv;
+
+  lwk    = ncv*(ncv+6);
+  Hm     = new ARTYPE[ncv*ncv];
+  Sm     = new ARTYPE[ncv*ncv];
+  Tm     = new ARTYPE[ncv*ncv];
+  Ym     = new ARTYPE[ncv*ncv];
+  Fb     = new ARTYPE[this->n*nb];
+  Wb     = new ARTYPE[this->n*nb];
+  Zb     = new ARTYPE[this->n*nb];
+  Rb     = new ARTYPE[nb*nb];
+  Cb     = new ARTYPE[ncv*nb];
+  Ritz   = new ARTYPE[ncv];
+  Wk     = new ARTYPE[lwk];
+  RitzI  = new ARFLOAT[ncv];
+  Rnorm  = new ARFLOAT[ncv];
+  Key    = new ARFLOAT[ncv];
+  Rwk    = new ARFLOAT[2*ncv];
+  Index  = new int[ncv];
+  Iwk    = new int[ncv];
+  Select = new ARlogical[ncv];
+  Bwork  = new ARlogical[ncv];
+  nbas   = 0;
+
+} // BlockAllocate.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::BlockClear()
+{
+
+  if (Hm)     delete[] Hm;
+  if (Sm)     delete[] Sm;
+  if (Tm)     delete[] Tm;
+  if (Ym)     delete[] Ym;
+  if (Fb)     delete[] Fb;
+  if (Wb)     delete[] Wb;
+  if (Zb)     delete[] Zb;
+  if (Rb)     delete[] Rb;
+  if (Cb)     delete[] Cb;
+  if (Ritz)   delete[] Ritz;
+  if (Wk)     delete[] Wk;
+  if (RitzI)  delete[] RitzI;
+  if (Rnorm)  delete[] Rnorm;
+  if (Key)    delete[] Key;
+  if (Rwk)    delete[] Rwk;
+  if (Index)  delete[] Index;
+  if (Iwk)    delete[] Iwk;
+  if (Select) delete[] Select;
+  if (Bwork)  delete[] Bwork;
+
+  int     nbp     = nb;
+  ARFOP   *objBp  = objB;
+  TypeOPX MultBXp = MultBX;
+  unsigned long seedp = seed;
+  BlockInit();
+  nb     = nbp;
+  objB   = objBp;
+  MultBX = MultBXp;
+  seed   = seedp;
+
+} // BlockClear.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::Prepare()
+{
+
+  BlockClear();
+
+  // Adjusting the block size. The restarted basis must keep at least nev
+  // vectors and leave room for one more block, so ncv >= nev+2*nb-1.
+
+  if (nb < 1) nb = (this->nev < 4) ? this->nev : 4;
+  if (this->ncv < (this->nev+2*nb-1)) this->ncv = this->nev+2*nb-1;
+  if (this->ncv > this->n) {
+    this->ncv = this->n;
+    while ((nb > 1) && (this->ncv < (this->nev+2*nb-1))) nb--;
+  }
+
+  ARrcStdEig<ARFLOAT, ARTYPE>::Prepare();
+
+  if (this->PrepareOK) {
+    try { BlockAllocate(); }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "Prepare");
+      ArpackError(ArpackError::CANNOT_PREPARE, "Prepare");
+      this->PrepareOK = false;
+    }
+  }
+
+} // Prepare.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+Copy(const ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>& other)
+{
+
+  ARrcStdEig<ARFLOAT, ARTYPE>::Copy(other);
+  objOP   = other.objOP;
+  MultOPX = other.MultOPX;
+  objB    = other.objB;
+  MultBX  = other.MultBX;
+  nb      = other.nb;
+  seed    = other.seed;
+
+  if (!this->PrepareOK) return;
+
+  BlockAllocate();
+  nbas = other.nbas;
+  copy(this->ncv*this->ncv, other.Hm, 1, Hm, 1);
+  copy(this->n*nb, other.Fb, 1, Fb, 1);
+  copy(nb*nb, other.Rb, 1, Rb, 1);
+
+} // Copy.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+MultOPBlock(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  double t0;
+
+  t0 = this->StartEvent(ARStats::USER);
+  (objOP->*MultOPX)(X, Y, nvec);
+  this->StopEvent(ARStats::USER, t0);
+  this->stats.nopx += nvec;
+
+} // MultOPBlock.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline ARTYPE* ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+MultBBlock(ARTYPE* X, int nvec)
+{
+
+  double t0;
+
+  if (objB == NULL) return X;
+  t0 = this->StartEvent(ARStats::USER);
+  (objB->*MultBX)(X, Zb, nvec);
+  this->StopEvent(ARStats::USER, t0);
+  this->stats.nbx += nvec;
+  return Zb;
+
+} // MultBBlock.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+ARFLOAT ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::Norm(ARTYPE* x)
+{
+
+  ARTYPE xbx;
+  ARTYPE one  = (ARTYPE)1;
+  ARTYPE zero = (ARTYPE)0;
+
+  if (objB == NULL) return nrm2(this->n, x, 1);
+  gemv("C", this->n, 1, one, x, this->n, MultBBlock(x, 1), 1, zero, &xbx, 1);
+  return std::sqrt(std::abs(xbx));
+
+} // Norm.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::RandomBlock(ARTYPE* X, int nvec)
+{
+
+  int i;
+
+  // Simple linear congruential generator (values in (-1, 1)).
+
+  for (i=0; i<(this->n*nvec); i++) {
+    seed  = (seed*1103515245UL+12345UL)&0x7fffffffUL;
+    X[i]  = (ARTYPE)(ARFLOAT(2.0)*ARFLOAT(seed)/ARFLOAT(0x7fffffffUL)-
+                     ARFLOAT(1.0));
+  }
+
+} // RandomBlock.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+Project(ARTYPE* x, ARTYPE* Q, int k, ARTYPE* c)
+{
+
+  ARTYPE one  = (ARTYPE)1;
+  ARTYPE zero = (ARTYPE)0;
+
+  if (k < 1) return;
+  gemv("C", this->n, k, one, Q, this->n, MultBBlock(x, 1), 1, zero, c, 1);
+  gemv("N", this->n, k, -one, Q, this->n, c, 1, one, x, 1);
+
+} // Project.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+Orthogonalize(ARTYPE* X, int nvec, int m, ARTYPE* h, int ldh,
+              ARTYPE* r, int ldr)
+{
+
+  int     i, j, pass, n;
+  ARFLOAT nrm0, nrm, eps;
+  ARTYPE  one, zero, scale, *x;
+
+  n    = this->n;
+  one  = (ARTYPE)1;
+  zero = (ARTYPE)0;
+  eps  = std::numeric_limits<ARFLOAT>::epsilon();
+
+  // Orthogonalizing X against V(:,1:m) twice (CGS2).
+
+  if (m > 0) {
+    for (pass=0; pass<2; pass++) {
+      gemm("C", "N", m, nvec, n, one, &this->V[1], n, MultBBlock(X, nvec), n,
+           zero, Cb, this->ncv);
+      gemm("N", "N", n, nvec, m, -one, &this->V[1], n, Cb, this->ncv,
+           one, X, n);
+      for (j=0; j<nvec; j++) {
+        for (i=0; i<m; i++) h[i+j*ldh] += Cb[i+j*this->ncv];
+      }
+    }
+  }
+
+  // QR factorization of X (modified Gram-Schmidt with reorthogonalization).
+
+  for (j=0; j<nvec; j++) {
+
+    x = &X[j*n];
+    for (i=0; i<nvec; i++) r[i+j*ldr] = zero;
+    nrm0 = Norm(x);
+
+    for (pass=0; pass<2; pass++) {
+      Project(x, X, j, Cb);
+      for (i=0; i<j; i++) r[i+j*ldr] += Cb[i];
+    }
+    nrm = Norm(x);
+
+    if (nrm > (ARFLOAT(n)*eps*nrm0)) {
+      r[j+j*ldr] = (ARTYPE)nrm;
+      scale = (ARTYPE)(ARFLOAT(1.0)/nrm);
+      scal(n, scale, x, 1);
+    }
+    else {
+
+      // x is (numerically) a combination of the previous vectors.
+      // Replacing it by a random vector orthogonal to V and X(:,1:j).
+
+      RandomBlock(x, 1);
+      for (pass=0; pass<2; pass++) {
+        if (m > 0) Project(x, &this->V[1], m, Cb);
+        Project(x, X, j, Cb);
+      }
+      nrm = Norm(x);
+      scale = (nrm > ARFLOAT(0.0)) ? (ARTYPE)(ARFLOAT(1.0)/nrm) : zero;
+      scal(n, scale, x, 1);
+
+    }
+
+  }
+
+} // Orthogonalize.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::StartBasis()
+{
+
+  int j;
+
+  // Using resid as the first vector if it was supplied by the user.
+  // Otherwise, the vectors kept from the previous problem (if any)
+  // are spread over the columns of the first block.
+
+  RandomBlock(Fb, nb);
+  if (!this->newRes) {
+    copy(this->n, this->resid, 1, Fb, 1);
+  }
+  else {
+    for (j=0; j<nb; j++) this->SeedVector(&Fb[j*this->n], j, nb);
+  }
+
+  Orthogonalize(Fb, nb, 0, Cb, this->ncv, Rb, nb);
+  nbas = 0;
+
+} // StartBasis.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::ExpandBasis()
+{
+
+  int    i, j, c0, c1, ncv;
+  ARTYPE *tmp;
+
+  ncv = this->ncv;
+
+  while ((nbas+nb) <= ncv) {
+
+    c0 = nbas;
+    c1 = nbas+nb;
+
+    // Appending Fb to V and computing W <- OP*Fb.
+
+    copy(this->n*nb, Fb, 1, &this->V[1+c0*this->n], 1);
+    MultOPBlock(&this->V[1+c0*this->n], Wb, nb);
+    this->iparam[9] += nb;
+
+    // Computing Hm(1:c1,c0+1:c1) and the next block.
+
+    for (j=c0; j<c1; j++) {
+      for (i=0; i<c1; i++) Hm[i+j*ncv] = (ARTYPE)0;
+    }
+    Orthogonalize(Wb, nb, c1, &Hm[c0*ncv], ncv, Rb, nb);
+    SymmetrizeBlock(c0, c1);
+    tmp = Fb;
+    Fb  = Wb;
+    Wb  = tmp;
+
+    // Storing Rb below the diagonal if there is room for another block.
+
+    if ((c1+nb) <= ncv) {
+      for (i=c1; i<(c1+nb); i++) {
+        for (j=0; j<c0; j++) Hm[i+j*ncv] = (ARTYPE)0;
+        for (j=c0; j<c1; j++) Hm[i+j*ncv] = Rb[(i-c1)+(j-c0)*nb];
+      }
+    }
+
+    nbas = c1;
+
+  }
+
+} // ExpandBasis.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+RotateBasis(int m, int k, ARTYPE* S, int lds)
+{
+
+  int    r, j, nr, rb, nt, lw, n;
+  ARTYPE *W;
+  ARTYPE one  = (ARTYPE)1;
+  ARTYPE zero = (ARTYPE)0;
+
+  // V is updated by blocks of rb rows. Wb is split among nt threads, so
+  // each thread uses lw elements of Wb (at least one row of the result).
+
+  n  = this->n;
+#ifdef _OPENMP
+  nt = omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+  nt = 1;
+#endif
+  while ((nt > 1) && (((n*nb)/nt < k) || (nt > n))) nt--;
+  lw = (n*nb)/nt;
+  rb = lw/k;
+  if (rb < 1) rb = 1;
+  if (rb > ((n+nt-1)/nt)) rb = (n+nt-1)/nt;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nt) schedule(static, 1) private(j, nr, W)
+#endif
+  for (r=0; r<n; r+=rb) {
+#ifdef _OPENMP
+    W  = &Wb[omp_get_thread_num()*lw];
+#else
+    W  = Wb;
+#endif
+    nr = ((n-r) < rb) ? (n-r) : rb;
+    gemm("N", "N", nr, k, m, one, &this->V[1+r], n, S, lds, zero, W, nr);
+    for (j=0; j<k; j++) copy(nr, &W[j*nr], 1, &this->V[1+r+j*n], 1);
+  }
+
+} // RotateBasis.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+ARFLOAT ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::ResidualNorm(ARTYPE* s, int m)
+{
+
+  ARTYPE one  = (ARTYPE)1;
+  ARTYPE zero = (ARTYPE)0;
+
+  gemv("N", nb, nb, one, Rb, nb, &s[m-nb], 1, zero, Cb, 1);
+  return nrm2(nb, Cb, 1);
+
+} // ResidualNorm.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::SortRitz(int m)
+{
+
+  int i, j, t;
+
+  // Insertion sort (stable, so conjugate pairs are kept together).
+
+  for (i=0; i<m; i++) Index[i] = i;
+  for (i=1; i<m; i++) {
+    t = Index[i];
+    for (j=i; (j>0)&&(Key[Index[j-1]]<Key[t]); j--) Index[j] = Index[j-1];
+    Index[j] = t;
+  }
+
+} // SortRitz.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::SetTolerance(int m)
+{
+
+  int     j;
+  ARFLOAT eps, hnorm;
+
+  eps   = std::numeric_limits<ARFLOAT>::epsilon();
+  tolr  = (this->tol > ARFLOAT(0.0)) ? this->tol : eps;
+  eps23 = std::pow(eps, ARFLOAT(2.0)/ARFLOAT(3.0));
+
+  // rfloor = m*eps*||Hm||_F.
+
+  hnorm = ARFLOAT(0.0);
+  for (j=0; j<m; j++) hnorm = lapy2(hnorm, nrm2(m, &Hm[j*this->ncv], 1));
+  rfloor = ARFLOAT(m)*eps*hnorm;
+
+} // SetTolerance.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+DefineParameters(int np, int nevp, ARFOP* objOPp,
+                 void (ARFOP::* MultOPXp)(ARTYPE[], ARTYPE[], int),
+                 const std::string& whichp, int ncvp, ARFLOAT tolp,
+                 int maxitp, ARTYPE* residp, int nbp)
+
+{
+
+  // Choosing default values for nb and ncv. Since each restart adds only
+  // (ncv-nev)/nb blocks to the basis, ncv must grow with nb.
+
+  nb      = (nbp > 0) ? nbp : ((nevp < 4) ? nevp : 4);
+  if ((ncvp == 0) && (nb > 1)) {
+    ncvp  = nevp+nb*(nevp+1);
+    if (ncvp > np) ncvp = np;
+  }
+  objOP   = objOPp;
+  MultOPX = MultOPXp;
+  ARrcStdEig<ARFLOAT, ARTYPE>::DefineParameters(np, nevp, whichp, ncvp, tolp,
+                                                maxitp, residp, true);
+
+} // DefineParameters.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+ChangeMultOPX(ARFOP* objOPp, void (ARFOP::* MultOPXp)(ARTYPE[], ARTYPE[], int))
+{
+
+  objOP   = objOPp;
+  MultOPX = MultOPXp;
+  this->Restart();
+
+} // ChangeMultOPX.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+ChangeMultBX(ARFOP* objBp, void (ARFOP::* MultBXp)(ARTYPE[], ARTYPE[], int))
+{
+
+  objB   = objBp;
+  MultBX = MultBXp;
+  this->Restart();
+
+} // ChangeMultBX.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+SetRegularMode(ARFOP* objOPp, void (ARFOP::* MultOPXp)(ARTYPE[], ARTYPE[], int))
+{
+
+  ChangeMultOPX(objOPp, MultOPXp);
+  this->NoShift();
+
+} // SetRegularMode.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+SetShiftInvertMode(ARTYPE sigmap, ARFOP* objOPp,
+                   void (ARFOP::* MultOPXp)(ARTYPE[], ARTYPE[], int))
+{
+
+  ChangeMultOPX(objOPp, MultOPXp);
+  this->ChangeShift(sigmap);
+
+} // SetShiftInvertMode.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::ChangeBlockSize(int nbp)
+{
+
+  nb = nbp;
+  Prepare();
+
+} // ChangeBlockSize.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+int ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::FindArnoldiBasis()
+{
+
+  int    iter;
+  bool   done;
+  double t0, tuser;
+
+  if (this->BasisOK) return this->nconv;
+  if (!this->PrepareOK) {
+    throw ArpackError(ArpackError::PREPARE_NOT_OK, "FindArnoldiBasis");
+  }
+
+  this->Restart();
+  this->iparam[9] = 0;
+
+  // Block Krylov-Schur main loop. The time spent in user products
+  // is not charged to the iteration itself.
+
+  t0    = this->StartEvent(ARStats::AUPP);
+  tuser = this->stats.tuser;
+  iter  = 0;
+  try {
+    StartBasis();
+    done = false;
+    while (!done) {
+      ExpandBasis();
+      iter++;
+      done = RitzStep(iter >= this->maxit);
+    }
+  }
+  catch (const ArpackError&) {
+    this->StopEvent(ARStats::AUPP, t0);
+    this->stats.taupp -= this->stats.tuser-tuser;
+    ArpackError(ArpackError::CANNOT_FIND_BASIS, "FindArnoldiBasis");
+    return 0;
+  }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    this->StopEvent(ARStats::AUPP, t0);
+    this->stats.taupp -= this->stats.tuser-tuser;
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "FindArnoldiBasis");
+    ArpackError(ArpackError::CANNOT_FIND_BASIS, "FindArnoldiBasis");
+    return 0;
+  }
+  this->StopEvent(ARStats::AUPP, t0);
+  this->stats.taupp    -= this->stats.tuser-tuser;
+  this->stats.nsteps   += iter;
+  this->stats.nrestart += iter;
+
+  // Storing the first residual vector in resid.
+
+  copy(this->n, Fb, 1, this->resid, 1);
+
+  this->iparam[3] = iter;
+  this->iparam[4] = nb;
+  this->iparam[5] = this->nconv;
+  this->BasisOK   = true;
+  if (this->nconv < this->nev) {
+    ArpackError(ArpackError::MAX_ITERATIONS, "FindArnoldiBasis");
+  }
+  return this->nconv;
+
+} // FindArnoldiBasis.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>& ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>::
+operator=(const ARbkStdEig<ARFLOAT, ARTYPE, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    BlockClear();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARKSEIG_H
+
@@ -0,0 +1,341 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARKSNSym.h.
+   Arpack++ class ARbkNonSymStdEig definition.
+   Block Krylov-Schur solver for real nonsymmetric
+   standard problems.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARKSNSYM_H
+#define ARKSNSYM_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "arch.h"
+#include "arkseig.h"
+#include "arrsnsym.h"
+
+
+template<class ARFLOAT, class ARFOP>
+class ARbkNonSymStdEig:
+  public virtual ARbkStdEig<ARFLOAT, ARFLOAT, ARFOP>,
+  public virtual ARrcNonSymStdEig<ARFLOAT> {
+
+ protected:
+
+ // a) Protected functions:
+
+  bool RitzStep(bool last);
+  // Computes the Schur form of Hm, checks convergence and restarts.
+
+  void Eupp();
+  // Computes the converged eigenvalues and eigenvectors.
+
+
+ public:
+
+ // b) Constructors and destructor.
+
+  ARbkNonSymStdEig() { }
+  // Short constructor.
+
+  ARbkNonSymStdEig(int np, int nevp, ARFOP* objOPp,
+                   void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+                   const std::string& whichp = "LM", int ncvp = 0,
+                   ARFLOAT tolp = 0.0, int maxitp = 0,
+                   ARFLOAT* residp = NULL, int nbp = 0);
+  // Long constructor (regular mode).
+
+  ARbkNonSymStdEig(int np, int nevp, ARFOP* objOPp,
+                   void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+                   ARFLOAT sigmap, const std::string& whichp = "LM",
+                   int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+                   ARFLOAT* residp = NULL, int nbp = 0);
+  // Long constructor (shift and invert mode).
+
+  ARbkNonSymStdEig(const ARbkNonSymStdEig& other) { this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARbkNonSymStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARbkNonSymStdEig& operator=(const ARbkNonSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARbkNonSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARbkNonSymStdEig member functions definition.                            //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+bool ARbkNonSymStdEig<ARFLOAT, ARFOP>::RitzStep(bool last)
+{
+
+  int     i, j, k, m, nc, nw, nb, ncv, inf;
+  ARFLOAT theta, ra, rb, zero, one;
+
+  m    = this->nbas;
+  nb   = this->nb;
+  ncv  = this->ncv;
+  zero = 0.0;
+  one  = 1.0;
+
+  // Computing the real Schur form Hm = Sm*Tm*Sm' and the eigenvectors
+  // of Hm (stored in Ym).
+
+  lacpy("A", m, m, this->Hm, ncv, this->Tm, ncv);
+  gees("V", m, this->Tm, ncv, this->Ritz, this->RitzI, this->Sm, ncv,
+       this->Wk, this->lwk, this->Bwork, inf);
+  if (inf != 0) throw ArpackError(ArpackError::LAPACK_ERROR, "RitzStep");
+
+  lacpy("A", m, m, this->Sm, ncv, this->Ym, ncv);
+  trevc("B", this->Select, m, this->Tm, ncv, this->Ym, ncv, m, k,
+        this->Wk, inf);
+  if (inf != 0) throw ArpackError(ArpackError::LAPACK_ERROR, "RitzStep");
+
+  // Sorting Ritz values according to "which".
+
+  for (i=0; i<m; i++) {
+    ra = this->Ritz[i];
+    rb = this->RitzI[i];
+    if (this->which == "LM")      this->Key[i] = lapy2(ra, rb);
+    else if (this->which == "SM") this->Key[i] = -lapy2(ra, rb);
+    else if (this->which == "LR") this->Key[i] = ra;
+    else if (this->which == "SR") this->Key[i] = -ra;
+    else if (this->which == "LI") this->Key[i] = std::abs(rb);
+    else                          this->Key[i] = -std::abs(rb);
+  }
+  this->SortRitz(m);
+
+  // Computing residual norms. Complex eigenvectors are stored as
+  // Ym(:,i)+I*Ym(:,i+1).
+
+  for (i=0; i<m; i++) {
+    if (this->RitzI[i] == zero) {
+      this->Rnorm[i] = this->ResidualNorm(&this->Ym[i*ncv], m)/
+                       nrm2(m, &this->Ym[i*ncv], 1);
+    }
+    else {
+      ra = this->ResidualNorm(&this->Ym[i*ncv], m);
+      rb = this->ResidualNorm(&this->Ym[(i+1)*ncv], m);
+      this->Rnorm[i] = lapy2(ra, rb)/lapy2(nrm2(m, &this->Ym[i*ncv], 1),
+                                           nrm2(m, &this->Ym[(i+1)*ncv], 1));
+      this->Rnorm[i+1] = this->Rnorm[i];
+      i++;
+    }
+  }
+
+  // Checking convergence of the wanted Ritz values. nev is increased by
+  // one if the last wanted value is part of a complex conjugate pair.
+
+  this->SetTolerance(m);
+
+  nw = this->nev;
+  if ((nw < m) && (this->RitzI[this->Index[nw-1]] != zero) &&
+      (this->RitzI[this->Index[nw]] == -this->RitzI[this->Index[nw-1]])) {
+    nw++;
+  }
+
+  nc = 0;
+  for (k=0; k<m; k++) {
+    i = this->Index[k];
+    theta = lapy2(this->Ritz[i], this->RitzI[i]);
+    this->Select[i] = (k < nw) && this->Converged(this->Rnorm[i], theta);
+    if (this->Select[i]) nc++;
+  }
+
+  if ((nc >= this->nev) || last) {
+
+    // Moving converged Ritz values to the top of the Schur form and
+    // storing the corresponding Schur vectors in V.
+
+    if (nc > 0) {
+      trsen(this->Select, m, this->Tm, ncv, this->Sm, ncv, this->Ritz,
+            this->RitzI, k, this->Wk, this->lwk, this->Iwk, ncv, inf);
+      if (inf != 0) {
+        throw ArpackError(ArpackError::REORDERING_ERROR, "RitzStep");
+      }
+      this->RotateBasis(m, k, this->Sm, ncv);
+      nc = k;
+    }
+    this->nconv = nc;
+    return true;
+
+  }
+
+  // Thick restart: keeping k Schur vectors. Complex conjugate pairs are
+  // never split.
+
+  k = (m-this->nev)/2;
+  if ((nb == 1) && (nc < k)) k = nc;
+  k += this->nev;
+  if (k > (m-nb)) k = m-nb;
+
+  for (i=0; i<m; i++) this->Select[i] = false;
+  for (j=0; j<k; j++) this->Select[this->Index[j]] = true;
+  i = this->Index[k-1];
+  if ((this->RitzI[i] > zero) && !this->Select[i+1]) {
+    if (k < (m-nb)) this->Select[i+1] = true; else this->Select[i] = false;
+  }
+  else if ((this->RitzI[i] < zero) && !this->Select[i-1]) {
+    if (k < (m-nb)) this->Select[i-1] = true; else this->Select[i] = false;
+  }
+
+  trsen(this->Select, m, this->Tm, ncv, this->Sm, ncv, this->Ritz,
+        this->RitzI, k, this->Wk, this->lwk, this->Iwk, ncv, inf);
+  if (inf != 0) throw ArpackError(ArpackError::REORDERING_ERROR, "RitzStep");
+
+  // Hm <- Tm(1:k,1:k); Hm(k+1:k+nb,1:k) <- Rb*Sm(m-nb+1:m,1:k).
+
+  lacpy("A", k, k, this->Tm, ncv, this->Hm, ncv);
+  gemm("N", "N", nb, k, nb, one, this->Rb, nb, &this->Sm[m-nb], ncv,
+       zero, &this->Hm[k], ncv);
+
+  this->RotateBasis(m, k, this->Sm, ncv);
+  this->nbas = k;
+  return false;
+
+} // RitzStep.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARbkNonSymStdEig<ARFLOAT, ARFOP>::Eupp()
+{
+
+  int     i, k, nc, ncv, inf;
+  ARFLOAT re, im, d, s, zero, one, *X;
+
+  nc   = this->nconv;
+  ncv  = this->ncv;
+  zero = 0.0;
+  one  = 1.0;
+
+  // Eigenvalues (lambda = sigma+1/theta in shift and invert mode).
+
+  for (i=0; i<nc; i++) {
+    re = this->Ritz[i];
+    im = this->RitzI[i];
+    if (this->mode == 3) {
+      d  = re*re+im*im;
+      re = this->sigmaR+re/d;
+      im = -im/d;
+    }
+    this->EigValR[i] = re;
+    this->EigValI[i] = im;
+  }
+
+  // Eigenvectors: X <- V(:,1:nc)*Y, where Y are the eigenvectors of the
+  // quasi-triangular matrix Tm(1:nc,1:nc). Schur vectors are kept in V
+  // unless EigVec overrides V.
+
+  this->info = 0;
+  if ((!this->rvec) || (this->HowMny != 'A') || (nc == 0)) return;
+
+  trevc("A", this->Select, nc, this->Tm, ncv, this->Ym, ncv, nc, k,
+        this->Wk, inf);
+  if (inf != 0) {
+    this->info = -9;
+    return;
+  }
+
+  if (this->OverV()) {
+    this->RotateBasis(nc, nc, this->Ym, ncv);
+    X = &this->V[1];
+  }
+  else {
+    gemm("N", "N", this->n, nc, nc, one, &this->V[1], this->n, this->Ym, ncv,
+         zero, this->EigVec, this->n);
+    X = this->EigVec;
+  }
+
+  // Normalizing eigenvectors. The eigenvalue with positive imaginary part
+  // must come first in each complex conjugate pair.
+
+  for (i=0; i<nc; i++) {
+    if (this->EigValI[i] == zero) {
+      s = one/nrm2(this->n, &X[i*this->n], 1);
+      scal(this->n, s, &X[i*this->n], 1);
+    }
+    else {
+      s = one/lapy2(nrm2(this->n, &X[i*this->n], 1),
+                    nrm2(this->n, &X[(i+1)*this->n], 1));
+      scal(this->n, s, &X[i*this->n], 1);
+      if (this->EigValI[i] < zero) {
+        s = -s;
+        this->EigValI[i]   = -this->EigValI[i];
+        this->EigValI[i+1] = -this->EigValI[i+1];
+      }
+      scal(this->n, s, &X[(i+1)*this->n], 1);
+      i++;
+    }
+  }
+
+} // Eupp.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARbkNonSymStdEig<ARFLOAT, ARFOP>::
+ARbkNonSymStdEig(int np, int nevp, ARFOP* objOPp,
+                 void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+                 const std::string& whichp, int ncvp, ARFLOAT tolp,
+                 int maxitp, ARFLOAT* residp, int nbp)
+
+{
+
+  this->NoShift();
+  this->DefineParameters(np, nevp, objOPp, MultOPXp, whichp,
+                         ncvp, tolp, maxitp, residp, nbp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARbkNonSymStdEig<ARFLOAT, ARFOP>::
+ARbkNonSymStdEig(int np, int nevp, ARFOP* objOPp,
+                 void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+                 ARFLOAT sigmap, const std::string& whichp, int ncvp,
+                 ARFLOAT tolp, int maxitp, ARFLOAT* residp, int nbp)
+
+{
+
+  this->ChangeShift(sigmap);
+  this->DefineParameters(np, nevp, objOPp, MultOPXp, whichp,
+                         ncvp, tolp, maxitp, residp, nbp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT, class ARFOP>
+ARbkNonSymStdEig<ARFLOAT, ARFOP>& ARbkNonSymStdEig<ARFLOAT, ARFOP>::
+operator=(const ARbkNonSymStdEig<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->BlockClear();
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARKSNSYM_H
+
@@ -0,0 +1,279 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARKSSym.h.
+   Arpack++ class ARbkSymStdEig definition.
+   Block Krylov-Schur (thick restart block Lanczos)
+   solver for real symmetric standard problems.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARKSSYM_H
+#define ARKSSYM_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "arch.h"
+#include "arkseig.h"
+#include "arrssym.h"
+
+
+template<class ARFLOAT, class ARFOP>
+class ARbkSymStdEig:
+  public virtual ARbkStdEig<ARFLOAT, ARFLOAT, ARFOP>,
+  public virtual ARrcSymStdEig<ARFLOAT> {
+
+ protected:
+
+ // a) Protected functions:
+
+  void SymmetrizeBlock(int c0, int c1);
+  // Copies the transpose of Hm(c0+1:c1,1:c0) to Hm(1:c0,c0+1:c1), so
+  // the projected matrix keeps its block tridiagonal (arrowhead after
+  // restarts) structure in spite of rounding errors.
+
+  bool RitzStep(bool last);
+  // Computes the eigenpairs of Hm, checks convergence and restarts.
+
+  void Eupp();
+  // Copies the converged eigenvalues and eigenvectors.
+
+
+ public:
+
+ // b) Constructors and destructor.
+
+  ARbkSymStdEig() { }
+  // Short constructor.
+
+  ARbkSymStdEig(int np, int nevp, ARFOP* objOPp,
+                void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+                const std::string& whichp = "LM", int ncvp = 0,
+                ARFLOAT tolp = 0.0, int maxitp = 0, ARFLOAT* residp = NULL,
+                int nbp = 0);
+  // Long constructor (regular mode).
+
+  ARbkSymStdEig(int np, int nevp, ARFOP* objOPp,
+                void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+                ARFLOAT sigmap, const std::string& whichp = "LM",
+                int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+                ARFLOAT* residp = NULL, int nbp = 0);
+  // Long constructor (shift and invert mode).
+
+  ARbkSymStdEig(const ARbkSymStdEig& other) { this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARbkSymStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARbkSymStdEig& operator=(const ARbkSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARbkSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARbkSymStdEig member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+void ARbkSymStdEig<ARFLOAT, ARFOP>::SymmetrizeBlock(int c0, int c1)
+{
+
+  int i, j, ncv;
+
+  ncv = this->ncv;
+  for (j=c0; j<c1; j++) {
+    for (i=0; i<c0; i++) this->Hm[i+j*ncv] = this->Hm[j+i*ncv];
+  }
+
+} // SymmetrizeBlock.
+
+
+template<class ARFLOAT, class ARFOP>
+bool ARbkSymStdEig<ARFLOAT, ARFOP>::RitzStep(bool last)
+{
+
+  int     i, j, k, m, nc, nb, ncv, inf;
+  ARFLOAT theta, lambda, zero, one;
+
+  m    = this->nbas;
+  nb   = this->nb;
+  ncv  = this->ncv;
+  zero = 0.0;
+  one  = 1.0;
+
+  // Computing the eigenpairs of the symmetric matrix Hm(1:m,1:m).
+
+  lacpy("U", m, m, this->Hm, ncv, this->Sm, ncv);
+  syev("V", "U", m, this->Sm, ncv, this->Ritz, this->Wk, this->lwk, inf);
+  if (inf != 0) throw ArpackError(ArpackError::LAPACK_ERROR, "RitzStep");
+
+  // Sorting Ritz values according to "which" (syev returns them in
+  // ascending order).
+
+  if (this->which == "BE") {
+    for (i=0, j=m-1, k=0; k<m; k++) {
+      this->Index[k] = (k%2) ? i++ : j--;
+    }
+  }
+  else {
+    for (i=0; i<m; i++) {
+      theta = this->Ritz[i];
+      if (this->which == "LA")      this->Key[i] = theta;
+      else if (this->which == "SA") this->Key[i] = -theta;
+      else if (this->which == "LM") this->Key[i] = std::abs(theta);
+      else                          this->Key[i] = -std::abs(theta);
+    }
+    this->SortRitz(m);
+  }
+
+  // Checking convergence of the wanted Ritz values.
+
+  this->SetTolerance(m);
+
+  nc = 0;
+  for (k=0; k<m; k++) {
+    i = this->Index[k];
+    this->Rnorm[i] = this->ResidualNorm(&this->Sm[i*ncv], m);
+    theta = std::abs(this->Ritz[i]);
+    this->Select[i] = (k < this->nev) &&
+                      this->Converged(this->Rnorm[i], theta);
+    if (this->Select[i]) nc++;
+  }
+
+  if ((nc >= this->nev) || last) {
+
+    // Storing converged eigenpairs in ascending order of lambda.
+
+    for (k=0, j=0; k<m; k++) {
+      if (this->Select[k]) {
+        theta  = this->Ritz[k];
+        lambda = (this->mode == 3) ? this->sigmaR+one/theta : theta;
+        for (i=j; (i>0)&&(this->Key[i-1]>lambda); i--) {
+          this->Key[i]   = this->Key[i-1];
+          this->Index[i] = this->Index[i-1];
+        }
+        this->Key[i]   = lambda;
+        this->Index[i] = k;
+        j++;
+      }
+    }
+    for (k=0; k<nc; k++) {
+      copy(m, &this->Sm[this->Index[k]*ncv], 1, &this->Tm[k*ncv], 1);
+      this->RitzI[k] = this->Rnorm[this->Index[k]];
+      this->Ritz[k]  = this->Key[k];
+    }
+    copy(nc, this->RitzI, 1, this->Rnorm, 1);
+    if (nc > 0) this->RotateBasis(m, nc, this->Tm, ncv);
+    this->nconv = nc;
+    return true;
+
+  }
+
+  // Thick restart: keeping k Ritz vectors. ARPACK heuristic is used when
+  // nb = 1. For larger blocks, half of the basis is kept.
+
+  k = (m-this->nev)/2;
+  if ((nb == 1) && (nc < k)) k = nc;
+  k += this->nev;
+  if (k > (m-nb)) k = m-nb;
+
+  for (j=0; j<k; j++) {
+    copy(m, &this->Sm[this->Index[j]*ncv], 1, &this->Tm[j*ncv], 1);
+  }
+
+  // Hm <- diag(theta); Hm(k+1:k+nb,1:k) <- Rb*Tm(m-nb+1:m,1:k).
+
+  for (j=0; j<k; j++) {
+    for (i=0; i<(k+nb); i++) this->Hm[i+j*ncv] = zero;
+    this->Hm[j+j*ncv] = this->Ritz[this->Index[j]];
+  }
+  gemm("N", "N", nb, k, nb, one, this->Rb, nb, &this->Tm[m-nb], ncv,
+       zero, &this->Hm[k], ncv);
+
+  this->RotateBasis(m, k, this->Tm, ncv);
+  this->nbas = k;
+  return false;
+
+} // RitzStep.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARbkSymStdEig<ARFLOAT, ARFOP>::Eupp()
+{
+
+  // Eigenvalues were transformed and Ritz vectors were stored in V
+  // by RitzStep.
+
+  copy(this->nconv, this->Ritz, 1, this->EigValR, 1);
+  if (this->rvec && !this->OverV()) {
+    copy(this->n*this->nconv, &this->V[1], 1, this->EigVec, 1);
+  }
+  this->info = 0;
+
+} // Eupp.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARbkSymStdEig<ARFLOAT, ARFOP>::
+ARbkSymStdEig(int np, int nevp, ARFOP* objOPp,
+              void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+              const std::string& whichp, int ncvp, ARFLOAT tolp,
+              int maxitp, ARFLOAT* residp, int nbp)
+
+{
+
+  this->NoShift();
+  this->DefineParameters(np, nevp, objOPp, MultOPXp, whichp,
+                         ncvp, tolp, maxitp, residp, nbp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARbkSymStdEig<ARFLOAT, ARFOP>::
+ARbkSymStdEig(int np, int nevp, ARFOP* objOPp,
+              void (ARFOP::* MultOPXp)(ARFLOAT[], ARFLOAT[], int),
+              ARFLOAT sigmap, const std::string& whichp, int ncvp,
+              ARFLOAT tolp, int maxitp, ARFLOAT* residp, int nbp)
+
+{
+
+  this->ChangeShift(sigmap);
+  this->DefineParameters(np, nevp, objOPp, MultOPXp, whichp,
+                         ncvp, tolp, maxitp, residp, nbp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT, class ARFOP>
+ARbkSymStdEig<ARFLOAT, ARFOP>& ARbkSymStdEig<ARFLOAT, ARFOP>::
+operator=(const ARbkSymStdEig<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->BlockClear();
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARKSSYM_H
+
@@ -106,7 +106,11 @@ Copy(const ARluCompGenEig<ARFLOAT>& other)
   Pencil = other.Pencil;
   this->objOP  = &Pencil;
   this->objB   = &Pencil;
-  if (this->mode > 2) this->objOP->FactorAsB(this->sigmaR);
+  if (this->mode > 2) {
+    this->StartFactor();
+    this->objOP->FactorAsB(this->sigmaR);
+    this->StopFactor();
+  }
 
 } // Copy.
 
@@ -115,7 +119,9 @@ template<class ARFLOAT>
 inline void ARluCompGenEig<ARFLOAT>::ChangeShift(arcomplex<ARFLOAT> sigmap)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsB(sigmap);
+  this->StopFactor();
   ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> >::ChangeShift(sigmap);
 
 } // ChangeShift.
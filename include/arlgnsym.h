@@ -115,12 +115,14 @@ Copy(const ARluNonSymGenEig<ARFLOAT>& other)
   this->objB   = &Pencil;
   this->objA   = &Pencil;
   if (this->mode > 2) {
+    this->StartFactor();
     if (this->sigmaI == 0.0) {
       this->objOP->FactorAsB(this->sigmaR);
     }
     else {
       this->objOP->FactorAsB(this->sigmaR, this->sigmaI, this->part);
     }
+    this->StopFactor();
   }
 
 } // Copy.
@@ -131,12 +133,14 @@ inline void ARluNonSymGenEig<ARFLOAT>::
 ChangeShift(ARFLOAT sigmaRp, ARFLOAT sigmaIp)
 {
 
+  this->StartFactor();
   if (sigmaIp == 0.0) {
     this->objOP->FactorAsB(sigmaRp);
   }
   else {
     this->objOP->FactorAsB(sigmaRp, sigmaIp, this->part);
   }
+  this->StopFactor();
   ARrcNonSymGenEig<ARFLOAT>::ChangeShift(sigmaRp, sigmaIp);
 
 } // ChangeShift.
@@ -62,6 +62,12 @@ class ARluSymGenEig:
 
   virtual void SetCayleyMode(ARFLOAT sigmap);
 
+  void SetFactorCache(int maxentries, std::size_t budget = 0)
+  { Pencil.SetFactorCache(maxentries, budget); }
+  // Keeps the factors of A-sigma*B computed for up to maxentries
+  // previous shifts (see ARluSymPencil::SetFactorCache), so ChangeShift
+  // does not factor A-sigma*B again when one of them is used.
+
  // c.2) Constructors and destructor.
 
   ARluSymGenEig() { }
@@ -109,7 +115,11 @@ Copy(const ARluSymGenEig<ARFLOAT>& other)
   this->objOP  = &Pencil;
   this->objB   = &Pencil;
   this->objA   = &Pencil;
-  if (this->mode > 2) this->objOP->FactorAsB(this->sigmaR);
+  if (this->mode > 2) {
+    this->StartFactor();
+    this->objOP->FactorAsB(this->sigmaR);
+    this->StopFactor();
+  }
 
 } // Copy.
 
@@ -118,7 +128,9 @@ template<class ARFLOAT>
 inline void ARluSymGenEig<ARFLOAT>::ChangeShift(ARFLOAT sigmap)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsB(sigmap);
+  this->StopFactor();
   ARrcSymGenEig<ARFLOAT>::ChangeShift(sigmap);
 
 } // ChangeShift.
@@ -21,6 +21,7 @@
 #define ARLNSMAT_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "armat.h"
@@ -42,6 +43,7 @@ class ARluNonSymMatrix: public ARMatrix<ARTYPE> {
  protected:
 
   bool        factored;
+  bool        analyzed;
   int         order;
   int         nnz;
   int*        irow;
@@ -53,6 +55,9 @@ class ARluNonSymMatrix: public ARMatrix<ARTYPE> {
   SuperMatrix A;
   SuperMatrix L;
   SuperMatrix U;
+  SuperMatrix AsI;
+  SuperMatrix AC;
+  int*        etree;
   ARhbMatrix<int, ARTYPE> mat;
   SuperLUStat_t stat;
 
@@ -74,10 +79,23 @@ class ARluNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void FactorAsI(ARTYPE sigma);
 
+  void ClearSymbolic();
+  // Discards the column ordering and elimination tree of A-sigma*I that
+  // were computed by the first call to FactorAsI and are reused by the
+  // following ones. Must be called if the sparsity pattern of A (irow,
+  // pcol) was changed after DefineMatrix. Changes in the values of A
+  // do not require this call.
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMV(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Computes Y = M*X reading the entries of M only once.
+
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
+  void MultMtV(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Computes Y = M'*X reading the entries of M only once.
+
   void MultMtMv(ARTYPE* v, ARTYPE* w);
 
   void MultMMtv(ARTYPE* v, ARTYPE* w);
@@ -86,6 +104,8 @@ class ARluNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+
   void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
                     int* pcolp, double thresholdp = 0.1,
                     int orderp = 1, bool check = true);   // Square matrix.
@@ -161,6 +181,7 @@ Copy(const ARluNonSymMatrix<ARTYPE, ARFLOAT>& other)
 
   this->defined   = other.defined;
   factored  = other.factored;
+  analyzed  = false;
 
   // Returning from here if "other" was not initialized.
 
@@ -200,6 +221,7 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::ClearMem()
     Destroy_CompCol_Matrix(&U);
     StatFree(&stat);
   }
+  ClearSymbolic();
   if (this->defined) {
     Destroy_SuperMatrix_Store(&A); // delete A.Store;
     delete[] permc;
@@ -212,6 +234,21 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::ClearMem()
 } // ClearMem.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymMatrix<ARTYPE, ARFLOAT>::ClearSymbolic()
+{
+
+  if (analyzed) {
+    Destroy_CompCol_Permuted(&AC);
+    Destroy_CompCol_Matrix(&AsI);
+    delete[] etree;
+    etree    = NULL;
+    analyzed = false;
+  }
+
+} // ClearSymbolic.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
 SubtractAsI(ARTYPE sigma, NCformat& A, NCformat& AsI)
@@ -294,6 +331,11 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
                       "ARluNonSymMatrix::FactorA");
   }
 
+  // Discarding the symbolic factorization of A-sigma*I, since permc
+  // will be overwritten.
+
+  ClearSymbolic();
+
   // Deleting previous versions of L and U.
   
   if (factored) {
@@ -325,7 +367,12 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
 
   // Reserving memory for etree (used in matrix decomposition).
 
-  etree = new int[this->n];
+  try { etree = new int[this->n]; }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    factored = false;
+    throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                      "ARluNonSymMatrix::FactorA");
+  }
 
   // Defining LUStat.
 
@@ -396,12 +443,9 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
   // Defining local variables.
 
   int         info;
-  int*        etree;
   int*        irowi;
   int*        pcoli;
   ARTYPE*     asi;
-  SuperMatrix AsI;
-  SuperMatrix AC;
   NCformat*   Astore;
   NCformat*   AsIstore;
 
@@ -434,12 +478,30 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
   set_default_options(&options);
   options.DiagPivotThresh = threshold;
 
-  // Creating a temporary matrix AsI.
-
-  irowi = new int[nnz+this->n];
-  pcoli = new int[this->n+1];
-  asi   = new ARTYPE[nnz+this->n];
-  Create_CompCol_Matrix(&AsI, this->n,  this->n, nnz, asi, irowi, pcoli, SLU_NC, SLU_GE);
+  // Creating matrix AsI. AsI is kept (with its column ordering and
+  // elimination tree) after the decomposition. Because all diagonal
+  // elements are stored, the pattern of AsI does not depend on sigma.
+
+  if (!analyzed) {
+    irowi = NULL;
+    pcoli = NULL;
+    asi   = NULL;
+    try {
+      irowi = new int[nnz+this->n];
+      pcoli = new int[this->n+1];
+      asi   = new ARTYPE[nnz+this->n];
+      etree = new int[this->n];
+    }
+    catch (const std::bad_alloc&) { // Memory is not sufficient.
+      delete[] irowi;
+      delete[] pcoli;
+      delete[] asi;
+      factored = false;
+      throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                        "ARluNonSymMatrix::FactorAsI");
+    }
+    Create_CompCol_Matrix(&AsI, this->n,  this->n, nnz, asi, irowi, pcoli, SLU_NC, SLU_GE);
+  }
 
   // Subtracting sigma*I from A and storing the result on AsI.
 
@@ -447,25 +509,26 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
   AsIstore = (NCformat*)AsI.Store;
   SubtractAsI(sigma, *Astore, *AsIstore);
 
-  // Reserving memory for etree (used in matrix decomposition).
-
-  etree = new int[this->n];
-
   // Defining LUStat.
 
   //StatInit(panel_size, relax);
   StatInit(&stat);
 
-  // Defining the column permutation of matrix AsI
-  // (using minimum degree ordering on AsI'*AsI).
+  if (!analyzed) {
 
-  get_perm_c(order, &AsI, permc);
+    // Defining the column permutation of matrix AsI
+    // (using minimum degree ordering on AsI'*AsI).
 
-  // Permuting columns of AsI and
-  // creating the elimination tree of AsI'*AsI.
+    get_perm_c(order, &AsI, permc);
 
-  //sp_preorder("N", &AsI, permc, etree, &AC);
-  sp_preorder(&options, &AsI, permc, etree, &AC);
+    // Permuting columns of AsI and
+    // creating the elimination tree of AsI'*AsI.
+    // AC shares row indices and values with AsI.
+
+    sp_preorder(&options, &AsI, permc, etree, &AC);
+    analyzed = true;
+
+  }
 
   // Decomposing AsI.
 
@@ -474,12 +537,6 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
   gstrf(&options,&AC, relax, panel_size, etree,
         NULL, 0, permc, permr, &L, &U, &stat, &info);
 
-  // Deleting AC, AsI and etree.
-
-  Destroy_CompCol_Permuted(&AC);
-  Destroy_CompCol_Matrix(&AsI);
-  delete[] etree;
-
   factored = (info == 0);
 
   // Handling errors.
@@ -527,6 +584,38 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 } // MultMv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  int    i, j, k, l;
+  ARTYPE t;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluNonSymMatrix::MultMV");
+  }
+
+  // Determining Y = M.X. Each column of M is used by all the nvec
+  // products before the next one is read.
+
+  for (i=0; i!=this->m*nvec; i++) Y[i]=(ARTYPE)0;
+
+  for (i=0; i!=this->n; i++) {
+    for (k=0; k!=nvec; k++) {
+      t = X[k*this->n+i];
+      l = k*this->m;
+      for (j=pcol[i]; j!=pcol[i+1]; j++) {
+        Y[l+irow[j]] += t*a[j];
+      }
+    }
+  }
+
+} // MultMV.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 {
@@ -553,6 +642,37 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 } // MultMtv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMtV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  int    i, j, k, l;
+  ARTYPE t;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluNonSymMatrix::MultMtV");
+  }
+
+  // Determining Y = M'.X. Each column of M is used by all the nvec
+  // products before the next one is read.
+
+  for (i=0; i!=this->n; i++) {
+    for (k=0; k!=nvec; k++) {
+      t = (ARTYPE)0;
+      l = k*this->m;
+      for (j=pcol[i]; j!=pcol[i+1]; j++) {
+        t += X[l+irow[j]]*a[j];
+      }
+      Y[k*this->n+i] = t;
+    }
+  }
+
+} // MultMtV.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 {
@@ -571,12 +691,30 @@ template<class ARTYPE, class ARFLOAT>
 void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[this->n];
+  int    i,j;
+  ARTYPE t;
+
+  // Quitting the function if A was not defined.
 
-  MultMtv(v,t);
-  MultMv(t,w);
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARluNonSymMatrix::MultMMtv");
+  }
 
-  delete[] t;
+  // Determining w = M.M'.v. Each column of M is used twice while it is
+  // still in cache: t = M(:,i)'.v is computed and t*M(:,i) is added to w.
+
+  for (i=0; i!=this->m; i++) w[i]=(ARTYPE)0;
+
+  for (i=0; i!=this->n; i++) {
+    t = (ARTYPE)0;
+    for (j=pcol[i]; j!=pcol[i+1]; j++) {
+      t += v[irow[j]]*a[j];
+    }
+    for (j=pcol[i]; j!=pcol[i+1]; j++) {
+      w[irow[j]] += t*a[j];
+    }
+  }
 
 } // MultMMtv.
 
@@ -618,12 +756,43 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
+MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARluNonSymMatrix::MultInvV");
+  }
+
+  // Solving A.Y = X (or AsI.Y = X). gstrs solves for all columns of Y
+  // in each supernode of L and U.
+
+  int         info;
+  SuperMatrix B;
+
+  if (X != Y) copy(this->n*nrhs, X, 1, Y, 1);
+  Create_Dense_Matrix(&B, this->n, nrhs, Y, this->n, SLU_DN, SLU_GE);
+  trans_t trans = NOTRANS;
+  gstrs(trans, &L, &U, permc, permr, &B, &stat, &info);
+  Destroy_SuperMatrix_Store(&B); // delete B.Store;
+
+} // MultInvV.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
              double thresholdp, int orderp, bool check)
 {
 
+  // Discarding the symbolic factorization of the previous matrix.
+
+  ClearSymbolic();
+
   this->m         = np;
   this->n         = np;
   nnz       = nnzp;
@@ -660,6 +829,8 @@ inline void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp)
 {
 
+  ClearSymbolic();
+
   this->m       = mp;
   this->n       = np;
   nnz     = nnzp;
@@ -679,6 +850,8 @@ inline ARluNonSymMatrix<ARTYPE, ARFLOAT>::ARluNonSymMatrix(): ARMatrix<ARTYPE>()
 { 
 
   factored = false;  
+  analyzed = false;
+  etree    = NULL;
   permc    = NULL;
   permr    = NULL;
 
@@ -693,6 +866,7 @@ ARluNonSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
 {
 
   factored = false;
+  analyzed = false;
   DefineMatrix(np, nnzp, ap, irowp, pcolp, thresholdp, orderp, check);
 
 } // Long constructor (square matrix).
@@ -705,6 +879,7 @@ ARluNonSymMatrix(int mp, int np, int nnzp, ARTYPE* ap,
 {
 
   factored = false;
+  analyzed = false;
   DefineMatrix(mp, np, nnzp, ap, irowp, pcolp);
 
 } // Long constructor (retangular matrix).
@@ -716,6 +891,7 @@ ARluNonSymMatrix(const std::string& file, double thresholdp, int orderp, bool ch
 {
 
   factored = false;
+  analyzed = false;
 
   try {
     mat.Define(file);
@@ -723,6 +899,10 @@ ARluNonSymMatrix(const std::string& file, double thresholdp, int orderp, bool ch
   catch (ArpackError) {    // Returning from here if an error has occurred.
     throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARluNonSymMatrix");
   }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "ARluNonSymMatrix");
+    throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARluNonSymMatrix");
+  }
 
   if (mat.NCols()==mat.NRows()) {
     DefineMatrix(mat.NCols(), mat.NonZeros(), (ARTYPE*)mat.Entries(),
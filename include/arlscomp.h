@@ -98,7 +98,11 @@ Copy(const ARluCompStdEig<ARFLOAT>& other)
   ARStdEig<ARFLOAT, arcomplex<ARFLOAT>, 
            ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     Copy(other);
-  if (this->mode > 2) this->objOP->FactorAsI(this->sigmaR);
+  if (this->mode > 2) {
+    this->StartFactor();
+    this->objOP->FactorAsI(this->sigmaR);
+    this->StopFactor();
+  }
 
 } // Copy.
 
@@ -107,7 +111,9 @@ template<class ARFLOAT>
 inline void ARluCompStdEig<ARFLOAT>::ChangeShift(arcomplex<ARFLOAT> sigmap)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsI(sigmap);
+  this->StopFactor();
   ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> >::ChangeShift(sigmap);
 
 } // ChangeShift.
@@ -134,6 +140,7 @@ SetShiftInvertMode(arcomplex<ARFLOAT> sigmap)
            ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP,
                        &ARluNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARluNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -167,6 +174,7 @@ ARluCompStdEig(int nevp, ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
                    &ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARluNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
@@ -21,15 +21,31 @@
 #define ARLSMAT_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "armat.h"
 #include "arhbmat.h"
+#include "arspmv.h"
 #include "arerror.h"
 #include "blas1c.h"
 #include "superluc.h"
 #include "arlspdef.h"
 #include "arlutil.h"
+#include "arfcache.h"
+
+
+// ARluFactor: LU factors of A-sigma*I (or A-sigma*B) stored by
+// ARFactorCache.
+
+struct ARluFactor {
+  SuperMatrix L;
+  SuperMatrix U;
+  int*        permc;     // Column permutation (NULL if it is shared).
+  int*        permr;     // Row permutation.
+  bool        diagonal;  // Only diagonal pivots were used.
+};
+
 
 template<class ARTYPE> class ARluSymPencil;
 
@@ -41,6 +57,7 @@ class ARluSymMatrix: public ARMatrix<ARTYPE> {
  protected:
 
   bool        factored;
+  bool        analyzed;
   char        uplo;
   int         order;
   int         nnz;
@@ -53,8 +70,16 @@ class ARluSymMatrix: public ARMatrix<ARTYPE> {
   SuperMatrix A;
   SuperMatrix L;
   SuperMatrix U;
+  SuperMatrix AsI;
+  SuperMatrix AC;
+  int*        etree;
   ARhbMatrix<int, ARTYPE> mat;
+  ARspSymMV<ARTYPE>       prod;
   SuperLUStat_t stat;
+  bool          shifted;
+  ARTYPE        sigmaf;
+  unsigned long version;
+  ARFactorCache<ARTYPE, ARluFactor, ARluSymMatrix<ARTYPE> > cache;
 
   bool DataOK();
 
@@ -62,7 +87,18 @@ class ARluSymMatrix: public ARMatrix<ARTYPE> {
 
   void ClearMem();
 
-  void ExpandA(NCformat& A, NCformat& Aexp, ARTYPE sigma = (ARTYPE)0);
+  void ExpandA(NCformat& A, NCformat& Aexp, ARTYPE sigma = (ARTYPE)0,
+               bool diag = false);
+
+  void FreeFactor(ARluFactor& f);
+
+  void ReleaseFactor();
+  // Moves L, U and permr to the cache if they are the factors of
+  // A-sigmaf*I, or deletes them otherwise.
+
+  bool ReuseFactor(ARTYPE sigma);
+  // Returns true if L and U are (or were taken from the cache and
+  // are now) the factors of A-sigma*I.
 
  public:
 
@@ -74,10 +110,45 @@ class ARluSymMatrix: public ARMatrix<ARTYPE> {
 
   void FactorAsI(ARTYPE sigma);
 
+  void ClearSymbolic();
+  // Discards the column ordering and elimination tree of A-sigma*I that
+  // were computed by the first call to FactorAsI and are reused by the
+  // following ones. Must be called if the sparsity pattern of A (irow,
+  // pcol) was changed after DefineMatrix. Changes in the values of A
+  // only require a call to ChangeValues.
+
+  void ChangeValues();
+  // Must be called when the values of A (but not its pattern) were
+  // changed after DefineMatrix. The factors of A-sigma*I computed
+  // before (including those stored in the cache) are discarded.
+
+  void SetFactorCache(int maxentries, std::size_t budget = 0);
+  // Keeps the factors of A-sigma*I computed for up to maxentries
+  // previous shifts, taking at most budget bytes (0 = no limit), so
+  // FactorAsI does not factor A-sigma*I again when one of these shifts
+  // is used. The least recently used factors are discarded first.
+  // maxentries = 0 (the default) disables the cache. The factors of
+  // the last shift are always reused if sigma is not changed.
+
+  int GetCacheEntries() { return cache.GetEntries(); }
+
+  std::size_t GetCacheMemory() { return cache.GetMemory(); }
+
+  int GetCacheHits() { return cache.GetHits(); }
+
+  int GetThreads() { return prod.GetThreads(); }
+
+  void ChangeThreads(int nthreadsp) { prod.ChangeThreads(nthreadsp); }
+  // Changes the number of threads used by MultMv (0 = OpenMP default).
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMV(ARTYPE* X, ARTYPE* Y, int nvec);
+
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+
   void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
                     char uplop = 'L', double thresholdp = 0.1,
                     int orderp = 2, bool check = true);
@@ -152,6 +223,9 @@ inline void ARluSymMatrix<ARTYPE>::Copy(const ARluSymMatrix<ARTYPE>& other)
 
   this->defined   = other.defined;
   factored  = other.factored;
+  analyzed  = false;
+  shifted   = false;
+  version   = 0;
 
   // Returning from here if "other" was not initialized.
 
@@ -161,6 +235,9 @@ inline void ARluSymMatrix<ARTYPE>::Copy(const ARluSymMatrix<ARTYPE>& other)
 
   DefineMatrix(other.n, other.nnz, other.a, other.irow, other.pcol,
                other.uplo, other.threshold, other.order);
+  prod = other.prod;
+  cache.Define(this, &ARluSymMatrix<ARTYPE>::FreeFactor,
+               other.cache.GetMaxEntries(), other.cache.GetBudget());
 
   // Throwing the original factorization away (this procedure 
   // is really awkward, but it is necessary because there
@@ -185,6 +262,7 @@ void ARluSymMatrix<ARTYPE>::ClearMem()
     Destroy_CompCol_Matrix(&U);
     StatFree(&stat);
   }
+  ClearSymbolic();
   if (this->defined) {
     Destroy_SuperMatrix_Store(&A); // delete A.Store;
     delete[] permc;
@@ -197,9 +275,132 @@ void ARluSymMatrix<ARTYPE>::ClearMem()
 } // ClearMem.
 
 
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::ClearSymbolic()
+{
+
+  if (analyzed) {
+    Destroy_CompCol_Permuted(&AC);
+    Destroy_CompCol_Matrix(&AsI);
+    delete[] etree;
+    etree    = NULL;
+    analyzed = false;
+  }
+
+  // The factors stored in the cache depend on permc.
+
+  cache.Clear();
+  shifted = false;
+
+} // ClearSymbolic.
+
+
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::FreeFactor(ARluFactor& f)
+{
+
+  Destroy_SuperNode_Matrix(&f.L);
+  Destroy_CompCol_Matrix(&f.U);
+  delete[] f.permc;
+  delete[] f.permr;
+
+} // FreeFactor.
+
+
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::ReleaseFactor()
+{
+
+  ARluFactor  f;
+  std::size_t bytes;
+
+  if (!factored) return;
+
+  if (shifted && cache.Enabled()) {
+
+    // Moving L, U and permr to the cache. permc is shared by all
+    // factorizations of A-sigma*I.
+
+    f.L        = L;
+    f.U        = U;
+    f.permc    = NULL;
+    f.permr    = permr;
+    f.diagonal = false;
+    bytes  = std::size_t(((SCformat*)L.Store)->nnz+((NCformat*)U.Store)->nnz)*
+             (sizeof(ARTYPE)+sizeof(int))+std::size_t(this->n)*sizeof(int);
+    permr  = new int[this->n];
+    cache.Store(sigmaf, version, f, bytes);
+
+  }
+  else {
+
+    Destroy_SuperNode_Matrix(&L);
+    Destroy_CompCol_Matrix(&U);
+
+  }
+  StatFree(&stat);
+  factored = false;
+  shifted  = false;
+
+} // ReleaseFactor.
+
+
+template<class ARTYPE>
+bool ARluSymMatrix<ARTYPE>::ReuseFactor(ARTYPE sigma)
+{
+
+  ARluFactor f;
+
+  // Checking if L and U already are the factors of A-sigma*I.
+
+  if (factored && shifted && (sigmaf == sigma)) return true;
+
+  // Looking for the factors of A-sigma*I in the cache.
+
+  if (!cache.Retrieve(sigma, version, f)) return false;
+
+  // Replacing L and U by the factors found in the cache.
+
+  ReleaseFactor();
+  delete[] permr;
+  L        = f.L;
+  U        = f.U;
+  permr    = f.permr;
+  StatInit(&stat);
+  factored = true;
+  shifted  = true;
+  sigmaf   = sigma;
+  return true;
+
+} // ReuseFactor.
+
+
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::ChangeValues()
+{
+
+  // L and U can no longer be reused by FactorAsI.
+
+  cache.Clear();
+  shifted = false;
+  version++;
+
+} // ChangeValues.
+
+
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::
+SetFactorCache(int maxentries, std::size_t budget)
+{
+
+  cache.Define(this, &ARluSymMatrix<ARTYPE>::FreeFactor, maxentries, budget);
+
+} // SetFactorCache.
+
+
 template<class ARTYPE>
 void ARluSymMatrix<ARTYPE>::
-ExpandA(NCformat& A, NCformat& Aexp, ARTYPE sigma)
+ExpandA(NCformat& A, NCformat& Aexp, ARTYPE sigma, bool diag)
 {
 
   // Defining local variables.
@@ -210,9 +411,10 @@ ExpandA(NCformat& A, NCformat& Aexp, ARTYPE sigma)
   int    *indA, *indE;
   ARTYPE *valA, *valE;
 
-  // Checking if sigma is zero.
+  // Checking if sigma is zero. All diagonal elements are stored
+  // in Aexp if diag is true.
 
-  subtract = (sigma != (ARTYPE)0);
+  subtract = (diag || (sigma != (ARTYPE)0));
 
   // Simplifying the notation.
 
@@ -360,6 +562,11 @@ void ARluSymMatrix<ARTYPE>::FactorA()
   NCformat*   Astore;
   NCformat*   Aexpstore;
 
+  // Discarding the symbolic factorization of A-sigma*I, since permc
+  // will be overwritten.
+
+  ClearSymbolic();
+
   // Deleting previous versions of L and U.
   
   if (factored) {
@@ -394,11 +601,26 @@ void ARluSymMatrix<ARTYPE>::FactorA()
   // options.DiagPivotThresh = 0.001;
   options.DiagPivotThresh = threshold;
 
-  // Creating a temporary matrix Aexp.
+  // Creating a temporary matrix Aexp and reserving memory for etree
+  // (used in matrix decomposition).
 
-  irowi = new int[nnz*2];
-  pcoli = new int[this->n+1];
-  aexp  = new ARTYPE[nnz*2];
+  irowi = NULL;
+  pcoli = NULL;
+  aexp  = NULL;
+  try {
+    irowi = new int[nnz*2];
+    pcoli = new int[this->n+1];
+    aexp  = new ARTYPE[nnz*2];
+    etree = new int[this->n];
+  }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    delete[] irowi;
+    delete[] pcoli;
+    delete[] aexp;
+    factored = false;
+    throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                      "ARluSymMatrix::FactorA");
+  }
   Create_CompCol_Matrix(&Aexp, this->n,  this->n, nnz, aexp, irowi, pcoli, SLU_NC, SLU_GE);
 
   // Expanding A.
@@ -407,10 +629,6 @@ void ARluSymMatrix<ARTYPE>::FactorA()
   Aexpstore = (NCformat*)Aexp.Store;
   ExpandA(*Astore, *Aexpstore);
 
-  // Reserving memory for etree (used in matrix decomposition).
-
-  etree = new int[this->n];
-
   // Defining LUStat.
 
   //StatInit(panel_size, relax);
@@ -469,25 +687,22 @@ void ARluSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluSymMatrix::FactorAsI");
   }
 
+  // Reusing the factors of A-sigma*I computed before, if possible.
+
+  if (ReuseFactor(sigma)) return;
+
   // Defining local variables.
 
   int         info;
-  int*        etree;
   int*        irowi;
   int*        pcoli;
   ARTYPE*     asi;
-  SuperMatrix AsI;
-  SuperMatrix AC;
   NCformat*   Astore;
   NCformat*   AsIstore;
 
-  // Deleting previous versions of L and U.
-  
-  if (factored) {
-    Destroy_SuperNode_Matrix(&L);
-    Destroy_CompCol_Matrix(&U);
-    StatFree(&stat);
-  }
+  // Deleting previous versions of L and U (or storing them in the cache).
+
+  ReleaseFactor();
 
   // Setting default values for gstrf parameters.
 
@@ -515,36 +730,55 @@ void ARluSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
   // options.DiagPivotThresh = 0.001;
   options.DiagPivotThresh = threshold;
 
-  // Creating a temporary matrix AsI.
-
-  irowi = new int[nnz*2+this->n];
-  pcoli = new int[this->n+1];
-  asi   = new ARTYPE[nnz*2+this->n];
-  Create_CompCol_Matrix(&AsI, this->n,  this->n, nnz, asi, irowi, pcoli, SLU_NC, SLU_GE);
+  // Creating matrix AsI. AsI is kept (with its column ordering and
+  // elimination tree) after the decomposition. Because all diagonal
+  // elements are stored, the pattern of AsI does not depend on sigma.
+
+  if (!analyzed) {
+    irowi = NULL;
+    pcoli = NULL;
+    asi   = NULL;
+    try {
+      irowi = new int[nnz*2+this->n];
+      pcoli = new int[this->n+1];
+      asi   = new ARTYPE[nnz*2+this->n];
+      etree = new int[this->n];
+    }
+    catch (const std::bad_alloc&) { // Memory is not sufficient.
+      delete[] irowi;
+      delete[] pcoli;
+      delete[] asi;
+      throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                        "ARluSymMatrix::FactorAsI");
+    }
+    Create_CompCol_Matrix(&AsI, this->n,  this->n, nnz, asi, irowi, pcoli, SLU_NC, SLU_GE);
+  }
 
   // Subtracting sigma*I from A and storing the result on AsI.
 
   Astore   = (NCformat*)A.Store;
   AsIstore = (NCformat*)AsI.Store;
-  ExpandA(*Astore, *AsIstore, sigma);
-
-  // Reserving memory for etree (used in matrix decomposition).
-
-  etree = new int[this->n];
+  ExpandA(*Astore, *AsIstore, sigma, true);
 
   // Defining LUStat.
 
   //StatInit(panel_size, relax);
   StatInit(&stat);
 
-  // Defining the column permutation of matrix AsI
-  // (using minimum degree ordering).
+  if (!analyzed) {
+
+    // Defining the column permutation of matrix AsI
+    // (using minimum degree ordering).
 
-  get_perm_c(order, &AsI, permc);
+    get_perm_c(order, &AsI, permc);
 
-  // Permuting columns of AsI and creating the elimination tree.
+    // Permuting columns of AsI and creating the elimination tree.
+    // AC shares row indices and values with AsI.
 
-  sp_preorder(&options, &AsI, permc, etree, &AC);
+    sp_preorder(&options, &AsI, permc, etree, &AC);
+    analyzed = true;
+
+  }
 
   // Decomposing AsI.
 
@@ -553,13 +787,9 @@ void ARluSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
   gstrf(&options,&AC, relax, panel_size, etree,
         NULL, 0, permc, permr, &L, &U, &stat, &info);
 
-  // Deleting AC, AsI and etree.
-
-  Destroy_CompCol_Permuted(&AC);
-  Destroy_CompCol_Matrix(&AsI);
-  delete[] etree;
-
   factored = (info == 0);
+  shifted  = factored;
+  sigmaf   = sigma;
 
   // Handling errors.
 
@@ -583,9 +813,6 @@ template<class ARTYPE>
 void ARluSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 {
 
-  int    i, j, k;
-  ARTYPE t;
-
   // Quitting the function if A was not defined.
 
   if (!this->IsDefined()) {
@@ -594,42 +821,26 @@ void ARluSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 
   // Determining w = M.v.
 
-  for (i=0; i!=this->m; i++) w[i]=(ARTYPE)0;
+  prod.MultMv(v, w);
 
-  if (uplo == 'U') {
+} // MultMv.
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i+1];
-      if ((k!=pcol[i])&&(irow[k-1]==i)) {
-        w[i] += t*a[k-1];
-        k--;
-      }
-      for (j=pcol[i]; j<k; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
 
-  }
-  else {
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i];
-      if ((k!=pcol[i+1])&&(irow[k]==i)) {
-        w[i] += t*a[k];
-        k++;
-      }
-      for (j=k; j<pcol[i+1]; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
+  // Quitting the function if A was not defined.
 
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluSymMatrix::MultMV");
   }
 
-} // MultMv.
+  // Determining Y = M.X.
+
+  prod.MultMV(X, Y, nvec);
+
+} // MultMV.
 
 
 template<class ARTYPE>
@@ -659,12 +870,43 @@ void ARluSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARluSymMatrix::MultInvV");
+  }
+
+  // Solving A.Y = X (or AsI.Y = X). gstrs solves for all columns of Y
+  // in each supernode of L and U.
+
+  int         info;
+  SuperMatrix B;
+
+  if (X != Y) copy(this->n*nrhs, X, 1, Y, 1);
+  Create_Dense_Matrix(&B, this->n, nrhs, Y, this->n, SLU_DN, SLU_GE);
+  trans_t trans = NOTRANS;
+  gstrs(trans, &L, &U, permc, permr, &B, &stat, &info);
+  Destroy_SuperMatrix_Store(&B); // delete B.Store;
+
+} // MultInvV.
+
+
 template<class ARTYPE>
 inline void ARluSymMatrix<ARTYPE>::
 DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
              char uplop, double thresholdp, int orderp, bool check)
 {
 
+  // Discarding the symbolic factorization of the previous matrix.
+
+  ClearSymbolic();
+  version++;
+
   this->m         = np;
   this->n         = np;
   nnz       = nnzp;
@@ -692,6 +934,10 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
   permc = new int[this->n];
   permr = new int[this->n];
 
+  // Preparing the matrix-vector product.
+
+  prod.Define(this->n, a, irow, pcol, uplo);
+
   this->defined = true;
 
 } // DefineMatrix.
@@ -702,6 +948,10 @@ inline ARluSymMatrix<ARTYPE>::ARluSymMatrix(): ARMatrix<ARTYPE>()
 {
 
   factored = false;
+  analyzed = false;
+  shifted  = false;
+  version  = 0;
+  etree    = NULL;
   permc    = NULL;
   permr    = NULL;
  
@@ -716,6 +966,9 @@ ARluSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
 {
 
   factored = false;
+  analyzed = false;
+  shifted  = false;
+  version  = 0;
   DefineMatrix(np, nnzp, ap, irowp, pcolp, uplop, thresholdp, orderp, check);
 
 } // Long constructor.
@@ -727,6 +980,9 @@ ARluSymMatrix(const std::string& file, double thresholdp, int orderp, bool check
 {
 
   factored = false;
+  analyzed = false;
+  shifted  = false;
+  version  = 0;
 
   try {
     mat.Define(file);
@@ -734,6 +990,10 @@ ARluSymMatrix(const std::string& file, double thresholdp, int orderp, bool check
   catch (ArpackError) {    // Returning from here if an error has occurred.
     throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARluSymMatrix");
   }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "ARluSymMatrix");
+    throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARluSymMatrix");
+  }
 
   if ((mat.NCols() == mat.NRows()) && (mat.IsSymmetric())) {
 
@@ -92,7 +92,11 @@ Copy(const ARluNonSymStdEig<ARFLOAT>& other)
 {
 
   ARStdEig<ARFLOAT, ARFLOAT, ARluNonSymMatrix<ARFLOAT, ARFLOAT> >:: Copy(other);
-  if (this->mode > 2) this->objOP->FactorAsI(this->sigmaR);
+  if (this->mode > 2) {
+    this->StartFactor();
+    this->objOP->FactorAsI(this->sigmaR);
+    this->StopFactor();
+  }
 
 } // Copy.
 
@@ -106,7 +110,9 @@ inline void ARluNonSymStdEig<ARFLOAT>::ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -129,6 +135,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARluNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, 
                        &ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -161,6 +168,7 @@ ARluNonSymStdEig(int nevp, ARluNonSymMatrix<ARFLOAT, ARFLOAT>& A,
                    &ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
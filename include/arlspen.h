@@ -26,6 +26,7 @@
 #include "arlspdef.h"
 #include "arlutil.h"
 #include "arlsmat.h"
+#include "arfcache.h"
 
 
 template<class ARTYPE>
@@ -44,11 +45,28 @@ class ARluSymPencil
   SuperMatrix            L;
   SuperMatrix            U;
   SuperLUStat_t stat;
+  bool                   diagonal;
+  ARTYPE                 sigmaf;
+  unsigned long          fversion;
+  ARFactorCache<ARTYPE, ARluFactor, ARluSymPencil<ARTYPE> > cache;
 
   virtual void Copy(const ARluSymPencil& other);
 
   void ClearMem();
 
+  unsigned long Version() { return A->version+B->version; }
+
+  void FreeFactor(ARluFactor& f);
+
+  void ReleaseFactor();
+  // Moves L, U, permc and permr to the cache, or deletes them if the
+  // cache is disabled.
+
+  bool ReuseFactor(ARTYPE sigma, bool diag);
+  // Returns true if L and U are (or were taken from the cache and are
+  // now) the factors of A-sigma*B. If diag is true, only factors that
+  // were computed using diagonal pivots are accepted.
+
   void SparseSaxpy(ARTYPE a, ARTYPE x[], int xind[], int nx, ARTYPE y[],
                    int yind[], int ny, ARTYPE z[], int zind[], int& nz);
 
@@ -57,11 +75,19 @@ class ARluSymPencil
   void SubtractAsB(int n, ARTYPE sigma, NCformat& A, 
                    NCformat& B, NCformat& AsB);
 
+  void FactorAsB(ARTYPE sigma, double threshold);
+
  public:
 
   bool IsFactored() { return factored; }
 
-  void FactorAsB(ARTYPE sigma);
+  void FactorAsB(ARTYPE sigma) { FactorAsB(sigma, A->threshold); }
+
+  int Inertia(ARTYPE sigma);
+  // Factors A-sigma*B using diagonal pivots only and returns the number
+  // of negative pivots, that is, the number of eigenvalues of (A,B)
+  // that are smaller than sigma (B must be positive definite).
+  // The factorization can be used by MultInvAsBv.
 
   void MultAv(ARTYPE* v, ARTYPE* w) { A->MultMv(v,w); }
 
@@ -71,6 +97,20 @@ class ARluSymPencil
 
   void MultInvAsBv(ARTYPE* v, ARTYPE* w);
 
+  void SetFactorCache(int maxentries, std::size_t budget = 0);
+  // Keeps the factors of A-sigma*B computed for up to maxentries
+  // previous shifts, taking at most budget bytes (0 = no limit), so
+  // FactorAsB and Inertia do not factor A-sigma*B again when one of
+  // these shifts is used. maxentries = 0 disables the cache. The
+  // factors of the last shift are always reused if sigma, A and B
+  // are not changed (see ARluSymMatrix::ChangeValues).
+
+  int GetCacheEntries() { return cache.GetEntries(); }
+
+  std::size_t GetCacheMemory() { return cache.GetMemory(); }
+
+  int GetCacheHits() { return cache.GetHits(); }
+
   void DefineMatrices(ARluSymMatrix<ARTYPE>& Ap, ARluSymMatrix<ARTYPE>& Bp);
 
   ARluSymPencil();
@@ -82,7 +122,7 @@ class ARluSymPencil
   ARluSymPencil(const ARluSymPencil& other) { Copy(other); }
   // Copy constructor.
 
-  virtual ~ARluSymPencil() { ClearMem(); }
+  virtual ~ARluSymPencil() { ClearMem(); cache.Clear(); }
   // Destructor.
 
   ARluSymPencil& operator=(const ARluSymPencil& other);
@@ -105,6 +145,8 @@ Copy(const ARluSymPencil<ARTYPE>& other)
   uplo     = other.uplo;
   A        = other.A;
   B        = other.B;
+  cache.Define(this, &ARluSymPencil<ARTYPE>::FreeFactor,
+               other.cache.GetMaxEntries(), other.cache.GetBudget());
 
   // Throwing the original factorization away (this procedure 
   // is really awkward, but it is necessary because there
@@ -137,6 +179,89 @@ void ARluSymPencil<ARTYPE>::ClearMem()
 } // ClearMem.
 
 
+template<class ARTYPE>
+void ARluSymPencil<ARTYPE>::FreeFactor(ARluFactor& f)
+{
+
+  Destroy_SuperNode_Matrix(&f.L);
+  Destroy_CompCol_Matrix(&f.U);
+  delete[] f.permc;
+  delete[] f.permr;
+
+} // FreeFactor.
+
+
+template<class ARTYPE>
+void ARluSymPencil<ARTYPE>::ReleaseFactor()
+{
+
+  ARluFactor  f;
+  std::size_t bytes;
+
+  if (factored && cache.Enabled()) {
+
+    f.L        = L;
+    f.U        = U;
+    f.permc    = permc;
+    f.permr    = permr;
+    f.diagonal = diagonal;
+    bytes = std::size_t(((SCformat*)L.Store)->nnz+((NCformat*)U.Store)->nnz)*
+            (sizeof(ARTYPE)+sizeof(int))+std::size_t(2*A->ncols())*sizeof(int);
+    permc = NULL;
+    permr = NULL;
+    StatFree(&stat);
+    factored = false;
+    cache.Store(sigmaf, fversion, f, bytes);
+
+  }
+  else {
+
+    ClearMem();
+    factored = false;
+
+  }
+
+} // ReleaseFactor.
+
+
+template<class ARTYPE>
+bool ARluSymPencil<ARTYPE>::ReuseFactor(ARTYPE sigma, bool diag)
+{
+
+  ARluFactor f;
+
+  // Checking if L and U already are the factors of A-sigma*B.
+
+  if (factored && (sigmaf == sigma) && (fversion == Version()) &&
+      (diagonal || !diag)) {
+    return true;
+  }
+
+  // Looking for the factors of A-sigma*B in the cache.
+
+  if (!cache.Retrieve(sigma, Version(), f)) return false;
+  if (diag && !f.diagonal) {
+    FreeFactor(f);
+    return false;
+  }
+
+  // Replacing L and U by the factors found in the cache.
+
+  ReleaseFactor();
+  L        = f.L;
+  U        = f.U;
+  permc    = f.permc;
+  permr    = f.permr;
+  diagonal = f.diagonal;
+  StatInit(&stat);
+  factored = true;
+  sigmaf   = sigma;
+  fversion = Version();
+  return true;
+
+} // ReuseFactor.
+
+
 template<class ARTYPE>
 void ARluSymPencil<ARTYPE>::
 SparseSaxpy(ARTYPE a, ARTYPE x[], int xind[], int nx, ARTYPE y[],
@@ -449,7 +574,7 @@ SubtractAsB(int n, ARTYPE sigma, NCformat& matA, NCformat& matB, NCformat& AsB)
 // } // FactorAsB.
 
 template<class ARTYPE>
-void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
+void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma, double threshold)
 {
 
   // Quitting the function if A and B were not defined.
@@ -466,6 +591,10 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
                       "ARluSymPencil::FactorAsB");
   }
 
+  // Reusing the factors of A-sigma*B computed before, if possible.
+
+  if (ReuseFactor(sigma, threshold == 0.0)) return;
+
   // Defining local variables.
 
   int         nnzi, info;
@@ -479,9 +608,10 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   NCformat*   Bstore;
   NCformat*   AsBstore;
 
-  // Deleting old versions of L, U, perm_r and perm_c.
+  // Deleting old versions of L, U, perm_r and perm_c (or storing
+  // them in the cache).
 
-  ClearMem();
+  ReleaseFactor();
 
   // Setting default values for gstrf parameters.
 
@@ -505,7 +635,7 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   /* Now we modify the default options to use the symmetric mode. */
   options.SymmetricMode = YES;
   options.ColPerm = MMD_AT_PLUS_A;
-  options.DiagPivotThresh = A->threshold;
+  options.DiagPivotThresh = threshold;
 
   // Defining A and B format.
 
@@ -532,11 +662,10 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   if (permc == NULL) permc = new int[A->ncols()];
   if (permr == NULL) permr = new int[A->ncols()];
 
-  // Defining LUStat.
+  // Defining LUStat (it is released by ClearMem).
 
 //  StatInit(panel_size, relax);
-    SuperLUStat_t stat;
-    StatInit(&stat);
+  StatInit(&stat);
 
   // Defining the column permutation of matrix AsB
   // (using minimum degree ordering on AsB'*AsB).
@@ -562,6 +691,9 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   delete[] etree;
 
   factored = (info == 0);
+  diagonal = (threshold == 0.0);
+  sigmaf   = sigma;
+  fversion = Version();
 
   // Handling errors.
 
@@ -580,6 +712,43 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
 
 } // FactorAsB.
 
+
+template<class ARTYPE>
+int ARluSymPencil<ARTYPE>::Inertia(ARTYPE sigma)
+{
+
+  int       i, j, s, neg;
+  ARTYPE*   lval;
+  SCformat* Lstore;
+
+  // Decomposing A-sigma*B. Off-diagonal pivots are only selected
+  // when a diagonal element is exactly zero.
+
+  FactorAsB(sigma, 0.0);
+
+  // If P is the symmetric permutation used, P*AsB*P' = L*D*L' and
+  // D = diag(U). Sylvester's law of inertia is not valid otherwise.
+
+  for (i=0; i<A->ncols(); i++) {
+    if (permr[i] != permc[i]) {
+      throw ArpackError(ArpackError::MATRIX_IS_SINGULAR,
+                        "ARluSymPencil::Inertia");
+    }
+  }
+
+  // Counting negative elements of diag(U) (stored in L supernodes).
+
+  Lstore = (SCformat*)L.Store;
+  lval   = (ARTYPE*)Lstore->nzval;
+  neg    = 0;
+  for (j=0; j<A->ncols(); j++) {
+    s = Lstore->sup_to_col[Lstore->col_to_sup[j]];
+    if (lval[Lstore->nzval_colptr[j]+j-s] < (ARTYPE)0) neg++;
+  }
+  return neg;
+
+} // Inertia.
+
 template<class ARTYPE>
 void ARluSymPencil<ARTYPE>::MultInvBAv(ARTYPE* v, ARTYPE* w)
 {
@@ -612,7 +781,6 @@ void ARluSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
   Create_Dense_Matrix(&RHS, A->nrows(), 1, w, A->nrows(), SLU_DN, SLU_GE);
 //  gstrs("N", &L, &U, permr, permc, &RHS, &info);
   trans_t trans = NOTRANS;
-  StatInit(&stat);
 
   gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
 
@@ -621,11 +789,27 @@ void ARluSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
 } // MultInvAsBv.
 
 
+template<class ARTYPE>
+void ARluSymPencil<ARTYPE>::
+SetFactorCache(int maxentries, std::size_t budget)
+{
+
+  cache.Define(this, &ARluSymPencil<ARTYPE>::FreeFactor, maxentries, budget);
+
+} // SetFactorCache.
+
+
 template<class ARTYPE>
 inline void ARluSymPencil<ARTYPE>::
 DefineMatrices(ARluSymMatrix<ARTYPE>& Ap, ARluSymMatrix<ARTYPE>& Bp)
 {
 
+  // Discarding the factors of the previous pencil.
+
+  ClearMem();
+  cache.Clear();
+  factored = false;
+
   A     = &Ap;
   B     = &Bp;
   permc = NULL;
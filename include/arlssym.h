@@ -93,7 +93,11 @@ inline void ARluSymStdEig<ARFLOAT>::Copy(const ARluSymStdEig<ARFLOAT>& other)
 {
 
   ARStdEig<ARFLOAT, ARFLOAT, ARluSymMatrix<ARFLOAT> >:: Copy(other);
-  if (this->mode > 2) this->objOP->FactorAsI(this->sigmaR);
+  if (this->mode > 2) {
+    this->StartFactor();
+    this->objOP->FactorAsI(this->sigmaR);
+    this->StopFactor();
+  }
 
 } // Copy.
 
@@ -107,7 +111,9 @@ inline void ARluSymStdEig<ARFLOAT>::ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -129,6 +135,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARluSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARluSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARluSymMatrix<ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -158,6 +165,7 @@ ARluSymStdEig(int nevp, ARluSymMatrix<ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, &ARluSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARluSymMatrix<ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
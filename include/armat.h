@@ -50,6 +50,13 @@ class ARMatrix {
   virtual void MultMv(ARTYPE* v, ARTYPE* w) = 0;
   // Matrix-vector product: w = A*v.
 
+  virtual void MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+  // Matrix-block product: Y = A*X, where X (n x nvec) and Y (m x nvec)
+  // are stored by columns.
+  {
+    for (int j=0; j<nvec; j++) MultMv(&X[j*n], &Y[j*m]);
+  } // MultMV.
+
 }; // ARMatrix.
 
 #endif // ARMAT_H
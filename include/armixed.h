@@ -0,0 +1,760 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARMixed.h.
+   Arpack++ classes ARMixedMatrix and ARSymRefine definition.
+   These classes make it possible to solve a real symmetric
+   problem in single precision and to deliver double precision
+   results:
+
+   - ARSymRefine takes the eigenvectors computed in single
+     precision by any symmetric solver (ARSymStdEig<float, ...>,
+     ARluSymStdEig<float>, ARbkSymStdEig<float>, ...) and refines
+     them in double precision by the Rayleigh-Ritz method applied
+     to the subspace spanned by the eigenvectors, by a few guard
+     vectors, by their (optionally preconditioned) residuals and by
+     their last corrections (LOBPCG).
+
+   - ARMixedMatrix factors A or A-sigma*I in single precision
+     (using any matrix class that has FactorA, FactorAsI and
+     MultInvv functions) and solves the double precision linear
+     systems required by the shift and invert mode by iterative
+     refinement.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARMIXED_H
+#define ARMIXED_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include "arch.h"
+#include "arerror.h"
+#include "armat.h"
+#include "arrseig.h"
+#include "blas1c.h"
+#include "lapackc.h"
+
+
+// ARMixedMatrix class definition.
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+class ARMixedMatrix: public ARMatrix<ARFLOAT> {
+
+ protected:
+
+  ARMATRIX* A;       // Matrix A (ARFLOAT precision).
+  ARLOWMAT* Alow;    // Matrix A (ARLOW precision), factored.
+  ARFLOAT   sigma;   // Shift (A-sigma*I is factored).
+  bool      factored;
+  int       maxref;  // Maximum number of refinement steps.
+  ARFLOAT   tol;     // Relative residual required by MultInvv.
+  int       nref;    // Refinement steps taken by the last MultInvv.
+  long      tref;    // Refinement steps taken by all calls to MultInvv.
+  ARFLOAT*  r;       // Residual (ARFLOAT precision).
+  ARLOW*    rlow;    // Residual (ARLOW precision).
+  ARLOW*    zlow;    // Correction (ARLOW precision).
+
+  void ClearMem();
+
+  void Residual(ARFLOAT* v, ARFLOAT* w);
+  // Stores v-(A-sigma*I)*w in r.
+
+ public:
+
+  bool IsFactored() { return factored; }
+
+  ARFLOAT GetShift() { return sigma; }
+  // Returns the shift used in the last factorization.
+
+  int GetRefinements() { return nref; }
+  // Returns the number of refinement steps taken by the last MultInvv.
+
+  long GetTotalRefinements() { return tref; }
+  // Returns the number of refinement steps taken by all calls to MultInvv.
+
+  void SetRefinement(int maxrefp, ARFLOAT tolp = 0.0);
+  // Defines the maximum number of refinement steps performed by
+  // MultInvv and the relative residual norm required (tolp = 0 means
+  // a few units of roundoff of ARFLOAT).
+
+  void FactorA();
+  // Factors A in ARLOW precision.
+
+  void FactorAsI(ARFLOAT sigmap);
+  // Factors A-sigmap*I in ARLOW precision.
+
+  void DefineShift(ARFLOAT sigmap);
+  // Tells this object that the ARLOW matrix already holds the factors
+  // of A-sigmap*I (computed by a single precision solver, for example),
+  // so they may be used by MultInvv without being computed again.
+
+  void MultMv(ARFLOAT* v, ARFLOAT* w);
+  // Matrix-vector product w <- A*v (ARFLOAT precision).
+
+  void MultInvv(ARFLOAT* v, ARFLOAT* w);
+  // Solves (A-sigma*I)*w = v. The factors of A-sigma*I (ARLOW precision)
+  // give the first approximation to w, that is corrected until the
+  // residual (ARFLOAT precision) is small enough or stops decreasing.
+
+  ARMixedMatrix(ARMATRIX* Ap, ARLOWMAT* Alowp);
+  // Constructor. Both matrices must represent A and must remain valid
+  // while this object is used.
+
+  virtual ~ARMixedMatrix() { ClearMem(); }
+  // Destructor.
+
+ private:
+
+  ARMixedMatrix(const ARMixedMatrix& other);
+
+  ARMixedMatrix& operator=(const ARMixedMatrix& other);
+
+}; // class ARMixedMatrix.
+
+
+// ------------------------------------------------------------------------ //
+// ARMixedMatrix member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+inline void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::ClearMem()
+{
+
+  if (r != NULL) delete[] r;
+  if (rlow != NULL) delete[] rlow;
+  if (zlow != NULL) delete[] zlow;
+  r    = NULL;
+  rlow = zlow = NULL;
+
+} // ClearMem.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+inline void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::
+Residual(ARFLOAT* v, ARFLOAT* w)
+{
+
+  int i;
+
+  A->MultMv(w, r);
+  for (i=0; i<this->n; i++) r[i] = v[i]-r[i]+sigma*w[i];
+
+} // Residual.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+inline void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::
+SetRefinement(int maxrefp, ARFLOAT tolp)
+{
+
+  maxref = (maxrefp > 0) ? maxrefp : 1;
+  tol    = (tolp > ARFLOAT(0.0)) ? tolp :
+           ARFLOAT(8.0)*std::numeric_limits<ARFLOAT>::epsilon();
+
+} // SetRefinement.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+inline void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::FactorA()
+{
+
+  Alow->FactorA();
+  sigma    = ARFLOAT(0.0);
+  factored = true;
+
+} // FactorA.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+inline void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::
+FactorAsI(ARFLOAT sigmap)
+{
+
+  Alow->FactorAsI(ARLOW(sigmap));
+  sigma    = sigmap;
+  factored = true;
+
+} // FactorAsI.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+inline void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::
+DefineShift(ARFLOAT sigmap)
+{
+
+  if (!Alow->IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARMixedMatrix::DefineShift");
+  }
+  sigma    = sigmap;
+  factored = true;
+
+} // DefineShift.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+inline void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::
+MultMv(ARFLOAT* v, ARFLOAT* w)
+{
+
+  A->MultMv(v, w);
+
+} // MultMv.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+void ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::
+MultInvv(ARFLOAT* v, ARFLOAT* w)
+{
+
+  int     i, n;
+  ARFLOAT vnorm, rnorm, rold;
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARMixedMatrix::MultInvv");
+  }
+
+  // Iterative refinement: w <- w + inv(A-sigma*I)*(v-(A-sigma*I)*w),
+  // with the correction computed in ARLOW precision. The iteration
+  // stops when the residual stops decreasing (the factorization is
+  // then too inaccurate to improve w).
+
+  n     = this->n;
+  vnorm = nrm2(n, v, 1);
+  rold  = vnorm;
+  nref  = 0;
+  for (i=0; i<n; i++) {
+    w[i] = ARFLOAT(0.0);
+    r[i] = v[i];
+  }
+  if (vnorm == ARFLOAT(0.0)) return;
+
+  while (nref < maxref) {
+    for (i=0; i<n; i++) rlow[i] = ARLOW(r[i]);
+    Alow->MultInvv(rlow, zlow);
+    for (i=0; i<n; i++) w[i] += ARFLOAT(zlow[i]);
+    nref++;
+    Residual(v, w);
+    rnorm = nrm2(n, r, 1);
+    if ((rnorm <= tol*vnorm) || (rnorm > ARFLOAT(0.5)*rold)) break;
+    rold = rnorm;
+  }
+  tref += nref;
+
+} // MultInvv.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARLOW, class ARLOWMAT>
+ARMixedMatrix<ARFLOAT, ARMATRIX, ARLOW, ARLOWMAT>::
+ARMixedMatrix(ARMATRIX* Ap, ARLOWMAT* Alowp): ARMatrix<ARFLOAT>(Ap->ncols())
+{
+
+  A        = Ap;
+  Alow     = Alowp;
+  sigma    = ARFLOAT(0.0);
+  factored = false;
+  nref     = 0;
+  tref     = 0;
+  r        = new ARFLOAT[this->n];
+  rlow     = new ARLOW[this->n];
+  zlow     = new ARLOW[this->n];
+  this->defined = true;
+  SetRefinement(10);
+
+} // Constructor.
+
+
+// ARSymRefine class definition.
+
+template<class ARFLOAT, class ARMATRIX, class ARFOP = ARMATRIX>
+class ARSymRefine {
+
+ public:
+
+ // a) Notation.
+
+  typedef void (ARMATRIX::* TypeMv)(ARFLOAT[], ARFLOAT[]);
+  typedef void (ARFOP::* TypeOPx)(ARFLOAT[], ARFLOAT[]);
+
+
+ protected:
+
+ // b) User defined parameters.
+
+  int      n;        // Dimension of the problem.
+  ARMATRIX *objA;    // Object that has MultAx as a member function.
+  TypeMv   MultAx;   // Function that evaluates the product A*x.
+  ARFOP    *objOP;   // Object that has MultOPx as a member function.
+  TypeOPx  MultOPx;  // Function applied to the residuals (may be NULL).
+  int      nguard;   // Number of guard vectors (-1 means nval+8).
+
+
+ // c) Results.
+
+  int      nval;     // Number of refined eigenpairs.
+  int      nconv;    // Number of eigenpairs that satisfy the tolerance.
+  int      niter;    // Number of Rayleigh-Ritz steps performed.
+  int      nblk;     // Number of Ritz pairs kept (eigenpairs and guards).
+  ARFLOAT  *EigVal;  // Refined eigenvalues (followed by the guards).
+  ARFLOAT  *EigVec;  // Refined eigenvectors (n x nblk).
+  ARFLOAT  *ResNorm; // Residual norms ||A*x - lambda*x||.
+
+
+ // d) Protected functions.
+
+  void ClearMem();
+
+  int Orthonormalize(ARFLOAT* S, int k, int m);
+  // Orthonormalizes the columns k to m-1 of S against the previous
+  // ones and against each other (classical Gram-Schmidt, applied again
+  // while a pass cancels most of the column). Columns that are
+  // (numerically) dependent are dropped. Returns the number of columns
+  // kept.
+
+  void RayleighRitz(ARFLOAT* S, ARFLOAT* W, int m, int nb,
+                    ARFLOAT* target, ARFLOAT* R, ARFLOAT* P);
+  // Rayleigh-Ritz step on the subspace spanned by the m columns of S
+  // (W = A*S), whose first nblk columns hold the previous Ritz vectors.
+  // The Ritz pairs that correspond to the nval eigenpairs are stored
+  // first in EigVal and EigVec, followed by at most nb-nval guards (the
+  // Ritz pairs closest to them). The residuals are stored in R and the part of
+  // each Ritz vector that lies outside the span of the previous Ritz
+  // vectors in P.
+
+ public:
+
+ // e) Public functions:
+
+  void SetOperator(ARFOP* objOPp, TypeOPx MultOPxp)
+  {
+    objOP   = objOPp;
+    MultOPx = MultOPxp;
+  }
+  // Defines a function (usually inv(A-sigma*I), in ARFLOAT precision)
+  // applied to the residuals before they are added to the subspace.
+  // When the eigenvalues are not at the ends of the spectrum, this
+  // makes the refinement converge much faster.
+
+  void SetGuardVectors(int nguardp) { nguard = nguardp; }
+  // Defines the number of extra Ritz pairs (guards) that are refined
+  // along with the eigenpairs, but are not checked for convergence.
+  // The guards approximate the eigenvectors next to the required ones,
+  // and so improve the convergence rate when these are not well
+  // separated from the rest of the spectrum (and no operator is used).
+  // nguardp = -1 (the default) means nval+8 guards.
+
+  template<class ARLOW>
+  int Refine(ARrcStdEig<ARLOW, ARLOW>& prob, int maxitp = 20,
+             ARFLOAT tolp = 0.0)
+  {
+    if (!prob.EigenvectorsFound()) prob.FindEigenvectors();
+    return Refine(prob.ConvergedEigenvalues(), prob.RawEigenvalues(),
+                  prob.RawEigenvectors(), maxitp, tolp);
+  }
+  // Refines the eigenvectors computed by prob (computing them first,
+  // if necessary). maxitp is the maximum number of Rayleigh-Ritz steps
+  // and tolp the required residual norm relative to an estimate of
+  // ||A|| (tolp = 0 means a few units of roundoff of ARFLOAT).
+  // Returns the number of eigenpairs that satisfy tolp.
+
+  template<class ARLOW>
+  int Refine(int nvalp, ARLOW* val, ARLOW* vec, int maxitp = 20,
+             ARFLOAT tolp = 0.0);
+  // Refines nvalp approximate eigenpairs (val, vec). The eigenvectors
+  // are stored sequentially in vec.
+
+  int ConvergedEigenvalues() { return nconv; }
+  // Returns the number of eigenpairs that satisfy the tolerance.
+
+  int GetNev() { return nval; }
+  // Returns the number of refined eigenpairs.
+
+  int GetIter() { return niter; }
+  // Returns the number of Rayleigh-Ritz steps performed.
+
+  ARFLOAT Eigenvalue(int i) { return EigVal[i]; }
+  // Furnishes the i-th refined eigenvalue.
+
+  ARFLOAT* RawEigenvalues() { return EigVal; }
+  // Provides raw access to the refined eigenvalues.
+
+  ARFLOAT* RawEigenvector(int i) { return &EigVec[size_t(i)*size_t(n)]; }
+  // Provides raw access to the i-th refined eigenvector.
+
+  ARFLOAT* RawEigenvectors() { return EigVec; }
+  // Provides raw access to the refined eigenvectors.
+
+  ARFLOAT ResidualNorm(int i) { return ResNorm[i]; }
+  // Returns ||A*x - lambda*x|| for the i-th refined eigenpair.
+
+ // f) Constructors and destructor.
+
+  ARSymRefine(int np, ARMATRIX* objAp, TypeMv MultAxp);
+  // Constructor. objAp->MultAxp computes the product A*x in ARFLOAT
+  // precision.
+
+  virtual ~ARSymRefine() { ClearMem(); }
+  // Destructor.
+
+ private:
+
+  ARSymRefine(const ARSymRefine& other);
+
+  ARSymRefine& operator=(const ARSymRefine& other);
+
+}; // class ARSymRefine.
+
+
+// ------------------------------------------------------------------------ //
+// ARSymRefine member functions definition.                                 //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARMATRIX, class ARFOP>
+inline void ARSymRefine<ARFLOAT, ARMATRIX, ARFOP>::ClearMem()
+{
+
+  if (EigVal != NULL) delete[] EigVal;
+  if (EigVec != NULL) delete[] EigVec;
+  if (ResNorm != NULL) delete[] ResNorm;
+  EigVal = EigVec = ResNorm = NULL;
+  nval   = nconv = nblk = 0;
+
+} // ClearMem.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARFOP>
+int ARSymRefine<ARFLOAT, ARMATRIX, ARFOP>::
+Orthonormalize(ARFLOAT* S, int k, int m)
+{
+
+  int     i, j, pass, p;
+  ARFLOAT h, norm0, norm, normold;
+  ARFLOAT *s;
+
+  // A new pass is made while the previous one removed more than half
+  // of the column (at most three passes). The residuals and corrections
+  // added to S are small and almost parallel to the columns already
+  // there when the refinement is close to convergence.
+
+  p = k;
+  for (j=k; j<m; j++) {
+    s     = &S[size_t(j)*size_t(n)];
+    norm0 = nrm2(n, s, 1);
+    norm  = norm0;
+    for (pass=0; (pass<3) && (norm > ARFLOAT(0.0)); pass++) {
+      for (i=0; i<p; i++) {
+        h = -dot(n, &S[size_t(i)*size_t(n)], 1, s, 1);
+        axpy(n, h, &S[size_t(i)*size_t(n)], 1, s, 1);
+      }
+      normold = norm;
+      norm    = nrm2(n, s, 1);
+      if ((pass > 0) && (norm > ARFLOAT(0.5)*normold)) break;
+    }
+    if (norm <= ARFLOAT(1e3)*std::numeric_limits<ARFLOAT>::epsilon()*norm0) {
+      continue;   // Dropping a dependent column.
+    }
+    h = ARFLOAT(1.0)/norm;
+    scal(n, h, s, 1);
+    if (p != j) copy(n, s, 1, &S[size_t(p)*size_t(n)], 1);
+    p++;
+  }
+  return p;
+
+} // Orthonormalize.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARFOP>
+void ARSymRefine<ARFLOAT, ARMATRIX, ARFOP>::
+RayleighRitz(ARFLOAT* S, ARFLOAT* W, int m, int nb, ARFLOAT* target,
+             ARFLOAT* R, ARFLOAT* P)
+{
+
+  int     i, j, k, best, info, lwork, nold;
+  ARFLOAT dist, h, tmin, tmax;
+  ARFLOAT *H, *theta, *work, *weight;
+  int     *order;
+  bool    *used;
+
+  // Projecting A onto the subspace: H = S'*W.
+
+  lwork  = 3*m;
+  H      = new ARFLOAT[m*m];
+  theta  = new ARFLOAT[m];
+  work   = new ARFLOAT[lwork];
+  used   = new bool[m];
+  weight = new ARFLOAT[m];
+  order  = new int[m];
+  tmin   = tmax = ARFLOAT(0.0);
+  for (j=0; j<m; j++) {
+    used[j] = false;
+    for (i=j; i<m; i++) {
+      H[i+j*m] = dot(n, &S[size_t(i)*size_t(n)], 1, &W[size_t(j)*size_t(n)], 1);
+    }
+  }
+  syev("V", "L", m, H, m, theta, work, lwork, info);
+  if (info != 0) {
+    delete[] H; delete[] theta; delete[] work; delete[] used;
+    delete[] weight; delete[] order;
+    throw ArpackError(ArpackError::LAPACK_ERROR, "ARSymRefine::Refine");
+  }
+
+  // Choosing the nval Ritz vectors that have the largest components
+  // along the previous eigenvectors (the first nval columns of S). In a
+  // dense part of the spectrum, the Ritz values closest to the previous
+  // eigenvalues may belong to other (poorly approximated) eigenpairs.
+
+  for (j=0; j<m; j++) {
+    weight[j] = ARFLOAT(0.0);
+    for (i=0; i<nval; i++) weight[j] += H[i+j*m]*H[i+j*m];
+  }
+  for (k=0; k<nval; k++) {
+    best = -1;
+    for (j=0; j<m; j++) {
+      if (!used[j] && ((best < 0) || (weight[j] > weight[best]))) best = j;
+    }
+    used[best] = true;
+  }
+
+  // Matching the chosen Ritz pairs with the previous eigenvalues.
+
+  for (k=0; k<nval; k++) {
+    best = -1;
+    for (j=0; j<m; j++) {
+      dist = std::fabs(theta[j]-target[k]);
+      if (used[j] && ((best < 0) || (dist < std::fabs(theta[best]-target[k])))) {
+        best = j;
+      }
+    }
+    used[best] = false;
+    order[k]   = best;
+    tmin = ((k == 0) || (theta[best] < tmin)) ? theta[best] : tmin;
+    tmax = ((k == 0) || (theta[best] > tmax)) ? theta[best] : tmax;
+  }
+  for (k=0; k<nval; k++) used[order[k]] = true;
+
+  // Choosing as guards the remaining Ritz pairs that are closest to the
+  // interval that contains the eigenvalues.
+
+  nold = nblk;
+  nblk = (nb < m) ? nb : m;
+  for (k=nval; k<nblk; k++) {
+    best = -1;
+    for (j=0; j<m; j++) {
+      if (used[j]) continue;
+      dist = (theta[j] < tmin) ? tmin-theta[j] : theta[j]-tmax;
+      if ((best < 0) || (dist < ((theta[best] < tmin) ? tmin-theta[best] :
+                                 theta[best]-tmax))) {
+        best = j;
+      }
+    }
+    used[best] = true;
+    order[k]   = best;
+  }
+
+  // Computing x = S*y, r = W*y-theta*x and the correction p (the part
+  // of x that comes from the columns of S after the first nold).
+
+  for (k=0; k<nblk; k++) {
+    best       = order[k];
+    EigVal[k]  = theta[best];
+    ARFLOAT* x = &EigVec[size_t(k)*size_t(n)];
+    ARFLOAT* r = &R[size_t(k)*size_t(n)];
+    ARFLOAT* p = &P[size_t(k)*size_t(n)];
+    for (i=0; i<n; i++) x[i] = r[i] = p[i] = ARFLOAT(0.0);
+    for (j=nold; j<m; j++) {
+      h = H[j+best*m];
+      axpy(n, h, &S[size_t(j)*size_t(n)], 1, p, 1);
+      axpy(n, h, &W[size_t(j)*size_t(n)], 1, r, 1);
+    }
+    copy(n, p, 1, x, 1);
+    for (j=0; j<nold; j++) {
+      h = H[j+best*m];
+      axpy(n, h, &S[size_t(j)*size_t(n)], 1, x, 1);
+      axpy(n, h, &W[size_t(j)*size_t(n)], 1, r, 1);
+    }
+    h = -theta[best];
+    axpy(n, h, x, 1, r, 1);
+    ResNorm[k] = nrm2(n, r, 1);
+  }
+
+  delete[] H;
+  delete[] theta;
+  delete[] work;
+  delete[] used;
+  delete[] weight;
+  delete[] order;
+
+} // RayleighRitz.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARFOP>
+template<class ARLOW>
+int ARSymRefine<ARFLOAT, ARMATRIX, ARFOP>::
+Refine(int nvalp, ARLOW* val, ARLOW* vec, int maxitp, ARFLOAT tolp)
+{
+
+  // Each step applies the Rayleigh-Ritz method to the subspace spanned
+  // by the current Ritz vectors X (the eigenvectors and the guards), by
+  // the residuals R of the Ritz pairs that have not converged yet
+  // (multiplied by OP, if it was defined) and by the last corrections P
+  // of these pairs, as in the LOBPCG method. The first step only uses
+  // the eigenvectors, converted to ARFLOAT, so the guards are chosen
+  // from the Ritz pairs of the second step.
+  // The largest residual does not decrease monotonically (mainly while
+  // the guards are converging and near roundoff), so the iteration only
+  // stops after "patience" steps without a new minimum, and the best
+  // eigenpairs found are returned.
+
+  const int patience = 10;
+
+  int     i, k, m, mmax, nb, stall, nbest;
+  ARFLOAT tol, anorm, rnorm, rmax, rbest;
+  ARFLOAT *S, *W, *R, *P, *target, *BestVal, *BestVec, *BestRes;
+
+  ClearMem();
+  niter = 0;
+  if (nvalp <= 0) return 0;
+
+  nval    = nvalp;
+  nb      = nval+((nguard < 0) ? nval+8 : nguard);
+  if (nb > n) nb = n;
+  mmax    = 3*nb;
+  EigVal  = new ARFLOAT[nb];
+  EigVec  = new ARFLOAT[size_t(n)*size_t(nb)];
+  ResNorm = new ARFLOAT[nb];
+  S       = new ARFLOAT[size_t(n)*size_t(mmax)];
+  W       = new ARFLOAT[size_t(n)*size_t(mmax)];
+  R       = new ARFLOAT[size_t(n)*size_t(nb)];
+  P       = new ARFLOAT[size_t(n)*size_t(nb)];
+  target  = new ARFLOAT[nval];
+  BestVal = new ARFLOAT[nval];
+  BestVec = new ARFLOAT[size_t(n)*size_t(nval)];
+  BestRes = new ARFLOAT[nval];
+  tol     = (tolp > ARFLOAT(0.0)) ? tolp :
+            ARFLOAT(100.0)*std::numeric_limits<ARFLOAT>::epsilon();
+
+  for (k=0; k<nval; k++) target[k] = ARFLOAT(val[k]);
+  for (i=0; i<n*nval; i++) S[i] = ARFLOAT(vec[i]);
+  m     = Orthonormalize(S, 0, nval);
+  anorm = ARFLOAT(0.0);
+  rbest = ARFLOAT(0.0);
+  stall = nbest = 0;
+  if (m < nval) nval = m;  // Some eigenvectors were repeated.
+  nblk  = nval;
+
+  while (true) {
+
+    // Rayleigh-Ritz step.
+
+    for (k=0; k<m; k++) {
+      (objA->*MultAx)(&S[size_t(k)*size_t(n)], &W[size_t(k)*size_t(n)]);
+    }
+    RayleighRitz(S, W, m, nb, target, R, P);
+    niter++;
+
+    // Checking convergence and keeping the best eigenpairs found.
+
+    rmax  = ARFLOAT(0.0);
+    for (k=0; k<m; k++) {     // ||A*s|| <= ||A||.
+      rnorm = nrm2(n, &W[size_t(k)*size_t(n)], 1);
+      if (rnorm > anorm) anorm = rnorm;
+    }
+    for (k=0; k<nval; k++) {
+      if (std::fabs(EigVal[k]) > anorm) anorm = std::fabs(EigVal[k]);
+      if (ResNorm[k] > rmax) rmax = ResNorm[k];
+      target[k] = EigVal[k];
+    }
+    nconv = 0;
+    for (k=0; k<nval; k++) if (ResNorm[k] <= tol*anorm) nconv++;
+    if ((niter == 1) || (rmax < rbest)) {
+      rbest = rmax;
+      nbest = nconv;
+      stall = 0;
+      copy(nval, EigVal, 1, BestVal, 1);
+      copy(n*nval, EigVec, 1, BestVec, 1);
+      copy(nval, ResNorm, 1, BestRes, 1);
+    }
+    else {
+      stall++;
+    }
+    if ((nconv == nval) || (niter >= maxitp) || (stall >= patience)) break;
+
+    // Expanding the subspace: S = [X, OP*R, P].
+
+    copy(n*nblk, EigVec, 1, S, 1);
+    m = nblk;
+    for (k=0; k<nblk; k++) {
+      if ((k < nval) && (ResNorm[k] <= tol*anorm)) continue;
+      if (MultOPx != NULL) {
+        (objOP->*MultOPx)(&R[size_t(k)*size_t(n)], &S[size_t(m)*size_t(n)]);
+      }
+      else {
+        copy(n, &R[size_t(k)*size_t(n)], 1, &S[size_t(m)*size_t(n)], 1);
+      }
+      m++;
+    }
+    for (k=0; k<nblk; k++) {
+      if ((k < nval) && (ResNorm[k] <= tol*anorm)) continue;
+      copy(n, &P[size_t(k)*size_t(n)], 1, &S[size_t(m)*size_t(n)], 1);
+      m++;
+    }
+    m = Orthonormalize(S, nblk, m);
+
+  }
+
+  // Returning the best eigenpairs.
+
+  if (rmax > rbest) {
+    nconv = nbest;
+    copy(nval, BestVal, 1, EigVal, 1);
+    copy(n*nval, BestVec, 1, EigVec, 1);
+    copy(nval, BestRes, 1, ResNorm, 1);
+  }
+
+  delete[] S;
+  delete[] W;
+  delete[] R;
+  delete[] P;
+  delete[] target;
+  delete[] BestVal;
+  delete[] BestVec;
+  delete[] BestRes;
+  return nconv;
+
+} // Refine.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARFOP>
+inline ARSymRefine<ARFLOAT, ARMATRIX, ARFOP>::
+ARSymRefine(int np, ARMATRIX* objAp, TypeMv MultAxp)
+{
+
+  n       = np;
+  objA    = objAp;
+  MultAx  = MultAxp;
+  objOP   = NULL;
+  MultOPx = NULL;
+  nguard  = -1;
+  niter   = 0;
+  EigVal  = EigVec = ResNorm = NULL;
+  ClearMem();
+
+} // Constructor.
+
+
+#endif // ARMIXED_H
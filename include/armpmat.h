@@ -0,0 +1,507 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARMPMat.h.
+   Arpack++ class ARmpMatrix definition.
+   ARmpMatrix is a square sparse matrix whose rows are distributed
+   among the processes of an MPI communicator. Each process stores
+   a block of consecutive rows in compressed sparse row (CSR) format,
+   with global column indices, and the vectors used by MultMv are
+   distributed in the same way. This is the distribution used by
+   ARParSymStdEig and ARParNonSymStdEig, so MultMv can be passed to
+   these classes.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARMPMAT_H
+#define ARMPMAT_H
+
+#include <cstddef>
+#include <algorithm>
+#include <mpi.h>
+#include "arch.h"
+#include "armat.h"
+#include "arerror.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef ARMPTAG
+#define ARMPTAG 4831
+#endif // Tag of the messages sent by ARmpMatrix::MultMv.
+
+
+template<class ARTYPE>
+class ARmpMatrix: public ARMatrix<ARTYPE> {
+
+ protected:
+
+ // a) Distribution of the rows.
+
+  MPI_Comm comm;      // Communicator that contains all processes.
+  int      nprocs;    // Number of processes.
+  int      nglobal;   // Dimension of the matrix.
+  int      first;     // First row stored by this process.
+  int*     rowdist;   // First row stored by each process (and nglobal).
+
+ // b) Local rows.
+ //    The columns of the local rows are split in two blocks, both
+ //    stored in CSR format: the local block (columns that correspond
+ //    to rows stored by this process) and the ghost block (columns
+ //    owned by other processes), so the local block can be multiplied
+ //    while the elements of v owned by other processes are received.
+
+  int      nnz;       // Number of nonzero elements in the local rows.
+  int*     lptr;      // Pointers to the beginning of each row (local block).
+  int*     lcol;      // Local column indices (local block).
+  ARTYPE*  la;        // Nonzero elements of the local block.
+  int*     gptr;      // Pointers to the beginning of each row (ghost block).
+  int*     gcol;      // Positions of the columns in xghost (ghost block).
+  ARTYPE*  ga;        // Nonzero elements of the ghost block.
+
+ // c) Halo exchange.
+
+  int      nghost;    // Number of columns owned by other processes.
+  int      nsend;     // Number of elements of v sent to other processes.
+  int*     rcount;    // Number of elements received from each process.
+  int*     rdispl;    // Position of these elements in xghost.
+  int*     scount;    // Number of elements sent to each process.
+  int*     sdispl;    // Position of these elements in sindex.
+  int*     sindex;    // Local rows of the elements of v that are sent.
+  ARTYPE*  xghost;    // Elements of v received from other processes.
+  ARTYPE*  xsend;     // Elements of v sent to other processes.
+  MPI_Request* request;
+
+  template<class T>
+  static T* CopyArray(int size, const T* x);
+  // Returns a copy of x (or NULL if x is NULL).
+
+  void ClearMem();
+
+  virtual void Copy(const ARmpMatrix& other);
+
+  bool DataOK(int nnzp, int* jcolp, int* prowp);
+  // Checks the local rows (all processes get the same answer).
+
+  int* CreateHalo(int* jcolp);
+  // Lists the columns owned by other processes and tells these
+  // processes which elements of v must be sent to this one. Returns
+  // the sorted list of these columns (to be deleted by the caller).
+
+  void SplitRows(ARTYPE* ap, int* jcolp, int* prowp, int* ghost);
+  // Creates the local and the ghost blocks. ghost is the sorted list
+  // of the columns owned by other processes.
+
+ public:
+
+  MPI_Comm GetCommunicator() { return comm; }
+
+  int GetGlobalN() { return nglobal; }
+
+  int GetFirstRow() { return first; }
+
+  int GetGhosts() { return nghost; }
+
+  int nzeros() { return nnz; }
+
+  void MultMv(ARTYPE* v, ARTYPE* w);
+  // Matrix-vector product w <- A*v. v and w only contain the rows
+  // stored by this process. All processes must call this function
+  // at the same time.
+
+  void DefineMatrix(MPI_Comm commp, int nlocp, int nnzp, ARTYPE* ap,
+                    int* jcolp, int* prowp);
+  // Defines the nlocp rows stored by this process. Process p stores
+  // the rows that follow those of process p-1, so the dimension of the
+  // matrix is the sum of nlocp over all processes. {nnzp, ap, jcolp,
+  // prowp} contains the local rows in CSR format (prowp has nlocp+1
+  // elements) with global column indices. These arrays are copied.
+  // All processes must call this function at the same time.
+
+  ARmpMatrix(): ARMatrix<ARTYPE>()
+  {
+    comm = MPI_COMM_WORLD;
+    nprocs = nglobal = first = nnz = nghost = nsend = 0;
+    rowdist = lptr = lcol = gptr = gcol = NULL;
+    rcount = rdispl = scount = sdispl = sindex = NULL;
+    la = ga = xghost = xsend = NULL;
+    request = NULL;
+  }
+  // Short constructor that does nothing.
+
+  ARmpMatrix(MPI_Comm commp, int nlocp, int nnzp, ARTYPE* ap,
+             int* jcolp, int* prowp);
+  // Long constructor.
+
+  ARmpMatrix(const ARmpMatrix& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARmpMatrix() { ClearMem(); }
+  // Destructor.
+
+  ARmpMatrix& operator=(const ARmpMatrix& other);
+  // Assignment operator.
+
+}; // class ARmpMatrix.
+
+
+// ------------------------------------------------------------------------ //
+// ARmpMatrix member functions definition.                                  //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE>
+template<class T>
+inline T* ARmpMatrix<ARTYPE>::CopyArray(int size, const T* x)
+{
+
+  T* y;
+
+  if (x == NULL) return NULL;
+  y = new T[size];
+  for (int i=0; i<size; i++) y[i] = x[i];
+  return y;
+
+} // CopyArray.
+
+
+template<class ARTYPE>
+void ARmpMatrix<ARTYPE>::ClearMem()
+{
+
+  delete[] rowdist;
+  delete[] lptr;
+  delete[] lcol;
+  delete[] la;
+  delete[] gptr;
+  delete[] gcol;
+  delete[] ga;
+  delete[] rcount;
+  delete[] rdispl;
+  delete[] scount;
+  delete[] sdispl;
+  delete[] sindex;
+  delete[] xghost;
+  delete[] xsend;
+  delete[] request;
+  rowdist = lptr = lcol = gptr = gcol = NULL;
+  rcount = rdispl = scount = sdispl = sindex = NULL;
+  la = ga = xghost = xsend = NULL;
+  request = NULL;
+
+} // ClearMem.
+
+
+template<class ARTYPE>
+void ARmpMatrix<ARTYPE>::Copy(const ARmpMatrix<ARTYPE>& other)
+{
+
+  // Copying very fundamental variables.
+
+  this->m       = other.m;
+  this->n       = other.n;
+  this->defined = other.defined;
+  comm          = other.comm;
+  nprocs        = other.nprocs;
+  nglobal       = other.nglobal;
+  first         = other.first;
+  nnz           = other.nnz;
+  nghost        = other.nghost;
+  nsend         = other.nsend;
+
+  // Copying the arrays (the buffers used by MultMv are not copied).
+
+  rowdist = CopyArray(nprocs+1, other.rowdist);
+  lptr    = CopyArray(this->m+1, other.lptr);
+  lcol    = CopyArray(other.lptr ? other.lptr[this->m] : 0, other.lcol);
+  la      = CopyArray(other.lptr ? other.lptr[this->m] : 0, other.la);
+  gptr    = CopyArray(this->m+1, other.gptr);
+  gcol    = CopyArray(other.gptr ? other.gptr[this->m] : 0, other.gcol);
+  ga      = CopyArray(other.gptr ? other.gptr[this->m] : 0, other.ga);
+  rcount  = CopyArray(nprocs, other.rcount);
+  rdispl  = CopyArray(nprocs, other.rdispl);
+  scount  = CopyArray(nprocs, other.scount);
+  sdispl  = CopyArray(nprocs, other.sdispl);
+  sindex  = CopyArray(nsend, other.sindex);
+  xghost  = NULL;
+  xsend   = NULL;
+  request = NULL;
+  if (this->defined) {
+    xghost  = new ARTYPE[nghost+1];
+    xsend   = new ARTYPE[nsend+1];
+    request = new MPI_Request[2*nprocs];
+  }
+
+} // Copy.
+
+
+template<class ARTYPE>
+bool ARmpMatrix<ARTYPE>::DataOK(int nnzp, int* jcolp, int* prowp)
+{
+
+  int i, k, bad, anybad;
+
+  // Checking if prowp is in ascending order and if the column indices
+  // are within bounds.
+
+  bad = (prowp[0] != 0) || (prowp[this->m] != nnzp);
+  for (i=0; (i<this->m) && (!bad); i++) {
+    if (prowp[i] > prowp[i+1]) bad = 1;
+  }
+  for (k=0; (k<nnzp) && (!bad); k++) {
+    if ((jcolp[k] < 0) || (jcolp[k] >= nglobal)) bad = 1;
+  }
+
+  // A process cannot stop alone, since the others would wait for it.
+
+  MPI_Allreduce(&bad, &anybad, 1, MPI_INT, MPI_MAX, comm);
+  return (anybad == 0);
+
+} // DataOK.
+
+
+template<class ARTYPE>
+int* ARmpMatrix<ARTYPE>::CreateHalo(int* jcolp)
+{
+
+  int  i, k, p, last;
+  int* ghost;
+
+  // Listing the columns owned by other processes. After sorting, the
+  // columns of each process are consecutive.
+
+  last  = first+this->m;
+  ghost = new int[nnz+1];
+  nghost = 0;
+  for (k=0; k<nnz; k++) {
+    if ((jcolp[k] < first) || (jcolp[k] >= last)) ghost[nghost++] = jcolp[k];
+  }
+  std::sort(ghost, ghost+nghost);
+  nghost = int(std::unique(ghost, ghost+nghost)-ghost);
+
+  // Counting the columns owned by each process.
+
+  rcount = new int[nprocs];
+  rdispl = new int[nprocs];
+  for (p=0; p<nprocs; p++) rcount[p] = 0;
+  for (i=0; i<nghost; i++) {
+    p = int(std::upper_bound(rowdist, rowdist+nprocs+1, ghost[i])-rowdist)-1;
+    rcount[p]++;
+  }
+  rdispl[0] = 0;
+  for (p=1; p<nprocs; p++) rdispl[p] = rdispl[p-1]+rcount[p-1];
+
+  // Telling each process which of its rows are needed here.
+
+  scount = new int[nprocs];
+  sdispl = new int[nprocs];
+  MPI_Alltoall(rcount, 1, MPI_INT, scount, 1, MPI_INT, comm);
+  sdispl[0] = 0;
+  for (p=1; p<nprocs; p++) sdispl[p] = sdispl[p-1]+scount[p-1];
+  nsend  = sdispl[nprocs-1]+scount[nprocs-1];
+  sindex = new int[nsend+1];
+  MPI_Alltoallv(ghost, rcount, rdispl, MPI_INT,
+                sindex, scount, sdispl, MPI_INT, comm);
+  for (i=0; i<nsend; i++) sindex[i] -= first;
+
+  // Creating the buffers used by MultMv.
+
+  xghost  = new ARTYPE[nghost+1];
+  xsend   = new ARTYPE[nsend+1];
+  request = new MPI_Request[2*nprocs];
+
+  return ghost;
+
+} // CreateHalo.
+
+
+template<class ARTYPE>
+void ARmpMatrix<ARTYPE>::
+SplitRows(ARTYPE* ap, int* jcolp, int* prowp, int* ghost)
+{
+
+  int i, k, l, g, last;
+
+  // Counting the elements of each block.
+
+  last = first+this->m;
+  lptr = new int[this->m+1];
+  gptr = new int[this->m+1];
+  lptr[0] = gptr[0] = 0;
+  for (i=0; i<this->m; i++) {
+    lptr[i+1] = lptr[i];
+    gptr[i+1] = gptr[i];
+    for (k=prowp[i]; k<prowp[i+1]; k++) {
+      if ((jcolp[k] >= first) && (jcolp[k] < last)) lptr[i+1]++;
+      else gptr[i+1]++;
+    }
+  }
+
+  // Storing the elements. The columns of the ghost block are replaced
+  // by their positions in xghost.
+
+  lcol = new int[lptr[this->m]+1];
+  la   = new ARTYPE[lptr[this->m]+1];
+  gcol = new int[gptr[this->m]+1];
+  ga   = new ARTYPE[gptr[this->m]+1];
+  l = g = 0;
+  for (k=0; k<nnz; k++) {
+    if ((jcolp[k] >= first) && (jcolp[k] < last)) {
+      lcol[l] = jcolp[k]-first;
+      la[l++] = ap[k];
+    }
+    else {
+      gcol[g] = int(std::lower_bound(ghost, ghost+nghost, jcolp[k])-ghost);
+      ga[g++] = ap[k];
+    }
+  }
+
+} // SplitRows.
+
+
+template<class ARTYPE>
+void ARmpMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
+{
+
+  int    i, k, p, nreq;
+  ARTYPE t;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARmpMatrix::MultMv");
+  }
+
+  // Posting the receives of the elements of v owned by other processes.
+
+  nreq = 0;
+  for (p=0; p<nprocs; p++) {
+    if (rcount[p] > 0) {
+      MPI_Irecv(&xghost[rdispl[p]], int(rcount[p]*sizeof(ARTYPE)), MPI_BYTE,
+                p, ARMPTAG, comm, &request[nreq++]);
+    }
+  }
+
+  // Sending the local elements of v needed by other processes.
+
+  for (i=0; i<nsend; i++) xsend[i] = v[sindex[i]];
+  for (p=0; p<nprocs; p++) {
+    if (scount[p] > 0) {
+      MPI_Isend(&xsend[sdispl[p]], int(scount[p]*sizeof(ARTYPE)), MPI_BYTE,
+                p, ARMPTAG, comm, &request[nreq++]);
+    }
+  }
+
+  // Multiplying the local block while the messages are in transit.
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k, t) schedule(static)
+#endif
+  for (i=0; i<this->m; i++) {
+    t = (ARTYPE)0;
+    for (k=lptr[i]; k<lptr[i+1]; k++) t += la[k]*v[lcol[k]];
+    w[i] = t;
+  }
+
+  // Adding the contribution of the ghost block.
+
+  MPI_Waitall(nreq, request, MPI_STATUSES_IGNORE);
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k, t) schedule(static)
+#endif
+  for (i=0; i<this->m; i++) {
+    t = (ARTYPE)0;
+    for (k=gptr[i]; k<gptr[i+1]; k++) t += ga[k]*xghost[gcol[k]];
+    w[i] += t;
+  }
+
+} // MultMv.
+
+
+template<class ARTYPE>
+void ARmpMatrix<ARTYPE>::
+DefineMatrix(MPI_Comm commp, int nlocp, int nnzp, ARTYPE* ap,
+             int* jcolp, int* prowp)
+{
+
+  int  p, rank;
+  int* ghost;
+
+  // Deleting the previous matrix.
+
+  ClearMem();
+  this->defined = false;
+
+  // Finding the first row stored by each process.
+
+  comm     = commp;
+  this->m  = nlocp;
+  this->n  = nlocp;
+  nnz      = nnzp;
+  MPI_Comm_size(comm, &nprocs);
+  MPI_Comm_rank(comm, &rank);
+  rowdist  = new int[nprocs+1];
+  rowdist[0] = 0;
+  MPI_Allgather(&nlocp, 1, MPI_INT, &rowdist[1], 1, MPI_INT, comm);
+  for (p=0; p<nprocs; p++) rowdist[p+1] += rowdist[p];
+  nglobal  = rowdist[nprocs];
+  first    = rowdist[rank];
+
+  // Checking data.
+
+  if (!DataOK(nnzp, jcolp, prowp)) {
+    throw ArpackError(ArpackError::INCONSISTENT_DATA,
+                      "ARmpMatrix::DefineMatrix");
+  }
+
+  // Creating the halo and the blocks.
+
+  ghost = CreateHalo(jcolp);
+  SplitRows(ap, jcolp, prowp, ghost);
+  delete[] ghost;
+
+  this->defined = true;
+
+} // DefineMatrix.
+
+
+template<class ARTYPE>
+inline ARmpMatrix<ARTYPE>::
+ARmpMatrix(MPI_Comm commp, int nlocp, int nnzp, ARTYPE* ap,
+           int* jcolp, int* prowp): ARMatrix<ARTYPE>(nlocp)
+{
+
+  rowdist = lptr = lcol = gptr = gcol = NULL;
+  rcount = rdispl = scount = sdispl = sindex = NULL;
+  la = ga = xghost = xsend = NULL;
+  request = NULL;
+  DefineMatrix(commp, nlocp, nnzp, ap, jcolp, prowp);
+
+} // Long constructor.
+
+
+template<class ARTYPE>
+ARmpMatrix<ARTYPE>& ARmpMatrix<ARTYPE>::
+operator=(const ARmpMatrix<ARTYPE>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    ClearMem();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARMPMAT_H
@@ -0,0 +1,155 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARPSNSym.h.
+   Arpack++ class ARParNonSymStdEig definition.
+   ARParNonSymStdEig is the distributed memory version of ARNonSymStdEig.
+   MultOPx is called by all processes at the same time, each one
+   receiving only the rows of x that it stores and computing the same
+   rows of y <- OP*x. The communication required by the product (see
+   ARmpMatrix, for example) is performed by MultOPx.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARPSNSYM_H
+#define ARPSNSYM_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "arerror.h"
+#include "arsnsym.h"
+#include "arrpsnsym.h"
+
+
+template<class ARFLOAT, class ARFOP>
+class ARParNonSymStdEig:
+  public virtual ARNonSymStdEig<ARFLOAT, ARFOP>,
+  public virtual ARrcParNonSymStdEig<ARFLOAT> {
+
+ protected:
+
+ // a) Protected functions:
+
+  typename ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::TypeEngine* NewEngine() {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "NewEngine");
+    return NULL;
+  }
+  // The Krylov-Schur engine does not handle distributed vectors.
+
+  void Aupp() { ARrcParNonSymStdEig<ARFLOAT>::Aupp(); }
+  // Calls PSNAUPD and PDNAUPD.
+
+  void Eupp() { ARrcParNonSymStdEig<ARFLOAT>::Eupp(); }
+  // Calls PSNEUPD and PDNEUPD.
+
+
+ public:
+
+ // b) Constructors and destructor.
+
+  ARParNonSymStdEig() { this->kschur = false; }
+  // Short constructor.
+
+  ARParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+                    void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+                    const std::string& whichp = "LM", int ncvp = 0,
+                    ARFLOAT tolp = 0.0, int maxitp = 0,
+                    ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (regular mode). nlocp is the number of rows
+  // stored by this process.
+
+  ARParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+                    void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+                    ARFLOAT sigmap, const std::string& whichp = "LM",
+                    int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+                    ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARParNonSymStdEig(const ARParNonSymStdEig& other)
+  {
+    this->comm    = other.comm;
+    this->nglobal = other.nglobal;
+    ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::Copy(other);
+  }
+  // Copy constructor.
+
+  virtual ~ARParNonSymStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARParNonSymStdEig& operator=(const ARParNonSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARParNonSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARParNonSymStdEig member functions definition.                           //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARParNonSymStdEig<ARFLOAT, ARFOP>::
+ARParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+                  void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+                  const std::string& whichp, int ncvp, ARFLOAT tolp,
+                  int maxitp, ARFLOAT* residp, bool ishiftp)
+
+{
+
+  this->comm   = commp;
+  this->kschur = false;
+  this->NoShift();
+  this->DefineParameters(nlocp, nevp, objOPp, MultOPxp, whichp,
+                         ncvp, tolp, maxitp, residp, ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARParNonSymStdEig<ARFLOAT, ARFOP>::
+ARParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+                  void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+                  ARFLOAT sigmap, const std::string& whichp, int ncvp,
+                  ARFLOAT tolp, int maxitp, ARFLOAT* residp, bool ishiftp)
+
+{
+
+  this->comm   = commp;
+  this->kschur = false;
+  this->ChangeShift(sigmap);
+  this->DefineParameters(nlocp, nevp, objOPp, MultOPxp, whichp,
+                         ncvp, tolp, maxitp, residp, ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT, class ARFOP>
+ARParNonSymStdEig<ARFLOAT, ARFOP>& ARParNonSymStdEig<ARFLOAT, ARFOP>::
+operator=(const ARParNonSymStdEig<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->comm    = other.comm;
+    this->nglobal = other.nglobal;
+    ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARPSNSYM_H
@@ -0,0 +1,155 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARPSSym.h.
+   Arpack++ class ARParSymStdEig definition.
+   ARParSymStdEig is the distributed memory version of ARSymStdEig.
+   MultOPx is called by all processes at the same time, each one
+   receiving only the rows of x that it stores and computing the same
+   rows of y <- OP*x. The communication required by the product (see
+   ARmpMatrix, for example) is performed by MultOPx.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARPSSYM_H
+#define ARPSSYM_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "arerror.h"
+#include "arssym.h"
+#include "arrpssym.h"
+
+
+template<class ARFLOAT, class ARFOP>
+class ARParSymStdEig:
+  public virtual ARSymStdEig<ARFLOAT, ARFOP>,
+  public virtual ARrcParSymStdEig<ARFLOAT> {
+
+ protected:
+
+ // a) Protected functions:
+
+  typename ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::TypeEngine* NewEngine() {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "NewEngine");
+    return NULL;
+  }
+  // The Krylov-Schur engine does not handle distributed vectors.
+
+  void Aupp() { ARrcParSymStdEig<ARFLOAT>::Aupp(); }
+  // Calls PSSAUPD and PDSAUPD.
+
+  void Eupp() { ARrcParSymStdEig<ARFLOAT>::Eupp(); }
+  // Calls PSSEUPD and PDSEUPD.
+
+
+ public:
+
+ // b) Constructors and destructor.
+
+  ARParSymStdEig() { this->kschur = false; }
+  // Short constructor.
+
+  ARParSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+                 void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+                 const std::string& whichp = "LM", int ncvp = 0,
+                 ARFLOAT tolp = 0.0, int maxitp = 0, ARFLOAT* residp = NULL,
+                 bool ishiftp = true);
+  // Long constructor (regular mode). nlocp is the number of rows
+  // stored by this process.
+
+  ARParSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+                 void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+                 ARFLOAT sigmap, const std::string& whichp = "LM",
+                 int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+                 ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARParSymStdEig(const ARParSymStdEig& other)
+  {
+    this->comm    = other.comm;
+    this->nglobal = other.nglobal;
+    ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::Copy(other);
+  }
+  // Copy constructor.
+
+  virtual ~ARParSymStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARParSymStdEig& operator=(const ARParSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARParSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARParSymStdEig member functions definition.                              //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARParSymStdEig<ARFLOAT, ARFOP>::
+ARParSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+               void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+               const std::string& whichp, int ncvp, ARFLOAT tolp,
+               int maxitp, ARFLOAT* residp, bool ishiftp)
+
+{
+
+  this->comm   = commp;
+  this->kschur = false;
+  this->NoShift();
+  this->DefineParameters(nlocp, nevp, objOPp, MultOPxp, whichp,
+                         ncvp, tolp, maxitp, residp, ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARParSymStdEig<ARFLOAT, ARFOP>::
+ARParSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFOP* objOPp,
+               void (ARFOP::* MultOPxp)(ARFLOAT[], ARFLOAT[]),
+               ARFLOAT sigmap, const std::string& whichp, int ncvp,
+               ARFLOAT tolp, int maxitp, ARFLOAT* residp, bool ishiftp)
+
+{
+
+  this->comm   = commp;
+  this->kschur = false;
+  this->ChangeShift(sigmap);
+  this->DefineParameters(nlocp, nevp, objOPp, MultOPxp, whichp,
+                         ncvp, tolp, maxitp, residp, ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT, class ARFOP>
+ARParSymStdEig<ARFLOAT, ARFOP>& ARParSymStdEig<ARFLOAT, ARFOP>::
+operator=(const ARParSymStdEig<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->comm    = other.comm;
+    this->nglobal = other.nglobal;
+    ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARPSSYM_H
@@ -0,0 +1,1205 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARRand.h.
+   Arpack++ classes ARRandRange, ARRandSVD and ARRandSymEig definition.
+   These classes compute approximate singular triplets (ARRandSVD) or
+   eigenpairs (ARRandSymEig, real symmetric matrices) using a
+   randomized range finder: an orthonormal basis Q of A*Omega, where
+   Omega is a random n x (nval+nover) block, is improved by npower
+   power iterations and the small projected problem Q'*A is solved by
+   LAPACK. All products with A are blocked (MultMV and MultMtV), so
+   each of the 2*npower+2 (or npower+2) products reads the matrix only
+   once, what is much cheaper than a Krylov method when A is stored
+   out of core (ARdsNonSymMatrix with a file). The results are not
+   checked for convergence. They can be used directly, when a few
+   digits are enough, or to start ARSymStdEig (see SetSubspace in
+   ARrcStdEig) or ARSVD (through its resid parameter).
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARRAND_H
+#define ARRAND_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include "arch.h"
+#include "arerror.h"
+#include "arstats.h"
+#include "blas1c.h"
+#include "lapackc.h"
+
+
+template<class ARFLOAT, class ARFOP>
+class ARRandRange {
+
+ public:
+
+ // a) Notation.
+
+  typedef void (ARFOP::* TypeOPX)(ARFLOAT[], ARFLOAT[], int);
+
+
+ protected:
+
+ // b) User defined parameters.
+
+  ARFOP       *objA;    // Object that has MultAX and MultAtX as members.
+  TypeOPX     MultAX;   // Function that evaluates the product A*X.
+  TypeOPX     MultAtX;  // Function that evaluates A'*X (NULL if A = A').
+  int         m;        // Number of rows of A.
+  int         n;        // Number of columns of A.
+  int         nval;     // Number of values to be computed.
+  int         nover;    // Oversampling (number of extra random vectors).
+  int         npower;   // Number of power iterations.
+
+
+ // c) Internal variables.
+
+  bool        PrepareOK;  // Indicates if parameters were correctly set.
+  bool        ValuesOK;   // Indicates if the values were found.
+  bool        VectorsOK;  // Indicates if the vectors were found.
+  int         nconv;      // Number of values found.
+  int         l;          // Dimension of the subspace (nval+nover).
+  int         lwk;        // Dimension of array Wk.
+  unsigned long seed;     // Seed used to generate random vectors.
+  ARFLOAT     *Q;         // m x l orthonormal basis of the range of A.
+  ARFLOAT     *Z;         // max(m,n) x l auxiliary matrix.
+  ARFLOAT     *Cm;        // l x l projected matrix.
+  ARFLOAT     *Sv;        // Values of the projected matrix.
+  ARFLOAT     *Val;       // Values found (increasing order).
+  ARFLOAT     *X;         // m x nval left singular vectors (or eigenvectors).
+  ARFLOAT     *Y;         // n x nval right singular vectors.
+  ARFLOAT     *Wk;        // LAPACK workspace.
+  ARStats     stats;      // Performance counters.
+
+
+ // d) Protected functions:
+
+ // d.1) Memory control functions.
+
+  void ClearMem();
+  // Deletes all arrays.
+
+  void Copy(const ARRandRange& other);
+  // Makes a deep copy of "other" over "this" object.
+  // Old values are not deleted (this function is to be used
+  // by the copy constructor and the assignment operator only).
+
+  void Prepare();
+  // Checks parameters and allocates the working arrays.
+
+
+ // d.2) Functions that check user defined parameters.
+
+  int CheckNval(int nvalp);
+  // Does range checking on nval.
+
+  int CheckNover(int noverp);
+  // Forces nover to be non negative.
+
+  int CheckNpower(int npowerp);
+  // Forces npower to be non negative.
+
+
+ // d.3) Functions that build the basis.
+
+  void MultA(ARFLOAT* Xp, ARFLOAT* Yp, bool trans);
+  // Performs Yp <- A*Xp (or Yp <- A'*Xp if trans is true), where Xp
+  // and Yp contain l vectors.
+
+  void RandomBlock(ARFLOAT* Xp, int k);
+  // Fills Xp (with k elements) with pseudo-random values.
+
+  void Orthonormalize(ARFLOAT* Xp, int ld, int k);
+  // Orthonormalizes the k columns of Xp (ld x k) by the classical
+  // Gram-Schmidt method with reorthogonalization. Columns that are
+  // (numerically) dependent on the previous ones are replaced by
+  // random vectors.
+
+  void FindRange();
+  // Builds Q, an orthonormal basis of (A*A')^npower*A*Omega (or of
+  // A^(npower+1)*Omega if A is symmetric).
+
+
+ public:
+
+ // e) Public functions:
+
+ // e.1) Functions that allow changes in problem parameters.
+
+  void ChangeOversampling(int noverp);
+  // Changes the number of extra random vectors.
+
+  void ChangePowerIterations(int npowerp);
+  // Changes the number of power iterations.
+
+  void ChangeSeed(unsigned long seedp);
+  // Changes the seed used to generate the random block.
+
+
+ // e.2) Functions that provide access to internal variables' values.
+
+  bool ParametersDefined() { return PrepareOK; }
+  // Indicates if all parameters were correctly defined.
+
+  int GetM() { return m; }
+  // Returns the number of rows of A.
+
+  int GetN() { return n; }
+  // Returns the number of columns of A.
+
+  int GetOversampling() { return nover; }
+  // Returns the number of extra random vectors.
+
+  int GetPowerIterations() { return npower; }
+  // Returns the number of power iterations.
+
+  int GetBlockSize() { return l; }
+  // Returns the number of vectors used in each product with A.
+
+  const ARStats& GetStats() { return stats; }
+  // Returns the performance counters. nopx is the number of products
+  // with A and A' (counting each vector of a block) and nsteps the
+  // number of block products, i.e., the number of passes over A.
+
+  void ResetStats() { stats.Reset(); }
+  // Sets all performance counters to zero.
+
+
+ // e.3) Constructors and destructor.
+
+  ARRandRange();
+  // Short constructor.
+
+  ARRandRange(const ARRandRange& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARRandRange() { ClearMem(); }
+  // Destructor.
+
+}; // class ARRandRange.
+
+
+// ------------------------------------------------------------------------ //
+// ARRandRange member functions definition.                                 //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandRange<ARFLOAT, ARFOP>::ClearMem()
+{
+
+  if (Q != NULL)   delete[] Q;
+  if (Z != NULL)   delete[] Z;
+  if (Cm != NULL)  delete[] Cm;
+  if (Sv != NULL)  delete[] Sv;
+  if (Val != NULL) delete[] Val;
+  if (X != NULL)   delete[] X;
+  if (Y != NULL)   delete[] Y;
+  if (Wk != NULL)  delete[] Wk;
+
+  Q   = NULL;
+  Z   = NULL;
+  Cm  = NULL;
+  Sv  = NULL;
+  Val = NULL;
+  X   = NULL;
+  Y   = NULL;
+  Wk  = NULL;
+
+  PrepareOK = false;
+  ValuesOK  = false;
+  VectorsOK = false;
+  nconv     = 0;
+
+} // ClearMem.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandRange<ARFLOAT, ARFOP>::
+Copy(const ARRandRange<ARFLOAT, ARFOP>& other)
+{
+
+  int mn;
+
+  // Copying user-defined parameters and internal variables.
+
+  objA      = other.objA;
+  MultAX    = other.MultAX;
+  MultAtX   = other.MultAtX;
+  m         = other.m;
+  n         = other.n;
+  nval      = other.nval;
+  nover     = other.nover;
+  npower    = other.npower;
+  PrepareOK = other.PrepareOK;
+  ValuesOK  = other.ValuesOK;
+  VectorsOK = other.VectorsOK;
+  nconv     = other.nconv;
+  l         = other.l;
+  lwk       = other.lwk;
+  seed      = other.seed;
+  stats     = other.stats;
+
+  Q = Z = Cm = Sv = Val = X = Y = Wk = NULL;
+
+  if (!PrepareOK) return;
+
+  // Copying arrays.
+
+  mn  = (m > n) ? m : n;
+  Q   = new ARFLOAT[m*l];
+  Z   = new ARFLOAT[mn*l];
+  Cm  = new ARFLOAT[l*l];
+  Sv  = new ARFLOAT[l];
+  Val = new ARFLOAT[nval];
+  X   = new ARFLOAT[m*nval];
+  Wk  = new ARFLOAT[lwk];
+  if (MultAtX != NULL) Y = new ARFLOAT[n*nval];
+
+  copy(m*l, other.Q, 1, Q, 1);
+  copy(nval, other.Val, 1, Val, 1);
+  copy(m*nval, other.X, 1, X, 1);
+  if (Y != NULL) copy(n*nval, other.Y, 1, Y, 1);
+
+} // Copy.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandRange<ARFLOAT, ARFOP>::Prepare()
+{
+
+  int mn;
+
+  // Deleting old stuff.
+
+  ClearMem();
+
+  // Checking parameters.
+
+  nval   = CheckNval(nval);
+  nover  = CheckNover(nover);
+  npower = CheckNpower(npower);
+  mn     = (m < n) ? m : n;
+  l      = ((nval+nover) > mn) ? mn : nval+nover;
+
+  // Allocating memory. gesvd requires max(3*l+n, 5*l) elements in Wk
+  // and syev 3*l-1.
+
+  mn  = (m > n) ? m : n;
+  lwk = mn+5*l;
+  Q   = new ARFLOAT[m*l];
+  Z   = new ARFLOAT[mn*l];
+  Cm  = new ARFLOAT[l*l];
+  Sv  = new ARFLOAT[l];
+  Val = new ARFLOAT[nval];
+  X   = new ARFLOAT[m*nval];
+  Wk  = new ARFLOAT[lwk];
+  if (MultAtX != NULL) Y = new ARFLOAT[n*nval];
+
+  PrepareOK = true;
+
+} // Prepare.
+
+
+template<class ARFLOAT, class ARFOP>
+inline int ARRandRange<ARFLOAT, ARFOP>::CheckNval(int nvalp)
+{
+
+  if ((nvalp<1)||(nvalp>((m<n)?m:n))) {
+    throw ArpackError(ArpackError::NEV_OUT_OF_BOUNDS, "ARRandRange");
+  }
+  return nvalp;
+
+} // CheckNval.
+
+
+template<class ARFLOAT, class ARFOP>
+inline int ARRandRange<ARFLOAT, ARFOP>::CheckNover(int noverp)
+{
+
+  if (noverp >= 0) return noverp;
+  ArpackError::Set(ArpackError::PARAMETER_ERROR);
+  return 0;
+
+} // CheckNover.
+
+
+template<class ARFLOAT, class ARFOP>
+inline int ARRandRange<ARFLOAT, ARFOP>::CheckNpower(int npowerp)
+{
+
+  if (npowerp >= 0) return npowerp;
+  ArpackError::Set(ArpackError::PARAMETER_ERROR);
+  return 0;
+
+} // CheckNpower.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARRandRange<ARFLOAT, ARFOP>::
+MultA(ARFLOAT* Xp, ARFLOAT* Yp, bool trans)
+{
+
+  double t0;
+
+  t0 = ARTime();
+  if (trans) {
+    (objA->*MultAtX)(Xp, Yp, l);
+  }
+  else {
+    (objA->*MultAX)(Xp, Yp, l);
+  }
+  stats.tuser += ARTime()-t0;
+  stats.nopx  += l;
+  stats.nsteps++;
+
+} // MultA.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandRange<ARFLOAT, ARFOP>::RandomBlock(ARFLOAT* Xp, int k)
+{
+
+  int i;
+
+  // Simple linear congruential generator (values in (-1, 1)).
+
+  for (i=0; i<k; i++) {
+    seed  = (seed*1103515245UL+12345UL)&0x7fffffffUL;
+    Xp[i] = ARFLOAT(2.0)*ARFLOAT(seed)/ARFLOAT(0x7fffffffUL)-ARFLOAT(1.0);
+  }
+
+} // RandomBlock.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandRange<ARFLOAT, ARFOP>::Orthonormalize(ARFLOAT* Xp, int ld, int k)
+{
+
+  int     j, pass, tries;
+  ARFLOAT xnorm, xnorm0, s;
+  ARFLOAT *x;
+
+  for (j=0; j<k; j++) {
+
+    x = &Xp[j*ld];
+    for (tries=0; ; tries++) {
+
+      // Two passes of classical Gram-Schmidt against columns 0 to j-1
+      // (Wk holds the coefficients).
+
+      xnorm0 = nrm2(ld, x, 1);
+      for (pass=0; (pass<2) && (j>0); pass++) {
+        gemv("T", ld, j, (ARFLOAT)1, Xp, ld, x, 1, (ARFLOAT)0, Wk, 1);
+        gemv("N", ld, j, (ARFLOAT)-1, Xp, ld, Wk, 1, (ARFLOAT)1, x, 1);
+      }
+      xnorm = nrm2(ld, x, 1);
+
+      // Accepting x unless it lies (numerically) in the span of the
+      // previous columns. Otherwise, a random vector is used instead.
+
+      if ((xnorm > xnorm0*std::numeric_limits<ARFLOAT>::epsilon()*ARFLOAT(ld))
+          && (xnorm > (ARFLOAT)0)) break;
+      if (tries == 3) {
+        throw ArpackError(ArpackError::START_RESID_ZERO,
+                          "ARRandRange::Orthonormalize");
+      }
+      RandomBlock(x, ld);
+
+    }
+    s = (ARFLOAT)1/xnorm;
+    scal(ld, s, x, 1);
+
+  }
+
+} // Orthonormalize.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandRange<ARFLOAT, ARFOP>::FindRange()
+{
+
+  int i;
+
+  // Sampling the range of A: Q = orth(A*Omega).
+
+  RandomBlock(Z, n*l);
+  MultA(Z, Q, false);
+  Orthonormalize(Q, m, l);
+
+  // Power iterations. The basis is orthonormalized after each product,
+  // so the small singular values are not lost to rounding errors.
+
+  for (i=0; i<npower; i++) {
+    if (MultAtX == NULL) {
+      MultA(Q, Z, false);
+      copy(m*l, Z, 1, Q, 1);
+    }
+    else {
+      MultA(Q, Z, true);
+      Orthonormalize(Z, n, l);
+      MultA(Z, Q, false);
+    }
+    Orthonormalize(Q, m, l);
+  }
+
+} // FindRange.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARRandRange<ARFLOAT, ARFOP>::ChangeOversampling(int noverp)
+{
+
+  nover = CheckNover(noverp);
+  if (PrepareOK) Prepare();
+
+} // ChangeOversampling.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARRandRange<ARFLOAT, ARFOP>::ChangePowerIterations(int npowerp)
+{
+
+  npower    = CheckNpower(npowerp);
+  ValuesOK  = false;
+  VectorsOK = false;
+  nconv     = 0;
+
+} // ChangePowerIterations.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARRandRange<ARFLOAT, ARFOP>::ChangeSeed(unsigned long seedp)
+{
+
+  seed      = seedp;
+  ValuesOK  = false;
+  VectorsOK = false;
+  nconv     = 0;
+
+} // ChangeSeed.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARRandRange<ARFLOAT, ARFOP>::ARRandRange()
+{
+
+  objA    = NULL;
+  MultAX  = NULL;
+  MultAtX = NULL;
+  m = n   = 0;
+  nval    = 0;
+  nover   = 10;
+  npower  = 1;
+  l       = 0;
+  lwk     = 0;
+  seed    = 1UL;
+  Q = Z = Cm = Sv = Val = X = Y = Wk = NULL;
+  ClearMem();
+
+} // Short constructor.
+
+
+template<class ARFLOAT, class ARFOP>
+class ARRandSVD: public ARRandRange<ARFLOAT, ARFOP> {
+
+ public:
+
+ // a) Notation.
+
+  typedef typename ARRandRange<ARFLOAT, ARFOP>::TypeOPX TypeOPX;
+
+
+ protected:
+
+ // b) Protected functions:
+
+  void Compute();
+  // Finds the SVD of B = Q'*A (from B' = A'*Q) and the approximate
+  // singular triplets of A.
+
+
+ public:
+
+ // c) Public functions:
+
+ // c.1) Functions that perform calculations.
+
+  int FindSingularValues() { return FindSingularVectors(); }
+  // Determines the singular values (and vectors, that come at no
+  // additional cost).
+
+  int FindSingularVectors();
+  // Determines the singular values and vectors.
+
+  int SingularValues(ARFLOAT* &svalp);
+  // Overrides array svalp with the singular values of A.
+
+  int SingularVectors(ARFLOAT* &Up, ARFLOAT* &Vp, ARFLOAT* svalp = NULL);
+  // Overrides arrays Up (m x nsv) and Vp (n x nsv) with the left and
+  // right singular vectors of A. svalp, if given, receives the
+  // singular values.
+
+
+ // c.2) Functions that provide access to the solution.
+
+  bool SingularValuesFound() { return this->ValuesOK; }
+  // Indicates if the requested singular values are available.
+
+  bool SingularVectorsFound() { return this->VectorsOK; }
+  // Indicates if the requested singular vectors are available.
+
+  int ConvergedSingularValues() { return this->nconv; }
+  // Provides the number of singular values found. They are stored
+  // in increasing order.
+
+  ARFLOAT SingularValue(int i);
+  // Provides the i-eth singular value.
+
+  ARFLOAT* RawSingularValues();
+  // Provides raw access to the singular values.
+
+  ARFLOAT* RawLeftSingularVectors();
+  // Provides raw access to the left singular vectors (m x nsv).
+
+  ARFLOAT* RawLeftSingularVector(int i);
+  // Provides raw access to the i-eth left singular vector.
+
+  ARFLOAT* RawRightSingularVectors();
+  // Provides raw access to the right singular vectors (n x nsv).
+
+  ARFLOAT* RawRightSingularVector(int i);
+  // Provides raw access to the i-eth right singular vector.
+
+  int GetNsv() { return this->nval; }
+  // Returns the number of singular values to be computed.
+
+
+ // c.3) Functions that define the problem.
+
+  void DefineParameters(int mp, int np, int nsvp, ARFOP* objAp,
+                        TypeOPX MultAXp, TypeOPX MultAtXp,
+                        int noverp = 10, int npowerp = 1);
+  // Sets the values of all parameters.
+
+
+ // c.4) Constructors and destructor.
+
+  ARRandSVD() { }
+  // Short constructor.
+
+  ARRandSVD(int nsvp, ARFOP& A, int noverp = 10, int npowerp = 1);
+  // Long constructor. A must be a matrix class (e.g. ARdsNonSymMatrix
+  // or ARluNonSymMatrix) that defines nrows(), ncols(), MultMV and
+  // MultMtV.
+
+  ARRandSVD(int mp, int np, int nsvp, ARFOP* objAp, TypeOPX MultAXp,
+            TypeOPX MultAtXp, int noverp = 10, int npowerp = 1);
+  // Long constructor (A is a m x n matrix supplied by the products
+  // objAp->MultAXp(X, Y, k), Y <- A*X, and objAp->MultAtXp(X, Y, k),
+  // Y <- A'*X, where X and Y contain k vectors stored by columns).
+
+  ARRandSVD(const ARRandSVD& other) { this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARRandSVD() { }
+  // Destructor.
+
+
+ // d) Operators.
+
+  ARRandSVD& operator=(const ARRandSVD& other);
+  // Assignment operator.
+
+}; // class ARRandSVD.
+
+
+// ------------------------------------------------------------------------ //
+// ARRandSVD member functions definition.                                   //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandSVD<ARFLOAT, ARFOP>::Compute()
+{
+
+  int    i, j, info;
+  double t0;
+
+  t0 = ARTime();
+
+  // Finding Q and Z = A'*Q = B'.
+
+  this->FindRange();
+  this->MultA(this->Q, this->Z, true);
+
+  // B' = W*S*P', so A = Q*B = (Q*P)*S*W'. gesvd overrides Z with W.
+
+  gesvd("O", "S", this->n, this->l, this->Z, this->n, this->Sv, this->Z,
+        1, this->Cm, this->l, this->Wk, this->lwk, info);
+  if (info != 0) {
+    throw ArpackError(ArpackError::LAPACK_ERROR, "ARRandSVD::Compute");
+  }
+
+  // Storing the nsv largest values (in increasing order) and the
+  // corresponding vectors.
+
+  for (j=0; j<this->nval; j++) {
+    i = this->nval-1-j;
+    this->Val[j] = this->Sv[i];
+    copy(this->n, &this->Z[i*this->n], 1, &this->Y[j*this->n], 1);
+    gemv("N", this->m, this->l, (ARFLOAT)1, this->Q, this->m, &this->Cm[i],
+         this->l, (ARFLOAT)0, &this->X[j*this->m], 1);
+  }
+  this->nconv = this->nval;
+
+  this->stats.taupp += ARTime()-t0;
+
+} // Compute.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARRandSVD<ARFLOAT, ARFOP>::FindSingularVectors()
+{
+
+  // Quitting the function if the problem was not defined.
+
+  if (!this->PrepareOK) {
+    throw ArpackError(ArpackError::PREPARE_NOT_OK, "FindSingularVectors");
+  }
+
+  if (!this->VectorsOK) {
+    Compute();
+    this->ValuesOK  = true;
+    this->VectorsOK = true;
+  }
+  return this->nconv;
+
+} // FindSingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARRandSVD<ARFLOAT, ARFOP>::SingularValues(ARFLOAT* &svalp)
+{
+
+  FindSingularValues();
+
+  // Copying singular values to svalp.
+
+  if (svalp == NULL) svalp = new ARFLOAT[this->nval];
+  copy(this->nconv, this->Val, 1, svalp, 1);
+  return this->nconv;
+
+} // SingularValues.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARRandSVD<ARFLOAT, ARFOP>::
+SingularVectors(ARFLOAT* &Up, ARFLOAT* &Vp, ARFLOAT* svalp)
+{
+
+  FindSingularVectors();
+
+  // Copying singular vectors (and values) to the user arrays.
+
+  if (Up == NULL) Up = new ARFLOAT[this->m*this->nval];
+  if (Vp == NULL) Vp = new ARFLOAT[this->n*this->nval];
+  copy(this->m*this->nconv, this->X, 1, Up, 1);
+  copy(this->n*this->nconv, this->Y, 1, Vp, 1);
+  if (svalp != NULL) copy(this->nconv, this->Val, 1, svalp, 1);
+  return this->nconv;
+
+} // SingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT ARRandSVD<ARFLOAT, ARFOP>::SingularValue(int i)
+{
+
+  // Returning i-eth singular value.
+
+  if (!this->ValuesOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "SingularValue(i)");
+  }
+  else if ((i>=this->nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "SingularValue(i)");
+  }
+  return this->Val[i];
+
+} // SingularValue(i).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSVD<ARFLOAT, ARFOP>::RawSingularValues()
+{
+
+  if (!this->ValuesOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "RawSingularValues");
+  }
+  return this->Val;
+
+} // RawSingularValues.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSVD<ARFLOAT, ARFOP>::RawLeftSingularVectors()
+{
+
+  if (!this->VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawLeftSingularVectors");
+  }
+  return this->X;
+
+} // RawLeftSingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSVD<ARFLOAT, ARFOP>::RawLeftSingularVector(int i)
+{
+
+  if (!this->VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawLeftSingularVector(i)");
+  }
+  else if ((i>=this->nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "RawLeftSingularVector(i)");
+  }
+  return &this->X[i*this->m];
+
+} // RawLeftSingularVector(i).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSVD<ARFLOAT, ARFOP>::RawRightSingularVectors()
+{
+
+  if (!this->VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawRightSingularVectors");
+  }
+  return this->Y;
+
+} // RawRightSingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSVD<ARFLOAT, ARFOP>::RawRightSingularVector(int i)
+{
+
+  if (!this->VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK,
+                      "RawRightSingularVector(i)");
+  }
+  else if ((i>=this->nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "RawRightSingularVector(i)");
+  }
+  return &this->Y[i*this->n];
+
+} // RawRightSingularVector(i).
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandSVD<ARFLOAT, ARFOP>::
+DefineParameters(int mp, int np, int nsvp, ARFOP* objAp, TypeOPX MultAXp,
+                 TypeOPX MultAtXp, int noverp, int npowerp)
+{
+
+  // Setting user defined parameters.
+
+  if ((mp < 2) || (np < 2)) {
+    throw ArpackError(ArpackError::N_SMALLER_THAN_2);
+  }
+  if (MultAtXp == NULL) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "ARRandSVD");
+  }
+  this->objA    = objAp;
+  this->MultAX  = MultAXp;
+  this->MultAtX = MultAtXp;
+  this->m       = mp;
+  this->n       = np;
+  this->nval    = nsvp;
+  this->nover   = noverp;
+  this->npower  = npowerp;
+
+  // Checking parameters and allocating memory.
+
+  this->Prepare();
+
+} // DefineParameters.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARRandSVD<ARFLOAT, ARFOP>::
+ARRandSVD(int nsvp, ARFOP& A, int noverp, int npowerp)
+{
+
+  DefineParameters(A.nrows(), A.ncols(), nsvp, &A, &ARFOP::MultMV,
+                   &ARFOP::MultMtV, noverp, npowerp);
+
+} // Long constructor (matrix class).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARRandSVD<ARFLOAT, ARFOP>::
+ARRandSVD(int mp, int np, int nsvp, ARFOP* objAp, TypeOPX MultAXp,
+          TypeOPX MultAtXp, int noverp, int npowerp)
+{
+
+  DefineParameters(mp, np, nsvp, objAp, MultAXp, MultAtXp, noverp, npowerp);
+
+} // Long constructor (user defined products).
+
+
+template<class ARFLOAT, class ARFOP>
+ARRandSVD<ARFLOAT, ARFOP>& ARRandSVD<ARFLOAT, ARFOP>::
+operator=(const ARRandSVD<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+template<class ARFLOAT, class ARFOP>
+class ARRandSymEig: public ARRandRange<ARFLOAT, ARFOP> {
+
+ public:
+
+ // a) Notation.
+
+  typedef typename ARRandRange<ARFLOAT, ARFOP>::TypeOPX TypeOPX;
+
+
+ protected:
+
+ // b) Protected functions:
+
+  void Compute();
+  // Finds the eigenpairs of T = Q'*A*Q and keeps the nev ones with
+  // the largest magnitude.
+
+
+ public:
+
+ // c) Public functions:
+
+ // c.1) Functions that perform calculations.
+
+  int FindEigenvalues() { return FindEigenvectors(); }
+  // Determines the eigenvalues (and vectors, that come at no
+  // additional cost).
+
+  int FindEigenvectors();
+  // Determines the eigenvalues and eigenvectors.
+
+  int Eigenvalues(ARFLOAT* &EigValp);
+  // Overrides array EigValp with the eigenvalues of A.
+
+  int EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValp);
+  // Overrides arrays EigVecp (n x nev) and EigValp with the
+  // eigenvectors and eigenvalues of A.
+
+
+ // c.2) Functions that provide access to the solution.
+
+  bool EigenvaluesFound() { return this->ValuesOK; }
+  // Indicates if the requested eigenvalues are available.
+
+  bool EigenvectorsFound() { return this->VectorsOK; }
+  // Indicates if the requested eigenvectors are available.
+
+  int ConvergedEigenvalues() { return this->nconv; }
+  // Provides the number of eigenvalues found. They are stored in
+  // increasing order.
+
+  ARFLOAT Eigenvalue(int i);
+  // Provides the i-eth eigenvalue.
+
+  ARFLOAT* RawEigenvalues();
+  // Provides raw access to the eigenvalues.
+
+  ARFLOAT* RawEigenvectors();
+  // Provides raw access to the eigenvectors (n x nev). They can be
+  // passed to ARSymStdEig::SetSubspace.
+
+  ARFLOAT* RawEigenvector(int i);
+  // Provides raw access to the i-eth eigenvector.
+
+  int GetNev() { return this->nval; }
+  // Returns the number of eigenvalues to be computed.
+
+
+ // c.3) Functions that define the problem.
+
+  void DefineParameters(int np, int nevp, ARFOP* objAp, TypeOPX MultAXp,
+                        int noverp = 10, int npowerp = 1);
+  // Sets the values of all parameters.
+
+
+ // c.4) Constructors and destructor.
+
+  ARRandSymEig() { }
+  // Short constructor.
+
+  ARRandSymEig(int nevp, ARFOP& A, int noverp = 10, int npowerp = 1);
+  // Long constructor. A must be a symmetric matrix class (e.g.
+  // ARdsSymMatrix or ARluSymMatrix) that defines ncols() and MultMV.
+
+  ARRandSymEig(int np, int nevp, ARFOP* objAp, TypeOPX MultAXp,
+               int noverp = 10, int npowerp = 1);
+  // Long constructor (A is a n x n symmetric matrix supplied by the
+  // product objAp->MultAXp(X, Y, k), Y <- A*X, where X and Y contain
+  // k vectors stored by columns).
+
+  ARRandSymEig(const ARRandSymEig& other) { this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARRandSymEig() { }
+  // Destructor.
+
+
+ // d) Operators.
+
+  ARRandSymEig& operator=(const ARRandSymEig& other);
+  // Assignment operator.
+
+}; // class ARRandSymEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARRandSymEig member functions definition.                                //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandSymEig<ARFLOAT, ARFOP>::Compute()
+{
+
+  int    i, j, lo, hi, info;
+  double t0;
+
+  t0 = ARTime();
+
+  // Finding Q and T = Q'*A*Q (only its upper triangle is used).
+
+  this->FindRange();
+  this->MultA(this->Q, this->Z, false);
+  gemm("T", "N", this->l, this->l, this->n, (ARFLOAT)1, this->Q, this->n,
+       this->Z, this->n, (ARFLOAT)0, this->Cm, this->l);
+
+  syev("V", "U", this->l, this->Cm, this->l, this->Sv, this->Wk, this->lwk,
+       info);
+  if (info != 0) {
+    throw ArpackError(ArpackError::LAPACK_ERROR, "ARRandSymEig::Compute");
+  }
+
+  // The nev values with the largest magnitude are at both ends of Sv
+  // (that is in increasing order), so they are chosen from the ends.
+
+  lo = 0;
+  hi = this->l-1;
+  for (j=0; j<this->nval; j++) {
+    if (std::fabs(this->Sv[lo]) > std::fabs(this->Sv[hi])) lo++; else hi--;
+  }
+
+  // Storing the eigenvalues (in increasing order) and the Ritz vectors.
+
+  for (j=0, i=0; i<this->l; i++) {
+    if ((i >= lo) && (i <= hi)) continue;
+    this->Val[j] = this->Sv[i];
+    gemv("N", this->n, this->l, (ARFLOAT)1, this->Q, this->n,
+         &this->Cm[i*this->l], 1, (ARFLOAT)0, &this->X[j*this->n], 1);
+    j++;
+  }
+  this->nconv = this->nval;
+
+  this->stats.taupp += ARTime()-t0;
+
+} // Compute.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARRandSymEig<ARFLOAT, ARFOP>::FindEigenvectors()
+{
+
+  // Quitting the function if the problem was not defined.
+
+  if (!this->PrepareOK) {
+    throw ArpackError(ArpackError::PREPARE_NOT_OK, "FindEigenvectors");
+  }
+
+  if (!this->VectorsOK) {
+    Compute();
+    this->ValuesOK  = true;
+    this->VectorsOK = true;
+  }
+  return this->nconv;
+
+} // FindEigenvectors.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARRandSymEig<ARFLOAT, ARFOP>::Eigenvalues(ARFLOAT* &EigValp)
+{
+
+  FindEigenvalues();
+
+  // Copying eigenvalues to EigValp.
+
+  if (EigValp == NULL) EigValp = new ARFLOAT[this->nval];
+  copy(this->nconv, this->Val, 1, EigValp, 1);
+  return this->nconv;
+
+} // Eigenvalues.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARRandSymEig<ARFLOAT, ARFOP>::
+EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValp)
+{
+
+  FindEigenvectors();
+
+  // Copying eigenvalues and eigenvectors to the user arrays.
+
+  if (EigVecp == NULL) EigVecp = new ARFLOAT[this->n*this->nval];
+  if (EigValp == NULL) EigValp = new ARFLOAT[this->nval];
+  copy(this->n*this->nconv, this->X, 1, EigVecp, 1);
+  copy(this->nconv, this->Val, 1, EigValp, 1);
+  return this->nconv;
+
+} // EigenValVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT ARRandSymEig<ARFLOAT, ARFOP>::Eigenvalue(int i)
+{
+
+  // Returning i-eth eigenvalue.
+
+  if (!this->ValuesOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "Eigenvalue(i)");
+  }
+  else if ((i>=this->nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "Eigenvalue(i)");
+  }
+  return this->Val[i];
+
+} // Eigenvalue(i).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSymEig<ARFLOAT, ARFOP>::RawEigenvalues()
+{
+
+  if (!this->ValuesOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "RawEigenvalues");
+  }
+  return this->Val;
+
+} // RawEigenvalues.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSymEig<ARFLOAT, ARFOP>::RawEigenvectors()
+{
+
+  if (!this->VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawEigenvectors");
+  }
+  return this->X;
+
+} // RawEigenvectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARRandSymEig<ARFLOAT, ARFOP>::RawEigenvector(int i)
+{
+
+  if (!this->VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawEigenvector(i)");
+  }
+  else if ((i>=this->nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "RawEigenvector(i)");
+  }
+  return &this->X[i*this->n];
+
+} // RawEigenvector(i).
+
+
+template<class ARFLOAT, class ARFOP>
+void ARRandSymEig<ARFLOAT, ARFOP>::
+DefineParameters(int np, int nevp, ARFOP* objAp, TypeOPX MultAXp,
+                 int noverp, int npowerp)
+{
+
+  // Setting user defined parameters.
+
+  if (np < 2) {
+    throw ArpackError(ArpackError::N_SMALLER_THAN_2);
+  }
+  this->objA    = objAp;
+  this->MultAX  = MultAXp;
+  this->MultAtX = NULL;
+  this->m       = np;
+  this->n       = np;
+  this->nval    = nevp;
+  this->nover   = noverp;
+  this->npower  = npowerp;
+
+  // Checking parameters and allocating memory.
+
+  this->Prepare();
+
+} // DefineParameters.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARRandSymEig<ARFLOAT, ARFOP>::
+ARRandSymEig(int nevp, ARFOP& A, int noverp, int npowerp)
+{
+
+  DefineParameters(A.ncols(), nevp, &A, &ARFOP::MultMV, noverp, npowerp);
+
+} // Long constructor (matrix class).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARRandSymEig<ARFLOAT, ARFOP>::
+ARRandSymEig(int np, int nevp, ARFOP* objAp, TypeOPX MultAXp,
+             int noverp, int npowerp)
+{
+
+  DefineParameters(np, nevp, objAp, MultAXp, noverp, npowerp);
+
+} // Long constructor (user defined products).
+
+
+template<class ARFLOAT, class ARFOP>
+ARRandSymEig<ARFLOAT, ARFOP>& ARRandSymEig<ARFLOAT, ARFOP>::
+operator=(const ARRandSymEig<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARRAND_H
@@ -0,0 +1,254 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARRPSNSym.h.
+   Arpack++ class ARrcParNonSymStdEig definition.
+   ARrcParNonSymStdEig is the distributed memory version of
+   ARrcNonSymStdEig. The rows of the eigenvectors (and of resid, V and
+   workd) are distributed among the processes of an MPI communicator,
+   and PARPACK (pdnaupd and pdneupd) is called instead of ARPACK. Each
+   process only handles its own rows: GetVector and PutVector point to
+   local slices, so the products y <- OP*x must be performed
+   (collectively) on these slices, and GetN returns the local number
+   of rows.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARRPSNSYM_H
+#define ARRPSNSYM_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "arerror.h"
+#include "arrsnsym.h"
+#include "pnaupp.h"
+#include "pneupp.h"
+
+
+template<class ARFLOAT>
+class ARrcParNonSymStdEig: public virtual ARrcNonSymStdEig<ARFLOAT> {
+
+ protected:
+
+ // a) Distribution of the vectors.
+
+  MPI_Comm comm;     // Communicator that contains all processes.
+  int      nglobal;  // Global dimension of the eigenproblem.
+
+
+ // b) Protected functions:
+
+ // b.1) Functions that handle PARPACK code.
+
+  void Aupp();
+  // Interface to PARPACK subroutines PSNAUPD and PDNAUPD.
+
+  void Eupp();
+  // Interface to PARPACK subroutines PSNEUPD and PDNEUPD.
+
+
+ // b.2) Functions that check user defined parameters.
+
+  int CheckN(int np);
+  // Finds nglobal, the sum of np (the local number of rows) over all
+  // processes, and checks it.
+
+  int CheckNcv(int ncvp);
+  // Forces ncv to conform to its ranges (nglobal is used instead of n).
+
+  int CheckNev(int nevp);
+  // Does range checking on nev (nglobal is used instead of n).
+
+
+ public:
+
+ // c) Public functions:
+
+ // c.1) Functions that provide access to the distribution.
+
+  MPI_Comm GetCommunicator() { return comm; }
+  // Returns the communicator that contains all processes.
+
+  int GetGlobalN() { return nglobal; }
+  // Returns the dimension of the problem. GetN returns the number
+  // of rows stored by this process.
+
+
+ // c.2) Constructors and destructor.
+
+  ARrcParNonSymStdEig() { comm = MPI_COMM_WORLD; nglobal = 0; }
+  // Short constructor.
+
+  ARrcParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp,
+                      const std::string& whichp = "LM", int ncvp = 0,
+                      ARFLOAT tolp = 0.0, int maxitp = 0,
+                      ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (regular mode). nlocp is the number of rows
+  // stored by this process. All processes that belong to commp
+  // must create the problem with the same parameters (except for
+  // nlocp and residp, that contains only the local rows).
+
+  ARrcParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFLOAT sigmap,
+                      const std::string& whichp = "LM", int ncvp = 0,
+                      ARFLOAT tolp = 0.0, int maxitp = 0,
+                      ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARrcParNonSymStdEig(const ARrcParNonSymStdEig& other)
+  { comm = other.comm; nglobal = other.nglobal; this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARrcParNonSymStdEig() { }
+  // Destructor.
+
+ // d) Operators.
+
+  ARrcParNonSymStdEig& operator=(const ARrcParNonSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARrcParNonSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARrcParNonSymStdEig member functions definition.                         //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT>
+inline void ARrcParNonSymStdEig<ARFLOAT>::Aupp()
+{
+
+  pnaupp(comm, this->ido, this->bmat, this->n, this->which, this->nev,
+         this->tol, this->resid, this->ncv, this->V, this->n, this->iparam,
+         this->ipntr, this->workd, this->workl, this->lworkl, this->info);
+
+} // Aupp.
+
+
+template<class ARFLOAT>
+inline void ARrcParNonSymStdEig<ARFLOAT>::Eupp()
+{
+
+  pneupp(comm, this->rvec, this->HowMny, this->EigValR, this->EigValI,
+         this->EigVec, this->n, this->sigmaR, this->sigmaI, this->workv,
+         this->bmat, this->n, this->which, this->nev, this->tol,
+         this->resid, this->ncv, this->V, this->n, this->iparam,
+         this->ipntr, this->workd, this->workl, this->lworkl, this->info);
+
+} // Eupp.
+
+
+template<class ARFLOAT>
+int ARrcParNonSymStdEig<ARFLOAT>::CheckN(int np)
+{
+
+  int nmin;
+
+  // All processes must reach the same conclusion, so the checks are
+  // performed on reduced values.
+
+  MPI_Allreduce(&np, &nglobal, 1, MPI_INT, MPI_SUM, comm);
+  MPI_Allreduce(&np, &nmin, 1, MPI_INT, MPI_MIN, comm);
+  if ((nglobal < 2) || (nmin < 1)) {
+    throw ArpackError(ArpackError::N_SMALLER_THAN_2);
+  }
+  return np;
+
+} // CheckN.
+
+
+template<class ARFLOAT>
+inline int ARrcParNonSymStdEig<ARFLOAT>::CheckNcv(int ncvp)
+{
+
+  // Adjusting ncv if ncv <= nev or ncv > nglobal.
+
+  if (ncvp < this->nev+1) {
+    if (ncvp) ArpackError::Set(ArpackError::NCV_OUT_OF_BOUNDS);
+    return ((2*this->nev+1)>nglobal)?nglobal:(2*this->nev+1);
+  }
+  else if (ncvp > nglobal) {
+    ArpackError::Set(ArpackError::NCV_OUT_OF_BOUNDS);
+    return nglobal;
+  }
+  else {
+    return ncvp;
+  }
+
+} // CheckNcv.
+
+
+template<class ARFLOAT>
+inline int ARrcParNonSymStdEig<ARFLOAT>::CheckNev(int nevp)
+{
+
+  if ((nevp<=1)||(nevp>=(nglobal-1))) { // 1 < nev < nglobal-1.
+    throw ArpackError(ArpackError::NEV_OUT_OF_BOUNDS);
+  }
+  return nevp;
+
+} // CheckNev.
+
+
+template<class ARFLOAT>
+inline ARrcParNonSymStdEig<ARFLOAT>::
+ARrcParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp,
+                    const std::string& whichp, int ncvp, ARFLOAT tolp,
+                    int maxitp, ARFLOAT* residp, bool ishiftp)
+
+{
+
+  comm    = commp;
+  nglobal = 0;
+  this->NoShift();
+  this->DefineParameters(nlocp, nevp, whichp, ncvp, tolp, maxitp,
+                         residp, ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT>
+inline ARrcParNonSymStdEig<ARFLOAT>::
+ARrcParNonSymStdEig(MPI_Comm commp, int nlocp, int nevp, ARFLOAT sigmap,
+                    const std::string& whichp, int ncvp, ARFLOAT tolp,
+                    int maxitp, ARFLOAT* residp, bool ishiftp)
+
+{
+
+  comm    = commp;
+  nglobal = 0;
+  this->ChangeShift(sigmap);
+  this->DefineParameters(nlocp, nevp, whichp, ncvp, tolp, maxitp,
+                         residp, ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT>
+ARrcParNonSymStdEig<ARFLOAT>& ARrcParNonSymStdEig<ARFLOAT>::
+operator=(const ARrcParNonSymStdEig<ARFLOAT>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    comm    = other.comm;
+    nglobal = other.nglobal;
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARRPSNSYM_H
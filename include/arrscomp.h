@@ -18,6 +18,7 @@
 #define ARRSCOMP_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "arerror.h"
@@ -142,9 +143,9 @@ inline void ARrcCompStdEig<ARFLOAT>::WorkspaceAllocate()
   this->lworkl  = this->ncv*(3*this->ncv+6);
   this->lworkv  = 2*this->ncv;
   this->lrwork  = this->ncv;
-  this->workl   = new arcomplex<ARFLOAT>[this->lworkl+1];
-  this->workv   = new arcomplex<ARFLOAT>[this->lworkv+1];
-  this->rwork   = new ARFLOAT[this->lrwork+1];
+  this->NewArray(this->workl, this->lworkl+1, ARAllocator::WORKSPACE);
+  this->NewArray(this->workv, this->lworkv+1, ARAllocator::WORKSPACE);
+  this->NewArray(this->rwork, this->lrwork+1, ARAllocator::WORKSPACE);
 
 } // WorkspaceAllocate.
 
@@ -176,24 +177,37 @@ Eigenvalues(arcomplex<ARFLOAT>* &EigValp, bool ivec, bool ischur)
 {
 
   if (this->ValuesOK) {                      // Eigenvalues are available .
-    if (EigValp == NULL) {             // Moving eigenvalues.
+    if ((EigValp == NULL) && (this->allocator == NULL)) {
+                                       // Moving eigenvalues.
       EigValp  = this->EigValR;
       this->EigValR  = NULL;
       this->newVal   = false;
       this->ValuesOK = false;
     }
     else {                             // Copying eigenvalues.
+      if (EigValp == NULL) {
+        try { EigValp = new arcomplex<ARFLOAT>[this->ValSize()]; }
+        catch (const ArpackError&) { return 0; }
+        catch (const std::bad_alloc&) {
+          ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvalues");
+          return 0;
+        }
+      }
       copy(this->nconv,this->EigValR,1,EigValp,1);
     }
   }
   else {
     if (this->newVal) {
-      delete[] this->EigValR;
+      this->DeleteArray(this->EigValR);
       this->newVal = false;
     }
     if (EigValp == NULL) {
       try { EigValp = new arcomplex<ARFLOAT>[this->ValSize()]; }
       catch (ArpackError) { return 0; }
+      catch (const std::bad_alloc&) {
+        ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvalues");
+        return 0;
+      }
     }
     this->EigValR = EigValp;
     if (ivec) {                        // Finding eigenvalues and eigenvectors.
@@ -221,11 +235,11 @@ EigenValVectors(arcomplex<ARFLOAT>* &EigVecp, arcomplex<ARFLOAT>* &EigValp,
   }
   else {                           // Eigenvalues and vectors are not available.
     if (this->newVec) {
-      delete[] this->EigVec;
+      this->DeleteArray(this->EigVec);
       this->newVec = false;
     }
     if (this->newVal) {
-      delete[] this->EigValR;
+      this->DeleteArray(this->EigValR);
       this->newVal = false;
     }  
     try {
@@ -233,6 +247,10 @@ EigenValVectors(arcomplex<ARFLOAT>* &EigVecp, arcomplex<ARFLOAT>* &EigValp,
       if (EigValp == NULL) EigValp = new arcomplex<ARFLOAT>[this->ValSize()];
     }
     catch (ArpackError) { return 0; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "EigenValVectors");
+      return 0;
+    }
     this->EigVec  = EigVecp;
     this->EigValR = EigValp;
     this->nconv   = this->FindEigenvectors(ischur);
@@ -297,6 +315,10 @@ StlEigenvalues(bool ivec, bool ischur)
     ValR = new vector<arcomplex<ARFLOAT> >(ValSize());
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvalues");
+    return NULL;
+  }
   ValPtr = ValR->begin();
   nconv = Eigenvalues(ValPtr, ivec, ischur);
   return ValR;
@@ -323,6 +345,10 @@ StlEigenvector(int i)
     Vec = new vector<arcomplex<ARFLOAT> >(&EigVec[i*n], &EigVec[(i+1)*n]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvector");
+    return NULL;
+  }
   return Vec;
 
 } // StlEigenvector(i).
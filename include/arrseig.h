@@ -24,14 +24,12 @@
 #include <string>
 #include "arch.h"
 #include "arerror.h"
+#include "arstats.h"
+#include "aralloc.h"
+#include "arview.h"
 #include "debug.h"
 #include "blas1c.h"
 
-
-// "New" handler.
-
-void MemoryOverflow() { throw ArpackError(ArpackError::MEMORY_OVERFLOW); }
-
 // ARrcStdEig class definition.
 
 template<class ARFLOAT, class ARTYPE>
@@ -96,6 +94,27 @@ class ARrcStdEig {
   ARTYPE  *EigVec;    // Eigenvectors.
 
 
+ // a.4) Performance data.
+
+  ARStats    stats;    // Counters and timings collected so far.
+  ARProfiler *profiler; // External profiler (NULL if none).
+  double     tstep;    // Time at which the last user product was requested.
+  double     tfact;    // Time at which the last factorization has begun.
+
+
+ // a.5) Memory allocation.
+
+  ARAllocator *allocator; // Allocator of the working arrays (NULL = new[]).
+
+
+ // a.6) Vectors kept from previous problems (warm start).
+
+  bool    warm;       // Indicates if converged vectors are kept automatically.
+  int     nseed;      // Number of vectors stored in seedV.
+  int     seedn;      // Dimension of the vectors stored in seedV.
+  ARTYPE  *seedV;     // Converged vectors of the last problem (seedn x nseed).
+
+
  // b) Protected functions:
 
  // b.1) Memory control functions.
@@ -116,6 +135,31 @@ class ARrcStdEig {
   void ClearMem();
   // Clears workspace.
 
+  template<class T>
+  void NewArray(T* &p, int k, ARAllocator::Use use)
+  {
+    p = (allocator == NULL) ? new T[k]
+                            : (T*)allocator->Allocate(size_t(k)*sizeof(T), use);
+  }
+  // Creates an array of k elements (using allocator, if defined).
+
+  template<class T>
+  void DeleteArray(T* &p)
+  {
+    if (p != NULL) {
+      if (allocator == NULL) delete[] p; else allocator->Deallocate(p);
+    }
+    p = NULL;
+  }
+  // Deletes an array created by NewArray.
+
+  void ClearSeed();
+  // Deletes the vectors kept from previous problems.
+
+  bool SeedVector(ARTYPE* x, int j, int nvec);
+  // Stores in x the sum of the kept vectors j, j+nvec, j+2*nvec, ...
+  // Returns false (and does not change x) if there is no such vector.
+
   virtual void ValAllocate();
   // Creates arrays EigValR and EigValI.
   // Redefined in ARrcNonSymStdEig.
@@ -150,14 +194,28 @@ class ARrcStdEig {
   void EuppError();
   // Handles errors occurred in function Eupp.
 
+  double StartEvent(ARStats::Event ev);
+  // Notifies the profiler that stage ev has begun and returns the time.
+
+  void StopEvent(ARStats::Event ev, double t0);
+  // Charges the time elapsed since t0 to stage ev.
+
+  void StartFactor() { tfact = StartEvent(ARStats::FACTOR); }
+  // Must be called by derived classes before factoring OP.
+
+  void StopFactor() { StopEvent(ARStats::FACTOR, tfact); stats.nfactor++; }
+  // Must be called by derived classes after factoring OP.
+
 
  // b.3) Functions that check user defined parameters.
 
-  int CheckN(int np);
+  virtual int CheckN(int np);
   // Does range checking on ncv.
+  // Redefined in ARrcParSymStdEig and ARrcParNonSymStdEig.
 
-  int CheckNcv(int ncvp);
+  virtual int CheckNcv(int ncvp);
   // Forces ncv to conform to its ranges.
+  // Redefined in ARrcParSymStdEig and ARrcParNonSymStdEig.
 
   virtual int CheckNev(int nevp);
   // Does range checking on nev.
@@ -174,6 +232,10 @@ class ARrcStdEig {
  // b.4) Functions that set internal variables.
 
   void Restart();
+  // Clears the current solution and prepares ARPACK to begin a new
+  // Arnoldi iteration. When vectors were kept from a previous problem,
+  // their sum is used as the starting vector (unless resid was
+  // supplied by the user).
 
   virtual void Prepare();
   // Defines internal variables and allocates working arrays.
@@ -365,6 +427,15 @@ class ARrcStdEig {
   // Overrides array EigVecp sequentially with the eigenvectors of the
   // given eigen-problem. Also calculates Schur vectors if requested.
 
+  int CopyEigenvectors(ARTYPE* dest, int ld = 0, bool rowmajor = false,
+                       bool ischur = false);
+  // Copies the converged eigenvectors to the caller-owned array dest,
+  // element i of eigenvector j being stored in dest[i+j*ld] (or in
+  // dest[i*ld+j] if rowmajor is true). ld = 0 means n (or nconv if
+  // rowmajor is true). Eigenvectors are calculated (in V, unless
+  // Schur vectors are also requested) if they are not available.
+  // Returns the number of eigenvectors copied.
+
 
  // c.9) Functions that return elements of vectors and matrices.
 
@@ -404,6 +475,16 @@ class ARrcStdEig {
   ARTYPE* RawResidualVector();
   // Provides raw access to residual vector elements.
 
+  ARView<ARTYPE> ArnoldiBasisView();
+  // Returns a view (n x ncv) of the Arnoldi basis.
+
+  ARView<ARTYPE> EigenvectorView();
+  // Returns a view (n x nconv) of the eigenvectors. No copy is made,
+  // so the view is valid until the problem is changed or solved again.
+
+  ARView<ARTYPE> SchurVectorView();
+  // Returns a view (n x nev) of the Schur vectors.
+
 
  // c.11) Functions that use STL vector class.
 
@@ -431,15 +512,94 @@ class ARrcStdEig {
 #endif // #ifdef STL_VECTOR_H.
 
 
- // c.12) Constructors and destructor.
+ // c.12) Functions that provide performance data.
+
+  const ARStats& GetStats() { return stats; }
+  // Returns the counters and timings collected since the problem was
+  // defined or since the last call to ResetStats.
+  // When the reverse communication interface is used, the time elapsed
+  // between two calls to TakeStep is charged to the user products.
+
+  void ResetStats() { stats.Reset(); }
+  // Sets all counters to zero (to obtain data from a single solve).
+
+  void SetProfiler(ARProfiler* profilerp) { profiler = profilerp; }
+  // Defines an external profiler that is notified each time the solver
+  // enters or leaves a stage. The profiler is shared by copies of this
+  // object and is never deleted by ARPACK++.
+
+  ARAllocator* GetAllocator() { return allocator; }
+  // Returns the allocator of the working arrays (NULL if new[] is used).
+
+  void SetAllocator(ARAllocator* allocatorp);
+  // Defines the allocator used to create V, resid, the ARPACK workspace
+  // and the arrays that store eigenvalues and eigenvectors (see aralloc.h).
+  // Working arrays already created are discarded and recreated, so all
+  // results are lost. The allocator is shared by copies of this object,
+  // must live longer than them and is never deleted by ARPACK++.
+  // Eigenvalues and eigenvectors are always copied (never moved) to the
+  // arrays returned by Eigenvalues, Eigenvectors and EigenValVectors
+  // when an allocator is defined.
+
+
+ // c.13) Functions that reuse the solution of a previous problem.
+
+  void WarmStart(bool warmp = true)
+  {
+    warm = warmp;
+    if (!warm) ClearSeed();
+  }
+  // Turns on (or off) the warm start mode. In this mode, the converged
+  // eigenvectors (or Schur vectors) of each problem are kept when the
+  // problem is redefined (by DefineParameters or by any function that
+  // changes a parameter, the operator or the shift) and are used as the
+  // starting subspace of the next problem of the same dimension. This
+  // is useful to solve a sequence of slowly varying problems.
+
+  bool GetWarmStart() { return warm; }
+  // Indicates if the warm start mode is on.
+
+  int SaveSubspace();
+  // Keeps the converged eigenvectors (or, if they are not available,
+  // the Schur vectors) of the current problem, so they can be used to
+  // start the next one. Returns the number of vectors kept.
+
+  int GetSubspaceSize() { return nseed; }
+  // Returns the number of vectors kept from the previous problem.
+
+  void Recycle();
+  // Keeps the converged vectors and restarts the solver. Must be
+  // called when the operator (or the matrix) is changed in place,
+  // so the next call to FindEigenvalues or FindEigenvectors solves
+  // the new problem starting from the previous solution.
+
+  void ClearSubspace() { ClearSeed(); }
+  // Discards the vectors kept from the previous problem.
+
+  void SetSubspace(int k, ARTYPE* X);
+  // Replaces the vectors kept from the previous problem by the k
+  // columns of X (n x k), so they are used to start the next problem
+  // (X may contain, for example, the approximate eigenvectors given by
+  // ARRandSymEig or the right singular vectors given by ARRandSVD).
+  // When the Krylov-Schur engine is used, the vectors are spread over
+  // the first block of the basis. Otherwise, their sum is used as the
+  // starting vector. The warm start mode need not be on.
+
+
+ // c.14) Constructors and destructor.
 
   ARrcStdEig();
   // Short constructor that does almost nothing.
 
-  ARrcStdEig(const ARrcStdEig& other) { Copy(other); }
+  ARrcStdEig(const ARrcStdEig& other)
+  {
+    seedV = NULL;
+    nseed = seedn = 0;
+    Copy(other);
+  }
   // Copy constructor.
 
-  virtual ~ARrcStdEig() { ClearMem(); }
+  virtual ~ARrcStdEig() { ClearMem(); ClearSeed(); }
   // Very simple destructor.
 
  // d) Operators:
@@ -479,36 +639,31 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::ClearMem()
  
   // Deleting working arrays.
     
-  if (workl) delete[] workl;
-  if (workd) delete[] workd;
-  if (workv) delete[] workv;
-  if (rwork) delete[] rwork;
-  if (V)     delete[] V;
-
-  workl = NULL;
-  workd = NULL;
-  workv = NULL;
-  rwork = NULL;
-  V     = NULL;
+  DeleteArray(workl);
+  DeleteArray(workd);
+  DeleteArray(workv);
+  DeleteArray(rwork);
+  DeleteArray(V);
+  ClearBasis();
 
   // Deleting input and output arrays.
 
   if (newRes) {
-    delete[] resid;
+    DeleteArray(resid);
     newRes = false;
     resid = NULL;   // Salwen. Mar 3, 2000.
   }
 
   if (newVal) {
-    delete[] EigValR;
-    delete[] EigValI;
+    DeleteArray(EigValR);
+    DeleteArray(EigValI);
     newVal = false;
   }
   EigValR=NULL;
   EigValI=NULL;
 
   if (newVec) {
-    delete[] EigVec;
+    DeleteArray(EigVec);
     newVec = false;
   }
   EigVec=NULL;
@@ -525,19 +680,47 @@ inline void ARrcStdEig<ARFLOAT, ARTYPE>::ValAllocate()
 {
 
   if (EigValR == NULL) {              // Creating a new array EigValR.
-    EigValR = new ARTYPE[ValSize()];
+    NewArray(EigValR, ValSize(), ARAllocator::VECTOR);
     newVal = true;
   }
 
 } // ValAllocate.
 
+template<class ARFLOAT, class ARTYPE>
+inline void ARrcStdEig<ARFLOAT, ARTYPE>::ClearSeed()
+{
+
+  if (seedV) delete[] seedV;
+  seedV = NULL;
+  nseed = 0;
+  seedn = 0;
+
+} // ClearSeed.
+
+
+template<class ARFLOAT, class ARTYPE>
+bool ARrcStdEig<ARFLOAT, ARTYPE>::SeedVector(ARTYPE* x, int j, int nvec)
+{
+
+  // The kept vectors are only used by problems of the same dimension.
+
+  int i;
+
+  if ((seedn != n) || (j >= nseed)) return false;
+  copy(n, &seedV[j*n], 1, x, 1);
+  for (i=j+nvec; i<nseed; i+=nvec) axpy(n, (ARTYPE)1, &seedV[i*n], 1, x, 1);
+  return true;
+
+} // SeedVector.
+
+
 template<class ARFLOAT, class ARTYPE>
 inline void ARrcStdEig<ARFLOAT, ARTYPE>::VecAllocate(bool newV)
 {
 
   if (EigVec == NULL) {
     if (newV) {                       // Creating a new array EigVec.
-      EigVec = new ARTYPE[ValSize()*n];
+      NewArray(EigVec, ValSize()*n, ARAllocator::VECTOR);
       newVec = true;
     }
     else {                            // Using V to store EigVec.
@@ -606,6 +789,30 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::EuppError()
 } // EuppError.
 
 
+template<class ARFLOAT, class ARTYPE>
+inline double ARrcStdEig<ARFLOAT, ARTYPE>::StartEvent(ARStats::Event ev)
+{
+
+  if (profiler != NULL) profiler->Begin(ev);
+  return ARTime();
+
+} // StartEvent.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline void ARrcStdEig<ARFLOAT, ARTYPE>::
+StopEvent(ARStats::Event ev, double t0)
+{
+
+  double dt;
+
+  dt = ARTime()-t0;
+  stats.Time(ev) += dt;
+  if (profiler != NULL) profiler->End(ev, dt);
+
+} // StopEvent.
+
+
 template<class ARFLOAT, class ARTYPE>
 inline int ARrcStdEig<ARFLOAT, ARTYPE>::CheckN(int np)
 {
@@ -685,12 +892,15 @@ template<class ARFLOAT, class ARTYPE>
 void ARrcStdEig<ARFLOAT, ARTYPE>::Restart()
 {
 
+  if (warm) SaveSubspace(); // Keeping the vectors of the last problem.
+
   nconv=0;                  // No eigenvalues found yet.
   ido  =0;                  // First call to AUPP.
   iparam[1]=(int)AutoShift; // Shift strategy used.
   iparam[3]=maxit;          // Maximum number of Arnoldi iterations allowed.
   iparam[4]=1;              // Blocksize must be 1.
   info =(int)(!newRes);     // Starting vector used.
+  if (newRes && (resid != NULL) && SeedVector(resid, 0, 1)) info = 1;
   ClearBasis();
 
 } // Restart.
@@ -702,6 +912,7 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::Prepare()
 
   // Deleting old stuff.
 
+  if (warm) SaveSubspace();
   ClearMem();
 
   // Defining internal variables.
@@ -709,14 +920,14 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::Prepare()
   try {
 
     if (resid == NULL) {       // Using a random starting vector.
-      resid  = new ARTYPE[n];
+      NewArray(resid, n, ARAllocator::VECTOR);
       newRes = true;
     }
 
     // Setting dimensions of working arrays.
 
-    workd    = new ARTYPE[3*n+1];
-    V        = new ARTYPE[n*ncv+1];
+    NewArray(workd, 3*n+1, ARAllocator::WORKSPACE);
+    NewArray(V, n*ncv+1, ARAllocator::BASIS);
     WorkspaceAllocate();
 
   }
@@ -724,6 +935,11 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::Prepare()
     ArpackError(ArpackError::CANNOT_PREPARE, "Prepare");
     return;
   }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "Prepare");
+    ArpackError(ArpackError::CANNOT_PREPARE, "Prepare");
+    return;
+  }
 
   Restart();
 
@@ -768,26 +984,42 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
   info      = other.info;
   mode      = other.mode;
   nconv     = other.nconv;
+  stats     = other.stats;
+  profiler  = other.profiler;
+  tstep     = other.tstep;
+  tfact     = other.tfact;
+  allocator = other.allocator;
 
   // Copying arrays with static dimension.
 
   for (i=0; i<12; i++) iparam[i] = other.iparam[i];
   for (i=0; i<15; i++) ipntr[i]  = other.ipntr[i];
 
+  // Copying the vectors kept from previous problems.
+
+  ClearSeed();
+  warm      = other.warm;
+  nseed     = other.nseed;
+  seedn     = other.seedn;
+  if (nseed > 0) {
+    seedV   = new ARTYPE[seedn*nseed];
+    copy(seedn*nseed,other.seedV,1,seedV,1);
+  }
+
   // Returning from here if "other" was not initialized.
 
   if (!PrepareOK) return;
 
   // Copying dynamic variables.
 
-  workd     = new ARTYPE[3*n+1];       // workd.
+  NewArray(workd, 3*n+1, ARAllocator::WORKSPACE);      // workd.
   copy(3*n+1,other.workd,1,workd,1);
 
-  V         = new ARTYPE[n*ncv+1];     // V.
+  NewArray(V, n*ncv+1, ARAllocator::BASIS);            // V.
   copy(n*ncv+1,other.V,1,V,1);
 
   if (newRes) {                        // resid.
-    resid   = new ARTYPE[n];
+    NewArray(resid, n, ARAllocator::VECTOR);
     copy(n,other.resid,1,resid,1);
   }
   else {
@@ -795,7 +1027,7 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
   }
 
   if (newVec) {                        // EigVec.
-    EigVec  = new ARTYPE[ValSize()*n];
+    NewArray(EigVec, ValSize()*n, ARAllocator::VECTOR);
     copy(ValSize()*n,other.EigVec,1,EigVec,1);
   }
   else if (other.EigVec == (&other.V[1])) {
@@ -806,10 +1038,10 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
   }
 
   if (newVal) {                        // EigValR and EigValI.
-    EigValR = new ARTYPE[ValSize()];
+    NewArray(EigValR, ValSize(), ARAllocator::VECTOR);
     copy(ValSize(),other.EigValR,1,EigValR,1);
     if (other.EigValI != NULL) {
-      EigValI = new ARFLOAT[ValSize()];
+      NewArray(EigValI, ValSize(), ARAllocator::VECTOR);
       copy(ValSize(),other.EigValI,1,EigValI,1);
     }
     else {
@@ -836,9 +1068,11 @@ DefineParameters(int np, int nevp, const std::string& whichp, int ncvp,
 
 {
 
-  // Providing a "new" handler.
+  // Deleting the arrays of a previously defined problem (resid and
+  // the output arrays would be lost by ClearFirst).
 
-  std::set_new_handler ( MemoryOverflow );
+  if (warm) SaveSubspace();
+  ClearMem();
 
   // Setting user defined parameters.
 
@@ -868,6 +1102,98 @@ DefineParameters(int np, int nevp, const std::string& whichp, int ncvp,
 } // DefineParameters.
 
 
+template<class ARFLOAT, class ARTYPE>
+void ARrcStdEig<ARFLOAT, ARTYPE>::SetAllocator(ARAllocator* allocatorp)
+{
+
+  // Recreating working arrays with the new allocator.
+
+  if (allocatorp == allocator) return;
+  if (PrepareOK) {
+    ClearMem();
+    allocator = allocatorp;
+    Prepare();
+  }
+  else {
+    allocator = allocatorp;
+  }
+
+} // SetAllocator.
+
+
+template<class ARFLOAT, class ARTYPE>
+int ARrcStdEig<ARFLOAT, ARTYPE>::SaveSubspace()
+{
+
+  // Choosing the vectors to be kept.
+
+  ARTYPE* vec;
+
+  if (VectorsOK && (EigVec != NULL)) {
+    vec = EigVec;
+  }
+  else if (SchurOK && (V != NULL)) {
+    vec = &V[1];
+  }
+  else {
+    return 0;
+  }
+  if (nconv < 1) return 0;
+
+  // Copying nconv vectors.
+
+  ClearSeed();
+  seedV = new ARTYPE[n*nconv];
+  copy(n*nconv, vec, 1, seedV, 1);
+  seedn = n;
+  nseed = nconv;
+  return nseed;
+
+} // SaveSubspace.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARrcStdEig<ARFLOAT, ARTYPE>::Recycle()
+{
+
+  SaveSubspace();
+  Restart();
+
+} // Recycle.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARrcStdEig<ARFLOAT, ARTYPE>::SetSubspace(int k, ARTYPE* X)
+{
+
+  bool warmp;
+
+  // Copying the k vectors supplied by the user.
+
+  if ((k < 0) || ((k > 0) && (X == NULL))) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "SetSubspace");
+  }
+  ClearSeed();
+  if (k > 0) {
+    seedV = new ARTYPE[n*k];
+    copy(n*k, X, 1, seedV, 1);
+    seedn = n;
+    nseed = k;
+  }
+
+  // Restarting the solver without saving the vectors of the current
+  // problem over the new ones.
+
+  if (PrepareOK) {
+    warmp = warm;
+    warm  = false;
+    Restart();
+    warm  = warmp;
+  }
+
+} // SetSubspace.
+
+
 template<class ARFLOAT, class ARTYPE>
 int ARrcStdEig<ARFLOAT, ARTYPE>::GetIter()
 {
@@ -1025,6 +1351,8 @@ template<class ARFLOAT, class ARTYPE>
 int ARrcStdEig<ARFLOAT, ARTYPE>::TakeStep()
 {
 
+  double t0;
+
   // Requiring the definition of all internal variables.
 
   if (!PrepareOK) {
@@ -1034,14 +1362,37 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::TakeStep()
   }
   else if (!BasisOK) {
 
+    // Charging the time elapsed since the last step to the user.
+
+    if ((ido == -1) || (ido == 1) || (ido == 2)) StopEvent(ARStats::USER, tstep);
+
     // Taking a step if the Arnoldi basis is not available.
 
+    t0 = StartEvent(ARStats::AUPP);
     Aupp();
+    StopEvent(ARStats::AUPP, t0);
+    stats.nsteps++;
+
+    // Counting the products requested by Aupp.
+
+    switch (ido) {
+    case -1:
+      if ((bmat == 'G') && (mode != 2)) stats.nbx++;
+      // Fall through.
+    case  1:
+      stats.nopx++;
+      tstep = StartEvent(ARStats::USER);
+      break;
+    case  2:
+      stats.nbx++;
+      tstep = StartEvent(ARStats::USER);
+    }
 
     // Checking if convergence was obtained.
 
     if (ido==99) {
       nconv = iparam[5];
+      stats.nrestart += iparam[3];
       AuppError();
       if (info >= 0) BasisOK = true;
     }
@@ -1068,6 +1419,8 @@ template<class ARFLOAT, class ARTYPE>
 int ARrcStdEig<ARFLOAT, ARTYPE>::FindEigenvalues()
 {
 
+  double t0;
+
   // Determining eigenvalues if they are not available.
 
   if (!ValuesOK) {
@@ -1076,7 +1429,9 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::FindEigenvalues()
       nconv = FindArnoldiBasis();
       rvec  = false;
       if (nconv>0) {
+        t0 = StartEvent(ARStats::EUPP);
         Eupp();
+        StopEvent(ARStats::EUPP, t0);
         EuppError();
       }
     }
@@ -1084,6 +1439,11 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::FindEigenvalues()
       ArpackError(ArpackError::CANNOT_FIND_VALUES, "FindEigenvalues");
       return 0;
     }
+    catch (const std::bad_alloc&) { // Memory is not sufficient.
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "FindEigenvalues");
+      ArpackError(ArpackError::CANNOT_FIND_VALUES, "FindEigenvalues");
+      return 0;
+    }
     if (newVal) ValuesOK = true;
   }
   return nconv;
@@ -1095,6 +1455,8 @@ template<class ARFLOAT, class ARTYPE>
 int ARrcStdEig<ARFLOAT, ARTYPE>::FindEigenvectors(bool schurp)
 {
 
+  double t0;
+
   // Determining eigenvectors if they are not available.
 
   if (!VectorsOK) {
@@ -1105,7 +1467,9 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::FindEigenvectors(bool schurp)
       rvec  = true;
       HowMny = 'A';
       if (nconv>0) {
+        t0 = StartEvent(ARStats::EUPP);
         Eupp();
+        StopEvent(ARStats::EUPP, t0);
         EuppError();
       }
     }
@@ -1113,6 +1477,11 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::FindEigenvectors(bool schurp)
       ArpackError(ArpackError::CANNOT_FIND_VECTORS, "FindEigenvectors");
       return 0;
     }
+    catch (const std::bad_alloc&) { // Memory is not sufficient.
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "FindEigenvectors");
+      ArpackError(ArpackError::CANNOT_FIND_VECTORS, "FindEigenvectors");
+      return 0;
+    }
     BasisOK = false;
     if (newVal) ValuesOK = true;
     if (newVec || OverV()) VectorsOK = true;
@@ -1127,6 +1496,8 @@ template<class ARFLOAT, class ARTYPE>
 int ARrcStdEig<ARFLOAT, ARTYPE>::FindSchurVectors()
 {
 
+  double t0;
+
   // Determining Schur vectors if they are not available.
 
   if (!SchurOK) {
@@ -1136,7 +1507,9 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::FindSchurVectors()
       rvec   = true;
       HowMny = 'P';
       if (nconv>0) {
+        t0 = StartEvent(ARStats::EUPP);
         Eupp();
+        StopEvent(ARStats::EUPP, t0);
         EuppError();
       }
     }
@@ -1144,6 +1517,11 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::FindSchurVectors()
       ArpackError(ArpackError::CANNOT_FIND_SCHUR, "FindSchurVectors");
       return 0;
     }
+    catch (const std::bad_alloc&) { // Memory is not sufficient.
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "FindSchurVectors");
+      ArpackError(ArpackError::CANNOT_FIND_SCHUR, "FindSchurVectors");
+      return 0;
+    }
     BasisOK = false;
     if (newVal) ValuesOK = true;
     SchurOK =true;
@@ -1161,7 +1539,8 @@ Eigenvectors(ARTYPE* &EigVecp, bool ischur)
   // Overriding EigVecp with the converged eigenvectors.
 
   if (VectorsOK) {                       // Eigenvectors are available.
-    if ((EigVecp == NULL) && (newVec)) { // Moving eigenvectors.
+    if ((EigVecp == NULL) && (newVec) && (allocator == NULL)) {
+                                         // Moving eigenvectors.
       EigVecp   = EigVec;
       EigVec    = NULL;
       newVec    = false;
@@ -1171,18 +1550,26 @@ Eigenvectors(ARTYPE* &EigVecp, bool ischur)
       if (EigVecp == NULL) {
         try { EigVecp = new ARTYPE[ValSize()*n]; }
         catch (ArpackError) { return 0; }
+        catch (const std::bad_alloc&) {
+          ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvectors");
+          return 0;
+        }
       }
       copy(ValSize()*n,EigVec,1,EigVecp,1);
     }
   }
   else {                                // Eigenvectors are not available.
     if (newVec) {
-      delete[] EigVec;
+      DeleteArray(EigVec);
       newVec = false;
     }
     if (EigVecp == NULL) {
       try { EigVecp = new ARTYPE[ValSize()*n]; }
       catch (ArpackError) { return 0; }
+      catch (const std::bad_alloc&) {
+        ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvectors");
+        return 0;
+      }
     }
     EigVec = EigVecp;
     nconv  = FindEigenvectors(ischur);
@@ -1193,6 +1580,25 @@ Eigenvectors(ARTYPE* &EigVecp, bool ischur)
 } // Eigenvectors(EigVecp, ischur).
 
 
+template<class ARFLOAT, class ARTYPE>
+int ARrcStdEig<ARFLOAT, ARTYPE>::
+CopyEigenvectors(ARTYPE* dest, int ld, bool rowmajor, bool ischur)
+{
+
+  // Determining eigenvectors if they are not available.
+
+  if (!VectorsOK) FindEigenvectors(ischur);
+  if (!VectorsOK) return 0;
+
+  // Copying nconv vectors to dest.
+
+  if (ld <= 0) ld = rowmajor ? nconv : n;
+  ARCopyBlock(n, nconv, EigVec, n, dest, ld, rowmajor);
+  return nconv;
+
+} // CopyEigenvectors.
+
+
 template<class ARFLOAT, class ARTYPE>
 inline ARTYPE ARrcStdEig<ARFLOAT, ARTYPE>::ArnoldiBasisVector(int i, int j)
 {
@@ -1357,6 +1763,42 @@ inline ARTYPE* ARrcStdEig<ARFLOAT, ARTYPE>::RawResidualVector()
 } // RawResidualVector.
 
 
+template<class ARFLOAT, class ARTYPE>
+inline ARView<ARTYPE> ARrcStdEig<ARFLOAT, ARTYPE>::ArnoldiBasisView()
+{
+
+  if (!BasisOK) {
+    throw ArpackError(ArpackError::BASIS_NOT_OK, "ArnoldiBasisView");
+  }
+  return ARView<ARTYPE>(&V[1], n, ncv, n);
+
+} // ArnoldiBasisView.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline ARView<ARTYPE> ARrcStdEig<ARFLOAT, ARTYPE>::EigenvectorView()
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "EigenvectorView");
+  }
+  return ARView<ARTYPE>(EigVec, n, nconv, n);
+
+} // EigenvectorView.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline ARView<ARTYPE> ARrcStdEig<ARFLOAT, ARTYPE>::SchurVectorView()
+{
+
+  if (!SchurOK) {
+    throw ArpackError(ArpackError::SCHUR_NOT_OK, "SchurVectorView");
+  }
+  return ARView<ARTYPE>(&V[1], n, nev, n);
+
+} // SchurVectorView.
+
+
 #ifdef STL_VECTOR_H // Defining some functions that use STL vector class.
 
 template<class ARFLOAT, class ARTYPE>
@@ -1374,6 +1816,10 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT, ARTYPE>::StlArnoldiBasisVectors()
     StlBasis = new vector<ARTYPE>(&V[1], &V[n*ncv+1]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlArnoldiBasisVectors");
+    return NULL;
+  }
   return StlBasis;
 
 } // StlArnoldiBasisVectors.
@@ -1397,6 +1843,10 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT,ARTYPE>::StlArnoldiBasisVector(int i)
     StlBasis = new vector<ARTYPE>(&V[i*n+1], &V[(i+1)*n+1]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlArnoldiBasisVector");
+    return NULL;
+  }
   return StlBasis;
 
 } // StlArnoldiBasisVector(i).
@@ -1413,6 +1863,10 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT,ARTYPE>::StlEigenvectors(bool ischur)
 
   try { StlEigVec = new vector<ARTYPE>(ValSize()*n); }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvectors");
+    return NULL;
+  }
   VecPtr = StlEigVec->begin();
   nconv  = Eigenvectors(VecPtr, ischur);
   return StlEigVec;
@@ -1433,6 +1887,10 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT, ARTYPE>::StlSchurVectors()
     StlSchurVec = new vector<ARTYPE>(&V[1], &V[nev*n+1]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlSchurVectors");
+    return NULL;
+  }
   return StlSchurVec;
 
 } // StlSchurVectors.
@@ -1456,6 +1914,10 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT, ARTYPE>::StlSchurVector(int i)
     StlSchurVec = new vector<ARTYPE>(&V[i*n+1], &V[(i+1)*n+1]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlSchurVector");
+    return NULL;
+  }
   return StlSchurVec;
 
 } // StlSchurVector(i).
@@ -1476,6 +1938,10 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT, ARTYPE>::StlResidualVector()
     StlResid = new vector<ARTYPE>(resid, &resid[n]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlResidualVector");
+    return NULL;
+  }
   return StlResid;
 
 } // StlResidualVector.
@@ -1497,6 +1963,14 @@ inline ARrcStdEig<ARFLOAT, ARTYPE>::ARrcStdEig()
   EigValI = NULL;
   EigVec  = NULL;
   bmat    = 'I';   // This is a standard problem.
+  profiler = NULL;
+  allocator = NULL;
+  warm    = false;
+  nseed   = 0;
+  seedn   = 0;
+  seedV   = NULL;
+  tstep   = 0.0;
+  tfact   = 0.0;
   ClearFirst();
   NoShift();
   NoTrace();
@@ -1511,6 +1985,7 @@ operator=(const ARrcStdEig<ARFLOAT, ARTYPE>& other)
 
   if (this != &other) { // Stroustrup suggestion.
     ClearMem();
+    ClearSeed();
     Copy(other);
   }
   return *this;
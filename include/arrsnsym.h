@@ -18,6 +18,7 @@
 #define ARRSNSYM_H
 
 #include <cstddef>
+#include <new>
 
 #include "arch.h"
 #include "arerror.h"
@@ -126,6 +127,20 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // given eigen-problem. Also stores the eigenvalues in EigValRp and
   // EigValIp. Calculates Schur vectors if requested.
 
+#ifdef ARCOMP_H
+  int ComplexEigenvalues(arcomplex<ARFLOAT>* dest, bool ivec = false,
+                         bool ischur = false);
+  // Stores the converged eigenvalues in the caller-owned array dest.
+  // Calculates eigenvectors and Schur vectors if requested.
+
+  int ComplexEigenvectors(arcomplex<ARFLOAT>* dest, int ld = 0,
+                          bool rowmajor = false);
+  // Stores the converged eigenvectors (in complex form) in the
+  // caller-owned array dest, element i of eigenvector j being stored
+  // in dest[i+j*ld] (or in dest[i*ld+j] if rowmajor is true). ld = 0
+  // means n (or nconv if rowmajor is true).
+#endif // ARCOMP_H.
+
 
  // b.4) Functions that return elements of vectors and matrices.
 
@@ -228,8 +243,8 @@ inline void ARrcNonSymStdEig<ARFLOAT>::ValAllocate()
 {
 
   if (this->EigValR == NULL) {
-    this->EigValR = new ARFLOAT[ValSize()];
-    this->EigValI = new ARFLOAT[ValSize()];
+    this->NewArray(this->EigValR, ValSize(), ARAllocator::VECTOR);
+    this->NewArray(this->EigValI, ValSize(), ARAllocator::VECTOR);
     this->newVal = true;
   }
 
@@ -243,8 +258,8 @@ inline void ARrcNonSymStdEig<ARFLOAT>::WorkspaceAllocate()
   this->lworkl  = 3*this->ncv*(this->ncv+2);
   this->lworkv  = 3*this->ncv;
   this->lrwork  = 0;
-  this->workl   = new ARFLOAT[this->lworkl+1];
-  this->workv   = new ARFLOAT[this->lworkv+1];
+  this->NewArray(this->workl, this->lworkl+1, ARAllocator::WORKSPACE);
+  this->NewArray(this->workv, this->lworkv+1, ARAllocator::WORKSPACE);
 
 } // WorkspaceAllocate.
 
@@ -314,6 +329,10 @@ GenComplex(vector<ARFLOAT>* RealPart, vector<ARFLOAT>* ImagPart, bool conj)
     Result = new vector<arcomplex<ARFLOAT> >(ValSize());
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "GenComplex ");
+    return NULL;
+  }
   ARFLOAT* rp  = RealPart->begin();
   ARFLOAT* ip  = ImagPart->begin();
   ARFLOAT* end = RealPart->end();
@@ -345,6 +364,10 @@ GenComplex(int dim, ARFLOAT* RealPart, ARFLOAT* ImagPart, bool conj)
     Result = new vector<arcomplex<ARFLOAT> >(dim);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "GenComplex ");
+    return NULL;
+  }
   ARFLOAT* rp  = RealPart; 
   ARFLOAT* ip  = ImagPart; 
   ARFLOAT* end = &RealPart[dim];
@@ -376,6 +399,10 @@ GenComplex(int dim, ARFLOAT* RealPart)
     Result = new vector<arcomplex<ARFLOAT> >(dim);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "GenComplex");
+    return NULL;
+  }
   ARFLOAT* rp  = RealPart; 
   ARFLOAT* end = &RealPart[dim];
   arcomplex<ARFLOAT>* s = Result->begin();
@@ -410,7 +437,8 @@ Eigenvalues(ARFLOAT* &EigValRp, ARFLOAT* &EigValIp, bool ivec, bool ischur)
 {
 
   if (this->ValuesOK) {                                 // Eigenvalues are available.
-    if ((EigValRp == NULL)&&(EigValIp == NULL)) { // Moving eigenvalues.
+    if ((EigValRp == NULL)&&(EigValIp == NULL)&&(this->allocator == NULL)) {
+                                                  // Moving eigenvalues.
       EigValRp = this->EigValR;
       EigValIp = this->EigValI;
       this->EigValR  = NULL;
@@ -424,14 +452,18 @@ Eigenvalues(ARFLOAT* &EigValRp, ARFLOAT* &EigValIp, bool ivec, bool ischur)
         if (EigValIp == NULL) EigValIp = new ARFLOAT[ValSize()];
       }
       catch (ArpackError) { return 0; }
+      catch (const std::bad_alloc&) {
+        ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvalues");
+        return 0;
+      }
       copy(this->nconv,this->EigValR,1,EigValRp,1);
       copy(this->nconv,this->EigValI,1,EigValIp,1);
     }
   }
   else {
     if (this->newVal) {
-      delete[] this->EigValR;
-      delete[] this->EigValI;
+      this->DeleteArray(this->EigValR);
+      this->DeleteArray(this->EigValI);
       this->newVal = false;
     }
     try {
@@ -439,6 +471,10 @@ Eigenvalues(ARFLOAT* &EigValRp, ARFLOAT* &EigValIp, bool ivec, bool ischur)
       if (EigValIp == NULL) EigValIp = new ARFLOAT[ValSize()];
     }
     catch (ArpackError) { return 0; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvalues");
+      return 0;
+    }
     this->EigValR = EigValRp;
     this->EigValI = EigValIp;
     if (ivec) {                              // Finding eigenvalues and vectors.
@@ -467,12 +503,12 @@ EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValRp,
   }
   else {                        // Eigenvalues ans vectors are not available.
     if (this->newVec) {
-      delete[] this->EigVec;
+      this->DeleteArray(this->EigVec);
       this->newVec = false;
     }
     if (this->newVal) {
-      delete[] this->EigValR;
-      delete[] this->EigValI;
+      this->DeleteArray(this->EigValR);
+      this->DeleteArray(this->EigValI);
       this->newVal = false;
     }
     try {
@@ -481,6 +517,10 @@ EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValRp,
       if (EigValIp == NULL) EigValIp = new ARFLOAT[ValSize()];
     }
     catch (ArpackError) { return 0; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "EigenValVectors");
+      return 0;
+    }
     this->EigVec  = EigVecp;
     this->EigValR = EigValRp;
     this->EigValI = EigValIp;
@@ -494,6 +534,83 @@ EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValRp,
 } // EigenValVectors(EigVecp, EigValRp, EigValIp, ischur).
 
 
+#ifdef ARCOMP_H
+template<class ARFLOAT>
+int ARrcNonSymStdEig<ARFLOAT>::
+ComplexEigenvalues(arcomplex<ARFLOAT>* dest, bool ivec, bool ischur)
+{
+
+  int i;
+
+  // Determining eigenvalues if they are not available.
+
+  if (ivec) {
+    this->FindEigenvectors(ischur);
+  }
+  else if (!this->ValuesOK) {
+    this->FindEigenvalues();
+  }
+  if (!this->ValuesOK) return 0;
+
+  // Copying eigenvalues to dest.
+
+  for (i=0; i<this->nconv; i++) {
+    dest[i] = arcomplex<ARFLOAT>(this->EigValR[i], this->EigValI[i]);
+  }
+  return this->nconv;
+
+} // ComplexEigenvalues(dest, ivec, ischur).
+
+
+template<class ARFLOAT>
+int ARrcNonSymStdEig<ARFLOAT>::
+ComplexEigenvectors(arcomplex<ARFLOAT>* dest, int ld, bool rowmajor)
+{
+
+  int      i, j, n;
+  size_t   step, pos;
+  ARFLOAT  sign;
+  ARFLOAT* re;
+  ARFLOAT* im;
+
+  // Determining eigenvectors if they are not available.
+
+  if (!this->VectorsOK) this->FindEigenvectors();
+  if ((!this->VectorsOK) || (!this->ValuesOK)) return 0;
+
+  // Copying eigenvectors to dest. A complex conjugate pair of
+  // eigenvectors is stored by ARPACK in two consecutive columns
+  // (the real and the imaginary part of the first vector).
+
+  n = this->n;
+  if (ld <= 0) ld = rowmajor ? this->nconv : n;
+  step = rowmajor ? size_t(ld) : 1;
+  for (j=0; j<this->nconv; j++) {
+    sign = (ARFLOAT)1.0;
+    if (this->EigValI[j] == (ARFLOAT)0.0) {   // Real eigenvector.
+      re = &this->EigVec[size_t(j)*n];
+      im = NULL;
+    }
+    else if (!ConjEigVec(j)) {                // First vector of a pair.
+      re = &this->EigVec[size_t(j)*n];
+      im = &this->EigVec[size_t(j+1)*n];
+    }
+    else {                                    // Second vector of a pair.
+      re = &this->EigVec[size_t(j-1)*n];
+      im = &this->EigVec[size_t(j)*n];
+      sign = (ARFLOAT)-1.0;
+    }
+    pos = rowmajor ? size_t(j) : size_t(j)*size_t(ld);
+    for (i=0; i<n; i++, pos+=step) {
+      dest[pos] = arcomplex<ARFLOAT>(re[i], (im == NULL) ? 0 : sign*im[i]);
+    }
+  }
+  return this->nconv;
+
+} // ComplexEigenvectors(dest, ld, rowmajor).
+#endif // ARCOMP_H.
+
+
 #ifdef ARCOMP_H
 template<class ARFLOAT>
 inline arcomplex<ARFLOAT> ARrcNonSymStdEig<ARFLOAT>::Eigenvalue(int i)
@@ -655,6 +772,10 @@ StlEigenvalues(bool ivec, bool ischur)
     StlEigValI = new vector<ARFLOAT>(ValSize());
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvalues");
+    return NULL;
+  }
 
   // Finding Eigenvalues.
 
@@ -689,6 +810,10 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvaluesReal()
     StlEigValR = new vector<ARFLOAT>(EigValR, &EigValR[ValSize()]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvaluesReal");
+    return NULL;
+  }
   return StlEigValR;
 
 } // StlEigenvaluesReal.
@@ -709,6 +834,10 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvaluesImag()
     StlEigValI = new vector<ARFLOAT>(EigValI, &EigValI[ValSize()]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvaluesImag");
+    return NULL;
+  }
   return StlEigValI;
 
 } // StlEigenvaluesImag.
@@ -761,6 +890,10 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvectorReal(int i)
       Vec = new vector<ARFLOAT>(&EigVec[i*n], &EigVec[(i+1)*n]);
     }
     catch (ArpackError) { return NULL; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvectorReal");
+      return NULL;
+    }
     return Vec;
   }
   else {                // Second eigenvector in a conjugate pair.
@@ -768,6 +901,10 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvectorReal(int i)
       Vec = new vector<ARFLOAT>(&EigVec[(i-1)*n], &EigVec[i*n]);
     }
     catch (ArpackError) { return NULL; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvectorReal");
+      return NULL;
+    }
     return Vec;
   }
 
@@ -793,6 +930,10 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvectorImag(int i)
       Vec = new vector<ARFLOAT>(ValSize(), (ARFLOAT)0.0);
     }
     catch (ArpackError) { return NULL; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvectorImag");
+      return NULL;
+    }
     return Vec;
   }
   else if (!ConjEigVec(i)) {      // First eigenvector in a conjugate pair.
@@ -800,6 +941,10 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvectorImag(int i)
       Vec = new vector<ARFLOAT>(&EigVec[(i+1)*n], &EigVec[(i+2)*n]);
     }
     catch (ArpackError) { return NULL; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvectorImag");
+      return NULL;
+    }
     return Vec;
   }
   else {                          // Second eigenvector in a conjugate pair.
@@ -807,6 +952,10 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvectorImag(int i)
       Vec = new vector<ARFLOAT>(&EigVec[i*n], &EigVec[(i+1)*n]);
     }
     catch (ArpackError) { return NULL; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvectorImag");
+      return NULL;
+    }
     for (ARFLOAT* s = Vec->begin(); s != Vec->end(); s++) *s = -(*s);
     return Vec;
   }
@@ -18,6 +18,7 @@
 #define ARRSSYM_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "arerror.h"
@@ -161,7 +162,7 @@ inline void ARrcSymStdEig<ARFLOAT>::WorkspaceAllocate()
   this->lworkl  = this->ncv*(this->ncv+9);
   this->lworkv  = 0;
   this->lrwork  = 0;
-  this->workl   = new ARFLOAT[this->lworkl+1];
+  this->NewArray(this->workl, this->lworkl+1, ARAllocator::WORKSPACE);
 
 } // WorkspaceAllocate.
 
@@ -232,24 +233,37 @@ Eigenvalues(ARFLOAT* &EigValp, bool ivec, bool ischur)
 {
 
   if (this->ValuesOK) {                      // Eigenvalues are available.
-    if (EigValp == NULL) {             // Moving eigenvalues.
+    if ((EigValp == NULL) && (this->allocator == NULL)) {
+                                       // Moving eigenvalues.
       EigValp  = this->EigValR;
       this->EigValR  = NULL;
       this->newVal   = false;
       this->ValuesOK = false;
     }
     else {                             // Copying eigenvalues.
+      if (EigValp == NULL) {
+        try { EigValp = new ARFLOAT[this->ValSize()]; }
+        catch (const ArpackError&) { return 0; }
+        catch (const std::bad_alloc&) {
+          ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvalues");
+          return 0;
+        }
+      }
       copy(this->nconv,this->EigValR,1,EigValp,1);
     }
   }
   else {                               // Eigenvalues are not available.
     if (this->newVal) {
-      delete[] this->EigValR;
+      this->DeleteArray(this->EigValR);
       this->newVal = false;
     }
     if (EigValp == NULL) {
       try { EigValp = new ARFLOAT[this->ValSize()]; }
       catch (ArpackError) { return 0; }
+      catch (const std::bad_alloc&) {
+        ArpackError(ArpackError::MEMORY_OVERFLOW, "Eigenvalues");
+        return 0;
+      }
     }
     this->EigValR = EigValp;
     if (ivec) {                        // Finding eigenvalues and eigenvectors.
@@ -280,12 +294,16 @@ EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValp, bool ischur)
       if (EigValp == NULL) EigValp = new ARFLOAT[this->ValSize()];
     }
     catch (ArpackError) { return 0; }
+    catch (const std::bad_alloc&) {
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "EigenValVectors");
+      return 0;
+    }
     if (this->newVec) {
-      delete[] this->EigVec;
+      this->DeleteArray(this->EigVec);
       this->newVec = false;
     }
     if (this->newVal) {
-      delete[] this->EigValR;
+      this->DeleteArray(this->EigValR);
       this->newVal = false;
     }
     this->EigVec  = EigVecp;
@@ -347,6 +365,10 @@ StlEigenvalues(bool ivec, bool ischur)
 
   try { StlEigValR = new vector<ARFLOAT>(ValSize()); }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvalues");
+    return NULL;
+  }
   ValPtr = StlEigValR->begin();
   nconv = Eigenvalues(ValPtr, ivec, ischur);
   return StlEigValR;
@@ -372,6 +394,10 @@ inline vector<ARFLOAT>* ARrcSymStdEig<ARFLOAT>::StlEigenvector(int i)
     Vec = new vector<ARFLOAT>(&EigVec[i*n], &EigVec[(i+1)*n]);
   }
   catch (ArpackError) { return NULL; }
+  catch (const std::bad_alloc&) {
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "StlEigenvector");
+    return NULL;
+  }
   return Vec;
 
 } // StlEigenvector(i).
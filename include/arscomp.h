@@ -22,15 +22,28 @@
 #include "arch.h"
 #include "arseig.h"
 #include "arrscomp.h"
+#include "arkscomp.h"
 
 template<class ARFLOAT, class ARFOP>
 class ARCompStdEig:
   virtual public ARStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFOP>,
   virtual public ARrcCompStdEig<ARFLOAT> {
 
+ protected:
+
+ // a) Protected functions:
+
+  typename ARStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFOP>::TypeEngine*
+    NewEngine();
+  // Creates an ARbkCompStdEig object.
+
+  void Eupp();
+  // Calls the Krylov-Schur engine, or CNEUPD and ZNEUPD.
+
+
  public:
 
- // a) Constructors and destructor.
+ // b) Constructors and destructor.
 
   ARCompStdEig() { }
   // Short constructor.
@@ -55,7 +68,7 @@ class ARCompStdEig:
   virtual ~ARCompStdEig() { }
   // Destructor.
 
- // b) Operators.
+ // c) Operators.
 
   ARCompStdEig& operator=(const ARCompStdEig& other);
   // Assignment operator.
@@ -68,6 +81,31 @@ class ARCompStdEig:
 // ------------------------------------------------------------------------ //
 
 
+template<class ARFLOAT, class ARFOP>
+inline typename ARStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFOP>::TypeEngine*
+ARCompStdEig<ARFLOAT, ARFOP>::NewEngine()
+{
+
+  return new ARbkCompStdEig<ARFLOAT,
+                            ARStdEig<ARFLOAT, arcomplex<ARFLOAT>, ARFOP> >;
+
+} // NewEngine.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARCompStdEig<ARFLOAT, ARFOP>::Eupp()
+{
+
+  if (this->EngineOK()) {
+    this->EngineEupp();
+  }
+  else {
+    ARrcCompStdEig<ARFLOAT>::Eupp();
+  }
+
+} // Eupp.
+
+
 template<class ARFLOAT, class ARFOP>
 inline ARCompStdEig<ARFLOAT, ARFOP>::
 ARCompStdEig(int np, int nevp, ARFOP* objOPp,
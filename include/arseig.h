@@ -20,9 +20,11 @@
 #define ARSEIG_H
 
 #include <cstddef>
+#include <new>
 #include "arch.h"
 #include "arerror.h"
 #include "arrseig.h"
+#include "arkseig.h"
 
 // ARStdEig class definition.
 
@@ -35,6 +37,10 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
 
   typedef void (ARFOP::* TypeOPx)(ARTYPE[], ARTYPE[]);
 
+  typedef void (ARFOP::* TypeOPX)(ARTYPE[], ARTYPE[], int);
+
+  typedef ARbkStdEig<ARFLOAT, ARTYPE, ARStdEig> TypeEngine;
+
 
  protected:
 
@@ -42,20 +48,54 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
 
   ARFOP   *objOP;     // Object that has MultOPx as a member function.
   TypeOPx MultOPx;    // Function that evaluates the product OP*x.
+  TypeOPX BlockOPX;   // Function that evaluates OP*X by blocks (or NULL).
+
+ // c) Krylov-Schur engine.
 
- // c) Protected functions.
+  bool       kschur;  // Indicates if the Krylov-Schur engine is used.
+  int        ksnb;    // Block size used by the engine (0 = default).
+  TypeEngine *engine; // Engine that found the last basis (or NULL).
+
+ // d) Protected functions.
 
   virtual void Copy(const ARStdEig& other);
   // Makes a deep copy of "other" over "this" object.
   // Old values are not deleted (this function is to be used
   // by the copy constructor and the assignment operator only).
 
+  virtual TypeEngine* NewEngine() {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "NewEngine");
+    return NULL;
+  }
+  // Creates a block Krylov-Schur solver of the same kind as this one.
+  // Redefined in ARSymStdEig, ARNonSymStdEig and ARCompStdEig.
+
+  void ClearEngine();
+  // Deletes the engine.
+
+  void MultOPX(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Performs Y <- OP*X with BlockOPX or, if it was not defined, one
+  // column at a time with MultOPx, so the engine can use the operator
+  // supplied by the user.
+
+  int EngineBasis();
+  // Finds the basis with the engine. V and resid are shared with the
+  // engine when possible, so the Ritz (or Schur) vectors it computes
+  // are stored in V.
+
+  void EngineEupp();
+  // Computes eigenvalues and eigenvectors from the basis found by the
+  // engine (used by Eupp in the derived classes).
+
+  bool EngineOK() { return kschur && (engine != NULL); }
+  // Indicates if the last basis was found by the engine.
+
 
  public:
 
- // d) Public functions:
+ // e) Public functions:
 
- // d.1) Function that stores user defined parameters.
+ // e.1) Function that stores user defined parameters.
 
   virtual void DefineParameters(int np, int nevp, ARFOP* objOPp,
                                 TypeOPx MultOPxp, const std::string& whichp="LM",
@@ -64,11 +104,19 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
   // Set values of problem parameters (also called by constructors).
   // Redefined in ARGenEigenProblem.
 
- // d.2) Function that allow changes in problem parameters.
+ // e.2) Function that allow changes in problem parameters.
 
   void ChangeMultOPx(ARFOP* objOPp, TypeOPx MultOPxp);
   // Changes the matrix-vector function that performs OP*x.
 
+  void ChangeBlockOPX(TypeOPX BlockOPXp);
+  // Defines a member function of objOP that performs Y <- OP*X for a
+  // block of nvec vectors (stored by columns) with the same operator
+  // as MultOPx. The Krylov-Schur engine calls it once per block instead
+  // of calling MultOPx once per vector. The ARlu classes use MultInvV
+  // in shift and invert mode, so the factors of OP are read once per
+  // block. BlockOPX is discarded when MultOPx is changed.
+
   virtual void SetRegularMode(ARFOP* objOPp, TypeOPx MultOPxp);
   // Turns problem to regular mode.
 
@@ -76,7 +124,28 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
                                   TypeOPx MultOPxp);
   // Turns problem to shift and invert mode with shift defined by sigmap.
 
- // d.3) Function that permits step by step execution of ARPACK.
+  void SetKrylovSchur(int nbp = 0);
+  // Makes FindArnoldiBasis use the block Krylov-Schur (thick restart
+  // Lanczos, for symmetric problems) engine of ARbkStdEig instead of
+  // the FORTRAN ARPACK routines. The engine orthogonalizes blocks of nbp
+  // vectors against V with level 3 BLAS (classical Gram-Schmidt with
+  // reorthogonalization) and updates V in parallel at each restart
+  // (when OpenMP is enabled). OP is still applied by MultOPx, one
+  // vector at a time. If nbp = 0, the block size is set to min(nev, 4).
+  // Only standard problems use the engine. It is used by default if
+  // ARKSBLOCK is defined as a non-negative number (see arch.h).
+  // Since the engine does not call ARPACK, problems that use it may be
+  // solved concurrently (one in each thread). The FORTRAN routines keep
+  // their state in static variables, so only one problem may call them
+  // at a time.
+
+  void SetArpack();
+  // Makes FindArnoldiBasis call the FORTRAN ARPACK routines (default).
+
+  bool KrylovSchur() { return kschur; }
+  // Indicates if the Krylov-Schur engine is used.
+
+ // e.3) Function that permits step by step execution of ARPACK.
 
   virtual void Iterate() {
     throw ArpackError(ArpackError::NOT_IMPLEMENTED, "Iterate");
@@ -84,25 +153,27 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
   // Takes one iteration of IRA method.
 
 
- // d.4) Function that performs all calculations in one step.
+ // e.4) Function that performs all calculations in one step.
 
   virtual int FindArnoldiBasis();
   // Determines the Arnoldi basis related to the given problem.
   // Redefined in ARGenEigenProblem and ARSymGenEigenProblem.
 
 
- // d.5) Constructor and destructor.
+ // e.5) Constructor and destructor.
 
-  ARStdEig() { }
+  ARStdEig()
+  { kschur = (ARKSBLOCK >= 0); ksnb = (ARKSBLOCK > 0) ? ARKSBLOCK : 0;
+    engine = NULL; BlockOPX = NULL; }
   // Constructor that does nothing but calling base class constructor.
 
-  ARStdEig(const ARStdEig& other) { Copy(other); }
+  ARStdEig(const ARStdEig& other) { engine = NULL; Copy(other); }
   // Copy constructor.
 
-  virtual ~ARStdEig() { }
+  virtual ~ARStdEig() { ClearEngine(); }
   // Very simple destructor.
 
- // e) Operators.
+ // f) Operators.
 
   ARStdEig& operator=(const ARStdEig& other);
   // Assignment operator.
@@ -121,12 +192,138 @@ Copy(const ARStdEig<ARFLOAT, ARTYPE, ARFOP>& other)
 {
 
   ARrcStdEig<ARFLOAT, ARTYPE>::Copy(other);
-  objOP   = other.objOP;
-  MultOPx = other.MultOPx;
+  objOP    = other.objOP;
+  MultOPx  = other.MultOPx;
+  BlockOPX = other.BlockOPX;
+  kschur   = other.kschur;
+  ksnb     = other.ksnb;
+
+  // The engine is not copied, so a basis found by it must be found again.
+
+  ClearEngine();
+  if (kschur) this->BasisOK = false;
 
 } // Copy.
 
 
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::ClearEngine()
+{
+
+  // V may belong to this object (resid is never deleted by the engine).
+
+  if (engine != NULL) {
+    if (engine->V == this->V) engine->V = NULL;
+    delete engine;
+    engine = NULL;
+  }
+
+} // ClearEngine.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::
+MultOPX(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  int j;
+
+  if (BlockOPX != NULL) {
+    (objOP->*BlockOPX)(X, Y, nvec);
+  }
+  else {
+    for (j=0; j<nvec; j++) {
+      (objOP->*MultOPx)(&X[j*this->n], &Y[j*this->n]);
+    }
+  }
+
+} // MultOPX.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+int ARStdEig<ARFLOAT, ARTYPE, ARFOP>::EngineBasis()
+{
+
+  // Creating a new engine with the parameters of this problem. resid
+  // is used as the starting vector if it was supplied by the user (or
+  // taken from the vectors kept by Recycle).
+
+  ClearEngine();
+  engine = NewEngine();
+  engine->profiler = this->profiler;
+  if (this->mode == 3) engine->ChangeShift(this->sigmaR);
+  engine->DefineParameters(this->n, this->nev, this, &ARStdEig::MultOPX,
+                           this->which, this->ncv, this->tol, this->maxit,
+                           (this->info != 0) ? this->resid : NULL, ksnb);
+  if (!engine->PrepareOK) {
+    throw ArpackError(ArpackError::PREPARE_NOT_OK, "FindArnoldiBasis");
+  }
+
+  // Sharing V, unless the engine needs more vectors than ncv (what may
+  // happen if nb > 1).
+
+  if (engine->ncv <= this->ncv) {
+    engine->DeleteArray(engine->V);
+    engine->V = this->V;
+  }
+
+  // Finding the basis and copying the results. engine->V is set to
+  // NULL if V is shared, so it is not affected if V is deleted later.
+
+  engine->stats = this->stats;
+  engine->FindArnoldiBasis();
+  this->stats = engine->stats;
+  if (engine->V == this->V) engine->V = NULL;
+
+  if (engine->resid != this->resid) {
+    copy(this->n, engine->resid, 1, this->resid, 1);
+  }
+  this->iparam[3] = engine->iparam[3];
+  this->iparam[4] = engine->iparam[4];
+  this->iparam[5] = engine->iparam[5];
+  this->iparam[9] = engine->iparam[9];
+  this->nconv     = engine->nconv;
+  this->BasisOK   = engine->BasisOK;
+  if (!this->BasisOK) {
+    throw ArpackError(ArpackError::CANNOT_FIND_BASIS, "FindArnoldiBasis");
+  }
+  return this->nconv;
+
+} // EngineBasis.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::EngineEupp()
+{
+
+  // Letting the engine store the results in the arrays of this object.
+
+  if (engine->V == NULL) engine->V = this->V;
+  engine->rvec    = this->rvec;
+  engine->HowMny  = this->HowMny;
+  engine->EigValR = this->EigValR;
+  engine->EigValI = this->EigValI;
+  engine->EigVec  = this->OverV() ? &engine->V[1] : this->EigVec;
+
+  engine->Eupp();
+  this->info = engine->info;
+
+  // Copying the vectors stored in V if V is not shared.
+
+  if (engine->V == this->V) {
+    engine->V = NULL;
+  }
+  else if (this->rvec) {
+    copy(this->n*this->nconv, &engine->V[1], 1, &this->V[1], 1);
+  }
+
+  engine->EigValR = NULL;
+  engine->EigValI = NULL;
+  engine->EigVec  = NULL;
+
+} // EngineEupp.
+
+
 template<class ARFLOAT, class ARTYPE, class ARFOP>
 void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::
 DefineParameters(int np, int nevp, ARFOP* objOPp,
@@ -141,6 +338,7 @@ DefineParameters(int np, int nevp, ARFOP* objOPp,
                                                 maxitp, residp, ishiftp);
   objOP     = objOPp;
   MultOPx   = MultOPxp;
+  BlockOPX  = NULL;
 
 } // DefineParameters.
 
@@ -150,13 +348,24 @@ inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::
 ChangeMultOPx(ARFOP* objOPp, void (ARFOP::* MultOPxp)(ARTYPE[], ARTYPE[]))
 {
 
-  objOP   = objOPp;
-  MultOPx = MultOPxp;
+  objOP    = objOPp;
+  MultOPx  = MultOPxp;
+  BlockOPX = NULL;
   this->Restart();
 
 } // ChangeMultOPx.
 
 
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::
+ChangeBlockOPX(void (ARFOP::* BlockOPXp)(ARTYPE[], ARTYPE[], int))
+{
+
+  BlockOPX = BlockOPXp;
+
+} // ChangeBlockOPX.
+
+
 template<class ARFLOAT, class ARTYPE, class ARFOP>
 inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::
 SetRegularMode(ARFOP* objOPp, void (ARFOP::* MultOPxp)(ARTYPE[], ARTYPE[]))
@@ -180,12 +389,50 @@ SetShiftInvertMode(ARTYPE sigmap, ARFOP* objOPp,
 } // SetShiftInvertMode.
 
 
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::SetKrylovSchur(int nbp)
+{
+
+  kschur = true;
+  ksnb   = nbp;
+  this->Restart();
+
+} // SetKrylovSchur.
+
+
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::SetArpack()
+{
+
+  kschur = false;
+  ClearEngine();
+  this->Restart();
+
+} // SetArpack.
+
+
 template<class ARFLOAT, class ARTYPE, class ARFOP>
 int ARStdEig<ARFLOAT, ARTYPE, ARFOP>::FindArnoldiBasis()
 {
 
   if (!this->BasisOK) this->Restart();
 
+  // Using the Krylov-Schur engine.
+
+  if (kschur) {
+    if (this->BasisOK) return this->nconv;
+    try { return EngineBasis(); }
+    catch (const ArpackError&) {
+      ArpackError(ArpackError::CANNOT_FIND_BASIS, "FindArnoldiBasis");
+      return 0;
+    }
+    catch (const std::bad_alloc&) { // Memory is not sufficient.
+      ArpackError(ArpackError::MEMORY_OVERFLOW, "FindArnoldiBasis");
+      ArpackError(ArpackError::CANNOT_FIND_BASIS, "FindArnoldiBasis");
+      return 0;
+    }
+  }
+
   // Changing to auto shift mode.
 
   if (!this->AutoShift) {
@@ -200,7 +447,7 @@ int ARStdEig<ARFLOAT, ARTYPE, ARFOP>::FindArnoldiBasis()
     // Calling Aupp.
 
     try { this->TakeStep(); }
-    catch (ArpackError) {
+    catch (const ArpackError&) {
       ArpackError(ArpackError::CANNOT_FIND_BASIS, "FindArnoldiBasis");
       return 0;
     }
@@ -0,0 +1,716 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARSlice.h.
+   Arpack++ class ARSymSlice definition.
+   Spectrum slicing driver that finds all eigenvalues of a
+   real symmetric pencil (A,B) inside an interval [a,b].
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARSLICE_H
+#define ARSLICE_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "arch.h"
+#include "arerror.h"
+#include "blas1c.h"
+#include "arkssym.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+template<class ARFLOAT, class ARPENCIL>
+class ARSliceOp {
+
+ // Operator used in each slice: OP*X = inv(A-sigma*B)*B*X. The
+ // factorization of A-sigma*B must be stored in the pencil.
+
+ public:
+
+  int       n;
+  ARPENCIL* P;
+
+  void MultOPX(ARFLOAT* X, ARFLOAT* Y, int nvec)
+  {
+    for (int j=0; j<nvec; j++) {
+      P->MultBv(&X[j*n], &Y[j*n]);
+      P->MultInvAsBv(&Y[j*n], &Y[j*n]);
+    }
+  }
+
+  void MultBX(ARFLOAT* X, ARFLOAT* Y, int nvec)
+  {
+    for (int j=0; j<nvec; j++) P->MultBv(&X[j*n], &Y[j*n]);
+  }
+
+}; // class ARSliceOp.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+class ARSymSlice {
+
+ protected:
+
+ // a) User defined parameters.
+
+  ARMATRIX* A;        // Matrix A.
+  ARMATRIX* B;        // Matrix B (positive definite).
+  int       n;        // Dimension of the problem.
+  ARFLOAT   lower;    // Lower bound of the interval.
+  ARFLOAT   upper;    // Upper bound of the interval.
+  int       nevs;     // Maximum number of eigenvalues in each slice.
+  int       nthreads; // Number of threads (0 = OpenMP default).
+  ARFLOAT   tol;      // Stopping criterion (relative accuracy).
+  int       maxit;    // Maximum number of iterations in each slice.
+
+ // b) Slices.
+
+  int       nslices;  // Number of slices.
+  ARFLOAT*  bound;    // Slice i is [bound[i], bound[i+1]).
+  int*      count;    // Number of eigenvalues smaller than bound[i].
+
+ // c) Results.
+
+  int       nconv;    // Number of eigenvalues found in [lower, upper).
+  ARFLOAT*  EigVal;   // Eigenvalues (in ascending order).
+  ARFLOAT*  EigVec;   // B-orthonormal eigenvectors.
+
+ // d) Protected functions.
+
+  void ClearMem();
+
+  void Copy(const ARSymSlice& other);
+
+  int Threads();
+  // Returns the number of threads actually used.
+
+  ARFLOAT Delta();
+  // Returns the tolerance used to compare eigenvalues.
+
+  int Inertia(ARPENCIL& P, ARFLOAT& sigma);
+  // Factors A-sigma*B and returns the number of eigenvalues smaller
+  // than sigma. If sigma is (numerically) an eigenvalue, it is slightly
+  // moved to the right.
+
+  void CountEigenvalues(std::vector<ARFLOAT>& pts, std::vector<int>& cnt);
+  // Computes (in parallel) the inertia at each point in pts.
+
+  void DefineSlices();
+  // Places the shifts. The interval is bisected until each slice
+  // contains at most nevs eigenvalues.
+
+  bool SolveSlice(int s, std::vector<ARFLOAT>& val,
+                  std::vector<ARFLOAT>& vec);
+  // Finds the eigenpairs in slice s using the shift and invert mode
+  // with sigma at the center of the slice. Eigenvalues that lie slightly
+  // outside the slice are also kept. Returns false if the number of
+  // eigenvalues found is smaller than the inertia count.
+
+  void Merge(std::vector<ARFLOAT>* val, std::vector<ARFLOAT>* vec);
+  // Sorts the eigenpairs found in all slices, removes duplicated pairs
+  // at slice boundaries and stores the result in EigVal and EigVec.
+
+
+ public:
+
+ // e) Public functions.
+
+ // e.1) Functions that allow changes in problem parameters.
+
+  void DefineMatrices(ARMATRIX& Ap, ARMATRIX& Bp);
+
+  void ChangeInterval(ARFLOAT lowerp, ARFLOAT upperp);
+
+  void ChangeSliceSize(int nevsp) { nevs = (nevsp > 0) ? nevsp : 40; }
+
+  void ChangeThreads(int nthreadsp) { nthreads = (nthreadsp<0)?1:nthreadsp; }
+  // nthreadsp = 0 means that OpenMP default value is used.
+
+  void ChangeTol(ARFLOAT tolp) { tol = tolp; }
+
+  void ChangeMaxit(int maxitp) { maxit = maxitp; }
+
+ // e.2) Function that performs all calculations.
+
+  int FindEigenvectors();
+  // Finds all eigenvalues in [lower, upper) and the corresponding
+  // eigenvectors. Returns the number of eigenvalues found.
+
+ // e.3) Functions that provide access to the solution.
+
+  int ConvergedEigenvalues() { return nconv; }
+
+  int TotalEigenvalues()
+  {
+    return (count != NULL) ? count[nslices]-count[0] : 0;
+  }
+  // Number of eigenvalues in [lower, upper) given by the inertia
+  // (zero until the slices are defined by FindEigenvectors).
+
+  int GetSlices() { return nslices; }
+
+  ARFLOAT SliceBound(int i) { return bound[i]; }
+
+  ARFLOAT Eigenvalue(int i) { return EigVal[i]; }
+
+  ARFLOAT Eigenvector(int i, int j) { return EigVec[i*n+j]; }
+
+  ARFLOAT* RawEigenvalues() { return EigVal; }
+
+  ARFLOAT* RawEigenvectors() { return EigVec; }
+
+  ARFLOAT* RawEigenvector(int i) { return &EigVec[i*n]; }
+
+ // e.4) Constructors and destructor.
+
+  ARSymSlice();
+  // Short constructor.
+
+  ARSymSlice(ARMATRIX& Ap, ARMATRIX& Bp, ARFLOAT lowerp, ARFLOAT upperp,
+             int nevsp = 0, int nthreadsp = 0, ARFLOAT tolp = 0.0,
+             int maxitp = 0);
+  // Long constructor.
+
+  ARSymSlice(const ARSymSlice& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARSymSlice() { ClearMem(); }
+  // Destructor.
+
+ // f) Operators.
+
+  ARSymSlice& operator=(const ARSymSlice& other);
+  // Assignment operator.
+
+}; // class ARSymSlice.
+
+
+// ------------------------------------------------------------------------ //
+// ARSymSlice member functions definition.                                  //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+inline void ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::ClearMem()
+{
+
+  delete[] bound;
+  delete[] count;
+  delete[] EigVal;
+  delete[] EigVec;
+  bound   = NULL;
+  count   = NULL;
+  EigVal  = NULL;
+  EigVec  = NULL;
+  nslices = 0;
+  nconv   = 0;
+
+} // ClearMem.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+void ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+Copy(const ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>& other)
+{
+
+  int i;
+
+  A        = other.A;
+  B        = other.B;
+  n        = other.n;
+  lower    = other.lower;
+  upper    = other.upper;
+  nevs     = other.nevs;
+  nthreads = other.nthreads;
+  tol      = other.tol;
+  maxit    = other.maxit;
+  nslices  = other.nslices;
+  nconv    = other.nconv;
+  bound    = NULL;
+  count    = NULL;
+  EigVal   = NULL;
+  EigVec   = NULL;
+
+  if (other.bound != NULL) {
+    bound = new ARFLOAT[nslices+1];
+    count = new int[nslices+1];
+    for (i=0; i<=nslices; i++) {
+      bound[i] = other.bound[i];
+      count[i] = other.count[i];
+    }
+  }
+  if (other.EigVal != NULL) {
+    EigVal = new ARFLOAT[nconv];
+    EigVec = new ARFLOAT[n*nconv];
+    copy(nconv, other.EigVal, 1, EigVal, 1);
+    copy(n*nconv, other.EigVec, 1, EigVec, 1);
+  }
+
+} // Copy.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+inline int ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::Threads()
+{
+
+#ifdef _OPENMP
+  return (nthreads == 0) ? omp_get_max_threads() : nthreads;
+#else
+  return 1;
+#endif
+
+} // Threads.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+inline ARFLOAT ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::Delta()
+{
+
+  ARFLOAT eps, scale;
+
+  eps   = std::numeric_limits<ARFLOAT>::epsilon();
+  scale = (std::abs(lower) > std::abs(upper)) ? std::abs(lower)
+                                              : std::abs(upper);
+  if (scale < (upper-lower)) scale = upper-lower;
+  return std::sqrt(eps)*scale;
+
+} // Delta.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+int ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+Inertia(ARPENCIL& P, ARFLOAT& sigma)
+{
+
+  int     k;
+  ARFLOAT eps, step;
+
+  eps  = std::numeric_limits<ARFLOAT>::epsilon();
+  step = Delta()*std::sqrt(eps);
+
+  for (k=0; k<10; k++) {
+    try {
+      return P.Inertia(sigma);
+    }
+    catch (const ArpackError&) {
+      sigma += step;
+      step  *= ARFLOAT(16.0);
+    }
+  }
+  throw ArpackError(ArpackError::MATRIX_IS_SINGULAR, "ARSymSlice::Inertia");
+  return 0;
+
+} // Inertia.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+void ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+CountEigenvalues(std::vector<ARFLOAT>& pts, std::vector<int>& cnt)
+{
+
+  int  i, np;
+  bool fail;
+
+  np   = (int)pts.size();
+  fail = false;
+  cnt.resize(np);
+
+  // Each point requires a factorization of A-sigma*B, so each thread
+  // uses its own pencil.
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(Threads()) schedule(dynamic, 1)
+#endif
+  for (i=0; i<np; i++) {
+    ARPENCIL P(*A, *B);
+    try {
+      cnt[i] = Inertia(P, pts[i]);
+    }
+    catch (const ArpackError&) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      fail = true;
+    }
+  }
+
+  if (fail) {
+    throw ArpackError(ArpackError::MATRIX_IS_SINGULAR,
+                      "ARSymSlice::CountEigenvalues");
+  }
+
+} // CountEigenvalues.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+void ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::DefineSlices()
+{
+
+  int                  i, ns, total, split;
+  ARFLOAT              h;
+  std::vector<ARFLOAT> pts, mid;
+  std::vector<int>     cnt, cmid;
+
+  // Counting the eigenvalues in [lower, upper).
+
+  pts.push_back(lower);
+  pts.push_back(upper);
+  CountEigenvalues(pts, cnt);
+  lower = pts[0];
+  upper = pts[1];
+  total = cnt[1]-cnt[0];
+
+  // Using uniformly spaced shifts (at least one slice per thread).
+
+  ns = (total+nevs-1)/nevs;
+  if (ns < Threads()) ns = Threads();
+  if (ns > total) ns = total;
+  if (ns > 1) {
+    h = (upper-lower)/ARFLOAT(ns);
+    for (i=1; i<ns; i++) pts.insert(pts.begin()+i, lower+h*ARFLOAT(i));
+    for (i=1; i<ns; i++) mid.push_back(pts[i]);
+    CountEigenvalues(mid, cmid);
+    for (i=1; i<ns; i++) {
+      pts[i] = mid[i-1];
+      cnt.insert(cnt.begin()+i, cmid[i-1]);
+    }
+  }
+
+  // Bisecting slices that contain too many eigenvalues. Slices that
+  // are too narrow (clusters) are not split.
+
+  do {
+    mid.clear();
+    for (i=0; (i+1)<(int)pts.size(); i++) {
+      if (((cnt[i+1]-cnt[i]) > nevs) && ((pts[i+1]-pts[i]) > Delta())) {
+        mid.push_back((pts[i]+pts[i+1])/ARFLOAT(2.0));
+      }
+    }
+    split = (int)mid.size();
+    if (split > 0) {
+      CountEigenvalues(mid, cmid);
+      for (i=0; (i+1)<(int)pts.size(); i++) {
+        if (mid.empty()) break;
+        if ((mid.front() > pts[i]) && (mid.front() < pts[i+1])) {
+          pts.insert(pts.begin()+i+1, mid.front());
+          cnt.insert(cnt.begin()+i+1, cmid.front());
+          mid.erase(mid.begin());
+          cmid.erase(cmid.begin());
+          i++;
+        }
+      }
+    }
+  } while (split > 0);
+
+  // Storing slices.
+
+  delete[] bound;
+  delete[] count;
+  nslices = (int)pts.size()-1;
+  bound   = new ARFLOAT[nslices+1];
+  count   = new int[nslices+1];
+  for (i=0; i<=nslices; i++) {
+    bound[i] = pts[i];
+    count[i] = cnt[i];
+  }
+
+} // DefineSlices.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+bool ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+SolveSlice(int s, std::vector<ARFLOAT>& val, std::vector<ARFLOAT>& vec)
+{
+
+  int     i, k, c, nev, ncv, nc, trial;
+  ARFLOAT sigma, lambda, lo, hi;
+  ARPENCIL                     P(*A, *B);
+  ARSliceOp<ARFLOAT, ARPENCIL> op;
+
+  c  = count[s+1]-count[s];
+  lo = bound[s]-Delta();
+  hi = bound[s+1]+Delta();
+  if (c == 0) return true;
+
+  // Factoring A-sigma*B. Since sigma is the center of the slice, the c
+  // eigenvalues closest to sigma are exactly those in the slice, so only
+  // a small safety margin is added to nev.
+
+  sigma = (bound[s]+bound[s+1])/ARFLOAT(2.0);
+  Inertia(P, sigma);
+  op.n = n;
+  op.P = &P;
+  nev  = c+2;
+
+  for (trial=0; trial<3; trial++) {
+
+    if (nev > (n-1)) nev = n-1;
+    ncv = 2*nev+1;
+    if (ncv > n) ncv = n;
+
+    ARbkSymStdEig<ARFLOAT, ARSliceOp<ARFLOAT, ARPENCIL> >
+      prob(n, nev, &op, &ARSliceOp<ARFLOAT, ARPENCIL>::MultOPX, sigma,
+           "LM", ncv, tol, maxit);
+    prob.ChangeMultBX(&op, &ARSliceOp<ARFLOAT, ARPENCIL>::MultBX);
+    nc = prob.FindEigenvectors();
+
+    // Keeping the eigenpairs that belong to the slice.
+
+    val.clear();
+    vec.clear();
+    for (i=0; i<nc; i++) {
+      lambda = prob.Eigenvalue(i);
+      if ((lambda >= lo) && (lambda < hi)) {
+        val.push_back(lambda);
+        for (k=0; k<n; k++) vec.push_back(prob.RawEigenvector(i)[k]);
+      }
+    }
+    if (((int)val.size() >= c) || (nev == (n-1))) break;
+    nev += c;
+
+  }
+
+  return ((int)val.size() >= c);
+
+} // SolveSlice.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+void ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+Merge(std::vector<ARFLOAT>* val, std::vector<ARFLOAT>* vec)
+{
+
+  int                   i, j, k, s, m, t;
+  ARFLOAT               delta, xbx;
+  ARFLOAT*              bx;
+  std::vector<ARFLOAT*> x;
+  std::vector<ARFLOAT>  lambda;
+  std::vector<int>      idx, keep;
+  ARPENCIL              P(*A, *B);
+
+  // Collecting and sorting all eigenpairs (insertion sort, since the
+  // eigenvalues of each slice are already sorted).
+
+  for (s=0; s<nslices; s++) {
+    for (i=0; i<(int)val[s].size(); i++) {
+      lambda.push_back(val[s][i]);
+      x.push_back(&vec[s][i*n]);
+    }
+  }
+  m = (int)lambda.size();
+  for (i=0; i<m; i++) idx.push_back(i);
+  for (i=1; i<m; i++) {
+    t = idx[i];
+    for (j=i; (j>0)&&(lambda[idx[j-1]]>lambda[t]); j--) idx[j] = idx[j-1];
+    idx[j] = t;
+  }
+
+  // Removing duplicates: eigenpairs found by two neighboring slices have
+  // close eigenvalues and B-parallel eigenvectors. Distinct eigenvectors
+  // associated to a multiple eigenvalue are B-orthogonal.
+
+  delta = Delta();
+  bx    = new ARFLOAT[n];
+  for (i=0; i<m; i++) {
+    t = idx[i];
+    if ((lambda[t] < lower) || (lambda[t] >= upper)) continue;
+    P.MultBv(x[t], bx);
+    for (k=(int)keep.size()-1; k>=0; k--) {
+      if ((lambda[t]-lambda[keep[k]]) > delta) break;
+      xbx = dot(n, x[keep[k]], 1, bx, 1);
+      if (std::abs(xbx) > ARFLOAT(0.5)) break;
+    }
+    if ((k < 0) || ((lambda[t]-lambda[keep[k]]) > delta)) keep.push_back(t);
+  }
+  delete[] bx;
+
+  // Storing eigenpairs.
+
+  delete[] EigVal;
+  delete[] EigVec;
+  nconv  = (int)keep.size();
+  EigVal = new ARFLOAT[nconv];
+  EigVec = new ARFLOAT[n*nconv];
+  for (k=0; k<nconv; k++) {
+    EigVal[k] = lambda[keep[k]];
+    copy(n, x[keep[k]], 1, &EigVec[k*n], 1);
+  }
+
+} // Merge.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+inline void ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+DefineMatrices(ARMATRIX& Ap, ARMATRIX& Bp)
+{
+
+  A = &Ap;
+  B = &Bp;
+  n = Ap.ncols();
+
+  if ((Ap.nrows() != Bp.nrows())||(Ap.ncols() != Bp.ncols())) {
+    throw ArpackError(ArpackError::INCOMPATIBLE_SIZES,
+                      "ARSymSlice::DefineMatrices");
+  }
+
+} // DefineMatrices.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+inline void ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+ChangeInterval(ARFLOAT lowerp, ARFLOAT upperp)
+{
+
+  if (lowerp >= upperp) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "ARSymSlice::ChangeInterval");
+  }
+  lower = lowerp;
+  upper = upperp;
+
+} // ChangeInterval.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+int ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::FindEigenvectors()
+{
+
+  int                   s;
+  bool                  fail, incomplete;
+  std::vector<ARFLOAT>* val;
+  std::vector<ARFLOAT>* vec;
+
+  if ((A == NULL) || (B == NULL)) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARSymSlice::FindEigenvectors");
+  }
+
+  // Placing the shifts.
+
+  DefineSlices();
+
+  // Solving independent slices in parallel. Each thread holds only one
+  // factorization and one small Krylov basis at a time.
+
+  val        = new std::vector<ARFLOAT>[nslices];
+  vec        = new std::vector<ARFLOAT>[nslices];
+  fail       = false;
+  incomplete = false;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(Threads()) schedule(dynamic, 1)
+#endif
+  for (s=0; s<nslices; s++) {
+    bool ok = true;
+    try {
+      ok = SolveSlice(s, val[s], vec[s]);
+    }
+    catch (const ArpackError&) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      fail = true;
+    }
+    if (!ok) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      incomplete = true;
+    }
+  }
+
+  if (fail) {
+    delete[] val;
+    delete[] vec;
+    throw ArpackError(ArpackError::CANNOT_FIND_VECTORS,
+                      "ARSymSlice::FindEigenvectors");
+  }
+
+  // Merging slices and checking the result against the inertia count.
+
+  Merge(val, vec);
+  delete[] val;
+  delete[] vec;
+
+  if (incomplete || (nconv != TotalEigenvalues())) {
+    ArpackError(ArpackError::MAX_ITERATIONS, "ARSymSlice::FindEigenvectors");
+  }
+  return nconv;
+
+} // FindEigenvectors.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+inline ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::ARSymSlice()
+{
+
+  A        = NULL;
+  B        = NULL;
+  n        = 0;
+  lower    = 0.0;
+  upper    = 0.0;
+  nevs     = 40;
+  nthreads = 0;
+  tol      = 0.0;
+  maxit    = 0;
+  nslices  = 0;
+  nconv    = 0;
+  bound    = NULL;
+  count    = NULL;
+  EigVal   = NULL;
+  EigVec   = NULL;
+
+} // Short constructor.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+inline ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+ARSymSlice(ARMATRIX& Ap, ARMATRIX& Bp, ARFLOAT lowerp, ARFLOAT upperp,
+           int nevsp, int nthreadsp, ARFLOAT tolp, int maxitp)
+{
+
+  nslices = 0;
+  nconv   = 0;
+  bound   = NULL;
+  count   = NULL;
+  EigVal  = NULL;
+  EigVec  = NULL;
+  DefineMatrices(Ap, Bp);
+  ChangeInterval(lowerp, upperp);
+  ChangeSliceSize(nevsp);
+  ChangeThreads(nthreadsp);
+  ChangeTol(tolp);
+  ChangeMaxit(maxitp);
+
+} // Long constructor.
+
+
+template<class ARFLOAT, class ARMATRIX, class ARPENCIL>
+ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>&
+ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>::
+operator=(const ARSymSlice<ARFLOAT, ARMATRIX, ARPENCIL>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    ClearMem();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARSLICE_H
+
@@ -22,6 +22,7 @@
 #include "arch.h"
 #include "arseig.h"
 #include "arrsnsym.h"
+#include "arksnsym.h"
 
 
 template<class ARFLOAT, class ARFOP>
@@ -29,9 +30,20 @@ class ARNonSymStdEig:
   public virtual ARStdEig<ARFLOAT, ARFLOAT, ARFOP>,
   public virtual ARrcNonSymStdEig<ARFLOAT> {
 
+ protected:
+
+ // a) Protected functions:
+
+  typename ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::TypeEngine* NewEngine();
+  // Creates an ARbkNonSymStdEig object.
+
+  void Eupp();
+  // Calls the Krylov-Schur engine, or SNEUPD and DNEUPD.
+
+
  public:
 
- // a) Constructors and destructor.
+ // b) Constructors and destructor.
 
   ARNonSymStdEig() { }
   // Short constructor.
@@ -55,7 +67,7 @@ class ARNonSymStdEig:
   virtual ~ARNonSymStdEig() { }
   // Destructor.
 
- // b) Operators.
+ // c) Operators.
 
   ARNonSymStdEig& operator=(const ARNonSymStdEig& other);
   // Assignment operator.
@@ -68,6 +80,30 @@ class ARNonSymStdEig:
 // ------------------------------------------------------------------------ //
 
 
+template<class ARFLOAT, class ARFOP>
+inline typename ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::TypeEngine*
+ARNonSymStdEig<ARFLOAT, ARFOP>::NewEngine()
+{
+
+  return new ARbkNonSymStdEig<ARFLOAT, ARStdEig<ARFLOAT, ARFLOAT, ARFOP> >;
+
+} // NewEngine.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARNonSymStdEig<ARFLOAT, ARFOP>::Eupp()
+{
+
+  if (this->EngineOK()) {
+    this->EngineEupp();
+  }
+  else {
+    ARrcNonSymStdEig<ARFLOAT>::Eupp();
+  }
+
+} // Eupp.
+
+
 template<class ARFLOAT, class ARFOP>
 inline ARNonSymStdEig<ARFLOAT, ARFOP>::
 ARNonSymStdEig(int np, int nevp, ARFOP* objOPp,
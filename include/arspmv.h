@@ -0,0 +1,431 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARSpMV.h.
+   Arpack++ class ARspSymMV definition.
+   Matrix-vector product for real and complex symmetric
+   matrices stored in compressed sparse column format
+   (lower or upper triangle only).
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARSPMV_H
+#define ARSPMV_H
+
+#include <cstddef>
+#include "arch.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template<class ARTYPE>
+class ARspSymMV {
+
+ protected:
+
+ // a) Matrix data (not owned by this class).
+
+  int     n;        // Dimension of the matrix.
+  char    uplo;     // 'L' (lower triangle) or 'U' (upper triangle).
+  int*    irow;     // Row indices of the nonzero elements.
+  int*    pcol;     // Pointers to the beginning of each column.
+  ARTYPE* a;        // Nonzero elements.
+
+ // b) Data used by the parallel product.
+ //    Entries of the stored triangle are also indexed by rows, so each
+ //    row of w = A*v can be computed independently. The sums are evaluated
+ //    in the same order used by the serial product, so both products give
+ //    identical results. Rows are split into nparts blocks with the same
+ //    number of nonzero elements.
+
+  int     nthreads; // Number of threads requested (0 = OpenMP default).
+  int     nparts;   // Number of row blocks.
+  int*    part;     // First row of each block.
+  int*    rptr;     // Pointers to the beginning of each row.
+  int*    rcol;     // Column indices of the off-diagonal elements.
+  int*    rpos;     // Position of the off-diagonal elements in a.
+
+  void ClearMem();
+
+  void Copy(const ARspSymMV& other);
+
+  void BuildIndex();
+  // Creates the row index (rptr, rcol, rpos) and the row partition.
+
+  void Range(int i, int& j0, int& j1, int& jd);
+  // Off-diagonal elements of column i are a(j0:j1-1). jd is the position
+  // of the diagonal element of column i (-1 if it is not stored).
+
+  void MultRows(int r0, int r1, ARTYPE* X, ARTYPE* Y, int nvec);
+  // Computes rows r0 to r1-1 of Y = A*X using the row index.
+
+ public:
+
+  bool Parallel() { return (nparts > 1); }
+
+  int GetThreads() { return nthreads; }
+
+  void ChangeThreads(int nthreadsp);
+  // Changes the number of threads used by MultMv and MultMV.
+  // nthreadsp = 0 means that OpenMP default value is used.
+
+  void Define(int np, ARTYPE* ap, int* irowp, int* pcolp, char uplop);
+
+  void MultMv(ARTYPE* v, ARTYPE* w);
+  // Matrix-vector product: w = A*v.
+
+  void MultMV(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Matrix-block product: Y = A*X (X and Y are n x nvec). Each column
+  // of Y is identical to the one computed by MultMv.
+
+  ARspSymMV();
+  // Short constructor.
+
+  ARspSymMV(const ARspSymMV& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARspSymMV() { ClearMem(); }
+  // Destructor.
+
+  ARspSymMV& operator=(const ARspSymMV& other);
+  // Assignment operator.
+
+}; // class ARspSymMV.
+
+
+// ------------------------------------------------------------------------ //
+// ARspSymMV member functions definition.                                   //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE>
+inline void ARspSymMV<ARTYPE>::ClearMem()
+{
+
+  delete[] part;
+  delete[] rptr;
+  delete[] rcol;
+  delete[] rpos;
+  part   = NULL;
+  rptr   = NULL;
+  rcol   = NULL;
+  rpos   = NULL;
+  nparts = 1;
+
+} // ClearMem.
+
+
+template<class ARTYPE>
+void ARspSymMV<ARTYPE>::Copy(const ARspSymMV<ARTYPE>& other)
+{
+
+  int i, nz;
+
+  n        = other.n;
+  uplo     = other.uplo;
+  irow     = other.irow;
+  pcol     = other.pcol;
+  a        = other.a;
+  nthreads = other.nthreads;
+  nparts   = other.nparts;
+  part     = NULL;
+  rptr     = NULL;
+  rcol     = NULL;
+  rpos     = NULL;
+
+  if (nparts > 1) {
+    nz   = other.rptr[n];
+    part = new int[nparts+1];
+    rptr = new int[n+1];
+    rcol = new int[nz];
+    rpos = new int[nz];
+    for (i=0; i<=nparts; i++) part[i] = other.part[i];
+    for (i=0; i<=n; i++) rptr[i] = other.rptr[i];
+    for (i=0; i<nz; i++) {
+      rcol[i] = other.rcol[i];
+      rpos[i] = other.rpos[i];
+    }
+  }
+
+} // Copy.
+
+
+template<class ARTYPE>
+inline void ARspSymMV<ARTYPE>::Range(int i, int& j0, int& j1, int& jd)
+{
+
+  j0 = pcol[i];
+  j1 = pcol[i+1];
+  jd = -1;
+  if (uplo == 'U') {
+    if ((j1!=j0)&&(irow[j1-1]==i)) jd = --j1;
+  }
+  else {
+    if ((j1!=j0)&&(irow[j0]==i)) jd = j0++;
+  }
+
+} // Range.
+
+
+template<class ARTYPE>
+void ARspSymMV<ARTYPE>::BuildIndex()
+{
+
+  int  i, j, p, r, j0, j1, jd, nt;
+  long nz, wk;
+
+  ClearMem();
+
+  nt = nthreads;
+#ifdef _OPENMP
+  if (nt == 0) nt = omp_get_max_threads();
+#else
+  nt = 1;
+#endif
+  if (nt > n) nt = n;
+  if (nt < 2) return;
+
+  // Counting the off-diagonal elements of each row.
+
+  rptr = new int[n+1];
+  for (r=0; r<=n; r++) rptr[r] = 0;
+  for (i=0; i<n; i++) {
+    Range(i, j0, j1, jd);
+    for (j=j0; j<j1; j++) rptr[irow[j]+1]++;
+  }
+  for (r=0; r<n; r++) rptr[r+1] += rptr[r];
+
+  // Storing columns in ascending order (the order used by MultMv).
+
+  rcol = new int[rptr[n]];
+  rpos = new int[rptr[n]];
+  for (i=0; i<n; i++) {
+    Range(i, j0, j1, jd);
+    for (j=j0; j<j1; j++) {
+      p = rptr[irow[j]]++;
+      rcol[p] = i;
+      rpos[p] = j;
+    }
+  }
+  for (r=n; r>0; r--) rptr[r] = rptr[r-1];
+  rptr[0] = 0;
+
+  // Splitting rows into nt blocks with (almost) the same amount of work.
+
+  nz     = (long)pcol[n]+(long)rptr[n]+(long)n;
+  nparts = nt;
+  part   = new int[nparts+1];
+  part[0] = 0;
+  for (p=1, r=0, wk=0; p<nparts; p++) {
+    while ((r<n)&&(wk*nparts < nz*p)) {
+      wk += (long)(pcol[r+1]-pcol[r])+(long)(rptr[r+1]-rptr[r])+1;
+      r++;
+    }
+    part[p] = r;
+  }
+  part[nparts] = n;
+
+} // BuildIndex.
+
+
+template<class ARTYPE>
+void ARspSymMV<ARTYPE>::
+MultRows(int r0, int r1, ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  int     r, j, p, l, j0, j1, jd;
+  ARTYPE  s;
+  ARTYPE* x;
+
+  for (r=r0; r<r1; r++) {
+    Range(r, j0, j1, jd);
+    for (l=0, x=X; l<nvec; l++, x+=n) {
+      s = (ARTYPE)0;
+      if (uplo == 'U') {
+
+        // Diagonal, column r and then row r (columns r+1:n).
+
+        if (jd >= 0) s += x[r]*a[jd];
+        for (j=j0; j<j1; j++) s += x[irow[j]]*a[j];
+        for (p=rptr[r]; p<rptr[r+1]; p++) s += x[rcol[p]]*a[rpos[p]];
+
+      }
+      else {
+
+        // Row r (columns 1:r-1), diagonal and then column r.
+
+        for (p=rptr[r]; p<rptr[r+1]; p++) s += x[rcol[p]]*a[rpos[p]];
+        if (jd >= 0) s += x[r]*a[jd];
+        for (j=j0; j<j1; j++) s += x[irow[j]]*a[j];
+
+      }
+      Y[r+l*n] = s;
+    }
+  }
+
+} // MultRows.
+
+
+template<class ARTYPE>
+inline void ARspSymMV<ARTYPE>::ChangeThreads(int nthreadsp)
+{
+
+  nthreads = (nthreadsp < 0) ? 1 : nthreadsp;
+  if (irow != NULL) BuildIndex();
+
+} // ChangeThreads.
+
+
+template<class ARTYPE>
+inline void ARspSymMV<ARTYPE>::
+Define(int np, ARTYPE* ap, int* irowp, int* pcolp, char uplop)
+{
+
+  n    = np;
+  a    = ap;
+  irow = irowp;
+  pcol = pcolp;
+  uplo = uplop;
+  BuildIndex();
+
+} // Define.
+
+
+template<class ARTYPE>
+void ARspSymMV<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
+{
+
+  int    i, j, k;
+  ARTYPE t;
+
+  if (Parallel()) {
+    MultMV(v, w, 1);
+    return;
+  }
+
+  // Determining w = M.v.
+
+  for (i=0; i!=n; i++) w[i]=(ARTYPE)0;
+
+  if (uplo == 'U') {
+
+    for (i=0; i!=n; i++) {
+      t = v[i];
+      k = pcol[i+1];
+      if ((k!=pcol[i])&&(irow[k-1]==i)) {
+        w[i] += t*a[k-1];
+        k--;
+      }
+      for (j=pcol[i]; j<k; j++) {
+        w[irow[j]] += t*a[j];
+        w[i] += v[irow[j]]*a[j];
+      }
+    }
+
+  }
+  else {
+
+    for (i=0; i!=n; i++) {
+      t = v[i];
+      k = pcol[i];
+      if ((k!=pcol[i+1])&&(irow[k]==i)) {
+        w[i] += t*a[k];
+        k++;
+      }
+      for (j=k; j<pcol[i+1]; j++) {
+        w[irow[j]] += t*a[j];
+        w[i] += v[irow[j]]*a[j];
+      }
+    }
+
+  }
+
+} // MultMv.
+
+
+template<class ARTYPE>
+void ARspSymMV<ARTYPE>::MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  int     i, j, l, j0, j1, jd;
+  ARTYPE  t;
+  ARTYPE* x;
+  ARTYPE* y;
+
+  if (Parallel()) {
+
+    // Each thread computes a block of rows of Y.
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nparts) schedule(static, 1)
+#endif
+    for (i=0; i<nparts; i++) {
+      MultRows(part[i], part[i+1], X, Y, nvec);
+    }
+    return;
+
+  }
+
+  // Determining Y = M.X. Each column of A is read once for all columns
+  // of X. The order of the operations is the same used by MultMv.
+
+  for (i=0; i!=n*nvec; i++) Y[i]=(ARTYPE)0;
+
+  for (i=0; i!=n; i++) {
+    Range(i, j0, j1, jd);
+    for (l=0, x=X, y=Y; l<nvec; l++, x+=n, y+=n) {
+      t = x[i];
+      if (jd >= 0) y[i] += t*a[jd];
+      for (j=j0; j<j1; j++) {
+        y[irow[j]] += t*a[j];
+        y[i] += x[irow[j]]*a[j];
+      }
+    }
+  }
+
+} // MultMV.
+
+
+template<class ARTYPE>
+inline ARspSymMV<ARTYPE>::ARspSymMV()
+{
+
+  n        = 0;
+  uplo     = 'L';
+  irow     = NULL;
+  pcol     = NULL;
+  a        = NULL;
+  nthreads = 1;
+  nparts   = 1;
+  part     = NULL;
+  rptr     = NULL;
+  rcol     = NULL;
+  rpos     = NULL;
+
+} // Short constructor.
+
+
+template<class ARTYPE>
+ARspSymMV<ARTYPE>& ARspSymMV<ARTYPE>::
+operator=(const ARspSymMV<ARTYPE>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    ClearMem();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARSPMV_H
+
@@ -4,6 +4,9 @@
 
    MODULE ARSSym.h.
    Arpack++ class ARSymStdEig definition.
+   Several ARSymStdEig problems may be solved at the same time (one
+   in each thread) only if they use the Krylov-Schur engine (see
+   SetKrylovSchur in arseig.h).
 
    ARPACK Authors
       Richard Lehoucq
@@ -22,6 +25,7 @@
 #include "arch.h"
 #include "arseig.h"
 #include "arrssym.h"
+#include "arkssym.h"
 
 
 template<class ARFLOAT, class ARFOP>
@@ -29,9 +33,20 @@ class ARSymStdEig:
   public virtual ARStdEig<ARFLOAT, ARFLOAT, ARFOP>,
   public virtual ARrcSymStdEig<ARFLOAT> {
 
+ protected:
+
+ // a) Protected functions:
+
+  typename ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::TypeEngine* NewEngine();
+  // Creates an ARbkSymStdEig object.
+
+  void Eupp();
+  // Calls the Krylov-Schur engine, or SSEUPD and DSEUPD.
+
+
  public:
 
- // a) Constructors and destructor.
+ // b) Constructors and destructor.
 
   ARSymStdEig() { }
   // Short constructor.
@@ -55,7 +70,7 @@ class ARSymStdEig:
   virtual ~ARSymStdEig() { }
   // Destructor.
 
- // b) Operators.
+ // c) Operators.
 
   ARSymStdEig& operator=(const ARSymStdEig& other);
   // Assignment operator.
@@ -68,6 +83,30 @@ class ARSymStdEig:
 // ------------------------------------------------------------------------ //
 
 
+template<class ARFLOAT, class ARFOP>
+inline typename ARStdEig<ARFLOAT, ARFLOAT, ARFOP>::TypeEngine*
+ARSymStdEig<ARFLOAT, ARFOP>::NewEngine()
+{
+
+  return new ARbkSymStdEig<ARFLOAT, ARStdEig<ARFLOAT, ARFLOAT, ARFOP> >;
+
+} // NewEngine.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARSymStdEig<ARFLOAT, ARFOP>::Eupp()
+{
+
+  if (this->EngineOK()) {
+    this->EngineEupp();
+  }
+  else {
+    ARrcSymStdEig<ARFLOAT>::Eupp();
+  }
+
+} // Eupp.
+
+
 template<class ARFLOAT, class ARFOP>
 inline ARSymStdEig<ARFLOAT, ARFOP>::
 ARSymStdEig(int np, int nevp, ARFOP* objOPp,
@@ -0,0 +1,127 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARStats.h.
+   Performance counters collected by the eigenvalue solvers.
+   ARStats stores the number of matrix-vector products and the
+   time spent in each stage of the Arnoldi process. ARProfiler
+   is the interface used to forward these events to an external
+   profiler.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARSTATS_H
+#define ARSTATS_H
+
+#include <ctime>
+#include "arch.h"
+
+#if __cplusplus >= 201103L
+#include <chrono>
+#elif defined(_OPENMP)
+#include <omp.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/time.h>
+#endif
+
+
+inline double ARTime()
+{
+
+  // Returns the wall clock time in seconds (the origin is arbitrary).
+
+#if __cplusplus >= 201103L
+  return std::chrono::duration<double>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+#elif defined(_OPENMP)
+  return omp_get_wtime();
+#elif defined(__unix__) || defined(__APPLE__)
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return double(tv.tv_sec)+1.0e-6*double(tv.tv_usec);
+#else
+  return double(std::clock())/double(CLOCKS_PER_SEC);
+#endif
+
+} // ARTime.
+
+
+// ARStats class definition.
+
+class ARStats {
+
+ public:
+
+  enum Event {   // Stages of the Arnoldi process that are timed.
+    USER,        // Products supplied by the user (OP*x and B*x).
+    AUPP,        // Arnoldi iteration (__AUPD or the block engine).
+    EUPP,        // Eigenvector and Schur vector extraction (__EUPD).
+    FACTOR       // Factorization of OP (FactorAsI or FactorAsB).
+  };
+
+  long   nopx;     // Number of products y <- OP*x.
+  long   nbx;      // Number of products y <- B*x.
+  long   nsteps;   // Number of calls to Aupp (reverse communication steps).
+  long   nrestart; // Number of Arnoldi update iterations (restarts).
+  long   nfactor;  // Number of factorizations of OP.
+  double tuser;    // Time spent in the products supplied by the user.
+  double taupp;    // Time spent by the Arnoldi iteration itself.
+  double teupp;    // Time spent computing eigenvectors and Schur vectors.
+  double tfactor;  // Time spent factoring OP.
+
+  void Reset()
+  {
+    nopx = nbx = nsteps = nrestart = nfactor = 0;
+    tuser = taupp = teupp = tfactor = 0.0;
+  }
+  // Sets all counters to zero.
+
+  double& Time(Event ev)
+  {
+    switch (ev) {
+    case USER:  return tuser;
+    case AUPP:  return taupp;
+    case EUPP:  return teupp;
+    default:    return tfactor;
+    }
+  }
+  // Returns the time counter associated with event ev.
+
+  double TotalTime() const { return tuser+taupp+teupp+tfactor; }
+  // Returns the time spent in all stages.
+
+  ARStats() { Reset(); }
+  // Constructor.
+
+}; // class ARStats.
+
+
+// ARProfiler class definition.
+
+class ARProfiler {
+
+ public:
+
+  virtual void Begin(ARStats::Event) { }
+  // Called when the solver enters a stage.
+
+  virtual void End(ARStats::Event, double) { }
+  // Called when the solver leaves a stage, the second argument
+  // being the time (in seconds) spent in that stage.
+
+  virtual ~ARProfiler() { }
+  // Destructor.
+
+}; // class ARProfiler.
+
+
+#endif // ARSTATS_H
+
@@ -0,0 +1,1126 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARSVD.h.
+   Arpack++ class ARSVD definition.
+   ARSVD finds some of the largest (or smallest) singular values of a
+   real m x n matrix A, as well as the corresponding left and right
+   singular vectors. The Golub-Kahan-Lanczos bidiagonalization
+   A*V = U*B, A'*U = V*B' + f*e' is built directly from the products
+   A*v and A'*u and restarted by keeping the wanted Ritz triplets of
+   the small matrix B (thick restart), so neither A'*A nor the
+   augmented matrix [0 A; A' 0] are used. Singular vectors are
+   obtained from U and V, without additional products with A.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARSVD_H
+#define ARSVD_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "arch.h"
+#include "arerror.h"
+#include "arstats.h"
+#include "blas1c.h"
+#include "lapackc.h"
+
+
+template<class ARFLOAT, class ARFOP>
+class ARSVD {
+
+ public:
+
+ // a) Notation.
+
+  typedef void (ARFOP::* TypeOPx)(ARFLOAT[], ARFLOAT[]);
+
+
+ protected:
+
+ // b) User defined parameters.
+
+  ARFOP       *objA;    // Object that has MultAx and MultAtx as members.
+  TypeOPx     MultAx;   // Function that evaluates the product A*x.
+  TypeOPx     MultAtx;  // Function that evaluates the product A'*x.
+  int         m;        // Number of rows of A.
+  int         n;        // Number of columns of A.
+  int         nsv;      // Number of singular values to be computed.
+  int         ncv;      // Dimension of the bidiagonalization.
+  int         maxit;    // Maximum number of restarts.
+  ARFLOAT     tol;      // Stopping criterion (relative accuracy).
+  std::string which;    // "LM" (largest) or "SM" (smallest values).
+  ARFLOAT     *resid;   // Initial right vector (optional).
+  bool        newRes;   // Indicates if resid was supplied by the user.
+
+
+ // c) Internal variables.
+
+  bool        PrepareOK;  // Indicates if parameters were correctly set.
+  bool        ValuesOK;   // Indicates if singular values were found.
+  bool        VectorsOK;  // Indicates if singular vectors were found.
+  int         nconv;      // Number of converged singular values.
+  int         iter;       // Number of restarts performed.
+  int         lwk;        // Dimension of array Wk.
+  unsigned long seed;     // Seed used to generate random vectors.
+  ARFLOAT     fnorm;      // Norm of f (the residual of A'*U = V*B').
+  ARFLOAT     eps23;      // eps^(2/3).
+  ARFLOAT     rfloor;     // Residual norms below rfloor are at rounding level.
+  ARFLOAT     *V;         // n x (ncv+1) right Lanczos vectors.
+  ARFLOAT     *U;         // m x ncv left Lanczos vectors.
+  ARFLOAT     *Bm;        // ncv x ncv projection U'*A*V.
+  ARFLOAT     *Pm;        // Left singular vectors of Bm.
+  ARFLOAT     *QTm;       // Right singular vectors of Bm (transposed).
+  ARFLOAT     *Sm;        // Singular values of Bm (in decreasing order).
+  ARFLOAT     *Rnorm;     // Residual norms of the Ritz triplets.
+  ARFLOAT     *Cm;        // ncv x ncv auxiliary matrix.
+  ARFLOAT     *Tmp;       // max(m,n) x ncv auxiliary matrix.
+  ARFLOAT     *SVal;      // Converged singular values (increasing order).
+  ARFLOAT     *Wk;        // LAPACK workspace.
+  int         *Index;     // Wanted Ritz triplets.
+  ARStats     stats;      // Performance counters.
+
+
+ // d) Protected functions:
+
+ // d.1) Memory control functions.
+
+  void ClearMem();
+  // Deletes all arrays.
+
+  virtual void Copy(const ARSVD& other);
+  // Makes a deep copy of "other" over "this" object.
+  // Old values are not deleted (this function is to be used
+  // by the copy constructor and the assignment operator only).
+
+  void Prepare();
+  // Checks parameters and allocates the working arrays.
+
+
+ // d.2) Functions that check user defined parameters.
+
+  int CheckNsv(int nsvp);
+  // Does range checking on nsv.
+
+  int CheckNcv(int ncvp);
+  // Forces ncv to conform to its ranges.
+
+  int CheckMaxit(int maxitp);
+  // Forces maxit to be greater than zero.
+
+  std::string CheckWhich(const std::string& whichp);
+  // Determines if the value of variable "which" is valid.
+
+  bool Converged(ARFLOAT rnorm, ARFLOAT sigma) {
+    if (sigma < eps23) sigma = eps23;
+    return ((rnorm <= tol*sigma) || (rnorm <= rfloor));
+  }
+  // Convergence test (the same used by the Krylov-Schur engine).
+
+
+ // d.3) Functions that build the bidiagonalization.
+
+  void MultA(ARFLOAT* x, ARFLOAT* y, bool trans);
+  // Performs y <- A*x (or y <- A'*x if trans is true).
+
+  void RandomVector(ARFLOAT* x, int k);
+  // Fills x (with k elements) with pseudo-random values.
+
+  ARFLOAT Orthogonalize(ARFLOAT* x, ARFLOAT* Q, int k, int ldq,
+                        ARFLOAT* c);
+  // Orthogonalizes x (with ldq elements) against the first k
+  // columns of Q (twice, classical Gram-Schmidt), stores the
+  // projection coefficients in c (if c != NULL) and returns the
+  // norm of x. If x lies in the span of Q, it is replaced by a
+  // random vector orthogonal to Q and zero is returned.
+
+  void Extend(int k);
+  // Extends the bidiagonalization from k to ncv steps.
+
+  void Rotate(int k, bool final);
+  // Replaces the first k columns of U and V by the wanted Ritz
+  // vectors (Index[0..k-1]).
+
+  void Iterate();
+  // Performs the restarted bidiagonalization and stores the
+  // converged singular values in SVal.
+
+
+ public:
+
+ // e) Public functions:
+
+ // e.1) Functions that allow changes in problem parameters.
+
+  void ChangeNsv(int nsvp);
+  // Changes the number of singular values to be computed.
+
+  void ChangeNcv(int ncvp);
+  // Changes the dimension of the bidiagonalization.
+
+  void ChangeMaxit(int maxitp);
+  // Changes the maximum number of restarts.
+
+  void ChangeTol(ARFLOAT tolp);
+  // Changes the stopping criterion.
+
+  void ChangeWhich(const std::string& whichp);
+  // Changes "which" ("LM" or "SM").
+
+
+ // e.2) Functions that permit step by step execution of ARSVD.
+
+  int FindSingularValues();
+  // Determines nsv singular values.
+
+  int FindSingularVectors();
+  // Determines nsv singular values and the corresponding left and
+  // right singular vectors.
+
+
+ // e.3) Functions that perform all calculations in one step.
+
+  int SingularValues(ARFLOAT* &svalp, bool ivec = false);
+  // Overrides array svalp with the singular values of A. Also
+  // calculates the singular vectors if requested (ivec = true).
+
+  int SingularVectors(ARFLOAT* &Up, ARFLOAT* &Vp, ARFLOAT* svalp = NULL);
+  // Overrides arrays Up (m x nconv) and Vp (n x nconv) with the left
+  // and right singular vectors of A. svalp, if given, receives the
+  // singular values.
+
+
+ // e.4) Functions that provide access to the solution.
+
+  bool ParametersDefined() { return PrepareOK; }
+  // Indicates if all parameters were correctly defined.
+
+  bool SingularValuesFound() { return ValuesOK; }
+  // Indicates if the requested singular values are available.
+
+  bool SingularVectorsFound() { return VectorsOK; }
+  // Indicates if the requested singular vectors are available.
+
+  int ConvergedSingularValues() { return nconv; }
+  // Provides the number of singular values found. They are stored
+  // in increasing order.
+
+  ARFLOAT SingularValue(int i);
+  // Provides the i-eth singular value.
+
+  ARFLOAT LeftSingularVector(int i, int j);
+  // Provides element j of the i-eth left singular vector.
+
+  ARFLOAT RightSingularVector(int i, int j);
+  // Provides element j of the i-eth right singular vector.
+
+  ARFLOAT* RawSingularValues();
+  // Provides raw access to the singular values.
+
+  ARFLOAT* RawLeftSingularVectors();
+  // Provides raw access to the left singular vectors (m x nconv).
+
+  ARFLOAT* RawLeftSingularVector(int i);
+  // Provides raw access to the i-eth left singular vector.
+
+  ARFLOAT* RawRightSingularVectors();
+  // Provides raw access to the right singular vectors (n x nconv).
+
+  ARFLOAT* RawRightSingularVector(int i);
+  // Provides raw access to the i-eth right singular vector.
+
+
+ // e.5) Functions that provide access to internal variables' values.
+
+  int GetM() { return m; }
+  // Returns the number of rows of A.
+
+  int GetN() { return n; }
+  // Returns the number of columns of A.
+
+  int GetNsv() { return nsv; }
+  // Returns the number of singular values to be computed.
+
+  int GetNcv() { return ncv; }
+  // Returns the dimension of the bidiagonalization.
+
+  int GetMaxit() { return maxit; }
+  // Returns the maximum number of restarts.
+
+  ARFLOAT GetTol() { return tol; }
+  // Returns the stopping criterion.
+
+  const std::string& GetWhich() { return which; }
+  // Returns "which".
+
+  int GetIter() { return iter; }
+  // Returns the number of restarts performed.
+
+  const ARStats& GetStats() { return stats; }
+  // Returns the performance counters. nopx is the number of products
+  // with A and A' and nrestart the number of restarts.
+
+  void ResetStats() { stats.Reset(); }
+  // Sets all performance counters to zero.
+
+
+ // e.6) Functions that define the problem.
+
+  void DefineParameters(int mp, int np, int nsvp, ARFOP* objAp,
+                        TypeOPx MultAxp, TypeOPx MultAtxp,
+                        const std::string& whichp = "LM", int ncvp = 0,
+                        ARFLOAT tolp = 0.0, int maxitp = 0,
+                        ARFLOAT* residp = NULL);
+  // Sets the values of all parameters.
+
+
+ // e.7) Constructors and destructor.
+
+  ARSVD();
+  // Short constructor.
+
+  ARSVD(int nsvp, ARFOP& A, const std::string& whichp = "LM",
+        int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+        ARFLOAT* residp = NULL);
+  // Long constructor. A must be a matrix class (e.g. ARluNonSymMatrix
+  // or ARdsNonSymMatrix) that defines nrows(), ncols(), MultMv and
+  // MultMtv.
+
+  ARSVD(int mp, int np, int nsvp, ARFOP* objAp, TypeOPx MultAxp,
+        TypeOPx MultAtxp, const std::string& whichp = "LM",
+        int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+        ARFLOAT* residp = NULL);
+  // Long constructor (A is a m x n matrix supplied by the products
+  // objAp->MultAxp(x, y), y <- A*x, and objAp->MultAtxp(x, y),
+  // y <- A'*x).
+
+  ARSVD(const ARSVD& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARSVD() { ClearMem(); }
+  // Destructor.
+
+
+ // f) Operators.
+
+  ARSVD& operator=(const ARSVD& other);
+  // Assignment operator.
+
+}; // class ARSVD.
+
+
+// ------------------------------------------------------------------------ //
+// ARSVD member functions definition.                                      //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::ClearMem()
+{
+
+  if (V != NULL)     delete[] V;
+  if (U != NULL)     delete[] U;
+  if (Bm != NULL)    delete[] Bm;
+  if (Pm != NULL)    delete[] Pm;
+  if (QTm != NULL)   delete[] QTm;
+  if (Sm != NULL)    delete[] Sm;
+  if (Rnorm != NULL) delete[] Rnorm;
+  if (Cm != NULL)    delete[] Cm;
+  if (Tmp != NULL)   delete[] Tmp;
+  if (SVal != NULL)  delete[] SVal;
+  if (Wk != NULL)    delete[] Wk;
+  if (Index != NULL) delete[] Index;
+
+  V     = NULL;
+  U     = NULL;
+  Bm    = NULL;
+  Pm    = NULL;
+  QTm   = NULL;
+  Sm    = NULL;
+  Rnorm = NULL;
+  Cm    = NULL;
+  Tmp   = NULL;
+  SVal  = NULL;
+  Wk    = NULL;
+  Index = NULL;
+
+  PrepareOK = false;
+  ValuesOK  = false;
+  VectorsOK = false;
+  nconv     = 0;
+
+} // ClearMem.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::Copy(const ARSVD<ARFLOAT, ARFOP>& other)
+{
+
+  int mn;
+
+  // Copying user-defined parameters and internal variables.
+
+  objA      = other.objA;
+  MultAx    = other.MultAx;
+  MultAtx   = other.MultAtx;
+  m         = other.m;
+  n         = other.n;
+  nsv       = other.nsv;
+  ncv       = other.ncv;
+  maxit     = other.maxit;
+  tol       = other.tol;
+  which     = other.which;
+  resid     = other.resid;
+  newRes    = other.newRes;
+  PrepareOK = other.PrepareOK;
+  ValuesOK  = other.ValuesOK;
+  VectorsOK = other.VectorsOK;
+  nconv     = other.nconv;
+  iter      = other.iter;
+  lwk       = other.lwk;
+  seed      = other.seed;
+  fnorm     = other.fnorm;
+  eps23     = other.eps23;
+  rfloor    = other.rfloor;
+  stats     = other.stats;
+
+  V = U = Bm = Pm = QTm = Sm = Rnorm = Cm = Tmp = SVal = Wk = NULL;
+  Index = NULL;
+
+  if (!PrepareOK) return;
+
+  // Copying arrays.
+
+  mn    = (m > n) ? m : n;
+  V     = new ARFLOAT[n*(ncv+1)];
+  U     = new ARFLOAT[m*ncv];
+  Bm    = new ARFLOAT[ncv*ncv];
+  Pm    = new ARFLOAT[ncv*ncv];
+  QTm   = new ARFLOAT[ncv*ncv];
+  Sm    = new ARFLOAT[ncv];
+  Rnorm = new ARFLOAT[ncv];
+  Cm    = new ARFLOAT[ncv*ncv];
+  Tmp   = new ARFLOAT[mn*ncv];
+  SVal  = new ARFLOAT[nsv];
+  Wk    = new ARFLOAT[lwk];
+  Index = new int[ncv];
+
+  copy(n*(ncv+1), other.V, 1, V, 1);
+  copy(m*ncv, other.U, 1, U, 1);
+  copy(ncv*ncv, other.Bm, 1, Bm, 1);
+  copy(ncv*ncv, other.Pm, 1, Pm, 1);
+  copy(ncv*ncv, other.QTm, 1, QTm, 1);
+  copy(ncv, other.Sm, 1, Sm, 1);
+  copy(ncv, other.Rnorm, 1, Rnorm, 1);
+  copy(nsv, other.SVal, 1, SVal, 1);
+
+} // Copy.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::Prepare()
+{
+
+  int mn;
+
+  // Deleting old stuff.
+
+  ClearMem();
+
+  // Checking parameters.
+
+  nsv   = CheckNsv(nsv);
+  ncv   = CheckNcv(ncv);
+  maxit = CheckMaxit(maxit);
+  which = CheckWhich(which);
+  if (tol <= (ARFLOAT)0) tol = std::numeric_limits<ARFLOAT>::epsilon();
+
+  // Allocating memory. gesvd requires at least 5*ncv elements in Wk.
+
+  mn    = (m > n) ? m : n;
+  lwk   = 8*ncv;
+  V     = new ARFLOAT[n*(ncv+1)];
+  U     = new ARFLOAT[m*ncv];
+  Bm    = new ARFLOAT[ncv*ncv];
+  Pm    = new ARFLOAT[ncv*ncv];
+  QTm   = new ARFLOAT[ncv*ncv];
+  Sm    = new ARFLOAT[ncv];
+  Rnorm = new ARFLOAT[ncv];
+  Cm    = new ARFLOAT[ncv*ncv];
+  Tmp   = new ARFLOAT[mn*ncv];
+  SVal  = new ARFLOAT[nsv];
+  Wk    = new ARFLOAT[lwk];
+  Index = new int[ncv];
+
+  PrepareOK = true;
+
+} // Prepare.
+
+
+template<class ARFLOAT, class ARFOP>
+inline int ARSVD<ARFLOAT, ARFOP>::CheckNsv(int nsvp)
+{
+
+  if ((nsvp<1)||(nsvp>=((m<n)?m:n))) {
+    throw ArpackError(ArpackError::NEV_OUT_OF_BOUNDS, "ARSVD");
+  }
+  return nsvp;
+
+} // CheckNsv.
+
+
+template<class ARFLOAT, class ARFOP>
+inline int ARSVD<ARFLOAT, ARFOP>::CheckNcv(int ncvp)
+{
+
+  int mn;
+
+  // Adjusting ncv if ncv <= nsv or ncv > min(m,n).
+
+  mn = (m < n) ? m : n;
+  if (ncvp < nsv+1) {
+    if (ncvp) ArpackError::Set(ArpackError::NCV_OUT_OF_BOUNDS);
+    return ((2*nsv+1)>mn)?mn:(2*nsv+1);
+  }
+  else if (ncvp > mn) {
+    ArpackError::Set(ArpackError::NCV_OUT_OF_BOUNDS);
+    return mn;
+  }
+  else {
+    return ncvp;
+  }
+
+} // CheckNcv.
+
+
+template<class ARFLOAT, class ARFOP>
+inline int ARSVD<ARFLOAT, ARFOP>::CheckMaxit(int maxitp)
+{
+
+  if (maxitp >= 1) return maxitp;
+  if (maxitp < 0)  ArpackError::Set(ArpackError::MAXIT_NON_POSITIVE);
+  return 100*nsv;
+
+} // CheckMaxit.
+
+
+template<class ARFLOAT, class ARFOP>
+std::string ARSVD<ARFLOAT, ARFOP>::CheckWhich(const std::string& whichp)
+{
+
+  if ((whichp == "LM") || (whichp == "SM")) return whichp;
+  throw ArpackError(ArpackError::WHICH_UNDEFINED, "ARSVD");
+  return whichp;
+
+} // CheckWhich.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARSVD<ARFLOAT, ARFOP>::MultA(ARFLOAT* x, ARFLOAT* y, bool trans)
+{
+
+  double t0;
+
+  t0 = ARTime();
+  if (trans) {
+    (objA->*MultAtx)(x, y);
+  }
+  else {
+    (objA->*MultAx)(x, y);
+  }
+  stats.tuser += ARTime()-t0;
+  stats.nopx++;
+
+} // MultA.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::RandomVector(ARFLOAT* x, int k)
+{
+
+  int i;
+
+  // Simple linear congruential generator (values in (-1, 1)).
+
+  for (i=0; i<k; i++) {
+    seed = (seed*1103515245UL+12345UL)&0x7fffffffUL;
+    x[i] = ARFLOAT(2.0)*ARFLOAT(seed)/ARFLOAT(0x7fffffffUL)-ARFLOAT(1.0);
+  }
+
+} // RandomVector.
+
+
+template<class ARFLOAT, class ARFOP>
+ARFLOAT ARSVD<ARFLOAT, ARFOP>::
+Orthogonalize(ARFLOAT* x, ARFLOAT* Q, int k, int ldq, ARFLOAT* c)
+{
+
+  int     i, pass, tries;
+  ARFLOAT xnorm, xnorm0;
+  ARFLOAT* d;
+
+  d     = &Wk[lwk-ncv];
+  tries = 0;
+
+  for (;;) {
+
+    // Two passes of classical Gram-Schmidt (with the coefficients
+    // accumulated in c).
+
+    xnorm0 = nrm2(ldq, x, 1);
+    if (c != NULL) for (i=0; i<k; i++) c[i] = (ARFLOAT)0;
+    for (pass=0; (pass<2) && (k>0); pass++) {
+      gemv("T", ldq, k, (ARFLOAT)1, Q, ldq, x, 1, (ARFLOAT)0, d, 1);
+      gemv("N", ldq, k, (ARFLOAT)-1, Q, ldq, d, 1, (ARFLOAT)1, x, 1);
+      if (c != NULL) axpy(k, (ARFLOAT)1, d, 1, c, 1);
+    }
+    xnorm = nrm2(ldq, x, 1);
+
+    // Accepting x unless it lies (numerically) in the span of Q.
+
+    if ((xnorm > xnorm0*std::numeric_limits<ARFLOAT>::epsilon()*ARFLOAT(ldq))
+        && (xnorm > (ARFLOAT)0)) {
+      if (tries) return (ARFLOAT)0;
+      return xnorm;
+    }
+
+    // Trying a random vector instead (the original one only contained
+    // a combination of the columns of Q).
+
+    if (tries++ == 3) {
+      throw ArpackError(ArpackError::START_RESID_ZERO, "ARSVD::Orthogonalize");
+    }
+    RandomVector(x, ldq);
+    c = NULL;
+
+  }
+
+} // Orthogonalize.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::Extend(int k)
+{
+
+  int     i, j;
+  ARFLOAT alpha, beta, s;
+  ARFLOAT *u, *v;
+
+  // Adding one column to U and V at a time. The coefficients of
+  // A*v(j) on U are the j-th column of Bm (after a restart, the
+  // first one contains the "spike" of the thick restart). The
+  // coefficients of A'*u(j) on V only give Bm(j,j) and Bm(j,j+1)
+  // (the others are zero up to rounding errors).
+
+  for (j=k; j<ncv; j++) {
+
+    u = &U[j*m];
+    v = &V[j*n];
+
+    // Computing u(j) = A*v(j) - U*Bm(0:j-1,j).
+
+    MultA(v, u, false);
+    alpha = Orthogonalize(u, U, j, m, &Bm[j*ncv]);
+    for (i=j+1; i<ncv; i++) Bm[i+j*ncv] = (ARFLOAT)0;
+    Bm[j+j*ncv] = alpha;
+    s = (ARFLOAT)1/((alpha != (ARFLOAT)0) ? alpha : nrm2(m, u, 1));
+    scal(m, s, u, 1);
+
+    // Computing v(j+1) = A'*u(j) - V*[..., Bm(j,j)].
+
+    MultA(u, &v[n], true);
+    beta = Orthogonalize(&v[n], V, j+1, n, NULL);
+    s = (ARFLOAT)1/((beta != (ARFLOAT)0) ? beta : nrm2(n, &v[n], 1));
+    scal(n, s, &v[n], 1);
+    if (j+1 < ncv) Bm[j+(j+1)*ncv] = beta;
+    else fnorm = beta;
+
+  }
+
+} // Extend.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::Rotate(int k, bool final)
+{
+
+  int i, j;
+
+  // Computing V(:,0:k-1) = V*Q(:,Index) and U(:,0:k-1) = U*P(:,Index).
+
+  for (j=0; j<k; j++) {
+    for (i=0; i<ncv; i++) Cm[i+j*ncv] = QTm[Index[j]+i*ncv];
+  }
+  gemm("N", "N", n, k, ncv, (ARFLOAT)1, V, n, Cm, ncv, (ARFLOAT)0, Tmp, n);
+  copy(n*k, Tmp, 1, V, 1);
+
+  for (j=0; j<k; j++) copy(ncv, &Pm[Index[j]*ncv], 1, &Cm[j*ncv], 1);
+  gemm("N", "N", m, k, ncv, (ARFLOAT)1, U, m, Cm, ncv, (ARFLOAT)0, Tmp, m);
+  copy(m*k, Tmp, 1, U, 1);
+
+  if (final) return;
+
+  // The residual vector becomes the (k+1)-th right vector, and Bm
+  // becomes diagonal (the spike is recomputed by Extend).
+
+  copy(n, &V[ncv*n], 1, &V[k*n], 1);
+  for (i=0; i<ncv*ncv; i++) Bm[i] = (ARFLOAT)0;
+  for (j=0; j<k; j++) Bm[j+j*ncv] = Sm[Index[j]];
+
+} // Rotate.
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::Iterate()
+{
+
+  int     i, j, k, nc, info;
+  bool    large;
+  ARFLOAT eps, s;
+  double  t0;
+
+  t0    = ARTime();
+  large = (which == "LM");
+  eps   = std::numeric_limits<ARFLOAT>::epsilon();
+  eps23 = std::pow(eps, ARFLOAT(2.0)/ARFLOAT(3.0));
+
+  // Setting the starting vector.
+
+  if (newRes) {
+    copy(n, resid, 1, V, 1);
+  }
+  else {
+    RandomVector(V, n);
+  }
+  Orthogonalize(V, V, 0, n, NULL);
+  s = (ARFLOAT)1/nrm2(n, V, 1);
+  scal(n, s, V, 1);
+
+  k    = 0;
+  iter = 0;
+  for (;;) {
+
+    // Building the bidiagonalization and finding the SVD of Bm.
+
+    Extend(k);
+    copy(ncv*ncv, Bm, 1, Cm, 1);
+    gesvd("A", "A", ncv, ncv, Cm, ncv, Sm, Pm, ncv, QTm, ncv,
+          Wk, lwk-ncv, info);
+    if (info != 0) {
+      throw ArpackError(ArpackError::LAPACK_ERROR, "ARSVD::Iterate");
+    }
+
+    // Ordering the Ritz triplets (wanted values first) and checking
+    // convergence: ||A'*u-sigma*v|| = fnorm*|P(ncv-1,i)|. rfloor =
+    // ncv*eps*||Bm||_F.
+
+    rfloor = (ARFLOAT)0;
+    for (j=0; j<ncv; j++) rfloor = lapy2(rfloor, Sm[j]);
+    rfloor *= ARFLOAT(ncv)*eps;
+
+    nc = 0;
+    for (j=0; j<ncv; j++) {
+      Index[j] = large ? j : ncv-1-j;
+      Rnorm[j] = fnorm*std::fabs(Pm[ncv-1+Index[j]*ncv]);
+      if ((j < nsv) && Converged(Rnorm[j], Sm[Index[j]])) nc++;
+    }
+    if ((nc >= nsv) || (iter >= maxit)) break;
+
+    // Thick restart: keeping k Ritz triplets (ARPACK heuristic).
+
+    k = (ncv-nsv)/2;
+    if (nc < k) k = nc;
+    k += nsv;
+    if (k > ncv-1) k = ncv-1;
+
+    Rotate(k, false);
+    iter++;
+    stats.nrestart++;
+
+  }
+
+  if (nc < nsv) {
+    ArpackError(ArpackError::MAX_ITERATIONS, "ARSVD::Iterate");
+  }
+
+  // Storing the converged values (in increasing order) and moving
+  // the corresponding vectors to the first columns of U and V.
+
+  for (nconv=0, j=0; j<nsv; j++) {
+    if (Converged(Rnorm[j], Sm[Index[j]])) Index[nconv++] = Index[j];
+  }
+  if (large) {
+    for (j=0; j<nconv/2; j++) {
+      i = Index[j]; Index[j] = Index[nconv-1-j]; Index[nconv-1-j] = i;
+    }
+  }
+  for (j=0; j<nconv; j++) SVal[j] = Sm[Index[j]];
+  Rotate(nconv, true);
+
+  stats.taupp += ARTime()-t0;
+
+} // Iterate.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARSVD<ARFLOAT, ARFOP>::ChangeNsv(int nsvp)
+{
+
+  nsv = CheckNsv(nsvp);
+  ncv = CheckNcv(ncv);
+  Prepare();
+
+} // ChangeNsv.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARSVD<ARFLOAT, ARFOP>::ChangeNcv(int ncvp)
+{
+
+  ncv = CheckNcv(ncvp);
+  Prepare();
+
+} // ChangeNcv.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARSVD<ARFLOAT, ARFOP>::ChangeMaxit(int maxitp)
+{
+
+  maxit = CheckMaxit(maxitp);
+  ValuesOK  = false;
+  VectorsOK = false;
+
+} // ChangeMaxit.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARSVD<ARFLOAT, ARFOP>::ChangeTol(ARFLOAT tolp)
+{
+
+  tol = (tolp > (ARFLOAT)0) ? tolp : std::numeric_limits<ARFLOAT>::epsilon();
+  ValuesOK  = false;
+  VectorsOK = false;
+
+} // ChangeTol.
+
+
+template<class ARFLOAT, class ARFOP>
+inline void ARSVD<ARFLOAT, ARFOP>::ChangeWhich(const std::string& whichp)
+{
+
+  which = CheckWhich(whichp);
+  ValuesOK  = false;
+  VectorsOK = false;
+
+} // ChangeWhich.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARSVD<ARFLOAT, ARFOP>::FindSingularValues()
+{
+
+  // Singular vectors are a by-product of the bidiagonalization.
+
+  return FindSingularVectors();
+
+} // FindSingularValues.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARSVD<ARFLOAT, ARFOP>::FindSingularVectors()
+{
+
+  // Quitting the function if the problem was not defined.
+
+  if (!PrepareOK) {
+    throw ArpackError(ArpackError::PREPARE_NOT_OK, "FindSingularVectors");
+  }
+
+  // Running the restarted bidiagonalization.
+
+  if (!VectorsOK) {
+    Iterate();
+    ValuesOK  = true;
+    VectorsOK = true;
+  }
+  return nconv;
+
+} // FindSingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARSVD<ARFLOAT, ARFOP>::SingularValues(ARFLOAT* &svalp, bool ivec)
+{
+
+  if (ivec) {
+    FindSingularVectors();
+  }
+  else {
+    FindSingularValues();
+  }
+
+  // Copying singular values to svalp.
+
+  if (svalp == NULL) svalp = new ARFLOAT[nsv];
+  copy(nconv, SVal, 1, svalp, 1);
+  return nconv;
+
+} // SingularValues.
+
+
+template<class ARFLOAT, class ARFOP>
+int ARSVD<ARFLOAT, ARFOP>::
+SingularVectors(ARFLOAT* &Up, ARFLOAT* &Vp, ARFLOAT* svalp)
+{
+
+  FindSingularVectors();
+
+  // Copying singular vectors (and values) to the user arrays.
+
+  if (Up == NULL) Up = new ARFLOAT[m*nsv];
+  if (Vp == NULL) Vp = new ARFLOAT[n*nsv];
+  copy(m*nconv, U, 1, Up, 1);
+  copy(n*nconv, V, 1, Vp, 1);
+  if (svalp != NULL) copy(nconv, SVal, 1, svalp, 1);
+  return nconv;
+
+} // SingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT ARSVD<ARFLOAT, ARFOP>::SingularValue(int i)
+{
+
+  // Returning i-eth singular value.
+
+  if (!ValuesOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "SingularValue(i)");
+  }
+  else if ((i>=nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "SingularValue(i)");
+  }
+  return SVal[i];
+
+} // SingularValue(i).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT ARSVD<ARFLOAT, ARFOP>::LeftSingularVector(int i, int j)
+{
+
+  // Returning element j of i-eth left singular vector.
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "LeftSingularVector(i,j)");
+  }
+  else if ((i>=nconv)||(i<0)||(j>=m)||(j<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "LeftSingularVector(i,j)");
+  }
+  return U[i*m+j];
+
+} // LeftSingularVector(i,j).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT ARSVD<ARFLOAT, ARFOP>::RightSingularVector(int i, int j)
+{
+
+  // Returning element j of i-eth right singular vector.
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RightSingularVector(i,j)");
+  }
+  else if ((i>=nconv)||(i<0)||(j>=n)||(j<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "RightSingularVector(i,j)");
+  }
+  return V[i*n+j];
+
+} // RightSingularVector(i,j).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARSVD<ARFLOAT, ARFOP>::RawSingularValues()
+{
+
+  if (!ValuesOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "RawSingularValues");
+  }
+  return SVal;
+
+} // RawSingularValues.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARSVD<ARFLOAT, ARFOP>::RawLeftSingularVectors()
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawLeftSingularVectors");
+  }
+  return U;
+
+} // RawLeftSingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARSVD<ARFLOAT, ARFOP>::RawLeftSingularVector(int i)
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawLeftSingularVector(i)");
+  }
+  else if ((i>=nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "RawLeftSingularVector(i)");
+  }
+  return &U[i*m];
+
+} // RawLeftSingularVector(i).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARSVD<ARFLOAT, ARFOP>::RawRightSingularVectors()
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawRightSingularVectors");
+  }
+  return V;
+
+} // RawRightSingularVectors.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARFLOAT* ARSVD<ARFLOAT, ARFOP>::RawRightSingularVector(int i)
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK,
+                      "RawRightSingularVector(i)");
+  }
+  else if ((i>=nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "RawRightSingularVector(i)");
+  }
+  return &V[i*n];
+
+} // RawRightSingularVector(i).
+
+
+template<class ARFLOAT, class ARFOP>
+void ARSVD<ARFLOAT, ARFOP>::
+DefineParameters(int mp, int np, int nsvp, ARFOP* objAp, TypeOPx MultAxp,
+                 TypeOPx MultAtxp, const std::string& whichp, int ncvp,
+                 ARFLOAT tolp, int maxitp, ARFLOAT* residp)
+{
+
+  // Setting user defined parameters.
+
+  objA    = objAp;
+  MultAx  = MultAxp;
+  MultAtx = MultAtxp;
+  m       = mp;
+  n       = np;
+  if ((m < 2) || (n < 2)) {
+    throw ArpackError(ArpackError::N_SMALLER_THAN_2);
+  }
+  nsv     = nsvp;
+  ncv     = ncvp;
+  maxit   = maxitp;
+  tol     = tolp;
+  which   = whichp;
+  resid   = residp;
+  newRes  = (residp != NULL);
+
+  // Checking parameters and allocating memory.
+
+  Prepare();
+
+} // DefineParameters.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARSVD<ARFLOAT, ARFOP>::ARSVD()
+{
+
+  objA    = NULL;
+  MultAx  = NULL;
+  MultAtx = NULL;
+  m = n   = 0;
+  nsv     = 0;
+  ncv     = 0;
+  maxit   = 0;
+  tol     = (ARFLOAT)0;
+  which   = "LM";
+  resid   = NULL;
+  newRes  = false;
+  iter    = 0;
+  lwk     = 0;
+  seed    = 1UL;
+  fnorm   = (ARFLOAT)0;
+  eps23   = (ARFLOAT)0;
+  rfloor  = (ARFLOAT)0;
+  V = U = Bm = Pm = QTm = Sm = Rnorm = Cm = Tmp = SVal = Wk = NULL;
+  Index   = NULL;
+  ClearMem();
+
+} // Short constructor.
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARSVD<ARFLOAT, ARFOP>::
+ARSVD(int nsvp, ARFOP& A, const std::string& whichp, int ncvp,
+      ARFLOAT tolp, int maxitp, ARFLOAT* residp)
+{
+
+  seed = 1UL;
+  V = U = Bm = Pm = QTm = Sm = Rnorm = Cm = Tmp = SVal = Wk = NULL;
+  Index = NULL;
+  iter  = 0;
+  DefineParameters(A.nrows(), A.ncols(), nsvp, &A, &ARFOP::MultMv,
+                   &ARFOP::MultMtv, whichp, ncvp, tolp, maxitp, residp);
+
+} // Long constructor (matrix class).
+
+
+template<class ARFLOAT, class ARFOP>
+inline ARSVD<ARFLOAT, ARFOP>::
+ARSVD(int mp, int np, int nsvp, ARFOP* objAp, TypeOPx MultAxp,
+      TypeOPx MultAtxp, const std::string& whichp, int ncvp,
+      ARFLOAT tolp, int maxitp, ARFLOAT* residp)
+{
+
+  seed = 1UL;
+  V = U = Bm = Pm = QTm = Sm = Rnorm = Cm = Tmp = SVal = Wk = NULL;
+  Index = NULL;
+  iter  = 0;
+  DefineParameters(mp, np, nsvp, objAp, MultAxp, MultAtxp, whichp,
+                   ncvp, tolp, maxitp, residp);
+
+} // Long constructor (user defined products).
+
+
+template<class ARFLOAT, class ARFOP>
+ARSVD<ARFLOAT, ARFOP>& ARSVD<ARFLOAT, ARFOP>::
+operator=(const ARSVD<ARFLOAT, ARFOP>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    ClearMem();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARSVD_H
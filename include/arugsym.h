@@ -62,6 +62,12 @@ class ARluSymGenEig:
 
   virtual void SetCayleyMode(ARFLOAT sigmap);
 
+  void SetFactorCache(int maxentries, std::size_t budget = 0)
+  { Pencil.SetFactorCache(maxentries, budget); }
+  // Keeps the factors of A-sigma*B computed for up to maxentries
+  // previous shifts (see ARumSymPencil::SetFactorCache), so ChangeShift
+  // does not factor A-sigma*B again when one of them is used.
+
  // c.2) Constructors and destructor.
 
   ARluSymGenEig() { }
@@ -117,7 +123,9 @@ template<class ARFLOAT>
 inline void ARluSymGenEig<ARFLOAT>::ChangeShift(ARFLOAT sigmap)
 {
 
+  this->StartFactor();
   this->objOP->FactorAsB(sigmap);
+  this->StopFactor();
   ARrcSymGenEig<ARFLOAT>::ChangeShift(sigmap);
 
 } // ChangeShift.
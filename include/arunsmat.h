@@ -21,6 +21,7 @@
 #define ARUNSMAT_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "armat.h"
@@ -85,8 +86,14 @@ class ARumNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMV(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Computes Y = M*X reading the entries of M only once.
+
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
+  void MultMtV(ARTYPE* X, ARTYPE* Y, int nvec);
+  // Computes Y = M'*X reading the entries of M only once.
+
   void MultMtMv(ARTYPE* v, ARTYPE* w);
 
   void MultMMtv(ARTYPE* v, ARTYPE* w);
@@ -95,6 +102,9 @@ class ARumNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+  // Solves the systems one column at a time (X and Y must differ).
+
   void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
                     int* pcolp, double thresholdp = 0.1,
                     int fillinp = 9, bool simest = false,
@@ -288,8 +298,19 @@ inline void ARumNonSymMatrix<ARTYPE, ARFLOAT>::CreateStructure()
   lindex = 30*this->n+dimfact;     // ?????
   lvalue = dimfact;
 
-  value  = new ARTYPE[lvalue];
-  index  = new int[lindex];
+  value  = NULL;
+  index  = NULL;
+  try {
+    value  = new ARTYPE[lvalue];
+    index  = new int[lindex];
+  }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    delete[] value;
+    value    = NULL;
+    factored = false;
+    throw ArpackError(ArpackError::MEMORY_OVERFLOW,
+                      "ARumNonSymMatrix::FactorA");
+  }
 
 } // CreateStructure.
 
@@ -430,6 +451,38 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 } // MultMv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  int    i, j, k, l;
+  ARTYPE t;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumNonSymMatrix::MultMV");
+  }
+
+  // Determining Y = M.X. Each column of M is used by all the nvec
+  // products before the next one is read.
+
+  for (i=0; i!=this->m*nvec; i++) Y[i]=(ARTYPE)0;
+
+  for (i=0; i!=this->n; i++) {
+    for (k=0; k!=nvec; k++) {
+      t = X[k*this->n+i];
+      l = k*this->m;
+      for (j=pcol[i]; j!=pcol[i+1]; j++) {
+        Y[l+irow[j]] += t*a[j];
+      }
+    }
+  }
+
+} // MultMV.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 {
@@ -456,6 +509,37 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 } // MultMtv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMtV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
+
+  int    i, j, k, l;
+  ARTYPE t;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumNonSymMatrix::MultMtV");
+  }
+
+  // Determining Y = M'.X. Each column of M is used by all the nvec
+  // products before the next one is read.
+
+  for (i=0; i!=this->n; i++) {
+    for (k=0; k!=nvec; k++) {
+      t = (ARTYPE)0;
+      l = k*this->m;
+      for (j=pcol[i]; j!=pcol[i+1]; j++) {
+        t += X[l+irow[j]]*a[j];
+      }
+      Y[k*this->n+i] = t;
+    }
+  }
+
+} // MultMtV.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 {
@@ -474,12 +558,30 @@ template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[this->n];
+  int    i,j;
+  ARTYPE t;
 
-  MultMtv(v,t);
-  MultMv(t,w);
+  // Quitting the function if A was not defined.
 
-  delete[] t;
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARumNonSymMatrix::MultMMtv");
+  }
+
+  // Determining w = M.M'.v. Each column of M is used twice while it is
+  // still in cache: t = M(:,i)'.v is computed and t*M(:,i) is added to w.
+
+  for (i=0; i!=this->m; i++) w[i]=(ARTYPE)0;
+
+  for (i=0; i!=this->n; i++) {
+    t = (ARTYPE)0;
+    for (j=pcol[i]; j!=pcol[i+1]; j++) {
+      t += v[irow[j]]*a[j];
+    }
+    for (j=pcol[i]; j!=pcol[i+1]; j++) {
+      w[irow[j]] += t*a[j];
+    }
+  }
 
 } // MultMMtv.
 
@@ -517,6 +619,33 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymMatrix<ARTYPE, ARFLOAT>::
+MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARumNonSymMatrix::MultInvV");
+  }
+
+  // Solving A.Y = X (or AsI.Y = X) one column at a time, with the same
+  // workspace. X and Y must not overlap.
+
+  ARTYPE* space = new ARTYPE[2*this->n];
+
+  for (int j=0; j<nrhs; j++) {
+    um2so(this->n, 0, false, lvalue, lindex, value, index, keep,
+          &X[j*this->n], &Y[j*this->n], space, cntl, icntl, info, rinfo);
+  }
+
+  delete[] space;
+
+} // MultInvV.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARumNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
@@ -615,6 +744,10 @@ ARumNonSymMatrix(const std::string& name, double thresholdp, int fillinp,
   catch (ArpackError) {    // Returning from here if an error has occurred.
     throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARumNonSymMatrix");
   }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "ARumNonSymMatrix");
+    throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARumNonSymMatrix");
+  }
 
   if (mat.NCols()==mat.NRows()) {
     DefineMatrix(mat.NCols(), mat.NonZeros(), (ARTYPE*)mat.Entries(),
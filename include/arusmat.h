@@ -28,13 +28,43 @@
 #define ARUSMAT_H
 
 #include <cstddef>
+#include <new>
 #include <string>
 #include "arch.h"
 #include "armat.h"
 #include "arhbmat.h"
+#include "arspmv.h"
 #include "arerror.h"
 //#include "blas1c.h"
 #include "umfpackc.h"
+#include "arfcache.h"
+
+
+// ARumFactor: LU factors of A-sigma*I (or A-sigma*B) stored by
+// ARFactorCache, with the matrix used by umfpack_di_solve.
+
+template<class ARTYPE>
+struct ARumFactor {
+  void*   Numeric;
+  int*    Ap;
+  int*    Ai;
+  ARTYPE* Ax;
+};
+
+template<class ARTYPE>
+inline std::size_t ARumFactorSize(int n, ARumFactor<ARTYPE>& f)
+{
+
+  // Returns the (approximate) memory taken by f, in bytes.
+
+  int lnz, unz, nrow, ncol, nzud;
+
+  umfpack_di_get_lunz(&lnz, &unz, &nrow, &ncol, &nzud, f.Numeric);
+  return std::size_t(lnz+unz+f.Ap[n])*(sizeof(ARTYPE)+sizeof(int))+
+         std::size_t(n+1)*sizeof(int);
+
+} // ARumFactorSize.
+
 
 template<class ARTYPE> class ARumSymPencil;
 
@@ -64,10 +94,16 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
   double  threshold;
   ARTYPE* a;
   ARhbMatrix<int, ARTYPE> mat;
+  ARspSymMV<ARTYPE>       prod;
   void*   Numeric;
+  void*   Symbolic;
   int*    Ap;
   int*    Ai;
   ARTYPE* Ax; 
+  bool    shifted;
+  ARTYPE  sigmaf;
+  unsigned long version;
+  ARFactorCache<ARTYPE, ARumFactor<ARTYPE>, ARumSymMatrix<ARTYPE> > cache;
 
   bool DataOK();
 
@@ -75,12 +111,22 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
 
   void ClearMem();
 
-  void ExpandA(ARTYPE sigma = (ARTYPE)0);
+  void ExpandA(ARTYPE sigma = (ARTYPE)0, bool diag = false);
 
 //  void CreateStructure();
 
   void ThrowError();
 
+  void FreeFactor(ARumFactor<ARTYPE>& f);
+
+  void ReleaseFactor();
+  // Moves Numeric, Ap, Ai and Ax to the cache if Numeric contains the
+  // factors of A-sigmaf*I, or deletes them otherwise.
+
+  bool ReuseFactor(ARTYPE sigma);
+  // Returns true if Numeric contains (or was taken from the cache and
+  // now contains) the factors of A-sigma*I.
+
  public:
 
   int nzeros() { return nnz; }
@@ -93,10 +139,46 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
 
   void FactorAsI(ARTYPE sigma);
 
+  void ClearSymbolic();
+  // Discards the symbolic analysis of A-sigma*I that was computed by
+  // the first call to FactorAsI and is reused by the following ones.
+  // Must be called if the sparsity pattern of A (irow, pcol) was
+  // changed after DefineMatrix. Changes in the values of A only
+  // require a call to ChangeValues.
+
+  void ChangeValues();
+  // Must be called when the values of A (but not its pattern) were
+  // changed after DefineMatrix. The factors of A-sigma*I computed
+  // before (including those stored in the cache) are discarded.
+
+  void SetFactorCache(int maxentries, std::size_t budget = 0);
+  // Keeps the factors of A-sigma*I computed for up to maxentries
+  // previous shifts, taking at most budget bytes (0 = no limit), so
+  // FactorAsI does not factor A-sigma*I again when one of these shifts
+  // is used. The least recently used factors are discarded first.
+  // maxentries = 0 (the default) disables the cache. The factors of
+  // the last shift are always reused if sigma is not changed.
+
+  int GetCacheEntries() { return cache.GetEntries(); }
+
+  std::size_t GetCacheMemory() { return cache.GetMemory(); }
+
+  int GetCacheHits() { return cache.GetHits(); }
+
+  int GetThreads() { return prod.GetThreads(); }
+
+  void ChangeThreads(int nthreadsp) { prod.ChangeThreads(nthreadsp); }
+  // Changes the number of threads used by MultMv (0 = OpenMP default).
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMV(ARTYPE* X, ARTYPE* Y, int nvec);
+
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs);
+  // Solves the systems one column at a time (X and Y must differ).
+
   void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
                     int* pcolp, char uplop = 'L', double thresholdp = 0.1, 
                     int fillinp = 9, bool reducible = true, bool check = true);
@@ -104,7 +186,10 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
   ARumSymMatrix(): ARMatrix<ARTYPE>()
   {
     factored = false;
+    shifted = false;
+    version = 0;
     Numeric = NULL;
+    Symbolic = NULL;
     Ap = NULL;
     Ai = NULL;
     Ax = NULL;
@@ -123,7 +208,7 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
   ARumSymMatrix(const ARumSymMatrix& other) { Copy(other); }
   // Copy constructor.
 
-  virtual ~ARumSymMatrix() { ClearMem(); }
+  virtual ~ARumSymMatrix() { ClearMem(); ClearSymbolic(); }
   // Destructor.
 
   ARumSymMatrix& operator=(const ARumSymMatrix& other);
@@ -192,6 +277,115 @@ inline void ARumSymMatrix<ARTYPE>::ClearMem()
 } // ClearMem.
 
 
+template<class ARTYPE>
+inline void ARumSymMatrix<ARTYPE>::ClearSymbolic()
+{
+
+  if (Symbolic) umfpack_di_free_symbolic(&Symbolic);
+  Symbolic = NULL;
+
+  // The factors stored in the cache are discarded as well.
+
+  cache.Clear();
+  shifted = false;
+
+} // ClearSymbolic.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::FreeFactor(ARumFactor<ARTYPE>& f)
+{
+
+  umfpack_di_free_numeric(&f.Numeric);
+  delete[] f.Ap;
+  delete[] f.Ai;
+  delete[] f.Ax;
+
+} // FreeFactor.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::ReleaseFactor()
+{
+
+  ARumFactor<ARTYPE> f;
+
+  if (factored && shifted && cache.Enabled()) {
+
+    f.Numeric = Numeric;
+    f.Ap      = Ap;
+    f.Ai      = Ai;
+    f.Ax      = Ax;
+    Numeric   = NULL;
+    Ap        = NULL;
+    Ai        = NULL;
+    Ax        = NULL;
+    cache.Store(sigmaf, version, f, ARumFactorSize(this->n, f));
+
+  }
+  else {
+
+    ClearMem();
+
+  }
+  factored = false;
+  shifted  = false;
+
+} // ReleaseFactor.
+
+
+template<class ARTYPE>
+bool ARumSymMatrix<ARTYPE>::ReuseFactor(ARTYPE sigma)
+{
+
+  ARumFactor<ARTYPE> f;
+
+  // Checking if Numeric already contains the factors of A-sigma*I.
+
+  if (factored && shifted && (sigmaf == sigma)) return true;
+
+  // Looking for the factors of A-sigma*I in the cache.
+
+  if (!cache.Retrieve(sigma, version, f)) return false;
+
+  // Replacing the current factors by those found in the cache.
+
+  ReleaseFactor();
+  Numeric  = f.Numeric;
+  Ap       = f.Ap;
+  Ai       = f.Ai;
+  Ax       = f.Ax;
+  factored = true;
+  shifted  = true;
+  sigmaf   = sigma;
+  return true;
+
+} // ReuseFactor.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::ChangeValues()
+{
+
+  // The current factors can no longer be reused by FactorAsI.
+
+  cache.Clear();
+  shifted = false;
+  version++;
+
+} // ChangeValues.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::
+SetFactorCache(int maxentries, std::size_t budget)
+{
+
+  cache.Define(this, &ARumSymMatrix<ARTYPE>::FreeFactor, maxentries, budget);
+
+} // SetFactorCache.
+
+
 
 template<class ARTYPE>
 void ARumSymMatrix<ARTYPE>::Copy(const ARumSymMatrix<ARTYPE>& other)
@@ -199,6 +393,11 @@ void ARumSymMatrix<ARTYPE>::Copy(const ARumSymMatrix<ARTYPE>& other)
 
   // Copying very fundamental variables.
   ClearMem();
+  Symbolic = NULL;
+  shifted  = false;
+  version  = 0;
+  cache.Define(this, &ARumSymMatrix<ARTYPE>::FreeFactor,
+               other.cache.GetMaxEntries(), other.cache.GetBudget());
 
   // Copying very fundamental variables and user-defined parameters.
 
@@ -215,6 +414,7 @@ void ARumSymMatrix<ARTYPE>::Copy(const ARumSymMatrix<ARTYPE>& other)
   a         = other.a;
   threshold = other.threshold;
   uplo      = other.uplo;
+  prod      = other.prod;
 
   // Returning from here if "other" was not initialized.
 
@@ -229,14 +429,15 @@ void ARumSymMatrix<ARTYPE>::Copy(const ARumSymMatrix<ARTYPE>& other)
 } // Copy.
 
 template<class ARTYPE>
-void ARumSymMatrix<ARTYPE>::ExpandA(ARTYPE sigma)
+void ARumSymMatrix<ARTYPE>::ExpandA(ARTYPE sigma, bool diag)
 {
 std::cout <<"ARumSymMatrix::ExpandA(" << sigma << ") ..." << std::flush; 
 
   ClearMem();
  
-  // Checking if sigma is zero.
-  bool subtract = (sigma != (ARTYPE)0);
+  // Checking if sigma is zero (all diagonal elements are stored
+  // if diag is true).
+  bool subtract = (diag || (sigma != (ARTYPE)0));
 
   int mynnz = 2*nnz;
   if (subtract) mynnz = 2*nnz + this->n; // some space for the diag entries just in case
@@ -491,14 +692,17 @@ std::cout <<"ARumSymMatrix::FactorA " << std::endl;
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumSymMatrix::FactorA");
   }
 
+  // Deleting the previous factors (or storing them in the cache).
+  ReleaseFactor();
+
   ExpandA(); // create Ap Ai Ax
 
-  void *Symbolic ;
-  status = umfpack_di_symbolic (this->n, this->n, Ap, Ai, Ax, &Symbolic, NULL, NULL) ;
+  void *SymbolicA ;
+  status = umfpack_di_symbolic (this->n, this->n, Ap, Ai, Ax, &SymbolicA, NULL, NULL) ;
   ThrowError();
-  status =  umfpack_di_numeric (Ap, Ai, Ax, Symbolic, &Numeric, NULL, NULL) ;
+  status =  umfpack_di_numeric (Ap, Ai, Ax, SymbolicA, &Numeric, NULL, NULL) ;
   ThrowError();
-  umfpack_di_free_symbolic (&Symbolic) ;
+  umfpack_di_free_symbolic (&SymbolicA) ;
 
 /*
 
@@ -531,25 +735,34 @@ std::cout <<"ARumSymMatrix::FactorAsI " << sigma  << std::endl;
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumSymMatrix::FactorAsI");
   }
 
+  // Reusing the factors of A-sigma*I computed before, if possible.
+  if (ReuseFactor(sigma)) return;
+
+  // Deleting the previous factors (or storing them in the cache).
+  ReleaseFactor();
+
   // Reserving memory for some vectors used in matrix decomposition.
   //CreateStructure();
 
-  // Subtracting sigma*I from A.
-  ExpandA(sigma);
+  // Subtracting sigma*I from A. Because all diagonal elements are
+  // stored, the pattern of AsI does not depend on sigma.
+  ExpandA(sigma, true);
 
   // Decomposing AsI.
   double Info [UMFPACK_INFO], Control [UMFPACK_CONTROL];
   umfpack_di_defaults (Control) ;
   //std::cout << " Ap[n] = " << Ap[this->n] << std::flush;
 
-  void *Symbolic ;
-  status = umfpack_di_symbolic (this->n, this->n, Ap, Ai, Ax, &Symbolic, Control, Info) ;
-  //std::cout << " symbolic status: " << status << std::endl;
-  ThrowError();
+  // The symbolic analysis is computed only once and reused
+  // by the following calls.
+  if (Symbolic == NULL) {
+    status = umfpack_di_symbolic (this->n, this->n, Ap, Ai, Ax, &Symbolic, Control, Info) ;
+    //std::cout << " symbolic status: " << status << std::endl;
+    ThrowError();
+  }
   status =  umfpack_di_numeric (Ap, Ai, Ax, Symbolic, &Numeric, NULL, NULL) ;
   //std::cout << " numeric status: " << status << std::endl;
   ThrowError();
-  umfpack_di_free_symbolic (&Symbolic) ;
 
 // // Decomposing AsI.
 //  um2fa(this->n, index[this->n], 0, false, lvalue, lindex, value,
@@ -557,6 +770,8 @@ std::cout <<"ARumSymMatrix::FactorAsI " << sigma  << std::endl;
 
 
   factored = true;
+  shifted  = true;
+  sigmaf   = sigma;
 
 } // FactorAsI.
 
@@ -564,10 +779,6 @@ std::cout <<"ARumSymMatrix::FactorAsI " << sigma  << std::endl;
 template<class ARTYPE>
 void ARumSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 {
-//std::cout <<"ARumSymMatrix::MultMv ..." << std::flush; 
-
-  int    i,j,k;
-  ARTYPE t;
 
   // Quitting the function if A was not defined.
 
@@ -577,42 +788,26 @@ void ARumSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 
   // Determining w = M.v.
 
-  for (i=0; i!=this->m; i++) w[i]=(ARTYPE)0;
+  prod.MultMv(v, w);
 
-  if (uplo == 'U') {
+} // MultMv.
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i+1];
-      if ((k!=pcol[i])&&(irow[k-1]==i)) {
-        w[i] += t*a[k-1];
-        k--;
-      }
-      for (j=pcol[i]; j<k; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
 
-  }
-  else {
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultMV(ARTYPE* X, ARTYPE* Y, int nvec)
+{
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i];
-      if ((k!=pcol[i+1])&&(irow[k]==i)) {
-        w[i] += t*a[k];
-        k++;
-      }
-      for (j=k; j<pcol[i+1]; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
+  // Quitting the function if A was not defined.
 
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumSymMatrix::MultMV");
   }
 
-} // MultMv.
+  // Determining Y = M.X.
+
+  prod.MultMV(X, Y, nvec);
+
+} // MultMV.
 
 
 template<class ARTYPE>
@@ -641,6 +836,31 @@ void ARumSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultInvV(ARTYPE* X, ARTYPE* Y, int nrhs)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARumSymMatrix::MultInvV");
+  }
+
+  // Solving A.Y = X (or AsI.Y = X). UMFPACK solves one column at a
+  // time, so X and Y must not overlap.
+
+  for (int j=0; j<nrhs; j++) {
+    status = umfpack_di_solve (UMFPACK_A, Ap, Ai, Ax, &Y[j*this->n],
+                               &X[j*this->n], Numeric, NULL, NULL) ;
+    if (status != UMFPACK_OK)
+      throw ArpackError(ArpackError::PARAMETER_ERROR,
+                        "ARumSymMatrix::MultInvV");
+  }
+
+} // MultInvV.
+
+
 template<class ARTYPE>
 inline void ARumSymMatrix<ARTYPE>::
 DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
@@ -648,6 +868,10 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
              int fillinp, bool reducible, bool check)
 {
 
+  // Discarding the symbolic analysis of the previous matrix.
+  ClearSymbolic();
+  version++;
+
   this->m   = np;
   this->n   = np;
   nnz       = nnzp;
@@ -671,6 +895,10 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
                       "ARumSymMatrix::DefineMatrix");
   }
 
+  // Preparing the matrix-vector product.
+
+  prod.Define(this->n, a, irow, pcol, uplo);
+
   this->defined = true;
 
 } // DefineMatrix.
@@ -683,10 +911,13 @@ ARumSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
               int fillinp, bool reducible, bool check)   : ARMatrix<ARTYPE>(np)
 {
   Numeric = NULL;
+  Symbolic = NULL;
   Ap = NULL;
   Ai = NULL;
   Ax = NULL;
   factored = false;
+  shifted = false;
+  version = 0;
   DefineMatrix(np, nnzp, ap, irowp, pcolp, uplop,
                thresholdp, fillinp, reducible, check);
 
@@ -699,11 +930,14 @@ ARumSymMatrix(const std::string& file, double thresholdp, int fillinp,
               bool reducible, bool check)
 {
   Numeric = NULL;
+  Symbolic = NULL;
   Ap = NULL;
   Ai = NULL;
   Ax = NULL;
 
   factored = false;
+  shifted = false;
+  version = 0;
 
   try {
     mat.Define(file);
@@ -711,6 +945,10 @@ ARumSymMatrix(const std::string& file, double thresholdp, int fillinp,
   catch (ArpackError) {    // Returning from here if an error has occurred.
     throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARumSymMatrix");
   }
+  catch (const std::bad_alloc&) { // Memory is not sufficient.
+    ArpackError(ArpackError::MEMORY_OVERFLOW, "ARumSymMatrix");
+    throw ArpackError(ArpackError::CANNOT_READ_FILE, "ARumSymMatrix");
+  }
 
   if ((mat.NCols() == mat.NRows()) && (mat.IsSymmetric())) {
 
@@ -733,6 +971,7 @@ operator=(const ARumSymMatrix<ARTYPE>& other)
 
   if (this != &other) { // Stroustrup suggestion.
     ClearMem();
+    ClearSymbolic();
     Copy(other);
   }
   return *this;
@@ -86,7 +86,9 @@ inline void ARluNonSymStdEig<ARFLOAT>::ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -109,6 +111,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARumNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, 
                        &ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -141,6 +144,7 @@ ARluNonSymStdEig(int nevp, ARumNonSymMatrix<ARFLOAT, ARFLOAT>& A,
                    &ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
@@ -30,6 +30,7 @@
 //#include "lapackc.h"
 #include "arusmat.h"
 #include "blas1c.h"
+#include "arfcache.h"
 
 
 template<class ARTYPE>
@@ -45,6 +46,9 @@ class ARumSymPencil
   int*    Ap;
   int*    Ai;
   ARTYPE* Ax; 
+  ARTYPE  sigmaf;
+  unsigned long fversion;
+  ARFactorCache<ARTYPE, ARumFactor<ARTYPE>, ARumSymPencil<ARTYPE> > cache;
 
   virtual void Copy(const ARumSymPencil& other);
 
@@ -56,6 +60,18 @@ class ARumSymPencil
 //  void SubtractAsB(ARTYPE sigma);
   void ClearMem();
 
+  unsigned long Version() { return A->version+B->version; }
+
+  void FreeFactor(ARumFactor<ARTYPE>& f);
+
+  void ReleaseFactor();
+  // Moves Numeric, Ap, Ai and Ax to the cache, or deletes them if the
+  // cache is disabled.
+
+  bool ReuseFactor(ARTYPE sigma);
+  // Returns true if Numeric contains (or was taken from the cache and
+  // now contains) the factors of A-sigma*B.
+
  public:
 
   bool IsFactored() { return (Numeric != NULL); }
@@ -71,6 +87,20 @@ class ARumSymPencil
   //void MultInvAsBv(ARTYPE* v, ARTYPE* w) { AsB.MultInvv(v,w); }
   void MultInvAsBv(ARTYPE* v, ARTYPE* w);
 
+  void SetFactorCache(int maxentries, std::size_t budget = 0);
+  // Keeps the factors of A-sigma*B computed for up to maxentries
+  // previous shifts, taking at most budget bytes (0 = no limit), so
+  // FactorAsB does not factor A-sigma*B again when one of these shifts
+  // is used. maxentries = 0 disables the cache. The factors of the
+  // last shift are always reused if sigma, A and B are not changed
+  // (see ARumSymMatrix::ChangeValues).
+
+  int GetCacheEntries() { return cache.GetEntries(); }
+
+  std::size_t GetCacheMemory() { return cache.GetMemory(); }
+
+  int GetCacheHits() { return cache.GetHits(); }
+
   void DefineMatrices(ARumSymMatrix<ARTYPE>& Ap, ARumSymMatrix<ARTYPE>& Bp);
 
   //ARumSymPencil() { AsB.factored = false; }
@@ -83,7 +113,7 @@ class ARumSymPencil
   ARumSymPencil(const ARumSymPencil& other) { Copy(other); }
   // Copy constructor.
 
-  virtual ~ARumSymPencil() { }
+  virtual ~ARumSymPencil() { cache.Clear(); }
   // Destructor.
 
   ARumSymPencil& operator=(const ARumSymPencil& other);
@@ -111,6 +141,76 @@ inline void ARumSymPencil<ARTYPE>::ClearMem()
 } // ClearMem.
 
 
+template<class ARTYPE>
+void ARumSymPencil<ARTYPE>::FreeFactor(ARumFactor<ARTYPE>& f)
+{
+
+  umfpack_di_free_numeric(&f.Numeric);
+  delete[] f.Ap;
+  delete[] f.Ai;
+  delete[] f.Ax;
+
+} // FreeFactor.
+
+
+template<class ARTYPE>
+void ARumSymPencil<ARTYPE>::ReleaseFactor()
+{
+
+  ARumFactor<ARTYPE> f;
+
+  if ((Numeric != NULL) && cache.Enabled()) {
+
+    f.Numeric = Numeric;
+    f.Ap      = Ap;
+    f.Ai      = Ai;
+    f.Ax      = Ax;
+    Numeric   = NULL;
+    Ap        = NULL;
+    Ai        = NULL;
+    Ax        = NULL;
+    cache.Store(sigmaf, fversion, f, ARumFactorSize(A->n, f));
+
+  }
+  else {
+
+    ClearMem();
+
+  }
+
+} // ReleaseFactor.
+
+
+template<class ARTYPE>
+bool ARumSymPencil<ARTYPE>::ReuseFactor(ARTYPE sigma)
+{
+
+  ARumFactor<ARTYPE> f;
+
+  // Checking if Numeric already contains the factors of A-sigma*B.
+
+  if ((Numeric != NULL) && (sigmaf == sigma) && (fversion == Version())) {
+    return true;
+  }
+
+  // Looking for the factors of A-sigma*B in the cache.
+
+  if (!cache.Retrieve(sigma, Version(), f)) return false;
+
+  // Replacing the current factors by those found in the cache.
+
+  ReleaseFactor();
+  Numeric  = f.Numeric;
+  Ap       = f.Ap;
+  Ai       = f.Ai;
+  Ax       = f.Ax;
+  sigmaf   = sigma;
+  fversion = Version();
+  return true;
+
+} // ReuseFactor.
+
+
 
 template<class ARTYPE>
 inline void ARumSymPencil<ARTYPE>::Copy(const ARumSymPencil<ARTYPE>& other)
@@ -118,6 +218,8 @@ inline void ARumSymPencil<ARTYPE>::Copy(const ARumSymPencil<ARTYPE>& other)
   ClearMem();
   A        = other.A;
   B        = other.B;
+  cache.Define(this, &ARumSymPencil<ARTYPE>::FreeFactor,
+               other.cache.GetMaxEntries(), other.cache.GetBudget());
 //  AsB      = other.AsB;
 
 } // Copy.
@@ -416,6 +518,11 @@ void ARumSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
                       "ARumSymPencil::FactorAsB");
   }
 
+  // Reusing the factors of A-sigma*B computed before, if possible.
+  if (ReuseFactor(sigma)) return;
+
+  // Deleting the previous factors (or storing them in the cache).
+  ReleaseFactor();
 
   // Subtracting sigma*B from A and storing the result 
   ExpandAsB(sigma);
@@ -442,6 +549,8 @@ void ARumSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
     throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumSymPencil::FactorAsB numeric");
   }
   umfpack_di_free_symbolic (&Symbolic) ;
+  sigmaf   = sigma;
+  fversion = Version();
 
 //exit(0);
 
@@ -495,11 +604,26 @@ void ARumSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
 
 } // MultInvAsBv
 
+
+template<class ARTYPE>
+void ARumSymPencil<ARTYPE>::
+SetFactorCache(int maxentries, std::size_t budget)
+{
+
+  cache.Define(this, &ARumSymPencil<ARTYPE>::FreeFactor, maxentries, budget);
+
+} // SetFactorCache.
+
 template<class ARTYPE>
 inline void ARumSymPencil<ARTYPE>::
 DefineMatrices(ARumSymMatrix<ARTYPE>& Ap, ARumSymMatrix<ARTYPE>& Bp)
 {
 
+  // Discarding the factors of the previous pencil.
+
+  ClearMem();
+  cache.Clear();
+
   A = &Ap;
   B = &Bp;
 
@@ -515,10 +639,10 @@ template<class ARTYPE>
 inline ARumSymPencil<ARTYPE>::
 ARumSymPencil(ARumSymMatrix<ARTYPE>& Ap, ARumSymMatrix<ARTYPE>& Bp)
 {
-  Numeric = NULL;
-  Ap = NULL;
-  Ai = NULL;
-  Ax = NULL;
+  Numeric  = NULL;
+  this->Ap = NULL;
+  this->Ai = NULL;
+  this->Ax = NULL;
 
   //AsB.factored  = false;
   DefineMatrices(Ap, Bp);
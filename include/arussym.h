@@ -86,7 +86,9 @@ inline void ARluSymStdEig<ARFLOAT>::ChangeShift(ARFLOAT sigmaRp)
   this->mode      = 3;
   this->iparam[7] = this->mode;
 
+  this->StartFactor();
   this->objOP->FactorAsI(this->sigmaR);
+  this->StopFactor();
   this->Restart();
 
 } // ChangeShift.
@@ -108,6 +110,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARumSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARumSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeBlockOPX(&ARumSymMatrix<ARFLOAT>::MultInvV);
 
 } // SetShiftInvertMode.
 
@@ -137,6 +140,7 @@ ARluSymStdEig(int nevp, ARumSymMatrix<ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, &ARumSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
   ChangeShift(sigmap);
+  this->ChangeBlockOPX(&ARumSymMatrix<ARFLOAT>::MultInvV);
 
 } // Long constructor (shift and invert mode).
 
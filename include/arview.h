@@ -0,0 +1,109 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARView.h.
+   Non-owning views of the vectors stored by the eigenvalue solvers.
+   ARView describes a dense matrix stored in column-major order
+   (as the Arnoldi basis, the Schur vectors and the eigenvectors
+   are stored by ARPACK) without copying its elements. ARCopyBlock
+   copies such a matrix to a caller-owned array with an arbitrary
+   leading dimension, in column-major or row-major order.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARVIEW_H
+#define ARVIEW_H
+
+#include <cstddef>
+#include "arch.h"
+
+
+// ARView class definition.
+
+template<class T>
+class ARView {
+
+ protected:
+
+  T*  data;  // First element of the matrix (not owned by the view).
+  int rows;  // Number of rows (the dimension of the vectors).
+  int cols;  // Number of columns (the number of vectors).
+  int ld;    // Leading dimension (distance between two columns).
+
+ public:
+
+  T* Data() const { return data; }
+  // Returns a pointer to the first element.
+
+  int Rows() const { return rows; }
+  // Returns the number of rows.
+
+  int Cols() const { return cols; }
+  // Returns the number of columns.
+
+  int LeadingDim() const { return ld; }
+  // Returns the leading dimension.
+
+  bool Empty() const { return (data == NULL) || (rows == 0) || (cols == 0); }
+  // Indicates if the view contains no elements.
+
+  T* Column(int j) const { return &data[size_t(j)*size_t(ld)]; }
+  // Returns a pointer to column j (vector j).
+
+  T& operator()(int i, int j) const { return data[i+size_t(j)*size_t(ld)]; }
+  // Returns element i of column j.
+
+  ARView(T* datap = NULL, int rowsp = 0, int colsp = 0, int ldp = 0)
+  {
+    data = datap;
+    rows = rowsp;
+    cols = colsp;
+    ld   = (ldp > 0) ? ldp : rowsp;
+  }
+  // Constructor.
+
+}; // class ARView.
+
+
+template<class T>
+void ARCopyBlock(int rows, int cols, const T* src, int lds,
+                 T* dest, int ldd, bool rowmajor = false)
+{
+
+  // Copies a rows x cols column-major matrix stored in src to dest. If
+  // rowmajor is true, element (i,j) is stored in dest[i*ldd+j], otherwise
+  // it is stored in dest[i+j*ldd].
+
+  int i, j;
+
+  if (!rowmajor) {
+    for (j=0; j<cols; j++) {
+      const T* s = &src[size_t(j)*size_t(lds)];
+      T*       d = &dest[size_t(j)*size_t(ldd)];
+      for (i=0; i<rows; i++) d[i] = s[i];
+    }
+  }
+  else {                   // Transposing blocks of 64 rows.
+    int i0, i1;
+    for (i0=0; i0<rows; i0+=64) {
+      i1 = (i0+64 < rows) ? i0+64 : rows;
+      for (j=0; j<cols; j++) {
+        const T* s = &src[size_t(j)*size_t(lds)];
+        for (i=i0; i<i1; i++) dest[size_t(i)*size_t(ldd)+j] = s[i];
+      }
+    }
+  }
+
+} // ARCopyBlock.
+
+
+#endif // ARVIEW_H
+
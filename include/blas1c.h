@@ -303,6 +303,46 @@ inline void gemv(const char* trans, const ARint &m,
 } // gemv (arcomplex<double>)
 #endif
 
+// GEMM
+
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const float &alpha,
+                 const float a[], const ARint &lda, const float b[],
+                 const ARint &ldb, const float &beta, float c[],
+                 const ARint &ldc) {
+  F77NAME(sgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (float)
+
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const double &alpha,
+                 const double a[], const ARint &lda, const double b[],
+                 const ARint &ldb, const double &beta, double c[],
+                 const ARint &ldc) {
+  F77NAME(dgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (double)
+
+#ifdef ARCOMP_H
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const arcomplex<float> &alpha,
+                 const arcomplex<float> a[], const ARint &lda, const arcomplex<float> b[],
+                 const ARint &ldb, const arcomplex<float> &beta, arcomplex<float> c[],
+                 const ARint &ldc) {
+  F77NAME(cgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (arcomplex<float>)
+
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const arcomplex<double> &alpha,
+                 const arcomplex<double> a[], const ARint &lda, const arcomplex<double> b[],
+                 const ARint &ldb, const arcomplex<double> &beta, arcomplex<double> c[],
+                 const ARint &ldc) {
+  F77NAME(zgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (arcomplex<double>)
+#endif
+
 // GBMV
 
 inline void gbmv(const char* trans, const ARint &m, const ARint &n, 
@@ -54,6 +54,12 @@ extern "C"
                       const float *x, const ARint *incx, const float *beta, 
                       float *y, const ARint *incy);
 
+  void F77NAME(sgemm)(const char* transa, const char* transb,
+                      const ARint *m, const ARint *n, const ARint *k,
+                      const float *alpha, const float *a, const ARint *lda,
+                      const float *b, const ARint *ldb, const float *beta,
+                      float *c, const ARint *ldc);
+
   void F77NAME(sgbmv)(const char* trans, const ARint *m, const ARint *n, 
                       const ARint *kl, const ARint *ku, const float *alpha,
                       const float *a, const ARint *lda, const float *x,
@@ -97,6 +103,12 @@ extern "C"
                       const double *x, const ARint *incx, const double *beta,
                       double *y, const ARint *incy);
 
+  void F77NAME(dgemm)(const char* transa, const char* transb,
+                      const ARint *m, const ARint *n, const ARint *k,
+                      const double *alpha, const double *a, const ARint *lda,
+                      const double *b, const ARint *ldb, const double *beta,
+                      double *c, const ARint *ldc);
+
   void F77NAME(dgbmv)(const char* trans, const ARint *m, const ARint *n, 
                       const ARint *kl, const ARint *ku, const double *alpha,
                       const double *a, const ARint *lda, const double *x,
@@ -154,6 +166,12 @@ extern "C"
                       const arcomplex<float> *beta, arcomplex<float> *y,
                       const ARint *incy);
 
+  void F77NAME(cgemm)(const char* transa, const char* transb,
+                      const ARint *m, const ARint *n, const ARint *k,
+                      const arcomplex<float> *alpha, const arcomplex<float> *a, const ARint *lda,
+                      const arcomplex<float> *b, const ARint *ldb, const arcomplex<float> *beta,
+                      arcomplex<float> *c, const ARint *ldc);
+
   void F77NAME(cgbmv)(const char* trans, const ARint *m, 
                       const ARint *n, const ARint *kl, 
                       const ARint *ku, const arcomplex<float> *alpha,
@@ -206,6 +224,12 @@ extern "C"
                       const arcomplex<double> *beta, arcomplex<double> *y,
                       const ARint *incy);
 
+  void F77NAME(zgemm)(const char* transa, const char* transb,
+                      const ARint *m, const ARint *n, const ARint *k,
+                      const arcomplex<double> *alpha, const arcomplex<double> *a, const ARint *lda,
+                      const arcomplex<double> *b, const ARint *ldb, const arcomplex<double> *beta,
+                      arcomplex<double> *c, const ARint *ldc);
+
   void F77NAME(zgbmv)(const char* trans, const ARint *m, 
                       const ARint *n, const ARint *kl, 
                       const ARint *ku, const arcomplex<double> *alpha,
@@ -124,13 +124,14 @@ inline cholmod_sparse* Create_Cholmod_Sparse_Matrix(int m, int n, int nnz,
   
 } // Create_Cholmod_Sparse_Matrix (double).
 
-// Create_Cholmod_Dense_Matrix (from Triplet)
-inline cholmod_dense* Create_Cholmod_Dense_Matrix(int m, int n,
-                                  double* a, cholmod_common *c)
+// Set_Cholmod_Dense_Matrix
+inline void Set_Cholmod_Dense_Matrix(cholmod_dense* A, int m, int n,
+                                     double* a)
 {
 
+  // Makes header A point to the m x n matrix stored by columns in a
+  // (data is not copied and nothing is allocated).
 
-  cholmod_dense* A = new cholmod_dense;
   A->nrow = m;
   A->ncol = n;
   A->nzmax = m*n;
@@ -140,6 +141,17 @@ inline cholmod_dense* Create_Cholmod_Dense_Matrix(int m, int n,
   A->xtype = CHOLMOD_REAL; // real
   A->dtype = CHOLMOD_DOUBLE; // double
 
+} // Set_Cholmod_Dense_Matrix (double).
+
+// Create_Cholmod_Dense_Matrix (from Triplet)
+inline cholmod_dense* Create_Cholmod_Dense_Matrix(int m, int n,
+                                  double* a, cholmod_common *c)
+{
+
+
+  cholmod_dense* A = new cholmod_dense;
+  Set_Cholmod_Dense_Matrix(A, m, n, a);
+
 //  cholmod_dense* As = cholmod_copy_dense(A,c);
   
   return A;
@@ -29,6 +29,25 @@ inline void TraceOff()
 
 {
 
+  // Nothing is written if trace is already off, so solvers (that call
+  // this function when they are created) can be defined concurrently.
+  // logfil is only used when trace is on.
+
+  if ((F77NAME(debug).ndigit == 0) && (F77NAME(debug).mgetv0 == 0) &&
+      (F77NAME(debug).msaupd == 0) && (F77NAME(debug).msaup2 == 0) &&
+      (F77NAME(debug).msaitr == 0) && (F77NAME(debug).mseigt == 0) &&
+      (F77NAME(debug).msapps == 0) && (F77NAME(debug).msgets == 0) &&
+      (F77NAME(debug).mseupd == 0) && (F77NAME(debug).mnaupd == 0) &&
+      (F77NAME(debug).mnaup2 == 0) && (F77NAME(debug).mnaitr == 0) &&
+      (F77NAME(debug).mneigt == 0) && (F77NAME(debug).mnapps == 0) &&
+      (F77NAME(debug).mngets == 0) && (F77NAME(debug).mneupd == 0) &&
+      (F77NAME(debug).mcaupd == 0) && (F77NAME(debug).mcaup2 == 0) &&
+      (F77NAME(debug).mcaitr == 0) && (F77NAME(debug).mceigt == 0) &&
+      (F77NAME(debug).mcapps == 0) && (F77NAME(debug).mcgets == 0) &&
+      (F77NAME(debug).mceupd == 0)) {
+    return;
+  }
+
   F77NAME(debug).logfil = 6;
   F77NAME(debug).ndigit = 0;
   F77NAME(debug).mgetv0 = 0;
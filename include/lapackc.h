@@ -295,6 +295,167 @@ inline void sptrs(const char* trans, const ARint &n, const ARint &nrhs,
 } // sptrs (double)
 
 
+// SYEV
+
+inline void syev(const char* jobz, const char* uplo, const ARint &n,
+                 float A[], const ARint &lda, float w[], float work[],
+                 const ARint &lwork, ARint &info) {
+  F77NAME(ssyev)(jobz, uplo, &n, A, &lda, w, work, &lwork, &info);
+} // syev (float)
+
+inline void syev(const char* jobz, const char* uplo, const ARint &n,
+                 double A[], const ARint &lda, double w[], double work[],
+                 const ARint &lwork, ARint &info) {
+  F77NAME(dsyev)(jobz, uplo, &n, A, &lda, w, work, &lwork, &info);
+} // syev (double)
+
+
+// GESVD
+
+inline void gesvd(const char* jobu, const char* jobvt, const ARint &m,
+                  const ARint &n, float A[], const ARint &lda, float s[],
+                  float U[], const ARint &ldu, float VT[], const ARint &ldvt,
+                  float work[], const ARint &lwork, ARint &info) {
+  F77NAME(sgesvd)(jobu, jobvt, &m, &n, A, &lda, s, U, &ldu, VT, &ldvt,
+                 work, &lwork, &info);
+} // gesvd (float)
+
+inline void gesvd(const char* jobu, const char* jobvt, const ARint &m,
+                  const ARint &n, double A[], const ARint &lda, double s[],
+                  double U[], const ARint &ldu, double VT[], const ARint &ldvt,
+                  double work[], const ARint &lwork, ARint &info) {
+  F77NAME(dgesvd)(jobu, jobvt, &m, &n, A, &lda, s, U, &ldu, VT, &ldvt,
+                 work, &lwork, &info);
+} // gesvd (double)
+
+
+// GEES
+
+inline void gees(const char* jobvs, const ARint &n, float A[],
+                 const ARint &lda, float wr[], float wi[], float vs[],
+                 const ARint &ldvs, float work[], const ARint &lwork,
+                 ARlogical bwork[], ARint &info) {
+  ARint sdim;
+  F77NAME(sgees)(jobvs, "N", NULL, &n, A, &lda, &sdim, wr, wi, vs, &ldvs,
+                 work, &lwork, bwork, &info);
+} // gees (float)
+
+inline void gees(const char* jobvs, const ARint &n, double A[],
+                 const ARint &lda, double wr[], double wi[], double vs[],
+                 const ARint &ldvs, double work[], const ARint &lwork,
+                 ARlogical bwork[], ARint &info) {
+  ARint sdim;
+  F77NAME(dgees)(jobvs, "N", NULL, &n, A, &lda, &sdim, wr, wi, vs, &ldvs,
+                 work, &lwork, bwork, &info);
+} // gees (double)
+
+#ifdef ARCOMP_H
+inline void gees(const char* jobvs, const ARint &n, arcomplex<float> A[],
+                 const ARint &lda, arcomplex<float> w[],
+                 arcomplex<float> vs[], const ARint &ldvs,
+                 arcomplex<float> work[], const ARint &lwork,
+                 float rwork[], ARlogical bwork[], ARint &info) {
+  ARint sdim;
+  F77NAME(cgees)(jobvs, "N", NULL, &n, A, &lda, &sdim, w, vs, &ldvs,
+                 work, &lwork, rwork, bwork, &info);
+} // gees (arcomplex<float>)
+
+inline void gees(const char* jobvs, const ARint &n, arcomplex<double> A[],
+                 const ARint &lda, arcomplex<double> w[],
+                 arcomplex<double> vs[], const ARint &ldvs,
+                 arcomplex<double> work[], const ARint &lwork,
+                 double rwork[], ARlogical bwork[], ARint &info) {
+  ARint sdim;
+  F77NAME(zgees)(jobvs, "N", NULL, &n, A, &lda, &sdim, w, vs, &ldvs,
+                 work, &lwork, rwork, bwork, &info);
+} // gees (arcomplex<double>)
+#endif
+
+
+// TRSEN
+
+inline void trsen(const ARlogical select[], const ARint &n, float T[],
+                  const ARint &ldt, float Q[], const ARint &ldq,
+                  float wr[], float wi[], ARint &m, float work[],
+                  const ARint &lwork, ARint iwork[], const ARint &liwork,
+                  ARint &info) {
+  float s, sep;
+  F77NAME(strsen)("N", "V", select, &n, T, &ldt, Q, &ldq, wr, wi, &m,
+                  &s, &sep, work, &lwork, iwork, &liwork, &info);
+} // trsen (float)
+
+inline void trsen(const ARlogical select[], const ARint &n, double T[],
+                  const ARint &ldt, double Q[], const ARint &ldq,
+                  double wr[], double wi[], ARint &m, double work[],
+                  const ARint &lwork, ARint iwork[], const ARint &liwork,
+                  ARint &info) {
+  double s, sep;
+  F77NAME(dtrsen)("N", "V", select, &n, T, &ldt, Q, &ldq, wr, wi, &m,
+                  &s, &sep, work, &lwork, iwork, &liwork, &info);
+} // trsen (double)
+
+#ifdef ARCOMP_H
+inline void trsen(const ARlogical select[], const ARint &n,
+                  arcomplex<float> T[], const ARint &ldt,
+                  arcomplex<float> Q[], const ARint &ldq,
+                  arcomplex<float> w[], ARint &m, arcomplex<float> work[],
+                  const ARint &lwork, ARint &info) {
+  float s, sep;
+  F77NAME(ctrsen)("N", "V", select, &n, T, &ldt, Q, &ldq, w, &m,
+                  &s, &sep, work, &lwork, &info);
+} // trsen (arcomplex<float>)
+
+inline void trsen(const ARlogical select[], const ARint &n,
+                  arcomplex<double> T[], const ARint &ldt,
+                  arcomplex<double> Q[], const ARint &ldq,
+                  arcomplex<double> w[], ARint &m, arcomplex<double> work[],
+                  const ARint &lwork, ARint &info) {
+  double s, sep;
+  F77NAME(ztrsen)("N", "V", select, &n, T, &ldt, Q, &ldq, w, &m,
+                  &s, &sep, work, &lwork, &info);
+} // trsen (arcomplex<double>)
+#endif
+
+
+// TREVC
+
+inline void trevc(const char* howmny, ARlogical select[], const ARint &n,
+                  const float T[], const ARint &ldt, float vr[],
+                  const ARint &ldvr, const ARint &mm, ARint &m,
+                  float work[], ARint &info) {
+  F77NAME(strevc)("R", howmny, select, &n, T, &ldt, NULL, &n, vr, &ldvr,
+                  &mm, &m, work, &info);
+} // trevc (float)
+
+inline void trevc(const char* howmny, ARlogical select[], const ARint &n,
+                  const double T[], const ARint &ldt, double vr[],
+                  const ARint &ldvr, const ARint &mm, ARint &m,
+                  double work[], ARint &info) {
+  F77NAME(dtrevc)("R", howmny, select, &n, T, &ldt, NULL, &n, vr, &ldvr,
+                  &mm, &m, work, &info);
+} // trevc (double)
+
+#ifdef ARCOMP_H
+inline void trevc(const char* howmny, ARlogical select[], const ARint &n,
+                  arcomplex<float> T[], const ARint &ldt,
+                  arcomplex<float> vr[], const ARint &ldvr, const ARint &mm,
+                  ARint &m, arcomplex<float> work[], float rwork[],
+                  ARint &info) {
+  F77NAME(ctrevc)("R", howmny, select, &n, T, &ldt, NULL, &n, vr, &ldvr,
+                  &mm, &m, work, rwork, &info);
+} // trevc (arcomplex<float>)
+
+inline void trevc(const char* howmny, ARlogical select[], const ARint &n,
+                  arcomplex<double> T[], const ARint &ldt,
+                  arcomplex<double> vr[], const ARint &ldvr, const ARint &mm,
+                  ARint &m, arcomplex<double> work[], double rwork[],
+                  ARint &info) {
+  F77NAME(ztrevc)("R", howmny, select, &n, T, &ldt, NULL, &n, vr, &ldvr,
+                  &mm, &m, work, rwork, &info);
+} // trevc (arcomplex<double>)
+#endif
+
+
 inline void second(const float &t) {
   F77NAME(second)(&t);
 }
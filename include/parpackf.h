@@ -0,0 +1,106 @@
+/*
+  ARPACK++ v1.2 2/20/2000
+  c++ interface to ARPACK code.
+
+  MODULE parpackf.h
+  PARPACK FORTRAN routines.
+  PARPACK is the distributed memory (MPI) version of ARPACK. Each
+  routine takes the FORTRAN handle of the MPI communicator as its
+  first argument. All other arguments are those of the corresponding
+  ARPACK routine (see arpackf.h), but the vectors (resid, V, workd and
+  Z) only contain the rows that belong to the calling process, and n,
+  ldv and ldz are the local number of rows.
+
+  ARPACK Authors
+     Richard Lehoucq
+     Kristyn Maschhoff
+     Danny Sorensen
+     Chao Yang
+     Dept. of Computational & Applied Mathematics
+     Rice University
+     Houston, Texas
+*/
+
+#ifndef PARPACKF_H
+#define PARPACKF_H
+
+#include <mpi.h>
+#include "arch.h"
+
+extern "C"
+{
+
+// double precision symmetric routines.
+
+  void F77NAME(pdsaupd)(MPI_Fint *comm, ARint *ido, char *bmat, ARint *n,
+                        const char *which, ARint *nev, double *tol,
+                        double *resid, ARint *ncv, double *V, ARint *ldv,
+                        ARint *iparam, ARint *ipntr, double *workd,
+                        double *workl, ARint *lworkl, ARint *info);
+
+  void F77NAME(pdseupd)(MPI_Fint *comm, ARlogical *rvec, char *HowMny,
+                        ARlogical *select, double *d, double *Z,
+                        ARint *ldz, double *sigma, char *bmat, ARint *n,
+                        const char *which, ARint *nev, double *tol,
+                        double *resid, ARint *ncv, double *V,
+                        ARint *ldv, ARint *iparam, ARint *ipntr,
+                        double *workd, double *workl,
+                        ARint *lworkl, ARint *info);
+
+// double precision nonsymmetric routines.
+
+  void F77NAME(pdnaupd)(MPI_Fint *comm, ARint *ido, char *bmat, ARint *n,
+                        const char *which, ARint *nev, double *tol,
+                        double *resid, ARint *ncv, double *V, ARint *ldv,
+                        ARint *iparam, ARint *ipntr, double *workd,
+                        double *workl, ARint *lworkl, ARint *info);
+
+  void F77NAME(pdneupd)(MPI_Fint *comm, ARlogical *rvec, char *HowMny,
+                        ARlogical *select, double *dr, double *di,
+                        double *Z, ARint *ldz, double *sigmar,
+                        double *sigmai, double *workev,
+                        char *bmat, ARint *n, const char *which,
+                        ARint *nev, double *tol, double *resid,
+                        ARint *ncv, double *V, ARint *ldv,
+                        ARint *iparam, ARint *ipntr,
+                        double *workd, double *workl,
+                        ARint *lworkl, ARint *info);
+
+// single precision symmetric routines.
+
+  void F77NAME(pssaupd)(MPI_Fint *comm, ARint *ido, char *bmat, ARint *n,
+                        const char *which, ARint *nev, float *tol,
+                        float *resid, ARint *ncv, float *V, ARint *ldv,
+                        ARint *iparam, ARint *ipntr, float *workd,
+                        float *workl, ARint *lworkl, ARint *info);
+
+  void F77NAME(psseupd)(MPI_Fint *comm, ARlogical *rvec, char *HowMny,
+                        ARlogical *select, float *d, float *Z,
+                        ARint *ldz, float *sigma, char *bmat, ARint *n,
+                        const char *which, ARint *nev, float *tol,
+                        float *resid, ARint *ncv, float *V,
+                        ARint *ldv, ARint *iparam, ARint *ipntr,
+                        float *workd, float *workl,
+                        ARint *lworkl, ARint *info);
+
+// single precision nonsymmetric routines.
+
+  void F77NAME(psnaupd)(MPI_Fint *comm, ARint *ido, char *bmat, ARint *n,
+                        const char *which, ARint *nev, float *tol,
+                        float *resid, ARint *ncv, float *V, ARint *ldv,
+                        ARint *iparam, ARint *ipntr, float *workd,
+                        float *workl, ARint *lworkl, ARint *info);
+
+  void F77NAME(psneupd)(MPI_Fint *comm, ARlogical *rvec, char *HowMny,
+                        ARlogical *select, float *dr, float *di,
+                        float *Z, ARint *ldz, float *sigmar,
+                        float *sigmai, float *workev, char *bmat,
+                        ARint *n, const char *which, ARint *nev,
+                        float *tol, float *resid, ARint *ncv,
+                        float *V, ARint *ldv, ARint *iparam,
+                        ARint *ipntr, float *workd, float *workl,
+                        ARint *lworkl, ARint *info);
+
+}
+
+#endif // PARPACKF_H
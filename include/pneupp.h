@@ -0,0 +1,100 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE pneupp.h.
+   Interface to PARPACK subroutines pdneupd and psneupd.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef PNEUPP_H
+#define PNEUPP_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "parpackf.h"
+
+inline void pneupp(MPI_Comm comm, bool rvec, char HowMny, double dr[],
+                   double di[], double Z[], ARint ldz, double sigmar,
+                   double sigmai, double workv[], char bmat, ARint n,
+                   const std::string& which, ARint nev, double tol,
+                   double resid[], ARint ncv, double V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], double workd[],
+                   double workl[], ARint lworkl, ARint& info)
+
+/*
+  c++ version of PARPACK routine pdneupd. The parameters are those of
+  neupp (see neupp.h), except for comm, the MPI communicator passed to
+  pnaupp. Z, V and resid only contain the rows that belong to the
+  calling process, so ldz, n and ldv are the local number of rows.
+  The eigenvalues dr and di are the same on all processes.
+*/
+
+{
+
+  ARint      irvec;
+  ARlogical* iselect;
+  double*    iZ;
+  MPI_Fint   fcomm;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(pdneupd)(&fcomm, &irvec, &HowMny, iselect, dr, di, iZ, &ldz,
+                   &sigmar, &sigmai, &workv[1], &bmat, &n, which.c_str(),
+                   &nev, &tol, resid, &ncv, &V[1], &ldv, &iparam[1],
+                   &ipntr[1], &workd[1], &workl[1], &lworkl, &info);
+
+  delete[] iselect;
+
+} // pneupp (double).
+
+inline void pneupp(MPI_Comm comm, bool rvec, char HowMny, float dr[],
+                   float di[], float Z[], ARint ldz, float sigmar,
+                   float sigmai, float workv[], char bmat, ARint n,
+                   const std::string& which, ARint nev, float tol,
+                   float resid[], ARint ncv, float V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], float workd[],
+                   float workl[], ARint lworkl, ARint& info)
+
+/*
+  c++ version of PARPACK routine psneupd. The only difference between
+  psneupd and pdneupd is that in the former function all vectors have
+  single precision elements and in the latter all vectors have double
+  precision elements.
+*/
+
+{
+
+  ARint      irvec;
+  ARlogical* iselect;
+  float*     iZ;
+  MPI_Fint   fcomm;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(psneupd)(&fcomm, &irvec, &HowMny, iselect, dr, di, iZ, &ldz,
+                   &sigmar, &sigmai, &workv[1], &bmat, &n, which.c_str(),
+                   &nev, &tol, resid, &ncv, &V[1], &ldv, &iparam[1],
+                   &ipntr[1], &workd[1], &workl[1], &lworkl, &info);
+
+  delete[] iselect;
+
+} // pneupp (float).
+
+#endif // PNEUPP_H
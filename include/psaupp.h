@@ -0,0 +1,76 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE psaupp.h.
+   Interface to PARPACK subroutines pdsaupd and pssaupd.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef PSAUPP_H
+#define PSAUPP_H
+
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "parpackf.h"
+
+inline void psaupp(MPI_Comm comm, ARint& ido, char bmat, ARint n,
+                   const std::string& which, ARint nev, double& tol,
+                   double resid[], ARint ncv, double V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], double workd[],
+                   double workl[], ARint lworkl, ARint& info)
+
+/*
+  c++ version of PARPACK routine pdsaupd. The parameters are those of
+  saupp (see saupp.h), except for comm, the MPI communicator that
+  contains all processes that share the problem. The rows of resid, V
+  and workd are distributed among these processes: each one stores
+  only its own n rows (so n and ldv are the local number of rows),
+  and the vectors pointed by ipntr[1] and ipntr[2] (and ipntr[3]) are
+  also local. All processes must call this routine with the same
+  values of which, nev, tol, ncv and iparam.
+*/
+
+{
+
+  MPI_Fint fcomm = MPI_Comm_c2f(comm);
+
+  F77NAME(pdsaupd)(&fcomm, &ido, &bmat, &n, which.c_str(), &nev, &tol,
+                   resid, &ncv, &V[1], &ldv, &iparam[1], &ipntr[1],
+                   &workd[1], &workl[1], &lworkl, &info);
+
+} // psaupp (double).
+
+inline void psaupp(MPI_Comm comm, ARint& ido, char bmat, ARint n,
+                   const std::string& which, ARint nev, float& tol,
+                   float resid[], ARint ncv, float V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], float workd[],
+                   float workl[], ARint lworkl, ARint& info)
+
+/*
+  c++ version of PARPACK routine pssaupd. The only difference between
+  pssaupd and pdsaupd is that in the former function all vectors have
+  single precision elements and in the latter all vectors have double
+  precision elements.
+*/
+
+{
+
+  MPI_Fint fcomm = MPI_Comm_c2f(comm);
+
+  F77NAME(pssaupd)(&fcomm, &ido, &bmat, &n, which.c_str(), &nev, &tol,
+                   resid, &ncv, &V[1], &ldv, &iparam[1], &ipntr[1],
+                   &workd[1], &workl[1], &lworkl, &info);
+
+} // psaupp (float).
+
+#endif // PSAUPP_H
@@ -0,0 +1,98 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE pseupp.h.
+   Interface to PARPACK subroutines pdseupd and psseupd.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef PSEUPP_H
+#define PSEUPP_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "parpackf.h"
+
+inline void pseupp(MPI_Comm comm, bool rvec, char HowMny, double d[],
+                   double Z[], ARint ldz, double sigma, char bmat, ARint n,
+                   const std::string& which, ARint nev, double tol,
+                   double resid[], ARint ncv, double V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], double workd[],
+                   double workl[], ARint lworkl, ARint& info)
+
+/*
+  c++ version of PARPACK routine pdseupd. The parameters are those of
+  seupp (see seupp.h), except for comm, the MPI communicator passed to
+  psaupp. Z, V and resid only contain the rows that belong to the
+  calling process, so ldz, n and ldv are the local number of rows.
+  The eigenvalues d are the same on all processes.
+*/
+
+{
+
+  ARint      irvec;
+  ARlogical* iselect;
+  double*    iZ;
+  MPI_Fint   fcomm;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(pdseupd)(&fcomm, &irvec, &HowMny, iselect, d, iZ, &ldz, &sigma,
+                   &bmat, &n, which.c_str(), &nev, &tol, resid, &ncv, &V[1],
+                   &ldv, &iparam[1], &ipntr[1], &workd[1], &workl[1],
+                   &lworkl, &info );
+
+  delete[] iselect;
+
+} // pseupp (double).
+
+inline void pseupp(MPI_Comm comm, bool rvec, char HowMny, float d[],
+                   float Z[], ARint ldz, float sigma, char bmat, ARint n,
+                   const std::string& which, ARint nev, float tol,
+                   float resid[], ARint ncv, float V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], float workd[],
+                   float workl[], ARint lworkl, ARint& info)
+
+/*
+  c++ version of PARPACK routine psseupd. The only difference between
+  psseupd and pdseupd is that in the former function all vectors have
+  single precision elements and in the latter all vectors have double
+  precision elements.
+*/
+
+{
+
+  ARint      irvec;
+  ARlogical* iselect;
+  float*     iZ;
+  MPI_Fint   fcomm;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(psseupd)(&fcomm, &irvec, &HowMny, iselect, d, iZ, &ldz, &sigma,
+                   &bmat, &n, which.c_str(), &nev, &tol, resid, &ncv, &V[1],
+                   &ldv, &iparam[1], &ipntr[1], &workd[1], &workl[1],
+                   &lworkl, &info );
+
+  delete[] iselect;
+
+} // pseupp (float).
+
+#endif // PSEUPP_H
@@ -100,6 +100,16 @@ int umfpack_di_solve
     double Info [UMFPACK_INFO]
 ) ;
 
+int umfpack_di_get_lunz
+(
+    int *lnz,
+    int *unz,
+    int *n_row,
+    int *n_col,
+    int *nz_udiag,
+    void *Numeric
+) ;
+
 int umfpack_di_report_matrix
 (
     int n_row,